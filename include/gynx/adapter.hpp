@@ -0,0 +1,618 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_ADAPTER_HPP_
+#define _GYNX_ADAPTER_HPP_
+
+#include <algorithm>
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/trim.hpp>
+#include <gynx/io/fastaqz.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/reverse_complement.hpp>
+
+namespace gynx {
+
+/// @brief Options of gynx::adapter_trimmer (defaults follow cutadapt for
+/// known adapters and fastp for pair overlaps and poly-G tails).
+struct adapter_options
+{   std::string adapter = "AGATCGGAAGAGC";  ///< 3' adapter of (first) reads
+    std::string adapter2 = "AGATCGGAAGAGC"; ///< 3' adapter of second reads
+    double error_rate = 0.1;        ///< mismatches allowed per adapter base
+    std::size_t min_overlap = 3;    ///< adapter bases to match at a read end
+    std::size_t poly_g = 10;        ///< shortest poly-G tail cut, 0 for none
+    std::size_t pair_overlap = 30;  ///< shortest overlap of a read pair
+    std::size_t pair_mismatches = 5;    ///< mismatches allowed in the overlap
+    std::size_t batch_size = 4096;  ///< records per task in file pipelines
+};
+
+/// @brief Counts returned by the adapter trimming pipelines.
+struct adapter_stats
+{   std::size_t reads = 0;          ///< records read (both mates of pairs)
+    std::size_t trimmed = 0;        ///< records shortened
+    std::uint64_t bases_removed = 0;
+
+    adapter_stats& operator+= (const adapter_stats& rhs) noexcept
+    {   reads += rhs.reads;
+        trimmed += rhs.trimmed;
+        bases_removed += rhs.bases_removed;
+        return *this;
+    }
+};
+
+namespace detail {
+
+// -- match counting kernels ---------------------------------------------------
+
+// The kernels set out[p], for every text position p < n, to the number of
+// pattern residues pat[j] (j < m <= 255, uppercase) equal to t[p + j] with
+// case ignored, an N in the pattern matching any residue if wildcards is
+// set. They work column by column, comparing one pattern residue with 16 to
+// 64 text positions at once, so there are no data-dependent branches. The
+// text must be zero-padded to n + m + 64 bytes, so that positions past its
+// end never match, and out must have room for n + 64 counts.
+
+inline void count_matches_scalar
+(   const char* t
+,   std::size_t n
+,   const char* pat
+,   std::size_t m
+,   bool wildcards
+,   std::uint8_t* out
+)   noexcept
+{   for (std::size_t p = 0; p < n; ++p)
+    {   unsigned c = 0;
+        for (std::size_t j = 0; j < m; ++j)
+            c += wildcards && 'N' == pat[j]
+            ?   0 != t[p + j]
+            :   (t[p + j] & 0xDF) == pat[j];
+        out[p] = static_cast<std::uint8_t>(c);
+    }
+}
+
+#if GYNX_SIMD_X86
+
+GYNX_TARGET_SSE42
+inline void count_matches_sse42
+(   const char* t
+,   std::size_t n
+,   const char* pat
+,   std::size_t m
+,   bool wildcards
+,   std::uint8_t* out
+)   noexcept
+{   const __m128i upper = _mm_set1_epi8(char(0xDF));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    for (std::size_t p = 0; p < n; p += 16)
+    {   __m128i acc = zero;
+        for (std::size_t j = 0; j < m; ++j)
+        {   const __m128i x = _mm_loadu_si128
+                (reinterpret_cast<const __m128i*>(t + p + j));
+            acc = wildcards && 'N' == pat[j]
+            ?   _mm_add_epi8(acc, _mm_andnot_si128(_mm_cmpeq_epi8(x, zero), one))
+            :   _mm_sub_epi8
+                (   acc
+                ,   _mm_cmpeq_epi8(_mm_and_si128(x, upper), _mm_set1_epi8(pat[j]))
+                );
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + p), acc);
+    }
+}
+
+GYNX_TARGET_AVX2
+inline void count_matches_avx2
+(   const char* t
+,   std::size_t n
+,   const char* pat
+,   std::size_t m
+,   bool wildcards
+,   std::uint8_t* out
+)   noexcept
+{   const __m256i upper = _mm256_set1_epi8(char(0xDF));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    for (std::size_t p = 0; p < n; p += 32)
+    {   __m256i acc = zero;
+        for (std::size_t j = 0; j < m; ++j)
+        {   const __m256i x = _mm256_loadu_si256
+                (reinterpret_cast<const __m256i*>(t + p + j));
+            acc = wildcards && 'N' == pat[j]
+            ?   _mm256_add_epi8(acc, _mm256_andnot_si256(_mm256_cmpeq_epi8(x, zero), one))
+            :   _mm256_sub_epi8
+                (   acc
+                ,   _mm256_cmpeq_epi8(_mm256_and_si256(x, upper), _mm256_set1_epi8(pat[j]))
+                );
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + p), acc);
+    }
+}
+
+GYNX_TARGET_AVX512
+inline void count_matches_avx512
+(   const char* t
+,   std::size_t n
+,   const char* pat
+,   std::size_t m
+,   bool wildcards
+,   std::uint8_t* out
+)   noexcept
+{   const __m512i upper = _mm512_set1_epi8(char(0xDF));
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi8(1);
+    for (std::size_t p = 0; p < n; p += 64)
+    {   __m512i acc = zero;
+        for (std::size_t j = 0; j < m; ++j)
+        {   const __m512i x = _mm512_loadu_si512(t + p + j);
+            const __mmask64 k = wildcards && 'N' == pat[j]
+            ?   _mm512_cmpneq_epi8_mask(x, zero)
+            :   _mm512_cmpeq_epi8_mask(_mm512_and_si512(x, upper), _mm512_set1_epi8(pat[j]));
+            acc = _mm512_mask_add_epi8(acc, k, acc, one);
+        }
+        _mm512_storeu_si512(out + p, acc);
+    }
+}
+
+#endif  // GYNX_SIMD_X86
+
+// Returns the match counts of @a pattern (at most 255 residues) at every
+// position of @a text in a thread-local buffer, valid until the next call.
+inline const std::uint8_t* match_counts
+(   std::string_view text
+,   std::string_view pattern
+,   bool wildcards
+)
+{   thread_local std::vector<char> t, pat;
+    thread_local std::vector<std::uint8_t> out;
+    const std::size_t n = text.size(), m = pattern.size();
+    t.assign(n + m + 64, 0);
+    std::copy(text.begin(), text.end(), t.begin());
+    pat.resize(m);
+    std::transform
+    (   pattern.begin()
+    ,   pattern.end()
+    ,   pat.begin()
+    ,   [](char c) { return static_cast<char>(c & 0xDF); }
+    );
+    out.resize(n + 64);
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            count_matches_avx512(t.data(), n, pat.data(), m, wildcards, out.data());
+            break;
+        case simd::isa::avx2:
+            count_matches_avx2(t.data(), n, pat.data(), m, wildcards, out.data());
+            break;
+        case simd::isa::sse42:
+            count_matches_sse42(t.data(), n, pat.data(), m, wildcards, out.data());
+            break;
+#endif
+        default:
+            count_matches_scalar(t.data(), n, pat.data(), m, wildcards, out.data());
+    }
+    return out.data();
+}
+
+// -- adapter search -----------------------------------------------------------
+
+// Leftmost start of @a adapter (at most 255 residues) in @a read, allowing
+// floor(L * rate) mismatches over the L aligned bases and letting the
+// adapter run off the 3' end by all but @a min_overlap bases; read.size()
+// if there is none. N in the adapter matches anything, case is ignored.
+inline std::size_t find_adapter
+(   std::string_view read
+,   std::string_view adapter
+,   double rate
+,   std::size_t min_overlap
+)
+{   const std::size_t n = read.size(), m = adapter.size();
+    const std::size_t o = std::max<std::size_t>(min_overlap, 1);
+    if (0 == m || n < o)
+        return n;
+    std::uint8_t k[256];    // mismatches allowed by aligned length
+    for (std::size_t len = 0; len <= m; ++len)
+        k[len] = static_cast<std::uint8_t>(double(len) * rate);
+    const std::uint8_t* c = match_counts(read, adapter, true);
+    for (std::size_t p = 0; p + o <= n; ++p)
+    {   const std::size_t len = std::min(m, n - p);
+        if (len - c[p] <= k[len])
+            return p;
+    }
+    return n;
+}
+
+// Start of the poly-G tail of @a read (fastp's rule: at most one mismatch
+// per 8 bases and 5 in all, at least @a min_length long); read.size() if
+// there is none.
+inline std::size_t poly_g_start(std::string_view read, std::size_t min_length) noexcept
+{   const std::size_t n = read.size();
+    if (0 == min_length || n < min_length)
+        return n;
+    std::size_t mismatches = 0, first_g = n, i = 0;
+    for (; i < n; ++i)
+    {   if ((read[n - i - 1] & 0xDF) != 'G')
+            ++mismatches;
+        else
+            first_g = n - i - 1;
+        if (mismatches > 5 || (mismatches > (i + 1) / 8 && i + 1 >= min_length))
+            break;
+    }
+    return i >= min_length ? first_g : n;
+}
+
+// Insert size of a read pair whose mates overlap head to head, i.e. the
+// reverse complement @a rc2 of the second read starts before @a r1 (fastp's
+// negative offsets), meaning both reads ran into adapter; 0 if they do not.
+// An overlap of L bases may have min(max_mismatches, L / 5) mismatches,
+// counted over its first 255 bases.
+inline std::size_t pair_insert
+(   std::string_view r1
+,   std::string_view rc2
+,   std::size_t min_overlap
+,   std::size_t max_mismatches
+)
+{   constexpr std::size_t max_pattern = 255;
+    const std::size_t n1 = r1.size(), n2 = rc2.size();
+    auto matches = [&](std::size_t len, std::uint8_t c)
+    {   len = std::min(len, max_pattern);
+        return len - c <= std::min(max_mismatches, len / 5);
+    };
+    // r1 starts first: the insert is at least as long as r1, no adapter
+    const std::uint8_t* c = match_counts(r1, rc2.substr(0, max_pattern), false);
+    for (std::size_t o = 0; o + min_overlap < n1; ++o)
+        if (matches(std::min(n1 - o, n2), c[o]))
+            return 0;
+    // rc2 starts first: the insert is the overlap
+    c = match_counts(rc2, r1.substr(0, max_pattern), false);
+    for (std::size_t o = 1; o + min_overlap < n2; ++o)
+        if (matches(std::min(n1, n2 - o), c[o]))
+            return std::min(n1, n2 - o);
+    return 0;
+}
+
+// Truncates record @a r and its "_qs" quality string to @a n residues and
+// returns the number of residues removed.
+template<typename Container, typename Map>
+std::size_t truncate_record(sq_gen<Container, Map>& r, std::size_t n)
+{   const std::size_t removed = r.size() - std::min(n, r.size());
+    if (removed)
+    {   r.resize(r.size() - removed, 'N');
+        if (r.has("_qs"))
+        {   auto& qs = std::any_cast<std::string&>(r["_qs"]);
+            qs.resize(std::min(qs.size(), r.size()));
+        }
+    }
+    return removed;
+}
+
+}   // end gynx::detail namespace
+
+// -- adapter_trimmer ----------------------------------------------------------
+
+/// @brief Adapter and poly-G trimmer of single or paired-end reads.
+/// @details A single read first loses its NextSeq/NovaSeq poly-G tail (a
+/// dark cycle reads as G) and then everything from the leftmost match of
+/// the known 3' adapter, cutadapt style, with up to @a error_rate
+/// mismatches per aligned base and partial adapters of at least
+/// @a min_overlap bases at the very end. For a pair, the mates are first
+/// overlapped as fastp does: if the second read's reverse complement starts
+/// before the first read, the insert is shorter than the reads and both are
+/// cut to its length, which needs no adapter sequence at all. Otherwise each
+/// mate is searched for its known adapter.
+class adapter_trimmer
+{   adapter_options _o;
+
+public:
+    ///
+    /// Creates a trimmer with options @a o.
+    explicit adapter_trimmer(adapter_options o = {})
+    :   _o(std::move(o))
+    {   if (_o.error_rate < 0.0 || _o.error_rate >= 1.0)
+            throw std::invalid_argument("gynx::adapter_trimmer: error rate not in [0, 1)");
+        if (_o.adapter.size() > 255 || _o.adapter2.size() > 255)
+            throw std::invalid_argument("gynx::adapter_trimmer: adapter longer than 255");
+        for (auto* a : { &_o.adapter, &_o.adapter2 })
+            for (auto& c : *a)
+                c = static_cast<char>(c & 0xDF);
+    }
+    ///
+    /// Returns the options of this trimmer.
+    const adapter_options& options() const noexcept
+    {   return _o;
+    }
+    ///
+    /// @brief Returns the region of single read @a read kept after removing
+    /// its poly-G tail and adapter (always starting at 0).
+    trim_range operator() (std::string_view read) const
+    {   return _single(read, _o.adapter);
+    }
+    ///
+    /// @brief Returns the regions of mates @a r1 and @a r2 kept after
+    /// removing poly-G tails and the adapters found from their overlap or
+    /// sequences.
+    std::pair<trim_range, trim_range> operator()
+    (   std::string_view r1
+    ,   std::string_view r2
+    )   const
+    {   r1 = r1.substr(0, detail::poly_g_start(r1, _o.poly_g));
+        r2 = r2.substr(0, detail::poly_g_start(r2, _o.poly_g));
+        thread_local std::string rc2;
+        rc2.resize(r2.size());
+        reverse_complement_copy(r2.data(), r2.data() + r2.size(), rc2.data());
+        if (const std::size_t insert = detail::pair_insert
+            (r1, rc2, _o.pair_overlap, _o.pair_mismatches))
+            return { { 0, std::min(insert, r1.size()) }, { 0, insert } };
+        return { _adapter(r1, _o.adapter), _adapter(r2, _o.adapter2) };
+    }
+
+private:
+    trim_range _single(std::string_view read, std::string_view adapter) const
+    {   return _adapter(read.substr(0, detail::poly_g_start(read, _o.poly_g)), adapter);
+    }
+    trim_range _adapter(std::string_view read, std::string_view adapter) const
+    {   return
+        {   0
+        ,   detail::find_adapter(read, adapter, _o.error_rate, _o.min_overlap)
+        };
+    }
+};
+
+// -- trimming records ---------------------------------------------------------
+///
+/// @brief Trims record @a r in place with @a trimmer, keeping its "_qs"
+/// quality string the same length. Returns the number of residues removed.
+template<typename Container, typename Map>
+std::size_t adapter_trim(sq_gen<Container, Map>& r, const adapter_trimmer& trimmer)
+{   const auto t = trimmer(std::string_view(r.data(), r.size()));
+    return detail::truncate_record(r, t.end);
+}
+///
+/// @brief Trims mates @a r1 and @a r2 in place with @a trimmer, keeping their
+/// "_qs" quality strings the same length. Returns the number of residues
+/// removed from both.
+template<typename Container, typename Map>
+std::size_t adapter_trim
+(   sq_gen<Container, Map>& r1
+,   sq_gen<Container, Map>& r2
+,   const adapter_trimmer& trimmer
+)
+{   const auto [t1, t2] = trimmer
+    (   std::string_view(r1.data(), r1.size())
+    ,   std::string_view(r2.data(), r2.size())
+    );
+    return detail::truncate_record(r1, t1.end) + detail::truncate_record(r2, t2.end);
+}
+
+namespace detail {
+
+// a batch of records (or read pairs) and their compressed FASTQ output
+template<typename Record>
+struct adapter_batch
+{   std::vector<Record> records;
+    std::string gz[2];
+};
+
+inline FILE* open_output(std::string_view filename)
+{   FILE* fp = filename == "-"
+    ?   stdout
+    :   std::fopen(std::string(filename).c_str(), "wb");
+    if (nullptr == fp)
+        throw std::runtime_error
+        (   "gynx::adapter_trim: could not open file -> "
+        +   std::string(filename)
+        );
+    return fp;
+}
+
+// closes (or flushes the standard output) and returns false on errors
+inline bool close_output(FILE* fp) noexcept
+{   const bool failed = std::ferror(fp) != 0;
+    return (fp == stdout ? std::fflush(fp) : std::fclose(fp)) == 0 && ! failed;
+}
+
+inline void write_error(std::string_view filename)
+{   throw std::runtime_error
+    (   "gynx::adapter_trim: error writing file -> "
+    +   std::string(filename)
+    );
+}
+
+// Trims and compresses batches of records with trim(batch) on @a pool while
+// they are read with read(add), and writes their gzip members to @a out in
+// file order on the calling thread.
+template<typename Record, typename Read, typename Trim>
+adapter_stats adapter_pipeline
+(   std::size_t batch_size
+,   thread_pool& pool
+,   Read read
+,   Trim trim
+,   FILE* const (&out)[2]
+)
+{   if (0 == batch_size)
+        throw std::invalid_argument("gynx::adapter_trim: batch size is 0");
+    typedef adapter_batch<Record> batch_type;
+    adapter_stats st;
+    auto fresh = [&]
+    {   auto b = std::make_shared<batch_type>();
+        b->records.reserve(batch_size);
+        return b;
+    };
+    parallel_pipeline<batch_type>
+    (   pool
+    ,   [&](auto& submit)
+        {   auto batch = fresh();
+            read
+            (   [&](auto&&... r)
+                {   batch->records.emplace_back(std::move(r)...);
+                    if (batch->records.size() == batch_size)
+                        submit(std::exchange(batch, fresh()));
+                }
+            );
+            if (! batch->records.empty())
+                submit(std::move(batch));
+        }
+    ,   trim
+    ,   [&](batch_type& b, const adapter_stats& s)
+        {   st += s;
+            for (int i = 0; i < 2; ++i)
+                if (out[i])
+                    std::fwrite(b.gz[i].data(), 1, b.gz[i].size(), out[i]);
+        }
+    );
+    return st;
+}
+
+}   // end gynx::detail namespace
+
+// -- trimming files -----------------------------------------------------------
+///
+/// @brief Trims every record of FASTQ file @a input with @a trimmer and
+/// writes them, in input order, to gzip-compressed FASTQ file @a output
+/// ("-" for the standard output) with @a writer.
+/// @details Batches of adapter_options::batch_size records are trimmed,
+/// formatted and compressed (as independent gzip members) on @a pool while
+/// the file is being read (see gynx::parallel_pipeline()), so compression
+/// scales with the pool too. Reads trimmed to nothing are written as empty
+/// records.
+template<typename Sequence = sq>
+adapter_stats adapter_trim_file
+(   std::string_view input
+,   std::string_view output
+,   const adapter_trimmer& trimmer = adapter_trimmer()
+,   thread_pool& pool = thread_pool::global()
+,   in::fast_aqz<Sequence> reader = {}
+,   out::fastq_gz writer = out::fastq_gz(0, 4)
+)
+{   FILE* const out[2] = { detail::open_output(output), nullptr };
+    adapter_stats st;
+    try
+    {   st = detail::adapter_pipeline<Sequence>
+        (   trimmer.options().batch_size
+        ,   pool
+        ,   [&](auto add) { reader(input, add); }
+        ,   [&](detail::adapter_batch<Sequence>& b)
+            {   adapter_stats s;
+                std::string text;
+                for (auto& r : b.records)
+                {   if (const auto k = adapter_trim(r, trimmer))
+                    {   ++s.trimmed;
+                        s.bases_removed += k;
+                    }
+                    writer.format(text, r);
+                }
+                b.gz[0] = writer.compress(text);
+                s.reads = b.records.size();
+                b.records.clear();
+                return s;
+            }
+        ,   out
+        );
+    }
+    catch (...)
+    {   if (out[0] != stdout)
+            std::fclose(out[0]);
+        throw;
+    }
+    if (! detail::close_output(out[0]))
+        detail::write_error(output);
+    return st;
+}
+///
+/// @brief Trims the read pairs of FASTQ files @a input1 and @a input2 with
+/// @a trimmer and writes them, in input order, to gzip-compressed FASTQ
+/// files @a output1 and @a output2 with @a writer. See adapter_trim_file().
+template<typename Sequence = sq>
+adapter_stats adapter_trim_files
+(   std::string_view input1
+,   std::string_view input2
+,   std::string_view output1
+,   std::string_view output2
+,   const adapter_trimmer& trimmer = adapter_trimmer()
+,   thread_pool& pool = thread_pool::global()
+,   in::fast_aqz<Sequence> reader = {}
+,   out::fastq_gz writer = out::fastq_gz(0, 4)
+)
+{   typedef std::pair<Sequence, Sequence> pair_type;
+    FILE* fp1 = detail::open_output(output1);
+    FILE* fp2{};
+    try
+    {   fp2 = detail::open_output(output2);
+    }
+    catch (...)
+    {   if (fp1 != stdout)
+            std::fclose(fp1);
+        throw;
+    }
+    FILE* const out[2] = { fp1, fp2 };
+    adapter_stats st;
+    try
+    {   st = detail::adapter_pipeline<pair_type>
+        (   trimmer.options().batch_size
+        ,   pool
+        ,   [&](auto add) { reader(input1, input2, add); }
+        ,   [&](detail::adapter_batch<pair_type>& b)
+            {   adapter_stats s;
+                std::string text1, text2;
+                for (auto& [r1, r2] : b.records)
+                {   const std::size_t n1 = r1.size(), n2 = r2.size();
+                    s.bases_removed += adapter_trim(r1, r2, trimmer);
+                    s.trimmed += (r1.size() < n1) + (r2.size() < n2);
+                    writer.format(text1, r1);
+                    writer.format(text2, r2);
+                }
+                b.gz[0] = writer.compress(text1);
+                b.gz[1] = writer.compress(text2);
+                s.reads = 2 * b.records.size();
+                b.records.clear();
+                return s;
+            }
+        ,   out
+        );
+    }
+    catch (...)
+    {   for (FILE* fp : out)
+            if (fp != stdout)
+                std::fclose(fp);
+        throw;
+    }
+    const bool ok1 = detail::close_output(fp1);
+    const bool ok2 = detail::close_output(fp2);
+    if (! ok1 || ! ok2)
+        detail::write_error(ok1 ? output2 : output1);
+    return st;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_ADAPTER_HPP_
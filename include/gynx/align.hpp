@@ -0,0 +1,902 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_ALIGN_HPP_
+#define _GYNX_ALIGN_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gynx/simd.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/thread_pool.hpp>
+
+namespace gynx {
+
+// -- scoring ------------------------------------------------------------------
+
+/// @brief A substitution matrix over an alphabet of residues.
+/// @details Lookups are case-insensitive; residues outside the alphabet
+/// score as the @a unknown residue given at construction.
+class scoring_matrix
+{   std::string _alphabet;
+    std::array<std::uint8_t, 256> _index{};
+    std::vector<std::int8_t> _scores;  // row-major, size() x size()
+
+public:
+    ///
+    /// Builds the matrix from the row-major @a scores of @a alphabet,
+    /// each in [-128, 127].
+    scoring_matrix
+    (   std::string_view alphabet
+    ,   const std::vector<int>& scores
+    ,   char unknown
+    )
+    :   _alphabet(alphabet)
+    {   const auto u = alphabet.find(unknown);
+        if
+        (   alphabet.empty()
+        ||  alphabet.size() > 255
+        ||  scores.size() != alphabet.size() * alphabet.size()
+        ||  std::string_view::npos == u
+        )
+            throw std::invalid_argument("gynx::scoring_matrix: bad dimensions");
+        _index.fill(static_cast<std::uint8_t>(u));
+        for (std::size_t i = 0; i < alphabet.size(); ++i)
+        {   const auto c = static_cast<unsigned char>(alphabet[i]);
+            _index[c] = static_cast<std::uint8_t>(i);
+            if ('A' <= c && c <= 'Z')
+                _index[c - 'A' + 'a'] = static_cast<std::uint8_t>(i);
+        }
+        for (int s : scores)
+        {   if (s < -128 || s > 127)
+                throw std::invalid_argument
+                    ("gynx::scoring_matrix: score out of range");
+            _scores.push_back(static_cast<std::int8_t>(s));
+        }
+    }
+
+    ///
+    /// Returns a nucleotide matrix over ACGTN where N and any other residue
+    /// score @a mismatch against everything.
+    static scoring_matrix dna(int match = 2, int mismatch = -3)
+    {   std::vector<int> s(25, mismatch);
+        for (int i = 0; i < 4; ++i)
+            s[i * 5 + i] = match;
+        return scoring_matrix("ACGTN", s, 'N');
+    }
+
+    ///
+    /// Returns the BLOSUM62 amino acid matrix; unknown residues score as X.
+    static scoring_matrix blosum62()
+    {   return scoring_matrix
+        (   "ARNDCQEGHILKMFPSTWYVBZX*"
+        ,   {    4,-1,-2,-2, 0,-1,-1, 0,-2,-1,-1,-1,-1,-2,-1, 1, 0,-3,-2, 0,-2,-1, 0,-4
+            ,   -1, 5, 0,-2,-3, 1, 0,-2, 0,-3,-2, 2,-1,-3,-2,-1,-1,-3,-2,-3,-1, 0,-1,-4
+            ,   -2, 0, 6, 1,-3, 0, 0, 0, 1,-3,-3, 0,-2,-3,-2, 1, 0,-4,-2,-3, 3, 0,-1,-4
+            ,   -2,-2, 1, 6,-3, 0, 2,-1,-1,-3,-4,-1,-3,-3,-1, 0,-1,-4,-3,-3, 4, 1,-1,-4
+            ,    0,-3,-3,-3, 9,-3,-4,-3,-3,-1,-1,-3,-1,-2,-3,-1,-1,-2,-2,-1,-3,-3,-2,-4
+            ,   -1, 1, 0, 0,-3, 5, 2,-2, 0,-3,-2, 1, 0,-3,-1, 0,-1,-2,-1,-2, 0, 3,-1,-4
+            ,   -1, 0, 0, 2,-4, 2, 5,-2, 0,-3,-3, 1,-2,-3,-1, 0,-1,-3,-2,-2, 1, 4,-1,-4
+            ,    0,-2, 0,-1,-3,-2,-2, 6,-2,-4,-4,-2,-3,-3,-2, 0,-2,-2,-3,-3,-1,-2,-1,-4
+            ,   -2, 0, 1,-1,-3, 0, 0,-2, 8,-3,-3,-1,-2,-1,-2,-1,-2,-2, 2,-3, 0, 0,-1,-4
+            ,   -1,-3,-3,-3,-1,-3,-3,-4,-3, 4, 2,-3, 1, 0,-3,-2,-1,-3,-1, 3,-3,-3,-1,-4
+            ,   -1,-2,-3,-4,-1,-2,-3,-4,-3, 2, 4,-2, 2, 0,-3,-2,-1,-2,-1, 1,-4,-3,-1,-4
+            ,   -1, 2, 0,-1,-3, 1, 1,-2,-1,-3,-2, 5,-1,-3,-1, 0,-1,-3,-2,-2, 0, 1,-1,-4
+            ,   -1,-1,-2,-3,-1, 0,-2,-3,-2, 1, 2,-1, 5, 0,-2,-1,-1,-1,-1, 1,-3,-1,-1,-4
+            ,   -2,-3,-3,-3,-2,-3,-3,-3,-1, 0, 0,-3, 0, 6,-4,-2,-2, 1, 3,-1,-3,-3,-1,-4
+            ,   -1,-2,-2,-1,-3,-1,-1,-2,-2,-3,-3,-1,-2,-4, 7,-1,-1,-4,-3,-2,-2,-1,-2,-4
+            ,    1,-1, 1, 0,-1, 0, 0, 0,-1,-2,-2, 0,-1,-2,-1, 4, 1,-3,-2,-2, 0, 0, 0,-4
+            ,    0,-1, 0,-1,-1,-1,-1,-2,-2,-1,-1,-1,-1,-2,-1, 1, 5,-2,-2, 0,-1,-1, 0,-4
+            ,   -3,-3,-4,-4,-2,-2,-3,-2,-2,-3,-2,-3,-1, 1,-4,-3,-2,11, 2,-3,-4,-3,-2,-4
+            ,   -2,-2,-2,-3,-2,-1,-2,-3, 2,-1,-1,-2,-1, 3,-3,-2,-2, 2, 7,-1,-3,-2,-1,-4
+            ,    0,-3,-3,-3,-1,-2,-2,-3,-3, 3, 1,-2, 1,-1,-2,-2, 0,-3,-1, 4,-3,-2,-1,-4
+            ,   -2,-1, 3, 4,-3, 0, 1,-1, 0,-3,-4, 0,-3,-3,-2, 0,-1,-4,-3,-3, 4, 1,-1,-4
+            ,   -1, 0, 0, 1,-3, 3, 4,-2, 0,-3,-3, 1,-1,-3,-1, 0,-1,-3,-2,-2, 1, 4,-1,-4
+            ,    0,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2, 0, 0,-2,-1,-1,-1,-1,-1,-4
+            ,   -4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4, 1
+            }
+        ,   'X'
+        );
+    }
+
+// -- observers ----------------------------------------------------------------
+    const std::string& alphabet() const noexcept
+    {   return _alphabet;
+    }
+    std::size_t size() const noexcept
+    {   return _alphabet.size();
+    }
+    ///
+    /// Returns the row/column of residue @a c.
+    std::uint8_t index(char c) const noexcept
+    {   return _index[static_cast<unsigned char>(c)];
+    }
+    const std::uint8_t* index_table() const noexcept
+    {   return _index.data();
+    }
+    ///
+    /// Returns the score of rows @a i and @a j.
+    int score(std::size_t i, std::size_t j) const noexcept
+    {   return _scores[i * _alphabet.size() + j];
+    }
+    int operator() (char a, char b) const noexcept
+    {   return score(index(a), index(b));
+    }
+    int min() const noexcept
+    {   return *std::min_element(_scores.begin(), _scores.end());
+    }
+    int max() const noexcept
+    {   return *std::max_element(_scores.begin(), _scores.end());
+    }
+};
+
+/// @brief Substitution scores and affine gap penalties; a gap of length L
+/// costs <tt>gap_open + L * gap_extend</tt>.
+struct alignment_scoring
+{   scoring_matrix matrix = scoring_matrix::dna();
+    int gap_open = 5;
+    int gap_extend = 2;
+};
+
+/// @brief Which ends of the sequences are free in an alignment.
+enum class alignment_mode
+{   global      ///< Needleman-Wunsch: both sequences end to end
+,   local       ///< Smith-Waterman: best-scoring pair of substrings
+,   semi_global ///< query end to end, free leading/trailing target residues
+};
+
+/// @brief Score and end coordinates (one past the last aligned residue) of
+/// an optimal alignment.
+struct alignment_score
+{   int score;
+    std::size_t query_end;
+    std::size_t target_end;
+
+    friend constexpr bool operator==
+    (   const alignment_score&
+    ,   const alignment_score&
+    ) = default;
+};
+
+/// @brief An optimal alignment with coordinates [begin, end) on both
+/// sequences and its CIGAR string (M: aligned pair, I: query residue
+/// against a gap, D: target residue against a gap).
+struct alignment
+{   int score;
+    std::size_t query_begin;
+    std::size_t query_end;
+    std::size_t target_begin;
+    std::size_t target_end;
+    std::string cigar;
+};
+
+namespace detail {
+
+// -- scalar reference ---------------------------------------------------------
+
+// Traceback bits per cell: where H came from (0 diagonal, 1 E, 2 F, 3 local
+// start) and whether E and F extend a gap rather than open one.
+enum : std::uint8_t
+{   from_diag = 0
+,   from_e = 1
+,   from_f = 2
+,   from_start = 3
+,   e_extends = 4
+,   f_extends = 8
+};
+
+// Gotoh's algorithm in 32-bit integers, column by column over the target.
+// Rows are query residues given as matrix indices. Records traceback bits
+// in dir[j * m + i] when dir is not null.
+inline alignment_score gotoh
+(   const std::uint8_t* q
+,   std::size_t m
+,   const char* t
+,   std::size_t n
+,   const alignment_scoring& sc
+,   alignment_mode mode
+,   std::uint8_t* dir = nullptr
+)
+{   constexpr int neg = std::numeric_limits<int>::min() / 2;
+    const bool local = alignment_mode::local == mode;
+    const bool global = alignment_mode::global == mode;
+    const int open = sc.gap_open, extend = sc.gap_extend, oe = open + extend;
+    const auto top = [&](std::ptrdiff_t j)  // H(-1, j)
+    {   return ! global || j < 0 ? 0 : -(open + extend * int(j + 1));
+    };
+    std::vector<int> h(m), e(m, neg);
+    for (std::size_t i = 0; i < m; ++i)
+        h[i] = local ? 0 : -(open + extend * int(i + 1));
+    std::vector<int> profile(sc.matrix.size() * m);  // [residue][row]
+    for (std::size_t c = 0; c < sc.matrix.size(); ++c)
+        for (std::size_t i = 0; i < m; ++i)
+            profile[c * m + i] = sc.matrix.score(q[i], c);
+
+    alignment_score r{ 0, 0, 0 };
+    if (alignment_mode::semi_global == mode && m)
+        r = { h[m - 1], m, 0 };
+    for (std::size_t j = 0; j < n; ++j)
+    {   const int* p = profile.data() + sc.matrix.index(t[j]) * m;
+        int diag = top(std::ptrdiff_t(j) - 1), up = top(j), f = neg;
+        for (std::size_t i = 0; i < m; ++i)
+        {   const int e_ext = e[i] - extend, e_open = h[i] - oe;
+            const int f_ext = f - extend, f_open = up - oe;
+            e[i] = std::max(e_ext, e_open);
+            f = std::max(f_ext, f_open);
+            int v = diag + p[i];
+            std::uint8_t d = from_diag;
+            if (e[i] > v)
+            {   v = e[i];
+                d = from_e;
+            }
+            if (f > v)
+            {   v = f;
+                d = from_f;
+            }
+            if (local && v <= 0)
+            {   v = 0;
+                d = from_start;
+            }
+            if (dir)
+                dir[j * m + i] = d
+                |   (e_ext > e_open ? e_extends : 0)
+                |   (f_ext > f_open ? f_extends : 0);
+            diag = h[i];
+            h[i] = up = v;
+            if (local && v > r.score)
+                r = { v, i + 1, j + 1 };
+        }
+        if (alignment_mode::semi_global == mode && m && h[m - 1] > r.score)
+            r = { h[m - 1], m, j + 1 };
+    }
+    if (global)
+        r = { m ? h[m - 1] : top(std::ptrdiff_t(n) - 1), m, n };
+    return r;
+}
+
+// Walks the traceback bits of gotoh() back from the end of @a r.
+inline alignment traceback
+(   const std::uint8_t* dir
+,   std::size_t m
+,   alignment_score r
+,   alignment_mode mode
+)
+{   std::string ops;
+    std::ptrdiff_t i = std::ptrdiff_t(r.query_end) - 1;
+    std::ptrdiff_t j = std::ptrdiff_t(r.target_end) - 1;
+    std::uint8_t state = from_diag;
+    while (i >= 0 && j >= 0)
+    {   const std::uint8_t d = dir[j * m + i];
+        if (from_e == state)
+        {   ops.push_back('D');
+            state = d & e_extends ? from_e : from_diag;
+            --j;
+        }
+        else if (from_f == state)
+        {   ops.push_back('I');
+            state = d & f_extends ? from_f : from_diag;
+            --i;
+        }
+        else if (from_start == (d & 3))
+            break;
+        else if (from_diag == (d & 3))
+        {   ops.push_back('M');
+            --i;
+            --j;
+        }
+        else
+            state = d & 3;
+    }
+    if (alignment_mode::global == mode)
+        for (; j >= 0; --j)
+            ops.push_back('D');
+    if (alignment_mode::local != mode)
+        for (; i >= 0; --i)
+            ops.push_back('I');
+
+    alignment a
+    {   r.score
+    ,   std::size_t(i + 1)
+    ,   r.query_end
+    ,   std::size_t(j + 1)
+    ,   r.target_end
+    ,   {}
+    };
+    for (auto it = ops.rbegin(); it != ops.rend(); )
+    {   const auto run = std::find_if
+            (it, ops.rend(), [op = *it](char c) { return c != op; });
+        a.cigar += std::to_string(run - it);
+        a.cigar += *it;
+        it = run;
+    }
+    return a;
+}
+
+// -- striped kernels ----------------------------------------------------------
+
+// Score-only Farrar striped kernels on saturating 8- or 16-bit lanes. Query
+// row i lives in lane i / seg of segment i % seg; the query profile holds
+// seg vectors of scores per alphabet residue. A result with overflow set
+// has to be recomputed with wider lanes.
+
+struct striped_result
+{   alignment_score r;
+    bool overflow;
+};
+
+#if GYNX_SIMD_X86
+
+template<typename T>
+struct sse42_ops
+{   using vec = __m128i;
+    using elem = T;
+    static constexpr std::size_t lanes = 16 / sizeof(T);
+
+    GYNX_TARGET_SSE42 static vec set1(int v)
+    {   if constexpr (1 == sizeof(T))
+            return _mm_set1_epi8(static_cast<char>(v));
+        else
+            return _mm_set1_epi16(static_cast<short>(v));
+    }
+    GYNX_TARGET_SSE42 static vec load(const T* p)
+    {   return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    GYNX_TARGET_SSE42 static void store(T* p, vec v)
+    {   _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+    GYNX_TARGET_SSE42 static vec adds(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm_adds_epi8(a, b);
+        else
+            return _mm_adds_epi16(a, b);
+    }
+    GYNX_TARGET_SSE42 static vec subs(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm_subs_epi8(a, b);
+        else
+            return _mm_subs_epi16(a, b);
+    }
+    GYNX_TARGET_SSE42 static vec max(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm_max_epi8(a, b);
+        else
+            return _mm_max_epi16(a, b);
+    }
+    GYNX_TARGET_SSE42 static vec min(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm_min_epi8(a, b);
+        else
+            return _mm_min_epi16(a, b);
+    }
+    GYNX_TARGET_SSE42 static bool any_gt(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm_movemask_epi8(_mm_cmpgt_epi8(a, b));
+        else
+            return _mm_movemask_epi8(_mm_cmpgt_epi16(a, b));
+    }
+    // moves every element one lane up and puts v in lane 0
+    GYNX_TARGET_SSE42 static vec shift_in(vec a, int v)
+    {   if constexpr (1 == sizeof(T))
+            return _mm_insert_epi8(_mm_slli_si128(a, 1), v, 0);
+        else
+            return _mm_insert_epi16(_mm_slli_si128(a, 2), v, 0);
+    }
+};
+
+template<typename T>
+struct avx2_ops
+{   using vec = __m256i;
+    using elem = T;
+    static constexpr std::size_t lanes = 32 / sizeof(T);
+
+    GYNX_TARGET_AVX2 static vec set1(int v)
+    {   if constexpr (1 == sizeof(T))
+            return _mm256_set1_epi8(static_cast<char>(v));
+        else
+            return _mm256_set1_epi16(static_cast<short>(v));
+    }
+    GYNX_TARGET_AVX2 static vec load(const T* p)
+    {   return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    GYNX_TARGET_AVX2 static void store(T* p, vec v)
+    {   _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    GYNX_TARGET_AVX2 static vec adds(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm256_adds_epi8(a, b);
+        else
+            return _mm256_adds_epi16(a, b);
+    }
+    GYNX_TARGET_AVX2 static vec subs(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm256_subs_epi8(a, b);
+        else
+            return _mm256_subs_epi16(a, b);
+    }
+    GYNX_TARGET_AVX2 static vec max(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm256_max_epi8(a, b);
+        else
+            return _mm256_max_epi16(a, b);
+    }
+    GYNX_TARGET_AVX2 static vec min(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm256_min_epi8(a, b);
+        else
+            return _mm256_min_epi16(a, b);
+    }
+    GYNX_TARGET_AVX2 static bool any_gt(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm256_movemask_epi8(_mm256_cmpgt_epi8(a, b));
+        else
+            return _mm256_movemask_epi8(_mm256_cmpgt_epi16(a, b));
+    }
+    GYNX_TARGET_AVX2 static vec shift_in(vec a, int v)
+    {   // [0, low half of a], so alignr carries across the 128-bit halves
+        const __m256i t = _mm256_permute2x128_si256(a, a, 0x08);
+        const __m256i s = _mm256_alignr_epi8(a, t, 16 - sizeof(T));
+        if constexpr (1 == sizeof(T))
+            return _mm256_insert_epi8(s, static_cast<char>(v), 0);
+        else
+            return _mm256_insert_epi16(s, static_cast<short>(v), 0);
+    }
+};
+
+template<typename T>
+struct avx512_ops
+{   using vec = __m512i;
+    using elem = T;
+    static constexpr std::size_t lanes = 64 / sizeof(T);
+
+    GYNX_TARGET_AVX512 static vec set1(int v)
+    {   if constexpr (1 == sizeof(T))
+            return _mm512_set1_epi8(static_cast<char>(v));
+        else
+            return _mm512_set1_epi16(static_cast<short>(v));
+    }
+    GYNX_TARGET_AVX512 static vec load(const T* p)
+    {   return _mm512_loadu_si512(p);
+    }
+    GYNX_TARGET_AVX512 static void store(T* p, vec v)
+    {   _mm512_storeu_si512(p, v);
+    }
+    GYNX_TARGET_AVX512 static vec adds(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm512_adds_epi8(a, b);
+        else
+            return _mm512_adds_epi16(a, b);
+    }
+    GYNX_TARGET_AVX512 static vec subs(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm512_subs_epi8(a, b);
+        else
+            return _mm512_subs_epi16(a, b);
+    }
+    GYNX_TARGET_AVX512 static vec max(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm512_max_epi8(a, b);
+        else
+            return _mm512_max_epi16(a, b);
+    }
+    GYNX_TARGET_AVX512 static vec min(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm512_min_epi8(a, b);
+        else
+            return _mm512_min_epi16(a, b);
+    }
+    GYNX_TARGET_AVX512 static bool any_gt(vec a, vec b)
+    {   if constexpr (1 == sizeof(T))
+            return _mm512_cmpgt_epi8_mask(a, b);
+        else
+            return _mm512_cmpgt_epi16_mask(a, b);
+    }
+    GYNX_TARGET_AVX512 static vec shift_in(vec a, int v)
+    {   // 128-bit lanes [0, a0, a1, a2]
+        const __m512i t = _mm512_maskz_shuffle_i32x4(0xfff0, a, a, 0x90);
+        const __m512i s = _mm512_alignr_epi8(a, t, 16 - sizeof(T));
+        if constexpr (1 == sizeof(T))
+            return _mm512_mask_set1_epi8(s, 1, static_cast<char>(v));
+        else
+            return _mm512_mask_set1_epi16(s, 1, static_cast<short>(v));
+    }
+};
+
+// The kernel is shared by all instruction sets and only compiled for one
+// inside the flattened, target-specific wrappers below; passing vectors
+// between it and the ops is never an actual call.
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+template<typename V>
+inline striped_result striped_score
+(   const typename V::elem* profile
+,   std::size_t seg
+,   std::size_t m
+,   const char* t
+,   std::size_t n
+,   const alignment_scoring& sc
+,   alignment_mode mode
+)
+{   using T = typename V::elem;
+    constexpr std::size_t L = V::lanes;
+    constexpr int lo = std::numeric_limits<T>::min();
+    constexpr int hi = std::numeric_limits<T>::max();
+    const auto clamp = [](long long v)
+    {   return static_cast<int>(std::clamp<long long>(v, lo, hi));
+    };
+    const bool local = alignment_mode::local == mode;
+    const bool global = alignment_mode::global == mode;
+    const long long open = sc.gap_open, extend = sc.gap_extend;
+    const int oe = clamp(open + extend);
+    const auto top = [&](std::ptrdiff_t j)  // H(-1, j)
+    {   return ! global || j < 0 ? 0ll : -(open + extend * (j + 1));
+    };
+    const std::uint8_t* index = sc.matrix.index_table();
+
+    std::vector<T> buf(3 * seg * L);
+    T* hload = buf.data();
+    T* hstore = hload + seg * L;
+    T* e = hstore + seg * L;
+    for (std::size_t s = 0; s < seg; ++s)
+        for (std::size_t l = 0; l < L; ++l)
+        {   const long long h = local ? 0 : -(open + extend * (l * seg + s + 1));
+            hload[s * L + l] = static_cast<T>(clamp(h));
+            e[s * L + l] = static_cast<T>(clamp(h - oe));
+        }
+
+    const auto vneg = V::set1(lo);
+    const auto vzero = V::set1(0);
+    const auto voe = V::set1(oe);
+    const auto vext = V::set1(clamp(extend));
+    auto vmax = V::set1(lo);
+    auto vmin = V::set1(hi);
+    const std::size_t last = ((m - 1) % seg) * L + (m - 1) / seg;
+    alignment_score r{ 0, 0, 0 };
+    if (alignment_mode::semi_global == mode)
+        r = { int(-(open + extend * std::ptrdiff_t(m))), m, 0 };
+
+    for (std::size_t j = 0; j < n; ++j)
+    {   const T* p = profile + index[static_cast<unsigned char>(t[j])] * seg * L;
+        auto vf = V::shift_in(vneg, clamp(top(j) - oe));
+        auto vh = V::shift_in
+            (V::load(hload + (seg - 1) * L), clamp(top(std::ptrdiff_t(j) - 1)));
+        auto vcol = vneg;
+        for (std::size_t s = 0; s < seg; ++s)
+        {   vh = V::adds(vh, V::load(p + s * L));
+            const auto ve = V::load(e + s * L);
+            vh = V::max(vh, ve);
+            vh = V::max(vh, vf);
+            if (local)
+                vh = V::max(vh, vzero);
+            else
+                vmin = V::min(vmin, vh);
+            vcol = V::max(vcol, vh);
+            V::store(hstore + s * L, vh);
+            vh = V::subs(vh, voe);
+            V::store(e + s * L, V::max(V::subs(ve, vext), vh));
+            vf = V::max(V::subs(vf, vext), vh);
+            vh = V::load(hload + s * L);
+        }
+        // lazy F: carry vertical gaps across lanes until they stop mattering
+        vf = V::shift_in(vf, lo);
+        for
+        (   std::size_t s = 0
+        ;   V::any_gt(vf, V::subs(V::load(hstore + s * L), voe))
+        ;
+        )
+        {   vh = V::max(V::load(hstore + s * L), vf);
+            V::store(hstore + s * L, vh);
+            if (! local)
+                vmin = V::min(vmin, vh);
+            vcol = V::max(vcol, vh);
+            V::store
+            (   e + s * L
+            ,   V::max(V::load(e + s * L), V::subs(vh, voe))
+            );
+            vf = V::subs(vf, vext);
+            if (++s == seg)
+            {   s = 0;
+                vf = V::shift_in(vf, lo);
+            }
+        }
+        vmax = V::max(vmax, vcol);
+        if (local && V::any_gt(vcol, V::set1(clamp(r.score))))
+        {   // leftmost column, then topmost row, holding the new maximum
+            alignas(64) T c[L];
+            V::store(c, vcol);
+            const int best = *std::max_element(c, c + L);
+            for (std::size_t i = 0; i < m; ++i)
+                if (best == hstore[(i % seg) * L + i / seg])
+                {   r = { best, i + 1, j + 1 };
+                    break;
+                }
+        }
+        else if (alignment_mode::semi_global == mode && hstore[last] > r.score)
+            r = { hstore[last], m, j + 1 };
+        std::swap(hload, hstore);
+    }
+    if (global)
+        r = { hload[last], m, n };
+
+    alignas(64) T c[L];
+    V::store(c, vmax);
+    bool overflow = *std::max_element(c, c + L) >= hi - std::max(0, sc.matrix.max());
+    if (! local)
+    {   V::store(c, vmin);
+        overflow |= *std::min_element(c, c + L)
+        <=  lo + oe + std::max(0, -sc.matrix.min());
+    }
+    return { r, overflow };
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+template<typename T>
+GYNX_TARGET_SSE42 __attribute__((flatten))
+inline striped_result striped_sse42
+(   const T* profile
+,   std::size_t seg
+,   std::size_t m
+,   const char* t
+,   std::size_t n
+,   const alignment_scoring& sc
+,   alignment_mode mode
+)
+{   return striped_score<sse42_ops<T>>(profile, seg, m, t, n, sc, mode);
+}
+
+template<typename T>
+GYNX_TARGET_AVX2 __attribute__((flatten))
+inline striped_result striped_avx2
+(   const T* profile
+,   std::size_t seg
+,   std::size_t m
+,   const char* t
+,   std::size_t n
+,   const alignment_scoring& sc
+,   alignment_mode mode
+)
+{   return striped_score<avx2_ops<T>>(profile, seg, m, t, n, sc, mode);
+}
+
+template<typename T>
+GYNX_TARGET_AVX512 __attribute__((flatten))
+inline striped_result striped_avx512
+(   const T* profile
+,   std::size_t seg
+,   std::size_t m
+,   const char* t
+,   std::size_t n
+,   const alignment_scoring& sc
+,   alignment_mode mode
+)
+{   return striped_score<avx512_ops<T>>(profile, seg, m, t, n, sc, mode);
+}
+
+#endif  // GYNX_SIMD_X86
+
+}   // end gynx::detail namespace
+
+// -- alignment_profile --------------------------------------------------------
+
+/// @brief A query prepared for repeated score-only alignment against many
+/// targets.
+/// @details Holds striped query profiles for the instruction set selected
+/// when it was built. Local alignments are tried on 8-bit lanes first;
+/// results that saturate are recomputed on 16-bit lanes and, if those
+/// saturate too, with the 32-bit scalar algorithm. A profile can be shared
+/// by many threads.
+class alignment_profile
+{   std::vector<std::uint8_t> _query;  // residue indices
+    alignment_scoring _scoring;
+    alignment_mode _mode;
+    simd::isa _isa;
+    std::size_t _seg8 = 0;
+    std::size_t _seg16 = 0;
+    std::vector<std::int8_t> _p8;
+    std::vector<std::int16_t> _p16;
+
+    template<typename T>
+    void _build(std::vector<T>& p, std::size_t& seg, std::size_t lanes)
+    {   const std::size_t m = _query.size();
+        const std::size_t a = _scoring.matrix.size();
+        seg = (m + lanes - 1) / lanes;
+        p.assign(a * seg * lanes, 0);
+        for (std::size_t c = 0; c < a; ++c)
+            for (std::size_t i = 0; i < m; ++i)
+                p[(c * seg + i % seg) * lanes + i / seg] = static_cast<T>
+                    (_scoring.matrix.score(_query[i], c));
+    }
+
+#if GYNX_SIMD_X86
+    template<typename T>
+    detail::striped_result _striped
+    (   const std::vector<T>& p
+    ,   std::size_t seg
+    ,   const char* t
+    ,   std::size_t n
+    )   const
+    {   const std::size_t m = _query.size();
+        switch (_isa)
+        {   case simd::isa::avx512:
+                return detail::striped_avx512(p.data(), seg, m, t, n, _scoring, _mode);
+            case simd::isa::avx2:
+                return detail::striped_avx2(p.data(), seg, m, t, n, _scoring, _mode);
+            default:
+                return detail::striped_sse42(p.data(), seg, m, t, n, _scoring, _mode);
+        }
+    }
+#endif
+
+public:
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    alignment_profile
+    (   sq_view_gen<Container> query
+    ,   alignment_mode mode
+    ,   alignment_scoring scoring = {}
+    )
+    :   _scoring(std::move(scoring))
+    ,   _mode(mode)
+    ,   _isa(simd::level())
+    {   if (_scoring.gap_open < 0 || _scoring.gap_extend < 0)
+            throw std::invalid_argument
+                ("gynx::alignment_profile: negative gap penalty");
+        _query.reserve(query.size());
+        for (char c : query)
+            _query.push_back(_scoring.matrix.index(c));
+        if (_query.empty() || simd::isa::scalar == _isa)
+            return;
+        const std::size_t bytes = simd::isa::avx512 == _isa ? 64
+        :   simd::isa::avx2 == _isa ? 32
+        :   16;
+        if (alignment_mode::local == _mode)
+            _build(_p8, _seg8, bytes);
+        _build(_p16, _seg16, bytes / 2);
+    }
+
+// -- observers ----------------------------------------------------------------
+    std::size_t size() const noexcept
+    {   return _query.size();
+    }
+    alignment_mode mode() const noexcept
+    {   return _mode;
+    }
+    const alignment_scoring& scoring() const noexcept
+    {   return _scoring;
+    }
+
+// -- alignment ----------------------------------------------------------------
+
+    /// @brief Returns the optimal score of the query against @a target and
+    /// where it ends.
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    alignment_score score(sq_view_gen<Container> target) const
+    {   const std::size_t n = target.size();
+#if GYNX_SIMD_X86
+        if (! _query.empty() && n && simd::isa::scalar != _isa)
+        {   if (! _p8.empty())
+                if (auto r = _striped(_p8, _seg8, target.data(), n); ! r.overflow)
+                    return r.r;
+            if (auto r = _striped(_p16, _seg16, target.data(), n); ! r.overflow)
+                return r.r;
+        }
+#endif
+        return detail::gotoh
+        (   _query.data()
+        ,   _query.size()
+        ,   target.data()
+        ,   n
+        ,   _scoring
+        ,   _mode
+        );
+    }
+
+    /// @brief Returns the score of every sequence in @a targets (sequences
+    /// or views), aligning them in parallel on @a pool.
+    template<std::ranges::random_access_range R>
+    std::vector<alignment_score> score_each
+    (   const R& targets
+    ,   thread_pool& pool = thread_pool::global()
+    )   const
+    {   std::vector<alignment_score> out(std::ranges::size(targets));
+        parallel_for
+        (   pool
+        ,   out.size()
+        ,   [&](std::size_t i)
+            {   const auto& t = targets[i];
+                out[i] = score
+                (   sq_view_gen<std::vector<char>>
+                    (std::ranges::data(t), std::ranges::size(t))
+                );
+            }
+        );
+        return out;
+    }
+};
+
+// -- pairwise alignment -------------------------------------------------------
+
+/// @brief Returns the optimal score of aligning @a query to @a target and
+/// the end of the alignment, using the striped SIMD kernels.
+template<typename Container1, typename Container2>
+requires std::is_same_v<typename Container1::value_type, char>
+&&  std::is_same_v<typename Container2::value_type, char>
+alignment_score align_score
+(   sq_view_gen<Container1> query
+,   sq_view_gen<Container2> target
+,   alignment_mode mode
+,   const alignment_scoring& scoring = {}
+)
+{   return alignment_profile(query, mode, scoring).score(target);
+}
+
+/// @brief Returns an optimal alignment of @a query to @a target with its
+/// CIGAR string.
+/// @details Traceback needs one byte per cell, so memory grows with
+/// <tt>query.size() * target.size()</tt>.
+template<typename Container1, typename Container2>
+requires std::is_same_v<typename Container1::value_type, char>
+&&  std::is_same_v<typename Container2::value_type, char>
+alignment align
+(   sq_view_gen<Container1> query
+,   sq_view_gen<Container2> target
+,   alignment_mode mode
+,   const alignment_scoring& scoring = {}
+)
+{   if (scoring.gap_open < 0 || scoring.gap_extend < 0)
+        throw std::invalid_argument("gynx::align: negative gap penalty");
+    std::vector<std::uint8_t> q;
+    q.reserve(query.size());
+    for (char c : query)
+        q.push_back(scoring.matrix.index(c));
+    std::vector<std::uint8_t> dir(query.size() * target.size());
+    const auto r = detail::gotoh
+    (   q.data()
+    ,   q.size()
+    ,   target.data()
+    ,   target.size()
+    ,   scoring
+    ,   mode
+    ,   dir.data()
+    );
+    return detail::traceback(dir.data(), q.size(), r, mode);
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_ALIGN_HPP_
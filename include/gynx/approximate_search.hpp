@@ -0,0 +1,464 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_APPROXIMATE_SEARCH_HPP_
+#define _GYNX_APPROXIMATE_SEARCH_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <gynx/simd.hpp>
+#include <gynx/sq_view.hpp>
+
+namespace gynx {
+
+/// @brief An approximate occurrence of a pattern ending just before @a end
+/// with an edit (Levenshtein) distance of @a distance.
+struct approximate_match
+{   std::size_t end;      ///< one past the last matched residue
+    std::size_t distance; ///< edit distance of the best alignment ending here
+
+    friend constexpr bool operator==
+    (   const approximate_match&
+    ,   const approximate_match&
+    ) = default;
+};
+
+namespace detail {
+
+// One column step of Myers' algorithm on a 64-row block, with horizontal
+// delta @a hin coming in from the block above (always 0 for the first block
+// when searching, as a match may start anywhere). Returns the horizontal
+// delta at row @a high.
+inline int myers_advance_block
+(   std::uint64_t& pv
+,   std::uint64_t& mv
+,   std::uint64_t eq
+,   int hin
+,   std::uint64_t high
+)   noexcept
+{   const std::uint64_t hin_neg = hin < 0;
+    const std::uint64_t xv = eq | mv;
+    eq |= hin_neg;
+    const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    std::uint64_t ph = mv | ~(xh | pv);
+    std::uint64_t mh = pv & xh;
+    const int hout = int(0 != (ph & high)) - int(0 != (mh & high));
+    ph = (ph << 1) | std::uint64_t(hin > 0);
+    mh = (mh << 1) | hin_neg;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+    return hout;
+}
+
+#if GYNX_SIMD_X86
+
+// The batch kernels run one read per 64-bit lane against a single-block
+// pattern; lanes past the end of their read see no matches and stop
+// updating their best score.
+
+GYNX_TARGET_AVX2
+inline void myers_best_lanes_avx2
+(   const std::uint64_t* peq
+,   const std::uint8_t* cls
+,   std::size_t m
+,   const char* const* reads
+,   const std::size_t* lens
+,   approximate_match* out
+)   noexcept
+{   const std::size_t n = *std::max_element(lens, lens + 4);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(m - 1));
+    const __m256i len = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lens));
+    __m256i pv = ones;
+    __m256i mv = _mm256_setzero_si256();
+    __m256i score = _mm256_set1_epi64x(static_cast<long long>(m));
+    __m256i best = score;
+    __m256i best_end = _mm256_setzero_si256();
+    for (std::size_t j = 0; j < n; ++j)
+    {   alignas(32) std::uint64_t e[4];
+        for (int l = 0; l < 4; ++l)
+            e[l] = j < lens[l]
+            ?   peq[cls[static_cast<unsigned char>(reads[l][j])]]
+            :   0;
+        const __m256i eq = _mm256_load_si256(reinterpret_cast<const __m256i*>(e));
+        const __m256i xv = _mm256_or_si256(eq, mv);
+        const __m256i xh = _mm256_or_si256
+        (   _mm256_xor_si256
+            (   _mm256_add_epi64(_mm256_and_si256(eq, pv), pv)
+            ,   pv
+            )
+        ,   eq
+        );
+        __m256i ph = _mm256_or_si256
+            (mv, _mm256_xor_si256(_mm256_or_si256(xh, pv), ones));
+        __m256i mh = _mm256_and_si256(pv, xh);
+        score = _mm256_add_epi64
+            (score, _mm256_and_si256(_mm256_srl_epi64(ph, shift), one));
+        score = _mm256_sub_epi64
+            (score, _mm256_and_si256(_mm256_srl_epi64(mh, shift), one));
+        ph = _mm256_slli_epi64(ph, 1);
+        mh = _mm256_slli_epi64(mh, 1);
+        pv = _mm256_or_si256
+            (mh, _mm256_xor_si256(_mm256_or_si256(xv, ph), ones));
+        mv = _mm256_and_si256(ph, xv);
+        const __m256i jv = _mm256_set1_epi64x(static_cast<long long>(j));
+        const __m256i better = _mm256_and_si256
+        (   _mm256_cmpgt_epi64(best, score)
+        ,   _mm256_cmpgt_epi64(len, jv)
+        );
+        best = _mm256_blendv_epi8(best, score, better);
+        best_end = _mm256_blendv_epi8
+            (best_end, _mm256_add_epi64(jv, one), better);
+    }
+    alignas(32) std::uint64_t b[4], e[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(b), best);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(e), best_end);
+    for (int l = 0; l < 4; ++l)
+        out[l] = { e[l], b[l] };
+}
+
+GYNX_TARGET_AVX512
+inline void myers_best_lanes_avx512
+(   const std::uint64_t* peq
+,   const std::uint8_t* cls
+,   std::size_t m
+,   const char* const* reads
+,   const std::size_t* lens
+,   approximate_match* out
+)   noexcept
+{   const std::size_t n = *std::max_element(lens, lens + 8);
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i len = _mm512_loadu_si512(lens);
+    const __m512i high
+    =   _mm512_set1_epi64(static_cast<long long>(std::uint64_t(1) << (m - 1)));
+    __m512i pv = _mm512_set1_epi64(-1);
+    __m512i mv = _mm512_setzero_si512();
+    __m512i score = _mm512_set1_epi64(static_cast<long long>(m));
+    __m512i best = score;
+    __m512i best_end = _mm512_setzero_si512();
+    for (std::size_t j = 0; j < n; ++j)
+    {   alignas(64) std::uint64_t e[8];
+        for (int l = 0; l < 8; ++l)
+            e[l] = j < lens[l]
+            ?   peq[cls[static_cast<unsigned char>(reads[l][j])]]
+            :   0;
+        const __m512i eq = _mm512_load_si512(e);
+        const __m512i xv = _mm512_or_si512(eq, mv);
+        const __m512i xh = _mm512_or_si512
+        (   _mm512_xor_si512
+            (   _mm512_add_epi64(_mm512_and_si512(eq, pv), pv)
+            ,   pv
+            )
+        ,   eq
+        );
+        // ph = mv | ~(xh | pv), mh = pv & xh
+        __m512i ph = _mm512_ternarylogic_epi64(mv, xh, pv, 0xf1);
+        __m512i mh = _mm512_and_si512(pv, xh);
+        score = _mm512_mask_add_epi64
+            (score, _mm512_test_epi64_mask(ph, high), score, one);
+        score = _mm512_mask_sub_epi64
+            (score, _mm512_test_epi64_mask(mh, high), score, one);
+        ph = _mm512_add_epi64(ph, ph);
+        mh = _mm512_add_epi64(mh, mh);
+        // pv = mh | ~(xv | ph)
+        pv = _mm512_ternarylogic_epi64(mh, xv, ph, 0xf1);
+        mv = _mm512_and_si512(ph, xv);
+        const __m512i jv = _mm512_set1_epi64(static_cast<long long>(j));
+        const __mmask8 better = _mm512_cmplt_epu64_mask(score, best)
+        &   _mm512_cmpgt_epu64_mask(len, jv);
+        best = _mm512_mask_mov_epi64(best, better, score);
+        best_end = _mm512_mask_add_epi64(best_end, better, jv, one);
+    }
+    alignas(64) std::uint64_t b[8], e[8];
+    _mm512_store_si512(b, best);
+    _mm512_store_si512(e, best_end);
+    for (int l = 0; l < 8; ++l)
+        out[l] = { e[l], b[l] };
+}
+
+#endif  // GYNX_SIMD_X86
+
+}   // end gynx::detail namespace
+
+// -- approximate_pattern ------------------------------------------------------
+
+/// @brief A pattern compiled for approximate (edit distance) search with
+/// Myers' bit-vector algorithm.
+/// @details The text is scanned in O(n * ceil(m / 64)) word operations.
+/// Matching is case-insensitive and otherwise exact on residues, so an N in
+/// the text mismatches every pattern base. Searching allocates nothing for
+/// patterns up to 64 * max_stack_blocks residues; an approximate_pattern
+/// can be shared by many threads.
+class approximate_pattern
+{   std::string _pattern;
+    std::array<std::uint8_t, 256> _class{};  // 0 = in no pattern residue
+    std::vector<std::uint64_t> _peq;         // class * _blocks + block
+    std::size_t _blocks;
+    std::uint64_t _high;                     // last pattern row, last block
+
+    // Calls f(end, distance) for every end position of the text in order
+    // while f returns true.
+    template<typename F>
+    void _scan(const char* s, std::size_t n, F&& f) const
+    {   const std::size_t m = _pattern.size();
+        if (! f(std::size_t(0), m))
+            return;
+        const std::uint8_t* cls = _class.data();
+        const std::uint64_t* peq = _peq.data();
+        const std::uint64_t high = _high;
+        if (1 == _blocks)
+        {   std::uint64_t pv = ~std::uint64_t(0), mv = 0;
+            std::size_t score = m;
+            for (std::size_t j = 0; j < n; ++j)
+            {   const std::uint64_t eq = peq[cls[static_cast<unsigned char>(s[j])]];
+                const std::uint64_t xv = eq | mv;
+                const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                std::uint64_t ph = mv | ~(xh | pv);
+                std::uint64_t mh = pv & xh;
+                score += std::size_t(0 != (ph & high));
+                score -= std::size_t(0 != (mh & high));
+                ph <<= 1;
+                mh <<= 1;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+                if (! f(j + 1, score))
+                    return;
+            }
+            return;
+        }
+        std::array<std::uint64_t, 2 * max_stack_blocks> stack;
+        std::vector<std::uint64_t> heap;
+        std::uint64_t* pv = stack.data();
+        if (_blocks > max_stack_blocks)
+        {   heap.resize(2 * _blocks);
+            pv = heap.data();
+        }
+        std::uint64_t* mv = pv + _blocks;
+        std::fill(pv, pv + _blocks, ~std::uint64_t(0));
+        std::fill(mv, mv + _blocks, std::uint64_t(0));
+        const std::size_t last = _blocks - 1;
+        const std::uint64_t top = std::uint64_t(1) << 63;
+        std::size_t score = m;
+        for (std::size_t j = 0; j < n; ++j)
+        {   const std::uint64_t* eq
+            =   peq + cls[static_cast<unsigned char>(s[j])] * _blocks;
+            int h = 0;
+            for (std::size_t b = 0; b < last; ++b)
+                h = detail::myers_advance_block(pv[b], mv[b], eq[b], h, top);
+            score += detail::myers_advance_block
+                (pv[last], mv[last], eq[last], h, high);
+            if (! f(j + 1, score))
+                return;
+        }
+    }
+
+public:
+    /// Patterns longer than 64 * max_stack_blocks need a heap buffer
+    /// per search.
+    static constexpr std::size_t max_stack_blocks = 8;
+
+// -- constructors -------------------------------------------------------------
+    explicit approximate_pattern(std::string_view pattern)
+    :   _pattern(pattern)
+    ,   _blocks((pattern.size() + 63) / 64)
+    ,   _high(std::uint64_t(1) << ((pattern.size() + 63) % 64))
+    {   if (pattern.empty())
+            throw std::invalid_argument
+                ("gynx::approximate_pattern: empty pattern");
+        const auto upper = [](unsigned char c)
+        {   return 'a' <= c && c <= 'z' ? c - 'a' + 'A' : c;
+        };
+        std::size_t classes = 1;
+        for (unsigned char c : pattern)
+            if (0 == _class[upper(c)])
+            {   _class[upper(c)] = static_cast<std::uint8_t>(classes++);
+                if ('A' <= upper(c) && upper(c) <= 'Z')
+                    _class[upper(c) - 'A' + 'a'] = _class[upper(c)];
+            }
+        _peq.assign(classes * _blocks, 0);
+        for (std::size_t i = 0; i < pattern.size(); ++i)
+            _peq[_class[static_cast<unsigned char>(pattern[i])] * _blocks + i / 64]
+                |= std::uint64_t(1) << (i % 64);
+        // rows past the pattern end match everything so they never
+        // carry a cost into the rows that count
+        if (const auto r = pattern.size() % 64)
+            for (std::size_t c = 0; c < classes; ++c)
+                _peq[c * _blocks + _blocks - 1] |= ~std::uint64_t(0) << r;
+    }
+
+// -- observers ----------------------------------------------------------------
+    const std::string& pattern() const noexcept
+    {   return _pattern;
+    }
+    std::size_t size() const noexcept
+    {   return _pattern.size();
+    }
+
+// -- search -------------------------------------------------------------------
+
+    /// @brief Calls @a f with an approximate_match for every end position in
+    /// @a s where the pattern matches with at most @a k edits.
+    template<typename Container, typename F>
+    requires std::is_same_v<typename Container::value_type, char>
+    &&  std::invocable<F&, approximate_match>
+    void for_each_match(sq_view_gen<Container> s, std::size_t k, F f) const
+    {   _scan
+        (   s.data()
+        ,   s.size()
+        ,   [&](std::size_t end, std::size_t d)
+            {   if (d <= k)
+                    f(approximate_match{ end, d });
+                return true;
+            }
+        );
+    }
+
+    /// @brief Returns every end position in @a s where the pattern matches
+    /// with at most @a k edits.
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    std::vector<approximate_match> find_all
+    (   sq_view_gen<Container> s
+    ,   std::size_t k
+    )   const
+    {   std::vector<approximate_match> hits;
+        for_each_match(s, k, [&](approximate_match h) { hits.push_back(h); });
+        return hits;
+    }
+
+    /// @brief Returns the leftmost end position in @a s where the pattern
+    /// matches with at most @a k edits, stopping the scan there.
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    std::optional<approximate_match> first
+    (   sq_view_gen<Container> s
+    ,   std::size_t k
+    )   const
+    {   std::optional<approximate_match> hit;
+        _scan
+        (   s.data()
+        ,   s.size()
+        ,   [&](std::size_t end, std::size_t d)
+            {   if (d > k)
+                    return true;
+                hit = approximate_match{ end, d };
+                return false;
+            }
+        );
+        return hit;
+    }
+
+    /// @brief Returns the leftmost end position in @a s with the smallest
+    /// edit distance to the pattern.
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    approximate_match best(sq_view_gen<Container> s) const
+    {   approximate_match b{ 0, _pattern.size() };
+        _scan
+        (   s.data()
+        ,   s.size()
+        ,   [&](std::size_t end, std::size_t d)
+            {   if (d < b.distance)
+                    b = { end, d };
+                return b.distance > 0;
+            }
+        );
+        return b;
+    }
+
+// -- batch --------------------------------------------------------------------
+
+    /// @brief Writes best() of every sequence in @a reads (sequences or views)
+    /// to @a out.
+    /// @details For patterns up to 64 residues several reads are processed
+    /// at once, one per SIMD lane (4 with AVX2, 8 with AVX-512).
+    template<std::ranges::random_access_range R>
+    void best_each(const R& reads, std::span<approximate_match> out) const
+    {   const std::size_t count = std::ranges::size(reads);
+        if (out.size() < count)
+            throw std::invalid_argument
+                ("gynx::approximate_pattern::best_each: output too small");
+        std::size_t i = 0;
+#if GYNX_SIMD_X86
+        const auto lanes = [&]<std::size_t W>(auto kernel)
+        {   const char* ptr[W];
+            std::size_t len[W];
+            for (; i + W <= count; i += W)
+            {   for (std::size_t l = 0; l < W; ++l)
+                {   ptr[l] = std::ranges::data(reads[i + l]);
+                    len[l] = std::ranges::size(reads[i + l]);
+                }
+                kernel
+                (   _peq.data()
+                ,   _class.data()
+                ,   _pattern.size()
+                ,   ptr
+                ,   len
+                ,   out.data() + i
+                );
+            }
+        };
+        if (1 == _blocks)
+            switch (simd::level())
+            {   case simd::isa::avx512:
+                    lanes.template operator()<8>(detail::myers_best_lanes_avx512);
+                    break;
+                case simd::isa::avx2:
+                    lanes.template operator()<4>(detail::myers_best_lanes_avx2);
+                    break;
+                default:
+                    break;
+            }
+#endif
+        for (; i < count; ++i)
+        {   const auto& r = reads[i];
+            out[i] = best
+            (   sq_view_gen<std::vector<char>>
+                (std::ranges::data(r), std::ranges::size(r))
+            );
+        }
+    }
+
+    /// @brief Returns best() of every sequence in @a reads.
+    template<std::ranges::random_access_range R>
+    std::vector<approximate_match> best_each(const R& reads) const
+    {   std::vector<approximate_match> out(std::ranges::size(reads));
+        best_each(reads, out);
+        return out;
+    }
+};
+
+}   // end gynx namespace
+
+#endif  // _GYNX_APPROXIMATE_SEARCH_HPP_
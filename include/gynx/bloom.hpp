@@ -0,0 +1,428 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_BLOOM_HPP_
+#define _GYNX_BLOOM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/hash.hpp>
+#include <gynx/kmers.hpp>
+#include <gynx/minimizers.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/io/fastaqz.hpp>
+
+#if __has_include(<sys/mman.h>)
+#   include <gynx/mmap_vector.hpp>
+#endif
+
+namespace gynx {
+
+// -- bloom_filter -------------------------------------------------------------
+
+/// @brief A cache-line-blocked Bloom filter of k-mers (k <= 32), keyed on
+/// their 2-bit encodings (see gynx::kmer).
+/// @details Each key is hashed with gynx::invertible_hash; the high bits
+/// pick one 512-bit block and the low 32 bits, multiplied by eight odd
+/// salts, set one bit in each of its eight 64-bit words (a split block
+/// Bloom filter). Every insert or query therefore touches a single cache
+/// line. insert() sets bits with atomic fetch-or, so any number of threads
+/// may insert concurrently without locks; queries should not overlap
+/// inserts. Sequence queries hash k-mers in vectorized blocks and prefetch
+/// the cache lines of upcoming k-mers. The filter is one array of cache
+/// lines, written as is (in host byte order) by save() and memory-mapped by
+/// the path constructor, so a saved filter loads instantly.
+class bloom_filter
+{   struct alignas(64) line
+    {   std::uint64_t w[8];
+    };
+    // header layout, in words of the first line
+    enum : std::size_t { h_magic, h_lines, h_k, h_canonical };
+    static constexpr std::uint64_t magic = 0x314d4c42584e5947ull;  // GYNXBLM1
+    static constexpr std::size_t group = 256;   // k-mers hashed per batch
+    static constexpr std::size_t distance = 16; // prefetch distance, in keys
+
+    static constexpr std::array<std::uint32_t, 8> _salt
+    {   0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du
+    ,   0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+    };
+
+    std::vector<line> _own;
+#if __has_include(<sys/mman.h>)
+    mmap_vector<line> _mapped;
+#endif
+    line*             _lines = nullptr;
+    std::size_t       _blocks = 0;
+
+    void _attach(line* p, std::size_t n) noexcept
+    {   _lines = p;
+        _blocks = n ? n - 1 : 0;
+    }
+    static void _check
+    (   const line* p
+    ,   std::size_t n
+    ,   const std::filesystem::path& path
+    )
+    {   if (n < 2 || p[0].w[h_magic] != magic || p[0].w[h_lines] != n)
+            throw std::runtime_error
+            (   "gynx::bloom_filter: not a filter file -> "
+            +   path.string()
+            );
+    }
+    const std::uint64_t* _header() const noexcept
+    {   return _lines->w;
+    }
+    const line& _block(std::uint64_t h) const noexcept
+    {   std::uint64_t hi;
+        detail::mul128(h, _blocks, hi);
+        return _lines[1 + static_cast<std::size_t>(hi)];
+    }
+    line& _block(std::uint64_t h) noexcept
+    {   return const_cast<line&>(std::as_const(*this)._block(h));
+    }
+    static std::uint64_t _bit(std::uint64_t h, std::size_t i) noexcept
+    {   return std::uint64_t(1)
+            << ((static_cast<std::uint32_t>(h) * _salt[i]) >> 26);
+    }
+    static bool _test(const line& b, std::uint64_t h) noexcept
+    {   bool r = true;
+        for (std::size_t i = 0; i < 8; ++i)
+            r &= (b.w[i] & _bit(h, i)) != 0;
+        return r;
+    }
+    void _set(line& b, std::uint64_t h) noexcept
+    {   for (std::size_t i = 0; i < 8; ++i)
+        {   const std::uint64_t bit = _bit(h, i);
+            std::atomic_ref<std::uint64_t> w(b.w[i]);
+            if (! (w.load(std::memory_order_relaxed) & bit))
+                w.fetch_or(bit, std::memory_order_relaxed);
+        }
+    }
+    // gathers the (canonical) k-mer encodings of s in groups, hashes them and
+    // calls f(hashes, n) per group
+    template<typename Container, typename F>
+    void _hashes(sq_view_gen<Container> s, F f) const
+    {   thread_local std::vector<std::uint64_t> buffer(group);
+        std::uint64_t* h = buffer.data();
+        const bool both = canonical();
+        std::size_t n = 0;
+        for (auto km : kmer_view<sq_view_gen<Container>>(s, k()))
+        {   h[n] = both ? km.canonical() : km.fwd;
+            if (++n == group)
+            {   detail::invertible_hash_block(h, h + n, invertible_hash{}.mask);
+                f(h, n);
+                n = 0;
+            }
+        }
+        if (n)
+        {   detail::invertible_hash_block(h, h + n, invertible_hash{}.mask);
+            f(h, n);
+        }
+    }
+
+    // tests n hashed keys, prefetching the blocks of upcoming keys
+    std::size_t _query
+    (   const std::uint64_t* h
+    ,   std::size_t n
+    ,   std::uint8_t* out
+    )   const noexcept
+    {   std::size_t hits = 0;
+        if (0 == _blocks)
+        {   if (out)
+                std::fill_n(out, n, std::uint8_t(0));
+            return 0;
+        }
+        for (std::size_t i = 0; i < std::min(distance, n); ++i)
+            GYNX_PREFETCH(&_block(h[i]), 0);
+        for (std::size_t i = 0; i < n; ++i)
+        {   if (i + distance < n)
+                GYNX_PREFETCH(&_block(h[i + distance]), 0);
+            const bool hit = _test(_block(h[i]), h[i]);
+            hits += hit;
+            if (out)
+                out[i] = hit;
+        }
+        return hits;
+    }
+
+public:
+// -- constructors -------------------------------------------------------------
+    bloom_filter() = default;
+    ///
+    /// @brief Constructs an empty filter of @a k-mers sized for @a expected
+    /// distinct k-mers at @a bits_per_kmer bits each (about 0.4% false
+    /// positives at the default of 16, 2% at 10).
+    /// @param canonical Whether a k-mer and its reverse complement are the
+    /// same key for the sequence overloads.
+    bloom_filter
+    (   std::size_t k
+    ,   std::size_t expected
+    ,   double bits_per_kmer = 16.0
+    ,   bool canonical = true
+    )
+    {   if (k < 1 || k > 32)
+            throw std::invalid_argument("gynx::bloom_filter: k out of range");
+        if (! (bits_per_kmer > 0.0))
+            throw std::invalid_argument("gynx::bloom_filter: bits_per_kmer <= 0");
+        const auto blocks = std::max<std::size_t>
+            (1, std::size_t(std::ceil(double(expected) * bits_per_kmer / 512.0)));
+        _own.resize(blocks + 1, line{});
+        _own[0].w[h_magic] = magic;
+        _own[0].w[h_lines] = blocks + 1;
+        _own[0].w[h_k] = k;
+        _own[0].w[h_canonical] = canonical;
+        _attach(_own.data(), _own.size());
+    }
+    ///
+    /// @brief Maps a filter written by save(); pages are read as they are
+    /// queried. Inserts into a mapped filter are private to the process.
+    /// @details Where memory mapping is not available (no <sys/mman.h>), the
+    /// file is read into memory instead.
+    explicit bloom_filter(const std::filesystem::path& path)
+#if __has_include(<sys/mman.h>)
+    :   _mapped(path)
+    {   _check(_mapped.data(), _mapped.size(), path);
+        _mapped.advise(mmap_vector<line>::advice::random);
+        _attach(_mapped.data(), _mapped.size());
+    }
+#else
+    {   std::ifstream is(path, std::ios::binary | std::ios::ate);
+        const auto size = static_cast<std::size_t>(is ? std::streamoff(is.tellg()) : 0);
+        if (is && 0 == size % sizeof(line))
+        {   _own.resize(size / sizeof(line));
+            is.seekg(0);
+            is.read(reinterpret_cast<char*>(_own.data()), std::streamsize(size));
+            if (! is)
+                _own.clear();
+        }
+        _check(_own.data(), _own.size(), path);
+        _attach(_own.data(), _own.size());
+    }
+#endif
+    bloom_filter(const bloom_filter& other)
+    :   _own(other._lines, other._lines + (other._lines ? other._blocks + 1 : 0))
+    {   _attach(_own.data(), _own.size());
+    }
+    bloom_filter(bloom_filter&& other) noexcept
+    :   _own(std::move(other._own))
+#if __has_include(<sys/mman.h>)
+    ,   _mapped(std::move(other._mapped))
+#endif
+    ,   _lines(std::exchange(other._lines, nullptr))
+    ,   _blocks(std::exchange(other._blocks, 0))
+    {}
+    bloom_filter& operator= (bloom_filter other) noexcept
+    {   std::swap(_own, other._own);
+#if __has_include(<sys/mman.h>)
+        std::swap(_mapped, other._mapped);
+#endif
+        std::swap(_lines, other._lines);
+        std::swap(_blocks, other._blocks);
+        return *this;
+    }
+
+// -- persistence --------------------------------------------------------------
+    ///
+    /// Writes the filter to @a path.
+    void save(const std::filesystem::path& path) const
+    {   std::ofstream os(path, std::ios::binary);
+        if (_lines)
+            os.write
+            (   reinterpret_cast<const char*>(_lines)
+            ,   std::streamsize((_blocks + 1) * sizeof(line))
+            );
+        if (! os)
+            throw std::runtime_error
+            (   "gynx::bloom_filter: could not write filter file -> "
+            +   path.string()
+            );
+    }
+
+// -- observers ----------------------------------------------------------------
+    [[nodiscard]] bool empty() const noexcept
+    {   return 0 == _blocks;
+    }
+    ///
+    /// Returns the k-mer length.
+    std::size_t k() const noexcept
+    {   return _lines ? _header()[h_k] : 0;
+    }
+    ///
+    /// Returns true if k-mers are inserted and queried on both strands.
+    bool canonical() const noexcept
+    {   return _lines && _header()[h_canonical];
+    }
+    ///
+    /// Returns the number of 512-bit blocks.
+    std::size_t blocks() const noexcept
+    {   return _blocks;
+    }
+    ///
+    /// Returns the size of the filter in bytes, header included.
+    std::size_t bytes() const noexcept
+    {   return _lines ? (_blocks + 1) * sizeof(line) : 0;
+    }
+
+// -- keys ---------------------------------------------------------------------
+    ///
+    /// Inserts the 2-bit encoded k-mer @a code into a non-empty filter.
+    /// Thread-safe and lock-free.
+    void insert(std::uint64_t code) noexcept
+    {   const std::uint64_t h = invertible_hash{}(code);
+        _set(_block(h), h);
+    }
+    ///
+    /// Returns true if @a code may have been inserted, false if it was not.
+    bool contains(std::uint64_t code) const noexcept
+    {   const std::uint64_t h = invertible_hash{}(code);
+        return _blocks && _test(_block(h), h);
+    }
+    ///
+    /// @brief Queries the codes in [@a first, @a last), writing 1 to @a out
+    /// for every possibly inserted code and 0 otherwise. Returns the number
+    /// of hits.
+    std::size_t contains
+    (   const std::uint64_t* first
+    ,   const std::uint64_t* last
+    ,   std::uint8_t* out
+    )   const
+    {   thread_local std::vector<std::uint64_t> buffer(group);
+        std::uint64_t* h = buffer.data();
+        std::size_t hits = 0;
+        while (first != last)
+        {   const std::size_t n = std::min<std::size_t>(group, last - first);
+            std::copy_n(first, n, h);
+            detail::invertible_hash_block(h, h + n, invertible_hash{}.mask);
+            hits += _query(h, n, out);
+            first += n;
+            out += n;
+        }
+        return hits;
+    }
+
+// -- sequences ----------------------------------------------------------------
+    ///
+    /// @brief Inserts the k-mers of @a s (skipping those overlapping
+    /// non-ACGT residues) and returns their number. Thread-safe and
+    /// lock-free.
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    std::size_t insert(sq_view_gen<Container> s)
+    {   std::size_t count = 0;
+        _hashes
+        (   s
+        ,   [&](const std::uint64_t* h, std::size_t n)
+            {   for (std::size_t i = 0; i < n; ++i)
+                {   if (i + distance < n)
+                        GYNX_PREFETCH(&_block(h[i + distance]), 1);
+                    _set(_block(h[i]), h[i]);
+                }
+                count += n;
+            }
+        );
+        return count;
+    }
+    ///
+    /// Inserts the k-mers of sequence @a s and returns their number.
+    template<typename Container, typename Map>
+    std::size_t insert(const sq_gen<Container, Map>& s)
+    {   return insert(s(0));
+    }
+    ///
+    /// @brief Returns the number of k-mers of @a s found in the filter,
+    /// i.e. the shared k-mers plus false positives.
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    std::size_t count(sq_view_gen<Container> s) const
+    {   std::size_t hits = 0;
+        if (empty())
+            return 0;
+        _hashes
+        (   s
+        ,   [&](const std::uint64_t* h, std::size_t n)
+            {   hits += _query(h, n, nullptr);
+            }
+        );
+        return hits;
+    }
+    ///
+    /// Returns the number of k-mers of sequence @a s found in the filter.
+    template<typename Container, typename Map>
+    std::size_t count(const sq_gen<Container, Map>& s) const
+    {   return count(s(0));
+    }
+    ///
+    /// @brief Inserts the k-mers of every record of @a filename, read with
+    /// gynx::in::fast_aqz and inserted in batches concurrently on @a pool
+    /// with gynx::parallel_pipeline(). Returns the number of records.
+    template<typename Sequence = sq>
+    std::size_t insert_file
+    (   std::string_view filename
+    ,   thread_pool& pool = thread_pool::global()
+    ,   in::fast_aqz<Sequence> reader = {}
+    ,   std::size_t batch_size = 64
+    )
+    {   typedef std::vector<Sequence> batch_type;
+        std::size_t n{};
+        parallel_pipeline<batch_type>
+        (   pool
+        ,   [&](auto& submit)
+            {   auto batch = std::make_shared<batch_type>();
+                n = reader
+                (   filename
+                ,   [&](Sequence&& s)
+                    {   batch->push_back(std::move(s));
+                        if (batch->size() >= batch_size)
+                            submit(std::exchange(batch, std::make_shared<batch_type>()));
+                    }
+                );
+                if (! batch->empty())
+                    submit(std::move(batch));
+            }
+        ,   [this](const batch_type& b)
+            {   for (const auto& r : b)
+                    insert(r);
+            }
+        );
+        return n;
+    }
+};
+
+}   // end gynx namespace
+
+#endif  // _GYNX_BLOOM_HPP_
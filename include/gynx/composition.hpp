@@ -0,0 +1,415 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_COMPOSITION_HPP_
+#define _GYNX_COMPOSITION_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gynx/sq_view.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/lut/nucleotide.hpp>
+
+namespace gynx {
+
+/// @brief Case-insensitive residue counts of a nucleotide sequence.
+struct composition_counts
+{   std::uint64_t a = 0;
+    std::uint64_t c = 0;
+    std::uint64_t g = 0;
+    std::uint64_t t = 0;
+    std::uint64_t n = 0;
+    std::uint64_t other = 0;
+
+    ///
+    /// Returns the total number of residues counted.
+    std::uint64_t total() const noexcept
+    {   return a + c + g + t + n + other;
+    }
+    ///
+    /// Returns the number of unambiguous (A, C, G or T) residues.
+    std::uint64_t acgt() const noexcept
+    {   return a + c + g + t;
+    }
+    ///
+    /// Returns the GC fraction of the unambiguous residues (0 if there are
+    /// none).
+    double gc_content() const noexcept
+    {   return acgt() ? double(g + c) / double(acgt()) : 0.0;
+    }
+    ///
+    /// Returns the GC skew (G - C) / (G + C) (0 if there is no G or C).
+    double gc_skew() const noexcept
+    {   return (g + c) ? (double(g) - double(c)) / double(g + c) : 0.0;
+    }
+    composition_counts& operator+= (const composition_counts& rhs) noexcept
+    {   a += rhs.a; c += rhs.c; g += rhs.g; t += rhs.t;
+        n += rhs.n; other += rhs.other;
+        return *this;
+    }
+    friend bool operator==
+    (   const composition_counts&
+    ,   const composition_counts&
+    )   = default;
+};
+
+/// @brief GC content and GC skew of one window of a profile.
+struct gc_window
+{   std::size_t pos;  ///< start of the window
+    double gc;        ///< GC fraction of the unambiguous residues
+    double skew;      ///< (G - C) / (G + C)
+};
+
+namespace detail {
+
+// counts of A, C, G, T and N in [first, last), as an array in class order;
+// 'other' is derived from the length by the caller
+using acgtn_counts = std::array<std::uint64_t, 5>;
+
+inline void count_acgtn_scalar
+(   const char* first
+,   const char* last
+,   acgtn_counts& cnt
+)   noexcept
+{   std::array<std::uint64_t, 6> k{};
+    for (; first != last; ++first)
+        ++k[lut::nt_class[static_cast<std::uint8_t>(*first)]];
+    for (int i = 0; i < 5; ++i)
+        cnt[i] += k[i];
+}
+
+#if GYNX_SIMD_X86
+
+// The SSE4.2/AVX2 kernels lowercase each byte (x | 0x20), accumulate compare
+// results in byte counters (subtracting the all-ones mask) and flush them to
+// 64-bit sums with psadbw every 255 blocks. AVX-512 popcounts compare masks.
+
+GYNX_TARGET_SSE42
+inline const char* count_acgtn_sse42
+(   const char* first
+,   const char* last
+,   acgtn_counts& cnt
+)   noexcept
+{   const __m128i lower = _mm_set1_epi8(0x20);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i base[5]
+    {   _mm_set1_epi8('a'), _mm_set1_epi8('c'), _mm_set1_epi8('g')
+    ,   _mm_set1_epi8('t'), _mm_set1_epi8('n')
+    };
+    __m128i sum[5] { zero, zero, zero, zero, zero };
+    while (last - first >= 16)
+    {   __m128i acc[5] { zero, zero, zero, zero, zero };
+        for (int k = 0; k < 255 && last - first >= 16; ++k, first += 16)
+        {   const __m128i x = _mm_or_si128
+                (_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)), lower);
+            for (int b = 0; b < 5; ++b)
+                acc[b] = _mm_sub_epi8(acc[b], _mm_cmpeq_epi8(x, base[b]));
+        }
+        for (int b = 0; b < 5; ++b)
+            sum[b] = _mm_add_epi64(sum[b], _mm_sad_epu8(acc[b], zero));
+    }
+    for (int b = 0; b < 5; ++b)
+        cnt[b] += std::uint64_t(_mm_cvtsi128_si64(sum[b]))
+               +  std::uint64_t(_mm_extract_epi64(sum[b], 1));
+    return first;
+}
+
+GYNX_TARGET_AVX2
+inline const char* count_acgtn_avx2
+(   const char* first
+,   const char* last
+,   acgtn_counts& cnt
+)   noexcept
+{   const __m256i lower = _mm256_set1_epi8(0x20);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i base[5]
+    {   _mm256_set1_epi8('a'), _mm256_set1_epi8('c'), _mm256_set1_epi8('g')
+    ,   _mm256_set1_epi8('t'), _mm256_set1_epi8('n')
+    };
+    __m256i sum[5] { zero, zero, zero, zero, zero };
+    while (last - first >= 32)
+    {   __m256i acc[5] { zero, zero, zero, zero, zero };
+        for (int k = 0; k < 255 && last - first >= 32; ++k, first += 32)
+        {   const __m256i x = _mm256_or_si256
+                (_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)), lower);
+            for (int b = 0; b < 5; ++b)
+                acc[b] = _mm256_sub_epi8(acc[b], _mm256_cmpeq_epi8(x, base[b]));
+        }
+        for (int b = 0; b < 5; ++b)
+            sum[b] = _mm256_add_epi64(sum[b], _mm256_sad_epu8(acc[b], zero));
+    }
+    for (int b = 0; b < 5; ++b)
+    {   const __m128i s = _mm_add_epi64
+        (   _mm256_castsi256_si128(sum[b])
+        ,   _mm256_extracti128_si256(sum[b], 1)
+        );
+        cnt[b] += std::uint64_t(_mm_cvtsi128_si64(s))
+               +  std::uint64_t(_mm_extract_epi64(s, 1));
+    }
+    return first;
+}
+
+GYNX_TARGET_AVX512
+inline const char* count_acgtn_avx512
+(   const char* first
+,   const char* last
+,   acgtn_counts& cnt
+)   noexcept
+{   const __m512i lower = _mm512_set1_epi8(0x20);
+    const __m512i base[5]
+    {   _mm512_set1_epi8('a'), _mm512_set1_epi8('c'), _mm512_set1_epi8('g')
+    ,   _mm512_set1_epi8('t'), _mm512_set1_epi8('n')
+    };
+    std::uint64_t k[5] {};
+    for (; last - first >= 64; first += 64)
+    {   const __m512i x = _mm512_or_si512(_mm512_loadu_si512(first), lower);
+        for (int b = 0; b < 5; ++b)
+            k[b] += std::uint64_t
+                (_mm_popcnt_u64(_mm512_cmpeq_epi8_mask(x, base[b])));
+    }
+    for (int b = 0; b < 5; ++b)
+        cnt[b] += k[b];
+    return first;
+}
+
+#endif  // GYNX_SIMD_X86
+
+inline acgtn_counts count_acgtn(const char* first, const char* last) noexcept
+{   acgtn_counts cnt{};
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            first = count_acgtn_avx512(first, last, cnt);
+            [[fallthrough]];
+        case simd::isa::avx2:
+            first = count_acgtn_avx2(first, last, cnt);
+            [[fallthrough]];
+        case simd::isa::sse42:
+            first = count_acgtn_sse42(first, last, cnt);
+            [[fallthrough]];
+#endif
+        default:
+            count_acgtn_scalar(first, last, cnt);
+    }
+    return cnt;
+}
+
+inline composition_counts make_composition
+(   const acgtn_counts& cnt
+,   std::uint64_t length
+)   noexcept
+{   composition_counts r{cnt[0], cnt[1], cnt[2], cnt[3], cnt[4], 0};
+    r.other = length - (cnt[0] + cnt[1] + cnt[2] + cnt[3] + cnt[4]);
+    return r;
+}
+
+// adds (d = +1) or removes (d = -1) the residues in [first, last) to/from
+// window counts; long blocks go through the SIMD kernels
+inline void slide_count
+(   std::array<std::int64_t, 6>& k
+,   const char* first
+,   const char* last
+,   int d
+)   noexcept
+{   if (last - first < 32)
+    {   for (; first != last; ++first)
+            k[lut::nt_class[static_cast<std::uint8_t>(*first)]] += d;
+        return;
+    }
+    const auto cnt = count_acgtn(first, last);
+    std::int64_t sum = 0;
+    for (int i = 0; i < 5; ++i)
+    {   k[i] += d * std::int64_t(cnt[i]);
+        sum += std::int64_t(cnt[i]);
+    }
+    k[5] += d * (std::int64_t(last - first) - sum);
+}
+
+inline gc_window make_gc_window
+(   std::size_t pos
+,   const std::array<std::int64_t, 6>& k
+)   noexcept
+{   const auto acgt = k[0] + k[1] + k[2] + k[3];
+    const auto gc = k[1] + k[2];
+    return
+    {   pos
+    ,   acgt ? double(gc) / double(acgt) : 0.0
+    ,   gc ? (double(k[2]) - double(k[1])) / double(gc) : 0.0
+    };
+}
+
+// fills out[first_window, last_window) of a profile; the counts of the first
+// window are computed from scratch, every later one is updated incrementally
+template<typename Container>
+void gc_profile_range
+(   sq_view_gen<Container> v
+,   std::size_t window
+,   std::size_t step
+,   std::size_t first_window
+,   std::size_t last_window
+,   gc_window* out
+)
+{   if (first_window >= last_window)
+        return;
+    const char* p = v.data();
+    std::array<std::int64_t, 6> k{};
+    std::size_t pos = first_window * step;
+    slide_count(k, p + pos, p + pos + window, +1);
+    out[first_window] = make_gc_window(pos, k);
+    for (std::size_t w = first_window + 1; w < last_window; ++w)
+    {   const std::size_t next = pos + step;
+        if (step < window)
+        {   slide_count(k, p + pos, p + next, -1);
+            slide_count(k, p + pos + window, p + next + window, +1);
+        }
+        else
+        {   k.fill(0);
+            slide_count(k, p + next, p + next + window, +1);
+        }
+        pos = next;
+        out[w] = make_gc_window(pos, k);
+    }
+}
+
+}   // end gynx::detail namespace
+
+// -- composition --------------------------------------------------------------
+///
+/// @brief Counts A, C, G, T, N and other residues of @a v, ignoring case.
+/// @details Uses SIMD compare-and-count kernels (AVX-512/AVX2/SSE4.2,
+/// selected at runtime) with a lookup-table fallback.
+template<typename Container>
+composition_counts composition(sq_view_gen<Container> v) noexcept
+{   const char* first = v.data();
+    return detail::make_composition
+    (   detail::count_acgtn(first, first + v.size())
+    ,   v.size()
+    );
+}
+///
+/// @brief Counts the residues of @a v in parallel blocks on @a pool.
+template<typename Container>
+composition_counts composition(sq_view_gen<Container> v, thread_pool& pool)
+{   const std::size_t blocks
+        = (v.size() + detail::parallel_block - 1) / detail::parallel_block;
+    std::vector<detail::acgtn_counts> partial(blocks);
+    parallel_for
+    (   pool
+    ,   blocks
+    ,   [&](std::size_t b)
+        {   const char* first = v.data() + b * detail::parallel_block;
+            const char* last = v.data()
+            +   std::min(v.size(), (b + 1) * detail::parallel_block);
+            partial[b] = detail::count_acgtn(first, last);
+        }
+    );
+    detail::acgtn_counts cnt{};
+    for (const auto& p : partial)
+        for (int i = 0; i < 5; ++i)
+            cnt[i] += p[i];
+    return detail::make_composition(cnt, v.size());
+}
+
+// -- gc content ---------------------------------------------------------------
+///
+/// @brief Returns the GC fraction of the unambiguous residues of @a v.
+template<typename Container>
+double gc_content(sq_view_gen<Container> v) noexcept
+{   return composition(v).gc_content();
+}
+///
+/// @brief Returns the GC fraction of @a v, counted in parallel on @a pool.
+template<typename Container>
+double gc_content(sq_view_gen<Container> v, thread_pool& pool)
+{   return composition(v, pool).gc_content();
+}
+
+// -- gc profile ---------------------------------------------------------------
+///
+/// @brief Computes GC content and GC skew of windows of @a window residues
+/// starting every @a step residues (default is non-overlapping windows).
+/// @details Overlapping windows are updated incrementally, so the cost is
+/// O(1) per residue regardless of the window size. A trailing partial window
+/// is not reported.
+template<typename Container>
+std::vector<gc_window> gc_profile
+(   sq_view_gen<Container> v
+,   std::size_t window
+,   std::size_t step = 0
+)
+{   if (0 == window)
+        throw std::invalid_argument("gynx::gc_profile: window must be > 0");
+    if (0 == step)
+        step = window;
+    if (v.size() < window)
+        return {};
+    const std::size_t count = (v.size() - window) / step + 1;
+    std::vector<gc_window> out(count);
+    detail::gc_profile_range(v, window, step, 0, count, out.data());
+    return out;
+}
+///
+/// @brief Computes the GC profile of @a v with windows split into blocks
+/// processed in parallel on @a pool.
+template<typename Container>
+std::vector<gc_window> gc_profile
+(   sq_view_gen<Container> v
+,   std::size_t window
+,   std::size_t step
+,   thread_pool& pool
+)
+{   if (0 == window)
+        throw std::invalid_argument("gynx::gc_profile: window must be > 0");
+    if (0 == step)
+        step = window;
+    if (v.size() < window)
+        return {};
+    const std::size_t count = (v.size() - window) / step + 1;
+    std::vector<gc_window> out(count);
+    const std::size_t per_block
+        = std::max<std::size_t>(1, detail::parallel_block / step);
+    parallel_for
+    (   pool
+    ,   (count + per_block - 1) / per_block
+    ,   [&](std::size_t b)
+        {   detail::gc_profile_range
+            (   v
+            ,   window
+            ,   step
+            ,   b * per_block
+            ,   std::min(count, (b + 1) * per_block)
+            ,   out.data()
+            );
+        }
+    );
+    return out;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_COMPOSITION_HPP_
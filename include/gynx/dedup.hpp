@@ -0,0 +1,430 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_DEDUP_HPP_
+#define _GYNX_DEDUP_HPP_
+
+#include <algorithm>
+#include <any>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/hash.hpp>
+#include <gynx/io/fastaqz.hpp>
+#include <gynx/thread_pool.hpp>
+
+namespace gynx {
+
+// -- fingerprint_set ----------------------------------------------------------
+
+/// @brief A concurrent, memory-bounded set of 64-bit fingerprints (e.g.
+/// sequence hashes from gynx::hash()).
+/// @details Fingerprints are routed by their high bits to partitions, each
+/// an open-addressing hash table behind its own mutex that doubles as it
+/// fills, so threads inserting at once rarely contend. When a partition
+/// reaches its share of the memory limit the set is saturated: new
+/// fingerprints routed there are reported as new but no longer stored, so
+/// the set turns approximate in the safe direction (a later repeat of them
+/// goes undetected) while memory stays bounded.
+class fingerprint_set
+{   struct partition
+    {   mutable std::mutex mutex;
+        std::vector<std::uint64_t> table;  // 0 marks an empty slot
+        std::size_t used = 0;
+    };
+
+    unsigned _bits;
+    std::size_t _max_slots;  // per partition
+    std::vector<partition> _parts;
+    std::atomic<bool> _saturated{false};
+
+    static constexpr std::size_t initial_slots = 256;
+
+    static std::uint64_t _key(std::uint64_t h) noexcept
+    {   return h ? h : 1;
+    }
+    partition& _partition_of(std::uint64_t key) noexcept
+    {   return _parts[_bits ? key >> (64 - _bits) : 0];
+    }
+    const partition& _partition_of(std::uint64_t key) const noexcept
+    {   return _parts[_bits ? key >> (64 - _bits) : 0];
+    }
+    // returns true if @a key was not in @a table yet
+    static bool _insert(std::vector<std::uint64_t>& table, std::uint64_t key) noexcept
+    {   const std::size_t mask = table.size() - 1;
+        for (std::size_t i = key & mask; ; i = (i + 1) & mask)
+        {   if (table[i] == key)
+                return false;
+            if (0 == table[i])
+            {   table[i] = key;
+                return true;
+            }
+        }
+    }
+
+public:
+    ///
+    /// @brief Creates a set whose tables use at most @a memory_limit bytes
+    /// in total, split into @a partitions (rounded up to a power of two).
+    explicit fingerprint_set
+    (   std::size_t memory_limit = std::size_t(1) << 30
+    ,   std::size_t partitions = 64
+    )
+    :   _bits(std::bit_width(std::bit_ceil(std::max<std::size_t>(partitions, 1))) - 1)
+    ,   _max_slots
+        (   std::max
+            (   initial_slots
+            ,   std::bit_floor
+                (   memory_limit / sizeof(std::uint64_t)
+                >>  _bits
+                )
+            )
+        )
+    ,   _parts(std::size_t(1) << _bits)
+    {}
+    fingerprint_set(const fingerprint_set&) = delete;
+    fingerprint_set& operator= (const fingerprint_set&) = delete;
+
+    ///
+    /// @brief Inserts @a h and returns true if it was not in the set (or
+    /// its partition is full). Safe to call from several threads.
+    bool insert(std::uint64_t h)
+    {   const std::uint64_t key = _key(h);
+        auto& p = _partition_of(key);
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (p.table.empty())
+            p.table.resize(initial_slots);
+        // grow at 7/8 load, or stop storing once at the limit
+        if (8 * (p.used + 1) > 7 * p.table.size())
+        {   if (p.table.size() < _max_slots)
+            {   std::vector<std::uint64_t> t(2 * p.table.size());
+                for (auto k : p.table)
+                    if (k)
+                        _insert(t, k);
+                p.table.swap(t);
+            }
+            else
+            {   const std::size_t mask = p.table.size() - 1;
+                for (std::size_t i = key & mask; p.table[i]; i = (i + 1) & mask)
+                    if (p.table[i] == key)
+                        return false;
+                _saturated.store(true, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        if (! _insert(p.table, key))
+            return false;
+        ++p.used;
+        return true;
+    }
+    ///
+    /// Returns true if @a h is in the set. Safe to call from several threads.
+    bool contains(std::uint64_t h) const
+    {   const std::uint64_t key = _key(h);
+        const auto& p = _partition_of(key);
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (p.table.empty())
+            return false;
+        const std::size_t mask = p.table.size() - 1;
+        for (std::size_t i = key & mask; p.table[i]; i = (i + 1) & mask)
+            if (p.table[i] == key)
+                return true;
+        return false;
+    }
+    ///
+    /// Returns the number of fingerprints stored.
+    std::size_t size() const
+    {   std::size_t n = 0;
+        for (const auto& p : _parts)
+        {   std::lock_guard<std::mutex> lock(p.mutex);
+            n += p.used;
+        }
+        return n;
+    }
+    ///
+    /// Returns the bytes held by the tables.
+    std::size_t bytes() const
+    {   std::size_t n = 0;
+        for (const auto& p : _parts)
+        {   std::lock_guard<std::mutex> lock(p.mutex);
+            n += p.table.size() * sizeof(std::uint64_t);
+        }
+        return n;
+    }
+    ///
+    /// Returns true if an insert found its partition full.
+    bool saturated() const noexcept
+    {   return _saturated.load(std::memory_order_relaxed);
+    }
+};
+
+// -- dedup --------------------------------------------------------------------
+
+/// @brief Which copy of a duplicated read gynx::dedup() keeps.
+enum class dedup_keep
+{   first         ///< the first in file order (single pass)
+,   best_quality  ///< the highest sum of Phred+33 qualities, first on ties
+};
+
+/// @brief Options of gynx::dedup().
+struct dedup_options
+{   bool canonical = true;  ///< a read and its reverse complement are duplicates
+    dedup_keep keep = dedup_keep::first;
+    std::size_t memory_limit = std::size_t(1) << 30;  ///< bytes for the set
+    std::size_t batch_size = 4096;  ///< reads hashed per task
+};
+
+/// @brief Summary of a gynx::dedup() run.
+struct dedup_stats
+{   std::size_t reads = 0;   ///< records read
+    std::size_t kept = 0;    ///< records passed on
+    bool saturated = false;  ///< the set filled up; some duplicates were kept
+
+    std::size_t duplicates() const noexcept
+    {   return reads - kept;
+    }
+    double duplication_rate() const noexcept
+    {   return reads ? double(reads - kept) / double(reads) : 0.0;
+    }
+};
+
+namespace detail {
+
+template<typename Sequence>
+struct dedup_batch
+{   std::vector<Sequence> reads;
+    std::vector<std::uint64_t> hashes;
+    std::vector<std::uint64_t> scores;
+    std::size_t first = 0;  // record index of reads[0]
+};
+
+template<typename Sequence>
+void dedup_hash(dedup_batch<Sequence>& b, bool canonical, bool scores)
+{   b.hashes.resize(b.reads.size());
+    for (std::size_t i = 0; i < b.reads.size(); ++i)
+        b.hashes[i] = canonical
+        ?   canonical_hash(b.reads[i](0))
+        :   hash(b.reads[i](0));
+    if (! scores)
+        return;
+    b.scores.assign(b.reads.size(), 0);
+    for (std::size_t i = 0; i < b.reads.size(); ++i)
+        if (b.reads[i].has("_qs"))
+        {   const auto& qs = std::any_cast<const std::string&>(b.reads[i]["_qs"]);
+            std::uint64_t q = 0;
+            for (char c : qs)
+                q += static_cast<std::uint8_t>(c) - 33u;
+            b.scores[i] = q;
+        }
+}
+
+// Reads @a filename in batches hashed on @a pool and calls g(batch) for each
+// batch in file order on the calling thread.
+template<typename Sequence, typename G>
+std::size_t dedup_pass
+(   std::string_view filename
+,   in::fast_aqz<Sequence>& reader
+,   const dedup_options& o
+,   thread_pool& pool
+,   G g
+)
+{   typedef dedup_batch<Sequence> batch_type;
+    std::size_t n = 0;
+    const bool scores = dedup_keep::best_quality == o.keep;
+    parallel_pipeline<batch_type>
+    (   pool
+    ,   [&](auto& submit)
+        {   auto batch = std::make_shared<batch_type>();
+            reader
+            (   filename
+            ,   [&](Sequence&& s)
+                {   batch->reads.push_back(std::move(s));
+                    ++n;
+                    if (batch->reads.size() == o.batch_size)
+                    {   submit(std::exchange(batch, std::make_shared<batch_type>()));
+                        batch->first = n;
+                    }
+                }
+            );
+            if (! batch->reads.empty())
+                submit(std::move(batch));
+        }
+    ,   [canonical = o.canonical, scores](batch_type& b)
+        {   dedup_hash(b, canonical, scores);
+        }
+    ,   g
+    );
+    return n;
+}
+
+// best copy of every distinct read: hash, quality score and record index;
+// only used from the thread running gynx::dedup()
+class dedup_best_table
+{   struct entry
+    {   std::uint64_t key = 0;  // 0 marks an empty slot
+        std::uint64_t score = 0;
+        std::uint64_t index = 0;
+    };
+    std::vector<entry> _slots;
+    std::size_t _used = 0;
+    std::size_t _max_slots;
+
+    static entry* _find(std::vector<entry>& slots, std::uint64_t key) noexcept
+    {   const std::size_t mask = slots.size() - 1;
+        std::size_t i = key & mask;
+        while (slots[i].key && slots[i].key != key)
+            i = (i + 1) & mask;
+        return &slots[i];
+    }
+
+public:
+    explicit dedup_best_table(std::size_t memory_limit)
+    :   _slots(256)
+    ,   _max_slots(std::max<std::size_t>(256, std::bit_floor(memory_limit / sizeof(entry))))
+    {}
+    // returns false if the read could not be stored (table full)
+    bool update(std::uint64_t h, std::uint64_t score, std::uint64_t index)
+    {   const std::uint64_t key = h ? h : 1;
+        entry* e = _find(_slots, key);
+        if (e->key)
+        {   if (score > e->score)
+                *e = { key, score, index };
+            return true;
+        }
+        if (8 * (_used + 1) > 7 * _slots.size())
+        {   if (_slots.size() == _max_slots)
+                return false;
+            std::vector<entry> t(2 * _slots.size());
+            for (const auto& x : _slots)
+                if (x.key)
+                    *_find(t, x.key) = x;
+            _slots.swap(t);
+            e = _find(_slots, key);
+        }
+        *e = { key, score, index };
+        ++_used;
+        return true;
+    }
+    // the index of the kept copy, or -1 if the read was not stored
+    std::uint64_t best(std::uint64_t h) noexcept
+    {   const entry* e = _find(_slots, h ? h : 1);
+        return e->key ? e->index : std::uint64_t(-1);
+    }
+    std::size_t size() const noexcept
+    {   return _used;
+    }
+};
+
+}   // end gynx::detail namespace
+
+/// @brief Removes duplicate reads from @a filename (FASTA/FASTQ, possibly
+/// gzipped), calling @a f with every kept record in file order.
+/// @details Reads are hashed (see gynx::hash() and gynx::canonical_hash())
+/// in batches on @a pool while the calling thread keeps reading, and the
+/// hashes are checked against a gynx::fingerprint_set in file order, so the
+/// result does not depend on the number of threads. Memory is bounded by
+/// @a o.memory_limit plus a few batches in flight; reads are compared by
+/// 64-bit hash, so for 10^8 distinct reads about one false duplicate is
+/// expected every few thousand runs.
+/// With dedup_keep::best_quality the file is read twice: the first pass
+/// finds the best copy of every distinct read, the second passes it on.
+/// Batches run through gynx::parallel_pipeline().
+template<typename Sequence = sq, typename F>
+requires std::invocable<F&, Sequence&&>
+dedup_stats dedup
+(   std::string_view filename
+,   F f
+,   const dedup_options& o = {}
+,   thread_pool& pool = thread_pool::global()
+,   in::fast_aqz<Sequence> reader = {}
+)
+{   if (0 == o.batch_size)
+        throw std::invalid_argument("gynx::dedup: batch_size is 0");
+    dedup_stats st;
+    if (dedup_keep::first == o.keep)
+    {   fingerprint_set seen(o.memory_limit);
+        st.reads = detail::dedup_pass
+        (   filename
+        ,   reader
+        ,   o
+        ,   pool
+        ,   [&](detail::dedup_batch<Sequence>& b)
+            {   for (std::size_t i = 0; i < b.reads.size(); ++i)
+                    if (seen.insert(b.hashes[i]))
+                    {   ++st.kept;
+                        f(std::move(b.reads[i]));
+                    }
+            }
+        );
+        st.saturated = seen.saturated();
+        return st;
+    }
+
+    if (filename == "-")
+        throw std::invalid_argument
+            ("gynx::dedup: best_quality needs a file that can be read twice");
+    detail::dedup_best_table best(o.memory_limit);
+    std::size_t untracked = 0;
+    st.reads = detail::dedup_pass
+    (   filename
+    ,   reader
+    ,   o
+    ,   pool
+    ,   [&](detail::dedup_batch<Sequence>& b)
+        {   for (std::size_t i = 0; i < b.reads.size(); ++i)
+                if (! best.update(b.hashes[i], b.scores[i], b.first + i))
+                    ++untracked;
+        }
+    );
+    st.saturated = untracked > 0;
+    st.kept = best.size() + untracked;
+    // quality scores are only needed by the first pass
+    dedup_options second = o;
+    second.keep = dedup_keep::first;
+    detail::dedup_pass
+    (   filename
+    ,   reader
+    ,   second
+    ,   pool
+    ,   [&](detail::dedup_batch<Sequence>& b)
+        {   for (std::size_t i = 0; i < b.reads.size(); ++i)
+            {   const std::uint64_t k = best.best(b.hashes[i]);
+                if (k == b.first + i || std::uint64_t(-1) == k)
+                    f(std::move(b.reads[i]));
+            }
+        }
+    );
+    return st;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_DEDUP_HPP_
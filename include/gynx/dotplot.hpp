@@ -0,0 +1,405 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_DOTPLOT_HPP_
+#define _GYNX_DOTPLOT_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gynx/kmers.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/thread_pool.hpp>
+
+namespace gynx {
+
+// -- dot_matrix ---------------------------------------------------------------
+
+/// @brief A dot plot of sequences x (rows) and y (columns) downsampled to
+/// rows() x cols() cells, each holding the number of dots that fell in it.
+/// @details Row r covers x positions [r * x_size() / rows(), (r + 1) *
+/// x_size() / rows()), and columns likewise for y. Writing the matrix to a
+/// stream gives one line of space-separated counts per row, the layout of
+/// gnuplot's <tt>plot '-' matrix with image</tt>.
+class dot_matrix
+{   std::size_t _rows = 0;
+    std::size_t _cols = 0;
+    std::size_t _x_size = 0;
+    std::size_t _y_size = 0;
+    std::vector<std::uint32_t> _cells;
+
+public:
+    dot_matrix() = default;
+    dot_matrix
+    (   std::size_t rows
+    ,   std::size_t cols
+    ,   std::size_t x_size
+    ,   std::size_t y_size
+    )
+    :   _rows(std::min(rows, x_size))
+    ,   _cols(std::min(cols, y_size))
+    ,   _x_size(x_size)
+    ,   _y_size(y_size)
+    ,   _cells(_rows * _cols, 0)
+    {}
+
+// -- observers ----------------------------------------------------------------
+    std::size_t rows() const noexcept
+    {   return _rows;
+    }
+    std::size_t cols() const noexcept
+    {   return _cols;
+    }
+    std::size_t x_size() const noexcept
+    {   return _x_size;
+    }
+    std::size_t y_size() const noexcept
+    {   return _y_size;
+    }
+    ///
+    /// Returns the row holding position @a i of x.
+    std::size_t row_of(std::size_t i) const noexcept
+    {   return i * _rows / _x_size;
+    }
+    ///
+    /// Returns the column holding position @a j of y.
+    std::size_t col_of(std::size_t j) const noexcept
+    {   return j * _cols / _y_size;
+    }
+    ///
+    /// Returns the first position of x in row @a r.
+    std::size_t row_begin(std::size_t r) const noexcept
+    {   return (r * _x_size + _rows - 1) / _rows;
+    }
+    ///
+    /// Returns the first position of y in column @a c.
+    std::size_t col_begin(std::size_t c) const noexcept
+    {   return (c * _y_size + _cols - 1) / _cols;
+    }
+
+// -- access -------------------------------------------------------------------
+    std::uint32_t& operator() (std::size_t r, std::size_t c) noexcept
+    {   return _cells[r * _cols + c];
+    }
+    std::uint32_t operator() (std::size_t r, std::size_t c) const noexcept
+    {   return _cells[r * _cols + c];
+    }
+    const std::uint32_t* data() const noexcept
+    {   return _cells.data();
+    }
+    ///
+    /// Returns the largest cell, e.g. for a color range.
+    std::uint32_t max() const noexcept
+    {   return _cells.empty()
+        ?   0
+        :   *std::max_element(_cells.begin(), _cells.end());
+    }
+    ///
+    /// Returns the total number of dots.
+    std::uint64_t total() const noexcept
+    {   std::uint64_t t = 0;
+        for (auto v : _cells)
+            t += v;
+        return t;
+    }
+
+    friend std::ostream& operator<< (std::ostream& os, const dot_matrix& m)
+    {   for (std::size_t r = 0; r < m._rows; ++r)
+        {   for (std::size_t c = 0; c < m._cols; ++c)
+                os << (c ? " " : "") << m(r, c);
+            os << '\n';
+        }
+        return os;
+    }
+};
+
+namespace detail {
+
+// Splits the rows of @a m into chunks for parallel_for; each chunk owns a
+// contiguous range of rows, so no two tasks write to the same cell.
+inline std::size_t dotplot_chunks(const dot_matrix& m, const thread_pool& pool)
+{   return std::min<std::size_t>
+    (   m.rows()
+    ,   8 * std::max<std::size_t>(1, pool.size())
+    );
+}
+
+// Number of bits set in [lo, hi) of bitset @a b.
+inline std::size_t popcount_range
+(   const std::uint64_t* b
+,   std::size_t lo
+,   std::size_t hi
+)   noexcept
+{   if (lo >= hi)
+        return 0;
+    const std::size_t wl = lo / 64, wh = (hi - 1) / 64;
+    const std::uint64_t ml = ~std::uint64_t(0) << (lo % 64);
+    const std::uint64_t mh = ~std::uint64_t(0) >> (63 - (hi - 1) % 64);
+    if (wl == wh)
+        return std::popcount(b[wl] & ml & mh);
+    std::size_t n = std::popcount(b[wl] & ml) + std::popcount(b[wh] & mh);
+    for (std::size_t w = wl + 1; w < wh; ++w)
+        n += std::popcount(b[w]);
+    return n;
+}
+
+}   // end gynx::detail namespace
+
+// -- word matches -------------------------------------------------------------
+///
+/// @brief Returns the dot plot of the exact k-mer matches (1 <= @a k <= 32)
+/// between @a x and @a y, downsampled to @a rows x @a cols.
+/// @details A dot is a position pair (i, j) where the k-mers of x at i and
+/// of y at j are equal or, with @a both_strands, reverse complements of
+/// each other. The k-mers of y are indexed in a hash table; rows of x are
+/// then looked up in parallel on @a pool. K-mers occurring more than
+/// @a max_occurrences times in y (low-complexity repeats) are skipped, which
+/// bounds the work to O(|x| * max_occurrences). Only A/C/G/T k-mers match.
+template<typename Container1, typename Container2>
+requires std::is_same_v<typename Container1::value_type, char>
+&&  std::is_same_v<typename Container2::value_type, char>
+dot_matrix dotplot
+(   sq_view_gen<Container1> x
+,   sq_view_gen<Container2> y
+,   std::size_t k
+,   std::size_t rows
+,   std::size_t cols
+,   bool both_strands = true
+,   std::size_t max_occurrences = 1024
+,   thread_pool& pool = thread_pool::global()
+)
+{   if (k < 1 || k > 32)
+        throw std::invalid_argument("gynx::dotplot: k out of range");
+    if (0 == rows || 0 == cols)
+        throw std::invalid_argument("gynx::dotplot: empty resolution");
+    dot_matrix m(rows, cols, x.size(), y.size());
+    if (x.size() < k || y.size() < k)
+        return m;
+
+    // index of y: positions grouped by k-mer, located by a hash table
+    std::vector<std::pair<std::uint64_t, std::size_t>> words;
+    words.reserve(y.size() - k + 1);
+    for (auto km : y | views::kmers(k))
+        words.emplace_back(km.fwd, km.pos);
+    std::sort(words.begin(), words.end());
+    std::vector<std::size_t> pos(words.size());
+    for (std::size_t i = 0; i < words.size(); ++i)
+        pos[i] = words[i].second;
+
+    struct slot
+    {   std::uint64_t code;
+        std::size_t begin;
+        std::size_t end;  // 0 marks an empty slot
+    };
+    const int bits = std::max(4, int(std::bit_width(2 * words.size())));
+    const std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+    const auto home = [bits](std::uint64_t code)
+    {   return (code * 0x9e3779b97f4a7c15ull) >> (64 - bits);
+    };
+    std::vector<slot> table(mask + 1, slot{ 0, 0, 0 });
+    for (std::size_t b = 0, e; b < words.size(); b = e)
+    {   for (e = b + 1; e < words.size() && words[e].first == words[b].first; ++e)
+            ;
+        if (e - b > max_occurrences)
+            continue;
+        auto h = home(words[b].first);
+        while (table[h].end)
+            h = (h + 1) & mask;
+        table[h] = { words[b].first, b, e };
+    }
+    const auto lookup = [&](std::uint64_t code) -> const slot*
+    {   for (auto h = home(code); table[h].end; h = (h + 1) & mask)
+            if (table[h].code == code)
+                return &table[h];
+        return nullptr;
+    };
+
+    const std::size_t chunks = detail::dotplot_chunks(m, pool);
+    parallel_for
+    (   pool
+    ,   chunks
+    ,   [&](std::size_t t)
+        {   const std::size_t first = m.row_begin(t * m.rows() / chunks);
+            const std::size_t last = m.row_begin((t + 1) * m.rows() / chunks);
+            if (first >= last || first + k > x.size())
+                return;
+            const auto end = std::min(x.size(), last + k - 1);
+            for (auto km : x.substr(first, end - first) | views::kmers(k))
+            {   const std::size_t r = m.row_of(first + km.pos);
+                if (const auto s = lookup(km.fwd))
+                    for (auto p = s->begin; p < s->end; ++p)
+                        ++m(r, m.col_of(pos[p]));
+                if (both_strands && km.rev != km.fwd)
+                    if (const auto s = lookup(km.rev))
+                        for (auto p = s->begin; p < s->end; ++p)
+                            ++m(r, m.col_of(pos[p]));
+            }
+        }
+    );
+    return m;
+}
+
+// -- windowed identity --------------------------------------------------------
+///
+/// @brief Returns the dot plot of @a x against @a y with a dot at (i, j)
+/// when at least @a threshold of the @a window residue pairs along the
+/// diagonal from (i, j) are identical (case-insensitive), downsampled to
+/// @a rows x @a cols.
+/// @details Each row is computed for all j at once, 64 columns per word:
+/// per-residue bitsets of y are combined into bit-sliced window counters
+/// that are updated incrementally from the row below. Rows are split
+/// across @a pool. The work is O(|x| * |y| * log(window) / 64), so this
+/// suits sequences up to some hundred kb; use the word-match dotplot()
+/// beyond.
+template<typename Container1, typename Container2>
+requires std::is_same_v<typename Container1::value_type, char>
+&&  std::is_same_v<typename Container2::value_type, char>
+dot_matrix dotplot_identity
+(   sq_view_gen<Container1> x
+,   sq_view_gen<Container2> y
+,   std::size_t window
+,   std::size_t threshold
+,   std::size_t rows
+,   std::size_t cols
+,   thread_pool& pool = thread_pool::global()
+)
+{   if (0 == window || threshold > window)
+        throw std::invalid_argument("gynx::dotplot_identity: bad window");
+    if (0 == rows || 0 == cols)
+        throw std::invalid_argument("gynx::dotplot_identity: empty resolution");
+    dot_matrix m(rows, cols, x.size(), y.size());
+    const std::size_t n = x.size(), ny = y.size();
+    if (n < window || ny < window)
+        return m;
+
+    // one bitset over the columns per residue of y, plus an empty one
+    const std::size_t words = (ny + 63) / 64;
+    const auto upper = [](char c)
+    {   return static_cast<unsigned char>('a' <= c && c <= 'z' ? c - 'a' + 'A' : c);
+    };
+    std::vector<std::uint32_t> which(256, 0);
+    std::vector<std::uint64_t> residues(words, 0);
+    for (std::size_t j = 0; j < ny; ++j)
+    {   auto& w = which[upper(y[j])];
+        if (0 == w)
+        {   w = static_cast<std::uint32_t>(residues.size() / words);
+            residues.resize(residues.size() + words, 0);
+        }
+        residues[w * words + j / 64] |= std::uint64_t(1) << (j % 64);
+    }
+    const auto row = [&](std::size_t i)
+    {   return residues.data() + which[upper(x[i])] * words;
+    };
+
+    const std::size_t planes = std::bit_width(window);
+    const std::size_t last_i = n - window;   // rows with a full window
+    const std::size_t last_j = ny - window;
+    const std::size_t chunks = detail::dotplot_chunks(m, pool);
+    parallel_for
+    (   pool
+    ,   chunks
+    ,   [&](std::size_t t)
+        {   const std::size_t first = m.row_begin(t * m.rows() / chunks);
+            const std::size_t last
+                = std::min(m.row_begin((t + 1) * m.rows() / chunks), last_i + 1);
+            if (first >= last)
+                return;
+            // counters S(j) = matches on the diagonal window from (i, j),
+            // one bit plane per bit of the count
+            std::vector<std::uint64_t> s(planes * words, 0);
+            std::vector<std::uint64_t> carry(words), borrow(words), eq(words), hit(words);
+            const std::size_t top = std::min(n - 1, last + window - 2);
+            for (std::size_t i = top + 1; i-- > first; )
+            {   // S_i(j) = S_{i+1}(j + 1) + M(i, j) - M(i + window, j + window)
+                for (std::size_t p = 0; p < planes; ++p)
+                {   std::uint64_t* sp = s.data() + p * words;
+                    for (std::size_t w = 0; w + 1 < words; ++w)
+                        sp[w] = (sp[w] >> 1) | (sp[w + 1] << 63);
+                    sp[words - 1] >>= 1;
+                }
+                // bit-sliced add and subtract, one plane at a time over all
+                // words so the loops vectorize
+                std::copy_n(row(i), words, carry.data());
+                const bool drop = i + window <= top;
+                if (drop)
+                {   const std::uint64_t* r = row(i + window);
+                    const std::size_t ws = window / 64, bs = window % 64;
+                    for (std::size_t w = 0; w < words; ++w)
+                    {   const std::uint64_t lo = w + ws < words ? r[w + ws] : 0;
+                        const std::uint64_t hi = w + ws + 1 < words ? r[w + ws + 1] : 0;
+                        borrow[w] = bs ? (lo >> bs) | (hi << (64 - bs)) : lo;
+                    }
+                }
+                for (std::size_t p = 0; p < planes; ++p)
+                {   std::uint64_t* sp = s.data() + p * words;
+                    for (std::size_t w = 0; w < words; ++w)
+                    {   const std::uint64_t c = sp[w] & carry[w];
+                        sp[w] ^= carry[w];
+                        carry[w] = c;
+                    }
+                    if (drop)
+                        for (std::size_t w = 0; w < words; ++w)
+                        {   const std::uint64_t b = ~sp[w] & borrow[w];
+                            sp[w] ^= borrow[w];
+                            borrow[w] = b;
+                        }
+                }
+                if (i >= last)
+                    continue;
+                // hit = S >= threshold, comparing from the top plane down
+                std::fill(hit.begin(), hit.end(), 0);
+                std::fill(eq.begin(), eq.end(), ~std::uint64_t(0));
+                for (std::size_t p = planes; p-- > 0; )
+                {   const std::uint64_t* sp = s.data() + p * words;
+                    if ((threshold >> p) & 1)
+                        for (std::size_t w = 0; w < words; ++w)
+                            eq[w] &= sp[w];
+                    else
+                        for (std::size_t w = 0; w < words; ++w)
+                        {   hit[w] |= eq[w] & sp[w];
+                            eq[w] &= ~sp[w];
+                        }
+                }
+                for (std::size_t w = 0; w < words; ++w)
+                    hit[w] |= eq[w];
+                const std::size_t r = m.row_of(i);
+                for (std::size_t c = 0; c < m.cols(); ++c)
+                    m(r, c) += static_cast<std::uint32_t>(detail::popcount_range
+                    (   hit.data()
+                    ,   m.col_begin(c)
+                    ,   std::min(m.col_begin(c + 1), last_j + 1)
+                    ));
+            }
+        }
+    );
+    return m;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_DOTPLOT_HPP_
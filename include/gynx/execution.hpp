@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_EXECUTION_HPP_
+#define _GYNX_EXECUTION_HPP_
+
+// Overloads of whole-sequence algorithms taking a standard execution policy
+// as their first argument, in the style of the parallel standard algorithms.
+// Sequenced policies run the serial versions on the calling thread; the
+// parallel ones run the thread_pool overloads on thread_pool::global().
+// This header is separate because <execution> may require linking a
+// parallel backend (e.g. TBB with libstdc++).
+
+#include <cstddef>
+#include <execution>
+#include <type_traits>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/composition.hpp>
+#include <gynx/minimizers.hpp>
+#include <gynx/normalize.hpp>
+#include <gynx/reverse_complement.hpp>
+
+namespace gynx {
+
+/// @brief Satisfied by the standard execution policy types, e.g.
+/// std::execution::seq or std::execution::par.
+template<typename P>
+concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<P>>;
+
+namespace detail {
+
+/// True for policies that must run on the calling thread.
+template<typename P>
+inline constexpr bool is_sequential_policy
+=   std::is_same_v<std::remove_cvref_t<P>, std::execution::sequenced_policy>
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201902L
+||  std::is_same_v<std::remove_cvref_t<P>, std::execution::unsequenced_policy>
+#endif
+;
+
+}   // end gynx::detail namespace
+
+// -- composition --------------------------------------------------------------
+///
+/// @brief Counts the residues of @a v, see composition().
+template<execution_policy P, typename Container>
+composition_counts composition(P&&, sq_view_gen<Container> v)
+{   if constexpr (detail::is_sequential_policy<P>)
+        return composition(v);
+    else
+        return composition(v, thread_pool::global());
+}
+///
+/// @brief Returns the GC fraction of the unambiguous residues of @a v.
+template<execution_policy P, typename Container>
+double gc_content(P&& policy, sq_view_gen<Container> v)
+{   return composition(policy, v).gc_content();
+}
+///
+/// @brief Computes the GC profile of @a v, see gc_profile().
+template<execution_policy P, typename Container>
+std::vector<gc_window> gc_profile
+(   P&&
+,   sq_view_gen<Container> v
+,   std::size_t window
+,   std::size_t step = 0
+)
+{   if constexpr (detail::is_sequential_policy<P>)
+        return gc_profile(v, window, step);
+    else
+        return gc_profile(v, window, step, thread_pool::global());
+}
+
+// -- reverse complement -------------------------------------------------------
+///
+/// @brief Reverse-complements @a s in place, see reverse_complement().
+template<execution_policy P, typename Container, typename Map>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container, Map>& reverse_complement(P&&, sq_gen<Container, Map>& s)
+{   if constexpr (detail::is_sequential_policy<P>)
+        return reverse_complement(s);
+    else
+        return reverse_complement(s, thread_pool::global());
+}
+///
+/// @brief Materializes the reverse complement of the view @a v.
+template<execution_policy P, typename Container>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container> reverse_complement_copy(P&&, sq_view_gen<Container> v)
+{   if constexpr (detail::is_sequential_policy<P>)
+        return reverse_complement_copy(v);
+    else
+        return reverse_complement_copy(v, thread_pool::global());
+}
+
+// -- normalization ------------------------------------------------------------
+///
+/// @brief Normalizes the residues of @a s in place, see normalize().
+template<execution_policy P, std::ranges::contiguous_range R>
+requires std::same_as<std::ranges::range_value_t<R>, char>
+std::size_t normalize
+(   P&&
+,   R& s
+,   alphabet a
+,   normalization p = normalization::uppercase
+)
+{   if constexpr (detail::is_sequential_policy<P>)
+        return normalize(s, a, p);
+    else
+        return normalize(s, a, p, thread_pool::global());
+}
+
+// -- minimizers ---------------------------------------------------------------
+///
+/// @brief Returns the (@a w, @a k)-minimizers of @a s, see minimizers().
+template<execution_policy P, typename Container, typename Hash = invertible_hash>
+std::vector<minimizer> minimizers
+(   P&&
+,   sq_view_gen<Container> s
+,   std::size_t w
+,   std::size_t k
+,   Hash hash = Hash()
+)
+{   if constexpr (detail::is_sequential_policy<P>)
+        return minimizers(s, w, k, hash);
+    else
+        return minimizers(s, w, k, thread_pool::global(), hash);
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_EXECUTION_HPP_
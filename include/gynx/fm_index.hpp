@@ -0,0 +1,649 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_FM_INDEX_HPP_
+#define _GYNX_FM_INDEX_HPP_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gynx/simd.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/thread_pool.hpp>
+
+#if __has_include(<sys/mman.h>)
+#   include <gynx/mmap_vector.hpp>
+#endif
+
+namespace gynx {
+
+namespace detail {
+
+// -- suffix array construction ------------------------------------------------
+
+/// @brief Returns the suffix array of @a s, whose symbols are in
+/// [0, @a upper], built by induced sorting (SA-IS, Nong, Zhang & Chan 2009).
+/// @details Runs in O(n) time; the reduced problem of the LMS substrings is
+/// solved recursively. A shorter suffix sorts before its extensions, so no
+/// sentinel is needed.
+inline std::vector<std::int32_t> sa_is
+(   const std::vector<std::int32_t>& s
+,   std::int32_t upper
+)
+{   const std::int32_t n = static_cast<std::int32_t>(s.size());
+    if (n < 8)
+    {   std::vector<std::int32_t> sa(n);
+        for (std::int32_t i = 0; i < n; ++i)
+            sa[i] = i;
+        std::sort
+        (   sa.begin()
+        ,   sa.end()
+        ,   [&](std::int32_t a, std::int32_t b)
+            {   return std::lexicographical_compare
+                (s.begin() + a, s.end(), s.begin() + b, s.end());
+            }
+        );
+        return sa;
+    }
+
+    // S-type (true) or L-type (false) suffixes and the bucket boundaries
+    std::vector<std::int32_t> sa(n);
+    std::vector<bool> ls(n, false);
+    for (std::int32_t i = n - 2; i >= 0; --i)
+        ls[i] = s[i] == s[i + 1] ? ls[i + 1] : s[i] < s[i + 1];
+    std::vector<std::int32_t> sum_l(upper + 1, 0), sum_s(upper + 1, 0);
+    for (std::int32_t i = 0; i < n; ++i)
+        if (ls[i])
+            ++sum_l[s[i] + 1];
+        else
+            ++sum_s[s[i]];
+    for (std::int32_t i = 0; i <= upper; ++i)
+    {   sum_s[i] += sum_l[i];
+        if (i < upper)
+            sum_l[i + 1] += sum_s[i];
+    }
+
+    std::vector<std::int32_t> buf(upper + 1);
+    const auto induce = [&](const std::vector<std::int32_t>& lms)
+    {   std::fill(sa.begin(), sa.end(), -1);
+        std::copy(sum_s.begin(), sum_s.end(), buf.begin());
+        for (auto d : lms)
+            if (d != n)
+                sa[buf[s[d]]++] = d;
+        std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+        sa[buf[s[n - 1]]++] = n - 1;
+        for (std::int32_t i = 0; i < n; ++i)
+        {   const std::int32_t v = sa[i];
+            if (v >= 1 && ! ls[v - 1])
+                sa[buf[s[v - 1]]++] = v - 1;
+        }
+        std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+        for (std::int32_t i = n - 1; i >= 0; --i)
+        {   const std::int32_t v = sa[i];
+            if (v >= 1 && ls[v - 1])
+                sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    // leftmost S-type positions
+    std::vector<std::int32_t> lms_map(n + 1, -1), lms;
+    for (std::int32_t i = 1; i < n; ++i)
+        if (! ls[i - 1] && ls[i])
+        {   lms_map[i] = static_cast<std::int32_t>(lms.size());
+            lms.push_back(i);
+        }
+    const std::int32_t m = static_cast<std::int32_t>(lms.size());
+    induce(lms);
+    if (0 == m)
+        return sa;
+
+    // name the sorted LMS substrings and sort them recursively
+    std::vector<std::int32_t> sorted;
+    sorted.reserve(m);
+    for (auto v : sa)
+        if (lms_map[v] != -1)
+            sorted.push_back(v);
+    std::vector<std::int32_t> rec(m);
+    std::int32_t rec_upper = 0;
+    rec[lms_map[sorted[0]]] = 0;
+    for (std::int32_t i = 1; i < m; ++i)
+    {   std::int32_t l = sorted[i - 1], r = sorted[i];
+        const std::int32_t end_l = lms_map[l] + 1 < m ? lms[lms_map[l] + 1] : n;
+        const std::int32_t end_r = lms_map[r] + 1 < m ? lms[lms_map[r] + 1] : n;
+        bool same = end_l - l == end_r - r;
+        if (same)
+        {   while (l < end_l && s[l] == s[r])
+            {   ++l;
+                ++r;
+            }
+            same = l != n && r != n && s[l] == s[r];
+        }
+        if (! same)
+            ++rec_upper;
+        rec[lms_map[sorted[i]]] = rec_upper;
+    }
+    const auto rec_sa = sa_is(rec, rec_upper);
+    for (std::int32_t i = 0; i < m; ++i)
+        sorted[i] = lms[rec_sa[i]];
+    induce(sorted);
+    return sa;
+}
+
+}   // end gynx::detail namespace
+
+// -- fm_hit -------------------------------------------------------------------
+
+/// @brief An occurrence reported by fm_index::locate(): the record it is in
+/// and its offset in that record.
+struct fm_hit
+{   std::size_t record;
+    std::size_t pos;
+
+    friend bool operator== (const fm_hit&, const fm_hit&) = default;
+    friend auto operator<=> (const fm_hit&, const fm_hit&) = default;
+};
+
+// -- fm_index -----------------------------------------------------------------
+
+/// @brief An FM-index of one or more nucleotide sequences for counting and
+/// locating exact occurrences of short queries.
+/// @details The suffix array is built with SA-IS. The BWT is stored as 2-bit
+/// symbols in 64-byte blocks of 64 rows that also hold the rank counts, so
+/// every rank query touches a single cache line. One suffix array entry in
+/// every @a sample_rate text positions is kept for locate(). Residues other
+/// than A/C/G/T (case-insensitive) act like record boundaries: no occurrence
+/// spans them. The whole index is one array of 64-bit words (32-bit fields
+/// are packed two per word, low half first), written as is by save() and
+/// memory-mapped by the path constructor, so a saved index loads instantly.
+/// Words are stored in the byte order of the host; an index saved on a host
+/// of the other byte order is rejected. Texts are limited to 2^31 - 1
+/// residues in total.
+class fm_index
+{   // header layout, in words
+    enum : std::size_t
+    {   h_magic, h_size, h_records, h_rate, h_samples, h_c
+    ,   h_blocks = h_c + 4, h_sample_data, h_starts, h_words
+    ,   header_words = 16
+    };
+    static constexpr std::uint64_t magic = 0x31494d46584e5947ull;  // GYNXFMI1
+    static constexpr std::size_t block_words = 8;
+    static constexpr std::size_t group = 16;  // queries searched in lockstep
+
+    // row block: rank counts of A/C/G/T and of sampled rows before the block
+    // (5 x 32-bit fields in words 0..2), then the low and high bit planes of
+    // the BWT, the rows holding a record boundary, and the sampled rows
+    enum : std::size_t { b_lo = 3, b_hi, b_sep, b_mark };
+
+    std::vector<std::uint64_t> _own;
+#if __has_include(<sys/mman.h>)
+    mmap_vector<std::uint64_t> _mapped;
+#endif
+
+    const std::uint64_t* _words() const noexcept
+    {
+#if __has_include(<sys/mman.h>)
+        if (! _mapped.empty())
+            return _mapped.data();
+#endif
+        return _own.empty() ? nullptr : _own.data();
+    }
+
+    // 32-bit field f of the words at p
+    static std::uint32_t _field(const std::uint64_t* p, std::size_t f) noexcept
+    {   return static_cast<std::uint32_t>(p[f / 2] >> (f % 2 * 32));
+    }
+    // sets the (zero) 32-bit field f of the words at p to v
+    static void _set_field(std::uint64_t* p, std::size_t f, std::uint32_t v) noexcept
+    {   p[f / 2] |= std::uint64_t(v) << (f % 2 * 32);
+    }
+
+    static void _check
+    (   const std::uint64_t* w
+    ,   std::size_t n
+    ,   const std::filesystem::path& path
+    )
+    {   if (n < header_words || w[h_magic] != magic || w[h_words] != n)
+            throw std::runtime_error
+            (   "gynx::fm_index: not an index file -> "
+            +   path.string()
+            );
+    }
+
+    // 1..4 for A/C/G/T, 0 for anything else
+    static constexpr std::array<std::uint8_t, 256> _codes = []
+    {   std::array<std::uint8_t, 256> t{};
+        t['A'] = t['a'] = 1;
+        t['C'] = t['c'] = 2;
+        t['G'] = t['g'] = 3;
+        t['T'] = t['t'] = 4;
+        return t;
+    }();
+
+    struct view
+    {   const std::uint64_t* w;
+        const std::uint64_t* blocks;
+        const std::uint64_t* samples;
+        const std::uint64_t* starts;
+
+        std::uint64_t c(unsigned b) const noexcept
+        {   return w[h_c + b];
+        }
+        // number of rows before i holding base b (0..3)
+        std::uint64_t occ(unsigned b, std::size_t i) const noexcept
+        {   const std::uint64_t* k = blocks + (i / 64) * block_words;
+            const std::uint64_t lo = k[b_lo], hi = k[b_hi];
+            std::uint64_t x = (b & 1 ? lo : ~lo) & (b & 2 ? hi : ~hi);
+            if (0 == b)
+                x &= ~k[b_sep];
+            const std::uint64_t mask = (std::uint64_t(1) << (i % 64)) - 1;
+            return _field(k, b) + std::popcount(x & mask);
+        }
+        void prefetch(std::size_t i) const noexcept
+        {   GYNX_PREFETCH(blocks + (i / 64) * block_words, 0);
+        }
+        // the row of the previous text position (LF mapping); row i must not
+        // hold a boundary
+        std::size_t lf(std::size_t i) const noexcept
+        {   const std::uint64_t* k = blocks + (i / 64) * block_words;
+            const unsigned o = i % 64;
+            const unsigned b = unsigned((k[b_lo] >> o) & 1)
+            |   unsigned((k[b_hi] >> o) & 1) << 1;
+            return c(b) + occ(b, i);
+        }
+        // the text position of row i
+        std::size_t position(std::size_t i) const noexcept
+        {   std::size_t steps = 0;
+            for (;;)
+            {   const std::uint64_t* k = blocks + (i / 64) * block_words;
+                const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+                if (k[b_mark] & bit)
+                {   const std::size_t r
+                        = _field(k, 4) + std::popcount(k[b_mark] & (bit - 1));
+                    return _field(samples, r) + steps;
+                }
+                i = lf(i);
+                ++steps;
+            }
+        }
+    };
+
+    view _view() const noexcept
+    {   const std::uint64_t* w = _words();
+        return
+        {   w
+        ,   w + w[h_blocks]
+        ,   w + w[h_sample_data]
+        ,   w + w[h_starts]
+        };
+    }
+
+    // rows [first, last) of the suffixes starting with the query
+    template<typename Container>
+    std::pair<std::size_t, std::size_t> _range
+    (   const view& v
+    ,   const sq_view_gen<Container>& q
+    )   const noexcept
+    {   if (q.empty())
+            return { 0, 0 };
+        std::size_t first = 0, last = v.w[h_size];
+        for (std::size_t i = q.size(); i-- > 0 && first < last; )
+        {   const unsigned b = _codes[static_cast<unsigned char>(q[i])];
+            if (0 == b)
+                return { 0, 0 };
+            first = v.c(b - 1) + v.occ(b - 1, first);
+            last = v.c(b - 1) + v.occ(b - 1, last);
+        }
+        return { first, std::max(first, last) };
+    }
+
+    // backward search of n <= group queries in lockstep: each step prefetches the
+    // blocks of the next one, so the cache misses of the group overlap
+    void _count_group
+    (   const view& v
+    ,   const std::pair<const char*, std::size_t>* queries
+    ,   std::size_t n
+    ,   std::size_t* out
+    )   const noexcept
+    {   struct state
+        {   const char* q;
+            std::size_t i, first, last;
+        };
+        std::array<state, group> st;
+        std::size_t live = 0;
+        for (std::size_t j = 0; j < n; ++j)
+        {   out[j] = 0;
+            if (queries[j].second)
+                st[live++] = { queries[j].first, queries[j].second, 0, v.w[h_size] };
+        }
+        std::array<std::size_t*, group> dst;
+        for (std::size_t j = 0, l = 0; j < n; ++j)
+            if (queries[j].second)
+                dst[l++] = out + j;
+        while (live)
+            for (std::size_t j = 0; j < live; )
+            {   auto& s = st[j];
+                const unsigned b = _codes[static_cast<unsigned char>(s.q[--s.i])];
+                if (b)
+                {   s.first = v.c(b - 1) + v.occ(b - 1, s.first);
+                    s.last = v.c(b - 1) + v.occ(b - 1, s.last);
+                }
+                if (0 == b || s.first >= s.last || 0 == s.i)
+                {   *dst[j] = b && s.first < s.last ? s.last - s.first : 0;
+                    st[j] = st[--live];
+                    dst[j] = dst[live];
+                    continue;
+                }
+                v.prefetch(s.first);
+                v.prefetch(s.last);
+                ++j;
+            }
+    }
+
+    template<typename Records>
+    void _build(const Records& records, std::size_t sample_rate)
+    {   if (0 == sample_rate)
+            throw std::invalid_argument("gynx::fm_index: sample_rate is 0");
+
+        // text: records each followed by a boundary, 0 = boundary
+        std::size_t total = 0, count = 0;
+        for (const auto& r : records)
+        {   total += std::ranges::size(r) + 1;
+            ++count;
+        }
+        if (total >= std::size_t(std::numeric_limits<std::int32_t>::max()))
+            throw std::length_error("gynx::fm_index: text too long");
+        std::vector<std::int32_t> text;
+        text.reserve(total);
+        std::vector<std::uint64_t> starts;
+        starts.reserve(count + 1);
+        for (const auto& r : records)
+        {   starts.push_back(text.size());
+            for (char ch : r)
+                text.push_back(_codes[static_cast<unsigned char>(ch)]);
+            text.push_back(0);
+        }
+        starts.push_back(text.size());
+        const std::size_t n = text.size();
+        const auto sa = detail::sa_is(text, 4);
+
+        const std::size_t blocks = n / 64 + 1;
+        std::size_t samples = 0;
+        const auto sampled = [&](std::size_t i)
+        {   return 0 == sa[i] % sample_rate || 0 == sa[i] || 0 == text[sa[i] - 1];
+        };
+        for (std::size_t i = 0; i < n; ++i)
+            samples += sampled(i);
+
+        std::vector<std::uint64_t> w(header_words);
+        w[h_magic] = magic;
+        w[h_size] = n;
+        w[h_records] = count;
+        w[h_rate] = sample_rate;
+        w[h_samples] = samples;
+        w[h_blocks] = header_words;
+        w[h_sample_data] = w[h_blocks] + blocks * block_words;
+        w[h_starts] = w[h_sample_data] + (samples + 1) / 2;
+        w[h_words] = w[h_starts] + starts.size();
+        w.resize(w[h_words], 0);
+
+        // C array: rows starting with a smaller symbol
+        std::array<std::uint64_t, 5> freq{};
+        for (auto s : text)
+            ++freq[s];
+        for (std::size_t b = 0, acc = 0; b < 4; ++b)
+            w[h_c + b] = acc += freq[b];
+
+        std::array<std::uint32_t, 5> rank{};
+        std::uint64_t* sample = w.data() + w[h_sample_data];
+        const auto set_ranks = [&](std::uint64_t* k)
+        {   for (std::size_t f = 0; f < rank.size(); ++f)
+                _set_field(k, f, rank[f]);
+        };
+        for (std::size_t i = 0; i < n; ++i)
+        {   std::uint64_t* k = w.data() + w[h_blocks] + (i / 64) * block_words;
+            if (0 == i % 64)
+                set_ranks(k);
+            const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+            const auto s = sa[i] ? text[sa[i] - 1] : 0;
+            if (0 == s)
+                k[b_sep] |= bit;
+            else
+            {   const unsigned b = s - 1;
+                if (b & 1)
+                    k[b_lo] |= bit;
+                if (b & 2)
+                    k[b_hi] |= bit;
+                ++rank[b];
+            }
+            if (sampled(i))
+            {   k[b_mark] |= bit;
+                _set_field(sample, rank[4]++, static_cast<std::uint32_t>(sa[i]));
+            }
+        }
+        if (0 == n % 64)  // the block past the last row
+            set_ranks(w.data() + w[h_blocks] + (n / 64) * block_words);
+        std::copy(starts.begin(), starts.end(), w.data() + w[h_starts]);
+        _own = std::move(w);
+    }
+
+public:
+// -- constructors -------------------------------------------------------------
+    ///
+    /// Default constructor. Constructs an empty index.
+    fm_index() = default;
+    ///
+    /// @brief Builds the index of @a text: a single sequence (e.g. gynx::sq
+    /// or a view) or a range of them, one record each.
+    /// @param sample_rate Keeps one suffix array entry every @a sample_rate
+    /// text positions. Larger values save memory at the cost of slower
+    /// locate().
+    template<std::ranges::input_range R>
+    explicit fm_index(const R& text, std::size_t sample_rate = 32)
+    {   if constexpr (std::is_same_v<std::ranges::range_value_t<R>, char>)
+            _build(std::span<const R>(&text, 1), sample_rate);
+        else
+            _build(text, sample_rate);
+    }
+    ///
+    /// @brief Maps an index written by save(); nothing is read until
+    /// queried.
+    /// @details Where memory mapping is not available (no <sys/mman.h>), the
+    /// file is read into memory instead.
+    explicit fm_index(const std::filesystem::path& path)
+#if __has_include(<sys/mman.h>)
+    :   _mapped(path)
+    {   _check(_mapped.data(), _mapped.size(), path);
+        _mapped.advise(mmap_vector<std::uint64_t>::advice::random);
+    }
+#else
+    {   std::ifstream is(path, std::ios::binary | std::ios::ate);
+        const auto size = static_cast<std::size_t>(is ? std::streamoff(is.tellg()) : 0);
+        if (is && 0 == size % sizeof(std::uint64_t))
+        {   _own.resize(size / sizeof(std::uint64_t));
+            is.seekg(0);
+            is.read(reinterpret_cast<char*>(_own.data()), std::streamsize(size));
+            if (! is)
+                _own.clear();
+        }
+        _check(_own.data(), _own.size(), path);
+    }
+#endif
+
+// -- persistence --------------------------------------------------------------
+    ///
+    /// Writes the index to @a path.
+    void save(const std::filesystem::path& path) const
+    {   const std::uint64_t* w = _words();
+        std::ofstream os(path, std::ios::binary);
+        if (w)
+            os.write
+            (   reinterpret_cast<const char*>(w)
+            ,   std::streamsize(w[h_words] * sizeof(std::uint64_t))
+            );
+        if (! os)
+            throw std::runtime_error
+            (   "gynx::fm_index: could not write index file -> "
+            +   path.string()
+            );
+    }
+
+// -- observers ----------------------------------------------------------------
+    [[nodiscard]] bool empty() const noexcept
+    {   return 0 == records();
+    }
+    ///
+    /// Returns the number of indexed records.
+    std::size_t records() const noexcept
+    {   const std::uint64_t* w = _words();
+        return w ? w[h_records] : 0;
+    }
+    ///
+    /// Returns the length of record @a r.
+    std::size_t record_size(std::size_t r) const noexcept
+    {   const auto v = _view();
+        return v.starts[r + 1] - v.starts[r] - 1;
+    }
+    ///
+    /// Returns the sampling rate of the suffix array.
+    std::size_t sample_rate() const noexcept
+    {   const std::uint64_t* w = _words();
+        return w ? w[h_rate] : 0;
+    }
+    ///
+    /// Returns the size of the index in bytes (as in memory and on disk).
+    std::size_t bytes() const noexcept
+    {   const std::uint64_t* w = _words();
+        return w ? w[h_words] * sizeof(std::uint64_t) : 0;
+    }
+
+// -- queries ------------------------------------------------------------------
+    ///
+    /// Returns the number of occurrences of @a query. Queries with residues
+    /// other than A/C/G/T, and empty ones, occur nowhere.
+    template<typename Container>
+    std::size_t count(sq_view_gen<Container> query) const noexcept
+    {   if (empty())
+            return 0;
+        const auto [first, last] = _range(_view(), query);
+        return last - first;
+    }
+    ///
+    /// Returns whether @a query occurs at all.
+    template<typename Container>
+    bool contains(sq_view_gen<Container> query) const noexcept
+    {   return count(query) > 0;
+    }
+    ///
+    /// Returns all occurrences of @a query, in no particular order.
+    template<typename Container>
+    std::vector<fm_hit> locate(sq_view_gen<Container> query) const
+    {   if (empty())
+            return {};
+        const auto v = _view();
+        const auto [first, last] = _range(v, query);
+        std::vector<fm_hit> hits;
+        hits.reserve(last - first);
+        const std::size_t records = v.w[h_records];
+        for (std::size_t i = first; i < last; ++i)
+        {   const std::size_t pos = v.position(i);
+            const std::size_t r = static_cast<std::size_t>
+            (   std::upper_bound(v.starts, v.starts + records + 1, pos)
+            -   v.starts
+            ) - 1;
+            hits.push_back({ r, pos - v.starts[r] });
+        }
+        return hits;
+    }
+
+    /// @brief Returns count() of every sequence in @a queries (sequences or
+    /// views), in parallel on @a pool.
+    template<std::ranges::random_access_range R>
+    std::vector<std::size_t> count_each
+    (   const R& queries
+    ,   thread_pool& pool = thread_pool::global()
+    )   const
+    {   std::vector<std::size_t> out(std::ranges::size(queries));
+        if (empty())
+            return out;
+        const auto v = _view();
+        constexpr std::size_t chunk = 1024;
+        parallel_for
+        (   pool
+        ,   (out.size() + chunk - 1) / chunk
+        ,   [&](std::size_t t)
+            {   const std::size_t end = std::min(out.size(), (t + 1) * chunk);
+                for (std::size_t i = t * chunk; i < end; i += group)
+                {   std::array<std::pair<const char*, std::size_t>, group> g;
+                    const std::size_t k = std::min(group, end - i);
+                    for (std::size_t j = 0; j < k; ++j)
+                    {   const auto& q = queries[i + j];
+                        g[j] = { std::ranges::data(q), std::ranges::size(q) };
+                    }
+                    _count_group(v, g.data(), k, out.data() + i);
+                }
+            }
+        );
+        return out;
+    }
+
+    /// @brief Returns locate() of every sequence in @a queries (sequences
+    /// or views), in parallel on @a pool.
+    template<std::ranges::random_access_range R>
+    std::vector<std::vector<fm_hit>> locate_each
+    (   const R& queries
+    ,   thread_pool& pool = thread_pool::global()
+    )   const
+    {   std::vector<std::vector<fm_hit>> out(std::ranges::size(queries));
+        constexpr std::size_t chunk = 256;
+        parallel_for
+        (   pool
+        ,   (out.size() + chunk - 1) / chunk
+        ,   [&](std::size_t t)
+            {   const std::size_t end = std::min(out.size(), (t + 1) * chunk);
+                for (std::size_t i = t * chunk; i < end; ++i)
+                {   const auto& q = queries[i];
+                    out[i] = locate
+                    (   sq_view_gen<std::vector<char>>
+                        (std::ranges::data(q), std::ranges::size(q))
+                    );
+                }
+            }
+        );
+        return out;
+    }
+};
+
+}   // end gynx namespace
+
+#endif  // _GYNX_FM_INDEX_HPP_
@@ -0,0 +1,564 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_HAMMING_HPP_
+#define _GYNX_HAMMING_HPP_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <gynx/sq_view.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/lut/nucleotide.hpp>
+
+namespace gynx {
+
+namespace detail {
+
+// All raw kernels call f(offset, mask) for each block of up to 64 positions
+// starting at offset, with bit i of mask set where a[offset + i] and
+// b[offset + i] differ, and stop early once f returns false.
+
+// -- scalar kernel ------------------------------------------------------------
+
+template<typename F>
+inline void mismatch_blocks_scalar
+(   const char* a
+,   const char* b
+,   std::size_t n
+,   std::size_t offset
+,   F& f
+)
+{   for (; offset < n; offset += 64)
+    {   const std::size_t len = std::min<std::size_t>(64, n - offset);
+        std::uint64_t m = 0;
+        for (std::size_t i = 0; i < len; ++i)
+            m |= std::uint64_t(a[offset + i] != b[offset + i]) << i;
+        if (m && ! f(offset, m))
+            return;
+    }
+}
+
+#if GYNX_SIMD_X86
+
+// -- SSE4.2 -------------------------------------------------------------------
+
+template<typename F>
+GYNX_TARGET_SSE42
+inline void mismatch_blocks_sse42
+(   const char* a
+,   const char* b
+,   std::size_t n
+,   std::size_t offset
+,   F& f
+)
+{   for (; n - offset >= 64; offset += 64)
+    {   std::uint64_t m = 0;
+        for (int j = 0; j < 4; ++j)
+        {   const __m128i x = _mm_loadu_si128
+                (reinterpret_cast<const __m128i*>(a + offset + 16 * j));
+            const __m128i y = _mm_loadu_si128
+                (reinterpret_cast<const __m128i*>(b + offset + 16 * j));
+            m |= std::uint64_t(std::uint16_t(~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))))
+                << (16 * j);
+        }
+        if (m && ! f(offset, m))
+            return;
+    }
+    mismatch_blocks_scalar(a, b, n, offset, f);
+}
+
+// -- AVX2 ---------------------------------------------------------------------
+
+template<typename F>
+GYNX_TARGET_AVX2
+inline void mismatch_blocks_avx2
+(   const char* a
+,   const char* b
+,   std::size_t n
+,   std::size_t offset
+,   F& f
+)
+{   for (; n - offset >= 64; offset += 64)
+    {   const __m256i x0 = _mm256_loadu_si256
+            (reinterpret_cast<const __m256i*>(a + offset));
+        const __m256i y0 = _mm256_loadu_si256
+            (reinterpret_cast<const __m256i*>(b + offset));
+        const __m256i x1 = _mm256_loadu_si256
+            (reinterpret_cast<const __m256i*>(a + offset + 32));
+        const __m256i y1 = _mm256_loadu_si256
+            (reinterpret_cast<const __m256i*>(b + offset + 32));
+        const std::uint64_t m
+            = std::uint64_t(std::uint32_t(~_mm256_movemask_epi8(_mm256_cmpeq_epi8(x0, y0))))
+            | std::uint64_t(std::uint32_t(~_mm256_movemask_epi8(_mm256_cmpeq_epi8(x1, y1)))) << 32;
+        if (m && ! f(offset, m))
+            return;
+    }
+    mismatch_blocks_scalar(a, b, n, offset, f);
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+template<typename F>
+GYNX_TARGET_AVX512
+inline void mismatch_blocks_avx512
+(   const char* a
+,   const char* b
+,   std::size_t n
+,   std::size_t offset
+,   F& f
+)
+{   for (; offset < n; offset += 64)
+    {   // masked loads cover the tail without reading past the end
+        const __mmask64 live = n - offset >= 64
+        ?   ~__mmask64(0)
+        :   (__mmask64(1) << (n - offset)) - 1;
+        const std::uint64_t m = _mm512_mask_cmpneq_epi8_mask
+        (   live
+        ,   _mm512_maskz_loadu_epi8(live, a + offset)
+        ,   _mm512_maskz_loadu_epi8(live, b + offset)
+        );
+        if (m && ! f(offset, m))
+            return;
+    }
+}
+
+#endif  // GYNX_SIMD_X86
+
+template<typename F>
+inline void mismatch_blocks(const char* a, const char* b, std::size_t n, F f)
+{   switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return mismatch_blocks_avx512(a, b, n, 0, f);
+        case simd::isa::avx2:
+            return mismatch_blocks_avx2(a, b, n, 0, f);
+        case simd::isa::sse42:
+            return mismatch_blocks_sse42(a, b, n, 0, f);
+#endif
+        default:
+            return mismatch_blocks_scalar(a, b, n, 0, f);
+    }
+}
+
+template<typename Container1, typename Container2>
+void check_lengths(const sq_view_gen<Container1>& a, const sq_view_gen<Container2>& b)
+{   if (a.size() != b.size())
+        throw std::invalid_argument("gynx::hamming: sequences differ in length");
+}
+
+}   // end gynx::detail namespace
+
+// -- raw residues -------------------------------------------------------------
+///
+/// @brief Returns the number of positions at which @a a and @a b differ.
+/// @details Residues are compared as bytes, like operator==. Dispatches at
+/// runtime to AVX-512, AVX2 or SSE4.2 compare and popcount kernels (see
+/// gynx::simd::level()). Throws std::invalid_argument if the lengths differ.
+template<typename Container1, typename Container2>
+requires std::is_same_v<typename Container1::value_type, char>
+&&  std::is_same_v<typename Container2::value_type, char>
+std::size_t hamming(sq_view_gen<Container1> a, sq_view_gen<Container2> b)
+{   detail::check_lengths(a, b);
+    std::size_t d = 0;
+    detail::mismatch_blocks
+    (   a.data()
+    ,   b.data()
+    ,   a.size()
+    ,   [&](std::size_t, std::uint64_t m)
+        {   d += std::popcount(m);
+            return true;
+        }
+    );
+    return d;
+}
+///
+/// @brief Returns whether @a a and @a b differ in at most @a k positions,
+/// stopping at the first block past @a k mismatches.
+template<typename Container1, typename Container2>
+requires std::is_same_v<typename Container1::value_type, char>
+&&  std::is_same_v<typename Container2::value_type, char>
+bool hamming_le(sq_view_gen<Container1> a, sq_view_gen<Container2> b, std::size_t k)
+{   detail::check_lengths(a, b);
+    std::size_t d = 0;
+    detail::mismatch_blocks
+    (   a.data()
+    ,   b.data()
+    ,   a.size()
+    ,   [&](std::size_t, std::uint64_t m)
+        {   d += std::popcount(m);
+            return d <= k;
+        }
+    );
+    return d <= k;
+}
+///
+/// @brief Returns the positions at which @a a and @a b differ, in order.
+template<typename Container1, typename Container2>
+requires std::is_same_v<typename Container1::value_type, char>
+&&  std::is_same_v<typename Container2::value_type, char>
+std::vector<std::size_t> mismatch_positions
+(   sq_view_gen<Container1> a
+,   sq_view_gen<Container2> b
+)
+{   detail::check_lengths(a, b);
+    std::vector<std::size_t> r;
+    detail::mismatch_blocks
+    (   a.data()
+    ,   b.data()
+    ,   a.size()
+    ,   [&](std::size_t offset, std::uint64_t m)
+        {   for (; m; m &= m - 1)
+                r.push_back(offset + std::countr_zero(m));
+            return true;
+        }
+    );
+    return r;
+}
+
+// -- 2-bit packed -------------------------------------------------------------
+///
+/// @brief Returns the number of bases at which two 2-bit packed words (e.g.
+/// k-mer encodings from gynx::views::kmers) differ.
+constexpr std::size_t hamming_2bit(std::uint64_t a, std::uint64_t b) noexcept
+{   const std::uint64_t x = a ^ b;
+    return std::popcount((x | x >> 1) & 0x5555555555555555ull);
+}
+
+// -- barcode whitelist --------------------------------------------------------
+
+/// @brief The closest whitelist entry to a query, see
+/// barcode_whitelist::nearest().
+struct barcode_match
+{   std::size_t index;     ///< position in the whitelist
+    std::size_t distance;  ///< Hamming distance to the query
+    bool unique;           ///< no other entry is as close
+
+    friend bool operator== (const barcode_match&, const barcode_match&) = default;
+};
+
+namespace detail {
+
+// 2-bit code of a barcode (A 0, C 1, G 2, T 3) and a mask with the low bit
+// of every base that is not A/C/G/T, which then always counts as a mismatch
+struct packed_barcode
+{   std::uint64_t code = 0;
+    std::uint64_t unknown = 0;
+};
+
+inline packed_barcode pack_barcode(const char* s, std::size_t n) noexcept
+{   packed_barcode p;
+    for (std::size_t i = 0; i < n; ++i)
+    {   const auto c = lut::nt_class[static_cast<std::uint8_t>(s[i])];
+        p.code = p.code << 2 | (c < 4 ? c : 0);
+        p.unknown = p.unknown << 2 | (c < 4 ? 0 : 1);
+    }
+    return p;
+}
+
+// -- scalar kernel ------------------------------------------------------------
+
+inline void barcode_distances_scalar
+(   const std::uint64_t* codes
+,   std::size_t n
+,   packed_barcode q
+,   std::uint8_t* out
+)   noexcept
+{   for (std::size_t i = 0; i < n; ++i)
+    {   const std::uint64_t x = codes[i] ^ q.code;
+        out[i] = static_cast<std::uint8_t>(std::popcount
+            (((x | x >> 1) & 0x5555555555555555ull) | q.unknown));
+    }
+}
+
+#if GYNX_SIMD_X86
+
+// -- AVX2 ---------------------------------------------------------------------
+
+// Lane popcounts use a nibble lookup with pshufb summed by psadbw, as the
+// vpopcntq instruction is not part of the targeted AVX-512 subset either.
+GYNX_TARGET_AVX2
+inline __m256i barcode_distance_avx2
+(   __m256i codes
+,   __m256i code
+,   __m256i unknown
+)   noexcept
+{   const __m256i nibbles = _mm256_setr_epi8
+    (   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    ,   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    const __m256i x = _mm256_xor_si256(codes, code);
+    const __m256i m = _mm256_or_si256
+    (   _mm256_and_si256
+        (   _mm256_or_si256(x, _mm256_srli_epi64(x, 1))
+        ,   _mm256_set1_epi64x(0x5555555555555555ll)
+        )
+    ,   unknown
+    );
+    const __m256i c = _mm256_add_epi8
+    (   _mm256_shuffle_epi8(nibbles, _mm256_and_si256(m, low))
+    ,   _mm256_shuffle_epi8(nibbles, _mm256_and_si256(_mm256_srli_epi16(m, 4), low))
+    );
+    return _mm256_sad_epu8(c, _mm256_setzero_si256());
+}
+
+GYNX_TARGET_AVX2
+inline void barcode_distances_avx2
+(   const std::uint64_t* codes
+,   std::size_t n
+,   packed_barcode q
+,   std::uint8_t* out
+)   noexcept
+{   const __m256i code = _mm256_set1_epi64x(static_cast<long long>(q.code));
+    const __m256i unknown = _mm256_set1_epi64x(static_cast<long long>(q.unknown));
+    // bytes 0, 8, 1, 9, .. of each 128-bit lane after merging four registers
+    const __m256i gather = _mm256_setr_epi8
+    (   0, 8, 1, 9, 2, 10, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1
+    ,   0, 8, 1, 9, 2, 10, 3, 11, -1, -1, -1, -1, -1, -1, -1, -1
+    );
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {   // distances fit a byte, so register j goes to byte j of each lane
+        __m256i d = _mm256_setzero_si256();
+        for (int j = 0; j < 4; ++j)
+            d = _mm256_or_si256(d, _mm256_slli_epi64(barcode_distance_avx2
+            (   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 4 * j))
+            ,   code
+            ,   unknown
+            ), 8 * j));
+        d = _mm256_shuffle_epi8(d, gather);
+        _mm_storeu_si128
+        (   reinterpret_cast<__m128i*>(out + i)
+        ,   _mm_unpacklo_epi16
+            (   _mm256_castsi256_si128(d)
+            ,   _mm256_extracti128_si256(d, 1)
+            )
+        );
+    }
+    barcode_distances_scalar(codes + i, n - i, q, out + i);
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+GYNX_TARGET_AVX512
+inline void barcode_distances_avx512
+(   const std::uint64_t* codes
+,   std::size_t n
+,   packed_barcode q
+,   std::uint8_t* out
+)   noexcept
+{   const __m512i nibbles = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_setr_epi8
+        (0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i low = _mm512_set1_epi8(0x0F);
+    const __m512i odd = _mm512_set1_epi64(0x5555555555555555ll);
+    const __m512i code = _mm512_set1_epi64(static_cast<long long>(q.code));
+    const __m512i unknown = _mm512_set1_epi64(static_cast<long long>(q.unknown));
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {   const __m512i x = _mm512_xor_si512(code, _mm512_loadu_si512(codes + i));
+        // (x | x >> 1) & odd | unknown
+        const __m512i m = _mm512_ternarylogic_epi64
+            (_mm512_or_si512(x, _mm512_maskz_srli_epi64(0xFF, x, 1)), odd, unknown, 0xEA);
+        const __m512i c = _mm512_add_epi8
+        (   _mm512_shuffle_epi8(nibbles, _mm512_and_si512(m, low))
+        ,   _mm512_shuffle_epi8(nibbles, _mm512_and_si512(_mm512_srli_epi16(m, 4), low))
+        );
+        _mm_storel_epi64
+        (   reinterpret_cast<__m128i*>(out + i)
+        ,   _mm512_maskz_cvtepi64_epi8(0xFF, _mm512_sad_epu8(c, _mm512_setzero_si512()))
+        );
+    }
+    barcode_distances_scalar(codes + i, n - i, q, out + i);
+}
+
+#endif  // GYNX_SIMD_X86
+
+inline void barcode_distances
+(   const std::uint64_t* codes
+,   std::size_t n
+,   packed_barcode q
+,   std::uint8_t* out
+)   noexcept
+{   switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return barcode_distances_avx512(codes, n, q, out);
+        case simd::isa::avx2:
+            return barcode_distances_avx2(codes, n, q, out);
+#endif
+        default:
+            return barcode_distances_scalar(codes, n, q, out);
+    }
+}
+
+}   // end gynx::detail namespace
+
+/// @brief A whitelist of equal-length barcodes (at most 32 bp) packed two
+/// bits per base for one-vs-many Hamming searches.
+/// @details Each query is compared against the whole whitelist in blocks
+/// that stay in L1, using XOR and popcount over the packed codes (AVX-512
+/// or AVX2 when available), which streams the 8 bytes per entry at memory
+/// speed. Bases other than A/C/G/T (e.g. N) in a query always count as a
+/// mismatch; the whitelist itself must be A/C/G/T only.
+class barcode_whitelist
+{   std::vector<std::uint64_t> _codes;
+    std::size_t _length = 0;
+
+    static constexpr std::size_t _block = 2048;
+
+    template<typename Q>
+    detail::packed_barcode _pack(const Q& q) const
+    {   if (std::ranges::size(q) != _length)
+            throw std::invalid_argument
+                ("gynx::barcode_whitelist: query length differs from barcodes");
+        return detail::pack_barcode(std::ranges::data(q), _length);
+    }
+
+    // calls f(index, distance) for every entry, block by block
+    template<typename F>
+    void _scan(detail::packed_barcode q, F f) const
+    {   std::array<std::uint8_t, _block> d;
+        for (std::size_t b = 0; b < _codes.size(); b += _block)
+        {   const std::size_t n = std::min(_block, _codes.size() - b);
+            detail::barcode_distances(_codes.data() + b, n, q, d.data());
+            for (std::size_t i = 0; i < n; ++i)
+                f(b + i, d[i]);
+        }
+    }
+
+public:
+    /// @brief Packs @a barcodes (sequences, views or strings). Throws
+    /// std::invalid_argument unless all are the same length of 1 to 32 bp
+    /// and contain only A/C/G/T (any case).
+    template<std::ranges::input_range R>
+    explicit barcode_whitelist(const R& barcodes)
+    {   for (const auto& b : barcodes)
+        {   const std::size_t n = std::ranges::size(b);
+            if (_codes.empty())
+            {   if (0 == n || n > 32)
+                    throw std::invalid_argument
+                        ("gynx::barcode_whitelist: barcode length must be 1 to 32");
+                _length = n;
+            }
+            else if (n != _length)
+                throw std::invalid_argument
+                    ("gynx::barcode_whitelist: barcodes differ in length");
+            const auto p = detail::pack_barcode(std::ranges::data(b), n);
+            if (p.unknown)
+                throw std::invalid_argument
+                    ("gynx::barcode_whitelist: barcode is not A/C/G/T only");
+            _codes.push_back(p.code);
+        }
+    }
+
+    /// @brief Returns the number of barcodes.
+    std::size_t size() const noexcept
+    {   return _codes.size();
+    }
+
+    /// @brief Returns true if there are no barcodes.
+    bool empty() const noexcept
+    {   return _codes.empty();
+    }
+
+    /// @brief Returns the length of the barcodes (0 when empty).
+    std::size_t length() const noexcept
+    {   return _length;
+    }
+
+    /// @brief Returns the 2-bit packed code of barcode @a i.
+    std::uint64_t code(std::size_t i) const noexcept
+    {   return _codes[i];
+    }
+
+    /// @brief Returns the Hamming distance of @a q to every barcode.
+    template<std::ranges::contiguous_range Q>
+    std::vector<std::uint8_t> distances(const Q& q) const
+    {   std::vector<std::uint8_t> out(_codes.size());
+        detail::barcode_distances(_codes.data(), _codes.size(), _pack(q), out.data());
+        return out;
+    }
+
+    /// @brief Returns the indices of the barcodes at most @a k mismatches
+    /// away from @a q, in whitelist order.
+    template<std::ranges::contiguous_range Q>
+    std::vector<std::size_t> within(const Q& q, std::size_t k) const
+    {   std::vector<std::size_t> out;
+        _scan(_pack(q), [&](std::size_t i, std::size_t d)
+        {   if (d <= k)
+                out.push_back(i);
+        });
+        return out;
+    }
+
+    /// @brief Returns the barcode closest to @a q (the first one on ties,
+    /// with unique set to false). Throws std::out_of_range when empty.
+    template<std::ranges::contiguous_range Q>
+    barcode_match nearest(const Q& q) const
+    {   if (_codes.empty())
+            throw std::out_of_range("gynx::barcode_whitelist: empty whitelist");
+        barcode_match best{ 0, std::numeric_limits<std::size_t>::max(), false };
+        _scan(_pack(q), [&](std::size_t i, std::size_t d)
+        {   if (d < best.distance)
+                best = { i, d, true };
+            else if (d == best.distance)
+                best.unique = false;
+        });
+        return best;
+    }
+
+    /// @brief Returns nearest() of every sequence in @a queries (sequences
+    /// or views), in parallel on @a pool.
+    template<std::ranges::random_access_range R>
+    std::vector<barcode_match> nearest_each
+    (   const R& queries
+    ,   thread_pool& pool = thread_pool::global()
+    )   const
+    {   std::vector<barcode_match> out(std::ranges::size(queries));
+        constexpr std::size_t chunk = 64;
+        parallel_for
+        (   pool
+        ,   (out.size() + chunk - 1) / chunk
+        ,   [&](std::size_t t)
+            {   const std::size_t end = std::min(out.size(), (t + 1) * chunk);
+                for (std::size_t i = t * chunk; i < end; ++i)
+                    out[i] = nearest(queries[i]);
+            }
+        );
+        return out;
+    }
+};
+
+}   // end gynx namespace
+
+#endif  // _GYNX_HAMMING_HPP_
@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_HOMOPOLYMER_HPP_
+#define _GYNX_HOMOPOLYMER_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/hamming.hpp>
+
+namespace gynx {
+
+// -- homopolymer runs ---------------------------------------------------------
+
+/// @brief A maximal run of identical residues, i.e. one residue of the
+/// homopolymer-compressed sequence.
+struct homopolymer
+{   std::size_t pos;    ///< start of the run in the underlying sequence
+    char        base;   ///< the repeated residue
+    std::size_t length; ///< number of repeats (>= 1)
+
+    friend constexpr bool operator== (const homopolymer&, const homopolymer&)
+        = default;
+};
+
+// -- homopolymer_view ---------------------------------------------------------
+
+/// @brief A view of the homopolymer runs of a character range, yielding
+/// (base, run-length) pairs without allocating.
+/// @details Residues are compared as bytes, so soft-masked runs (e.g. "aA")
+/// are split; uppercase the sequence first to merge them.
+/// @tparam V The underlying view of characters.
+template<std::ranges::view V>
+requires std::ranges::forward_range<V>
+class homopolymer_view
+:   public std::ranges::view_interface<homopolymer_view<V>>
+{   V _base = V();
+
+public:
+    using value_type = homopolymer;
+
+    class iterator
+    {   using base_iterator = std::ranges::iterator_t<const V>;
+        using base_sentinel = std::ranges::sentinel_t<const V>;
+
+        base_iterator _it{};    // first residue past the current run
+        base_sentinel _end{};
+        homopolymer   _run{};
+        bool          _done = true;
+
+        // scans the run starting at _it
+        constexpr void _next()
+        {   if (_it == _end)
+            {   _done = true;
+                return;
+            }
+            _run.pos += _run.length;
+            _run.base = static_cast<char>(*_it);
+            _run.length = 0;
+            do
+            {   ++_it;
+                ++_run.length;
+            }   while (_it != _end && static_cast<char>(*_it) == _run.base);
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = homopolymer;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr iterator() = default;
+        constexpr iterator(const homopolymer_view& parent)
+        :   _it(std::ranges::begin(parent._base))
+        ,   _end(std::ranges::end(parent._base))
+        ,   _done(false)
+        {   _next();
+        }
+
+        constexpr value_type operator* () const noexcept
+        {   return _run;
+        }
+        constexpr iterator& operator++ ()
+        {   _next();
+            return *this;
+        }
+        constexpr iterator operator++ (int)
+        {   iterator tmp = *this;
+            _next();
+            return tmp;
+        }
+        friend constexpr bool operator== (const iterator& a, const iterator& b)
+        {   return a._done == b._done && (a._done || a._run.pos == b._run.pos);
+        }
+        friend constexpr bool operator==
+        (   const iterator& a
+        ,   std::default_sentinel_t
+        )
+        {   return a._done;
+        }
+    };
+
+// -- constructors -------------------------------------------------------------
+    constexpr homopolymer_view() requires std::default_initializable<V>
+        = default;
+
+    constexpr explicit homopolymer_view(V base)
+    :   _base(std::move(base))
+    {}
+
+// -- iterators ----------------------------------------------------------------
+    constexpr iterator begin() const
+    {   return iterator(*this);
+    }
+    constexpr std::default_sentinel_t end() const noexcept
+    {   return std::default_sentinel;
+    }
+
+// -- observers ----------------------------------------------------------------
+    constexpr V base() const
+    {   return _base;
+    }
+};
+
+// -- range adaptors -----------------------------------------------------------
+
+namespace views {
+
+namespace detail {
+
+struct homopolymers_closure
+{   template<std::ranges::viewable_range R>
+    constexpr auto operator() (R&& r) const
+    {   using V = std::views::all_t<R>;
+        return homopolymer_view<V>(std::views::all(std::forward<R>(r)));
+    }
+    template<std::ranges::viewable_range R>
+    friend constexpr auto operator| (R&& r, const homopolymers_closure& c)
+    {   return c(std::forward<R>(r));
+    }
+};
+
+}   // end gynx::views::detail namespace
+
+///
+/// @brief Range adaptor producing the homopolymer runs of a sequence, e.g.
+/// <tt>seq | gynx::views::homopolymers()</tt>.
+constexpr detail::homopolymers_closure homopolymers() noexcept
+{   return {};
+}
+
+}   // end gynx::views namespace
+
+// -- homopolymer compression --------------------------------------------------
+
+namespace detail {
+
+/// @brief Writes the first residue of every homopolymer run of @a s[0, n)
+/// to @a out and its position to @a pos, returning the number of runs.
+/// @details Run boundaries are found 64 residues at a time by comparing
+/// @a s with itself shifted by one, so long homopolymers cost a single
+/// compare per block. Dense blocks are compacted without branches, which
+/// is safe as the output never overtakes the input.
+inline std::size_t compress_runs
+(   const char* s
+,   std::size_t n
+,   char* out
+,   std::size_t* pos
+)
+{   if (0 == n)
+        return 0;
+    out[0] = s[0];
+    pos[0] = 0;
+    std::size_t k = 1;
+    mismatch_blocks
+    (   s + 1
+    ,   s
+    ,   n - 1
+    ,   [&](std::size_t offset, std::uint64_t m)
+        {   const std::size_t len = std::min<std::size_t>(64, n - 1 - offset);
+            if (std::popcount(m) > 8)
+                for (std::size_t i = 0; i < len; ++i)
+                {   const std::size_t j = offset + i + 1;
+                    out[k] = s[j];
+                    pos[k] = j;
+                    k += (m >> i) & 1;
+                }
+            else
+                for (; m; m &= m - 1)
+                {   const std::size_t j = offset + std::countr_zero(m) + 1;
+                    out[k] = s[j];
+                    pos[k++] = j;
+                }
+            return true;
+        }
+    );
+    return k;
+}
+
+}   // end gynx::detail namespace
+
+/// @brief A homopolymer-compressed sequence together with the coordinate
+/// map back to the original sequence.
+template<typename Container = std::string>
+struct hpc_gen
+{   sq_gen<Container>        seq;     ///< one residue per homopolymer run
+    std::vector<std::size_t> offsets; ///< run starts, plus the original length
+
+    ///
+    /// Returns the original position of compressed residue @a i.
+    std::size_t original(std::size_t i) const noexcept
+    {   return offsets[i];
+    }
+    ///
+    /// Returns the run length of compressed residue @a i.
+    std::size_t run_length(std::size_t i) const noexcept
+    {   return offsets[i + 1] - offsets[i];
+    }
+    ///
+    /// Returns the length of the original sequence.
+    std::size_t original_size() const noexcept
+    {   return offsets.back();
+    }
+};
+
+/// @brief Returns the homopolymer compression of @a s and the coordinate
+/// map back to it.
+/// @details @c offsets holds the start of every run in @a s followed by
+/// @c s.size(), so run lengths are differences of neighbours. Run
+/// boundaries are detected with the SIMD kernels of gynx::hamming()
+/// (dispatched at runtime, see gynx::simd::level()).
+template<typename Container>
+requires std::is_same_v<typename Container::value_type, char>
+hpc_gen<Container> hpc(sq_view_gen<Container> s)
+{   hpc_gen<Container> r;
+    r.seq.resize(s.size(), 'N');
+    r.offsets.resize(s.size() + 1);
+    const std::size_t m = detail::compress_runs
+        (s.data(), s.size(), r.seq.data(), r.offsets.data());
+    r.seq.resize(m, 'N');
+    r.offsets[m] = s.size();
+    r.offsets.resize(m + 1);
+    return r;
+}
+///
+/// @brief Returns the homopolymer compression of @a s and the coordinate
+/// map back to it.
+template<typename Container, typename Map>
+hpc_gen<Container> hpc(const sq_gen<Container, Map>& s)
+{   return hpc(s(0));
+}
+
+}   // end gynx namespace
+
+template<std::ranges::view V>
+inline constexpr bool
+    std::ranges::enable_borrowed_range<gynx::homopolymer_view<V>>
+    = std::ranges::enable_borrowed_range<V>;
+
+#endif  // _GYNX_HOMOPOLYMER_HPP_
@@ -22,12 +22,16 @@
 #ifndef _GYNX_IO_FASTAQZ_HPP_
 #define _GYNX_IO_FASTAQZ_HPP_
 
+#include <concepts>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <stdexcept>
 
 #include <zlib.h>
 #include <gynx/io/kseq.h>
+#include <gynx/normalize.hpp>
+#include <gynx/phred.hpp>
 
 namespace gynx {
 
@@ -36,73 +40,140 @@ namespace in {
 
 KSEQ_INIT(gzFile, gzread)
 
+namespace detail {
+
+// opens @a filename ("-" for the standard input) for kseq_read(); the
+// kseq_t and its file are released even if a caller throws. @a who names
+// the caller in the error message.
+inline auto open_kseq(std::string_view filename, std::string_view who)
+{   gzFile fp = filename == "-"
+    ?   gzdopen(fileno(stdin), "r")
+    :   gzopen(std::string(filename).c_str(), "r");
+    if (nullptr == fp)
+        throw std::runtime_error
+        (   "gynx::" + std::string(who) + ": could not open file -> "
+        +   std::string(filename)
+        );
+    return std::unique_ptr<kseq_t, void(*)(kseq_t*)>
+    (   kseq_init(fp)
+    ,   [](kseq_t* ks)
+        {   gzFile fp = ks->f->f;
+            kseq_destroy(ks);
+            gzclose(fp);
+        }
+    );
+}
+
+}   // end gynx::in::detail namespace
+
 /// @brief A function object for reading FASTA/FASTQ files (possibly compressed
 /// with gzip) and returning a @a Sequence type.
+/// @details Residues can be normalized (validated, uppercased, ...) in the
+/// same pass that copies them out of the read buffer; see
+/// gynx::normalization. Quality strings can likewise be converted to
+/// Phred+33, so that downstream code needs a single table whatever the
+/// file's encoding; see gynx::in::detect_phred().
 /// @tparam Sequence
 template <class Sequence>
 struct fast_aqz
-{   Sequence operator() (std::string_view filename, size_t ndx)
-    {   gzFile fp = filename == "-"
-        ?   gzdopen(fileno(stdin), "r")
-        :   gzopen(std::string(filename).c_str(), "r");
-        if (nullptr == fp)
-            throw std::runtime_error
-                ("gynx::fast_aqz: could not open file -> " + std::string(filename));
-        kseq_t* seq = kseq_init(fp);
+{   ///
+    /// @brief Constructs a reader that normalizes residues to alphabet @a a
+    /// with policy @a p. By default residues are kept as read. A record with
+    /// residues outside the alphabet throws std::runtime_error, unless @a p
+    /// is normalization::replace. Quality strings in encoding @a q are
+    /// converted to Phred+33; phred_encoding::unknown keeps them as read.
+    fast_aqz
+    (   alphabet a = alphabet::iupac
+    ,   normalization p = normalization::none
+    ,   phred_encoding q = phred_encoding::unknown
+    )
+    :   _alphabet(a)
+    ,   _policy(p)
+    ,   _quality(q)
+    {}
+
+    Sequence operator() (std::string_view filename, size_t ndx)
+    {   auto seq = _open(filename);
         size_t count = 0;
         int r{};
-        while ((r = kseq_read(seq)) >= 0)
+        while ((r = kseq_read(seq.get())) >= 0)
             if (ndx == count++)
                 break;
-        Sequence s = (r > 0) ? Sequence(seq->seq.s) : Sequence();
-        if (r > 0)
-        {   s["_id"] = std::string(seq->name.s);
-            if (seq->qual.l)
-                s["_qs"] = std::string(seq->qual.s);
-            if (seq->comment.l)
-                s["_desc"] = std::string(seq->comment.s);
-        }
-        kseq_destroy(seq);
-        gzclose(fp);
-        if (-2 == r)
-            throw std::runtime_error
-            (   "gynx::fast_aqz: truncated quality string in file -> "
-            +   std::string(filename)
-            );
-        if (-3 == r)
-            throw std::runtime_error
-            (   "gynx::fast_aqz: error reading file -> "
-            +   std::string(filename)
-            ); 
-        return s;
+        _check(r, filename);
+        return (r > 0) ? _record(seq.get()) : Sequence();
     }
     Sequence operator() (std::string_view filename, std::string_view id)
-    {   gzFile fp = filename == "-"
-        ?   gzdopen(fileno(stdin), "r")
-        :   gzopen(std::string(filename).c_str(), "r");
-        if (nullptr == fp)
-            throw std::runtime_error
-            (   "gynx::fast_aqz: could not open file -> "
-            +   std::string(filename)
-            );
-        kseq_t* seq = kseq_init(fp);
+    {   auto seq = _open(filename);
         int r{};
-        while ((r = kseq_read(seq)) >= 0)
+        while ((r = kseq_read(seq.get())) >= 0)
         {   std::string_view name(seq->name.s);
             if (name == id)
                 break;
         }
-        Sequence s = (r > 0) ? Sequence(seq->seq.s) : Sequence();
-        if (r > 0)
-        {   s["_id"] = std::string(seq->name.s);
-            if (seq->qual.l)
-                s["_qs"] = std::string(seq->qual.s);
-            if (seq->comment.l)
-                s["_desc"] = std::string(seq->comment.s);
+        _check(r, filename);
+        return (r > 0) ? _record(seq.get()) : Sequence();
+    }
+    ///
+    /// Calls @a f with every record in @a filename, in file order, and
+    /// returns the number of records read.
+    template<typename F>
+    requires std::invocable<F&, Sequence&&>
+    std::size_t operator() (std::string_view filename, F f)
+    {   auto seq = _open(filename);
+        std::size_t count = 0;
+        int r{};
+        while ((r = kseq_read(seq.get())) >= 0)
+        {   f(_record(seq.get()));
+            ++count;
         }
-        kseq_destroy(seq);
-        gzclose(fp);
-        if (-2 == r)
+        _check(r, filename);
+        return count;
+    }
+    ///
+    /// @brief Calls @a f with the records of @a filename1 and @a filename2
+    /// pairwise (e.g. the two reads of paired-end runs), in file order, and
+    /// returns the number of pairs read. Throws std::runtime_error if one
+    /// file has more records than the other.
+    template<typename F>
+    requires std::invocable<F&, Sequence&&, Sequence&&>
+    std::size_t operator()
+    (   std::string_view filename1
+    ,   std::string_view filename2
+    ,   F f
+    )
+    {   auto seq1 = _open(filename1);
+        auto seq2 = _open(filename2);
+        std::size_t count = 0;
+        int r1{}, r2{};
+        while
+        (   (r1 = kseq_read(seq1.get())) >= 0
+        &&  (r2 = kseq_read(seq2.get())) >= 0
+        )
+        {   f(_record(seq1.get()), _record(seq2.get()));
+            ++count;
+        }
+        if (r1 < 0)                 // the first file ended, try the second
+            r2 = kseq_read(seq2.get());
+        _check(r1, filename1);
+        _check(r2, filename2);
+        if (r1 >= 0 || r2 >= 0)
+            throw std::runtime_error
+            (   "gynx::fast_aqz: unpaired records in file -> "
+            +   std::string(r1 >= 0 ? filename1 : filename2)
+            );
+        return count;
+    }
+
+private:
+    alphabet _alphabet;
+    normalization _policy;
+    phred_encoding _quality;
+
+    static auto _open(std::string_view filename)
+    {   return detail::open_kseq(filename, "fast_aqz");
+    }
+    static void _check(int r, std::string_view filename)
+    {   if (-2 == r)
             throw std::runtime_error
             (   "gynx::fast_aqz: truncated quality string in file -> "
             +   std::string(filename)
@@ -112,10 +183,57 @@ struct fast_aqz
             (   "gynx::fast_aqz: error reading file -> "
             +   std::string(filename)
             );
+    }
+    // residues are normalized in kseq's read buffer, which parsing has just
+    // brought into cache, so the copy into the sequence is its only write
+    Sequence _record(kseq_t* seq) const
+    {   if (normalization::none != _policy)
+        {   char* first = seq->seq.s;
+            char* last = first + seq->seq.l;
+            const char* bad = normalize(first, last, _alphabet, _policy);
+            if (bad != last)
+                throw std::runtime_error
+                (   "gynx::fast_aqz: invalid residue '" + std::string(1, *bad)
+                +   "' at " + std::to_string(bad - first)
+                +   " in record -> " + std::string(seq->name.s)
+                );
+        }
+        Sequence s(std::string_view(seq->seq.s, seq->seq.l));
+        s["_id"] = std::string(seq->name.s);
+        if (seq->qual.l)
+        {   std::string qs(seq->qual.s, seq->qual.l);
+            convert_phred(qs, _quality, phred_encoding::phred33);
+            s["_qs"] = std::move(qs);
+        }
+        if (seq->comment.l)
+            s["_desc"] = std::string(seq->comment.s);
         return s;
     }
 };
 
+///
+/// @brief Guesses the quality encoding of FASTQ file @a filename from the
+/// range of quality characters in its first @a records records (all if 0),
+/// see gynx::guess_phred(). Returns phred_encoding::unknown for files
+/// without qualities. With "-" the records are read from the standard
+/// input and are not available to a later reader.
+inline phred_encoding detect_phred
+(   std::string_view filename
+,   std::size_t records = 10000
+)
+{   auto seq = detail::open_kseq(filename, "detect_phred");
+    phred_range r;
+    int k{};
+    for (std::size_t n = 0; (0 == records || n < records) && (k = kseq_read(seq.get())) >= 0; ++n)
+        r += quality_range(std::string_view(seq->qual.s, seq->qual.l));
+    if (k < -1)
+        throw std::runtime_error
+        (   "gynx::detect_phred: error reading file -> "
+        +   std::string(filename)
+        );
+    return guess_phred(r);
+}
+
 }   // end gynx::in namespace
 
 /// Output file formats
@@ -343,9 +461,14 @@ private:
 
 /// @brief A function object for writing sequences to FASTQ files compressed
 /// with gzip.
+/// @details Besides writing a single sequence to a file, it can format()
+/// many records into a buffer and compress() it into one gzip member.
+/// Concatenated members form a valid gzip file, so batches of records can
+/// be compressed in parallel and written in order.
 struct fastq_gz
-{   fastq_gz(std::size_t line_width = 0)
+{   fastq_gz(std::size_t line_width = 0, int level = Z_DEFAULT_COMPRESSION)
     :   _line_width(line_width)
+    ,   _level(level)
     {}
     template <class Sequence>
     int operator()
@@ -353,68 +476,80 @@ struct fastq_gz
     ,   const Sequence& seq
     ,   typename Sequence::size_type line_width = 80
     )
-    {   gzFile fp = filename == "-"
-        ?   gzdopen(fileno(stdout), "w")
-        :   gzopen(std::string(filename).c_str(), "w");
+    {   const std::string mode = _level == Z_DEFAULT_COMPRESSION
+        ?   "w"
+        :   "w" + std::to_string(_level);
+        gzFile fp = filename == "-"
+        ?   gzdopen(fileno(stdout), mode.c_str())
+        :   gzopen(std::string(filename).c_str(), mode.c_str());
         if (nullptr == fp)
             throw std::runtime_error
             (   "gynx::fastq_gz: could not open file -> "
             +   std::string(filename)
             );
-        std::string id = seq.has("_id")
-        ?   std::any_cast<std::string>(seq["_id"])
-        :   "seq";
-        std::string desc = seq.has("_desc")
-        ?   " " + std::any_cast<std::string>(seq["_desc"])
-        :   " generated by Gynx";
-        std::string header = "@" + id + desc + "\n";
-        gzwrite(fp, header.c_str(), header.size());
-        if (_line_width)
-        {   for
-            (   typename Sequence::size_type i = 0
-            ;   i < std::size(seq)
-            ;   i += _line_width
-            )
-            {   std::string_view line
-                (   seq.data() + i
-                ,   std::min(_line_width, std::size(seq) - i)
-                );
-                gzwrite(fp, line.data(), line.size());
-                gzwrite(fp, "\n", 1);
-            }
-        }
-        else
-        {   gzwrite(fp, seq.data(),  std::size(seq));
-            gzwrite(fp, "\n", 1);
-        }
-        gzwrite(fp, "+\n", 2);
-        std::string qs = seq.has("_qs")
-        ?   std::any_cast<std::string>(seq["_qs"])
-        :   std::string(std::size(seq), 'I'); // dummy quality string
-        if (_line_width)
-        {   for
-            (   typename Sequence::size_type i = 0
-            ;   i < qs.size()
-            ;   i += _line_width
-            )
-            {   std::string_view line
-                (   qs.data() + i
-                ,   std::min(_line_width, qs.size() - i)
-                );
-                gzwrite(fp, line.data(), line.size());
-                gzwrite(fp, "\n", 1);
+        std::string record;
+        format(record, seq);
+        gzwrite(fp, record.data(), record.size());
+        gzclose(fp);
+        return 0;
+    }
+    ///
+    /// @brief Appends @a seq as one FASTQ record to @a buffer. The header is
+    /// the "_id" tag followed by the "_desc" tag, if any, so records read
+    /// with gynx::in::fast_aqz keep their header line.
+    template <class Sequence>
+    void format(std::string& buffer, const Sequence& seq) const
+    {   auto lines = [&](std::string_view s)
+        {   if (_line_width)
+                for (std::size_t i = 0; i < s.size(); i += _line_width)
+                {   buffer.append(s.substr(i, _line_width));
+                    buffer.push_back('\n');
+                }
+            else
+            {   buffer.append(s);
+                buffer.push_back('\n');
             }
-        }
+        };
+        buffer.push_back('@');
+        if (seq.has("_id"))
+            buffer.append(std::any_cast<const std::string&>(seq["_id"]));
         else
-        {   gzwrite(fp, qs.data(), qs.size());
-            gzwrite(fp, "\n", 1);
+            buffer.append("seq");
+        if (seq.has("_desc"))
+        {   buffer.push_back(' ');
+            buffer.append(std::any_cast<const std::string&>(seq["_desc"]));
         }
-        gzclose(fp);
-        return 0;
+        buffer.push_back('\n');
+        lines(std::string_view(seq.data(), std::size(seq)));
+        buffer.append("+\n");
+        if (seq.has("_qs"))
+            lines(std::any_cast<const std::string&>(seq["_qs"]));
+        else    // dummy quality string
+            lines(std::string(std::size(seq), 'I'));
+    }
+    ///
+    /// @brief Returns @a text compressed as one gzip member at this writer's
+    /// compression level.
+    std::string compress(std::string_view text) const
+    {   z_stream z{};
+        if (deflateInit2(&z, _level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw std::runtime_error("gynx::fastq_gz: could not initialize zlib");
+        std::string out(deflateBound(&z, text.size()), '\0');
+        z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+        z.avail_in = static_cast<uInt>(text.size());
+        z.next_out = reinterpret_cast<Bytef*>(out.data());
+        z.avail_out = static_cast<uInt>(out.size());
+        const int r = deflate(&z, Z_FINISH);
+        out.resize(z.total_out);
+        deflateEnd(&z);
+        if (r != Z_STREAM_END)
+            throw std::runtime_error("gynx::fastq_gz: compression failed");
+        return out;
     }
 
 private:
     std::size_t _line_width;
+    int _level;
 };
 
 }   // end gynx::out namespace
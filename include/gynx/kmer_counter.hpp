@@ -0,0 +1,497 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_KMER_COUNTER_HPP_
+#define _GYNX_KMER_COUNTER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/io/fastaqz.hpp>
+#include <gynx/kmers.hpp>
+#include <gynx/minimizers.hpp>
+#include <gynx/thread_pool.hpp>
+
+namespace gynx {
+
+/// @brief A distinct canonical k-mer and its number of occurrences.
+struct kmer_count
+{   std::uint64_t code;
+    std::uint64_t count;
+};
+
+/// @brief Counts canonical k-mers (k <= 32) across many sequences and
+/// threads.
+/// @details K-mers are routed by hash to partitions, each an open-addressing
+/// hash table behind its own mutex. Threads buffer k-mers in chunks, group
+/// them by partition and insert each group under one lock, which keeps lock
+/// traffic low and the partition being filled cache-resident.
+/// With a memory limit, a partition that would grow past it is sorted,
+/// spilled to a file in the spill directory and shrunk back to its initial
+/// size instead. Partitions smaller than half their share of the limit grow
+/// regardless, so runs do not get arbitrarily small. The first query merges
+/// each partition's table and spilled runs in one k-way merge into a sorted
+/// array, after which no more sequences can be added.
+class kmer_counter
+{   struct partition
+    {   std::mutex mutex;
+        std::vector<kmer_count> table;   // count == 0 marks an empty slot
+        std::size_t used = 0;
+        std::vector<std::filesystem::path> runs;
+        std::vector<kmer_count> sorted;  // filled by finish()
+    };
+
+    std::size_t _k;
+    std::size_t _memory_limit;
+    std::size_t _min_spill;              // smallest table spilled, in slots
+    std::filesystem::path _spill_dir;
+    std::string _prefix;
+    unsigned _bits;
+    std::vector<partition> _parts;
+    std::atomic<std::size_t> _memory{0};
+    std::atomic<std::size_t> _spills{0};
+    std::atomic<bool> _finished{false};
+    std::mutex _finish_mutex;
+
+    static constexpr std::size_t initial_slots = 1024;
+    static constexpr std::size_t flush_size = std::size_t(1) << 16;
+    static constexpr std::size_t read_block = std::size_t(1) << 14;
+
+    // a sorted run, spilled or in memory, read front to back
+    struct run_reader
+    {   std::filesystem::path path;
+        std::ifstream is;
+        std::size_t left = 0;            // entries not read from the file yet
+        std::vector<kmer_count> buffer;
+        std::size_t pos = 0;
+
+        void open(const std::filesystem::path& p)
+        {   path = p;
+            is.open(p, std::ios::binary);
+            left = std::filesystem::file_size(p) / sizeof(kmer_count);
+        }
+        // false once the run is exhausted; otherwise buffer[pos] is valid
+        bool fill()
+        {   if (pos < buffer.size())
+                return true;
+            if (0 == left)
+                return false;
+            buffer.resize(std::min(left, read_block));
+            is.read
+            (   reinterpret_cast<char*>(buffer.data())
+            ,   std::streamsize(buffer.size() * sizeof(kmer_count))
+            );
+            if (! is)
+                throw std::runtime_error
+                (   "gynx::kmer_counter: could not read spill file -> "
+                +   path.string()
+                );
+            left -= buffer.size();
+            pos = 0;
+            return true;
+        }
+    };
+
+    static std::uint64_t _hash(std::uint64_t code) noexcept
+    {   return invertible_hash()(code);
+    }
+    std::size_t _partition_of(std::uint64_t h) const noexcept
+    {   return _bits ? static_cast<std::size_t>(h >> (64 - _bits)) : 0;
+    }
+    // returns true if @a code was not in @a table yet
+    static bool _insert
+    (   std::vector<kmer_count>& table
+    ,   std::uint64_t code
+    ,   std::uint64_t h
+    ,   std::uint64_t count
+    )   noexcept
+    {   const std::size_t mask = table.size() - 1;
+        for (std::size_t i = h & mask; ; i = (i + 1) & mask)
+        {   if (0 == table[i].count)
+            {   table[i] = { code, count };
+                return true;
+            }
+            if (table[i].code == code)
+            {   table[i].count += count;
+                return false;
+            }
+        }
+    }
+    static std::vector<kmer_count> _sorted_entries
+    (   const std::vector<kmer_count>& table
+    )
+    {   std::vector<kmer_count> v;
+        for (const auto& e : table)
+            if (e.count)
+                v.push_back(e);
+        std::sort
+        (   v.begin()
+        ,   v.end()
+        ,   [](const kmer_count& a, const kmer_count& b)
+            {   return a.code < b.code;
+            }
+        );
+        return v;
+    }
+    // partition lock must be held
+    void _spill(partition& p, std::size_t index)
+    {   const auto v = _sorted_entries(p.table);
+        const auto path = _spill_dir /
+        (   _prefix
+        +   std::to_string(index) + "-"
+        +   std::to_string(p.runs.size()) + ".bin"
+        );
+        std::ofstream os(path, std::ios::binary);
+        os.write
+        (   reinterpret_cast<const char*>(v.data())
+        ,   std::streamsize(v.size() * sizeof(kmer_count))
+        );
+        if (! os)
+            throw std::runtime_error
+            (   "gynx::kmer_counter: could not write spill file -> "
+            +   path.string()
+            );
+        p.runs.push_back(path);
+        _memory -= (p.table.size() - initial_slots) * sizeof(kmer_count);
+        std::vector<kmer_count>(initial_slots).swap(p.table);
+        p.used = 0;
+        ++_spills;
+    }
+    // partition lock must be held
+    void _add_to
+    (   partition& p
+    ,   std::size_t index
+    ,   const std::uint64_t* codes
+    ,   std::size_t n
+    )
+    {   if (p.table.empty())
+        {   p.table.resize(initial_slots);
+            _memory += initial_slots * sizeof(kmer_count);
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {   if (2 * (p.used + 1) > p.table.size())
+            {   const std::size_t bytes = p.table.size() * sizeof(kmer_count);
+                if
+                (   _memory_limit
+                &&  _memory + bytes > _memory_limit
+                &&  p.table.size() >= _min_spill
+                )
+                    _spill(p, index);
+                else
+                {   std::vector<kmer_count> t(2 * p.table.size());
+                    for (const auto& e : p.table)
+                        if (e.count)
+                            _insert(t, e.code, _hash(e.code), e.count);
+                    p.table.swap(t);
+                    _memory += bytes;
+                }
+            }
+            if (_insert(p.table, codes[i], _hash(codes[i]), 1))
+                ++p.used;
+        }
+    }
+    // groups @a codes by partition with a counting sort, then inserts each
+    // group under its partition's lock
+    void _flush
+    (   std::vector<std::uint64_t>& codes
+    ,   std::vector<std::uint64_t>& grouped
+    ,   std::vector<std::size_t>& offsets
+    )
+    {   std::fill(offsets.begin(), offsets.end(), 0);
+        for (auto c : codes)
+            ++offsets[_partition_of(_hash(c)) + 1];
+        for (std::size_t i = 1; i < offsets.size(); ++i)
+            offsets[i] += offsets[i - 1];
+        grouped.resize(codes.size());
+        for (auto c : codes)
+            grouped[offsets[_partition_of(_hash(c))]++] = c;
+        for (std::size_t i = 0, first = 0; i < _parts.size(); ++i)
+        {   const std::size_t last = offsets[i];
+            if (last != first)
+            {   std::lock_guard<std::mutex> lock(_parts[i].mutex);
+                _add_to(_parts[i], i, grouped.data() + first, last - first);
+            }
+            first = last;
+        }
+        codes.clear();
+    }
+    template<typename Range>
+    void _add_all(const Range& seqs)
+    {   if (_finished)
+            throw std::logic_error("gynx::kmer_counter: counting already finished");
+        std::vector<std::uint64_t> codes, grouped;
+        std::vector<std::size_t> offsets(_parts.size() + 1);
+        codes.reserve(flush_size);
+        for (const auto& s : seqs)
+            for (auto km : s | views::kmers(_k))
+            {   codes.push_back(km.canonical());
+                if (codes.size() == flush_size)
+                    _flush(codes, grouped, offsets);
+            }
+        if (! codes.empty())
+            _flush(codes, grouped, offsets);
+    }
+    // merges the table and all spilled runs of @a p at once, with a min-heap
+    // of the runs ordered by their current entry
+    void _finish_partition(partition& p)
+    {   std::vector<run_reader> in(p.runs.size() + 1);
+        in[0].buffer = _sorted_entries(p.table);
+        _memory -= p.table.size() * sizeof(kmer_count);
+        std::vector<kmer_count>().swap(p.table);
+        for (std::size_t i = 0; i < p.runs.size(); ++i)
+            in[i + 1].open(p.runs[i]);
+
+        std::vector<std::size_t> heap;
+        for (std::size_t i = 0; i < in.size(); ++i)
+            if (in[i].fill())
+                heap.push_back(i);
+        const auto greater = [&](std::size_t a, std::size_t b)
+        {   return in[a].buffer[in[a].pos].code > in[b].buffer[in[b].pos].code;
+        };
+        std::make_heap(heap.begin(), heap.end(), greater);
+        std::vector<kmer_count> merged;
+        merged.reserve(in[0].buffer.size());
+        while (! heap.empty())
+        {   std::pop_heap(heap.begin(), heap.end(), greater);
+            auto& r = in[heap.back()];
+            const kmer_count e = r.buffer[r.pos++];
+            if (! merged.empty() && merged.back().code == e.code)
+                merged.back().count += e.count;
+            else
+                merged.push_back(e);
+            if (r.fill())
+                std::push_heap(heap.begin(), heap.end(), greater);
+            else
+                heap.pop_back();
+        }
+        in.clear();
+        for (const auto& path : p.runs)
+            std::filesystem::remove(path);
+        p.runs.clear();
+        p.sorted = std::move(merged);
+    }
+
+public:
+    ///
+    /// @brief Creates a counter of canonical @a k-mers.
+    /// @param memory_limit Bytes the counting hash tables may use in total
+    /// before partitions spill to disk; 0 means no limit. Tables below
+    /// half their share of the limit still grow, so the tables may briefly
+    /// take up to about twice the limit.
+    /// @param spill_dir Directory for spilled partitions.
+    /// @param partitions Number of partitions, rounded up to a power of two.
+    explicit kmer_counter
+    (   std::size_t k
+    ,   std::size_t memory_limit = 0
+    ,   std::filesystem::path spill_dir = std::filesystem::temp_directory_path()
+    ,   std::size_t partitions = 64
+    )
+    :   _k(k)
+    ,   _memory_limit(memory_limit)
+    ,   _spill_dir(std::move(spill_dir))
+    ,   _bits(std::bit_width(std::bit_ceil(std::max<std::size_t>(partitions, 1))) - 1)
+    ,   _parts(std::size_t(1) << _bits)
+    {   if (k < 1 || k > 32)
+            throw std::invalid_argument("gynx::kmer_counter: k out of range");
+        _min_spill = std::bit_ceil
+        (   std::max
+            (   initial_slots
+            ,   memory_limit / (2 * _parts.size() * sizeof(kmer_count))
+            )
+        );
+        std::random_device rd;
+        _prefix = "gynx-kmers-" + std::to_string(rd()) + "-";
+    }
+    kmer_counter(const kmer_counter&) = delete;
+    kmer_counter& operator= (const kmer_counter&) = delete;
+    ///
+    /// Destructor. Removes any spill files left behind.
+    ~kmer_counter()
+    {   for (auto& p : _parts)
+            for (const auto& path : p.runs)
+            {   std::error_code ec;
+                std::filesystem::remove(path, ec);
+            }
+    }
+
+// -- counting -----------------------------------------------------------------
+    ///
+    /// Counts the k-mers of @a s. Safe to call from several threads.
+    template<typename Container>
+    void add(sq_view_gen<Container> s)
+    {   _add_all(std::array{ s });
+    }
+    ///
+    /// @brief Counts the k-mers of every record in @a filename, read with
+    /// gynx::in::fast_aqz and counted in batches of @a batch_size records on
+    /// @a pool with gynx::parallel_pipeline(). Returns the number of
+    /// records.
+    template<typename Sequence = sq>
+    std::size_t add_file
+    (   std::string_view filename
+    ,   thread_pool& pool = thread_pool::global()
+    ,   std::size_t batch_size = 1024
+    )
+    {   typedef std::vector<Sequence> batch_type;
+        std::size_t n{};
+        parallel_pipeline<batch_type>
+        (   pool
+        ,   [&](auto& submit)
+            {   auto batch = std::make_shared<batch_type>();
+                n = in::fast_aqz<Sequence>()
+                (   filename
+                ,   [&](Sequence&& s)
+                    {   batch->push_back(std::move(s));
+                        if (batch->size() == batch_size)
+                            submit(std::exchange(batch, std::make_shared<batch_type>()));
+                    }
+                );
+                if (! batch->empty())
+                    submit(std::move(batch));
+            }
+        ,   [this](batch_type& b) { _add_all(b); }
+        );
+        return n;
+    }
+    ///
+    /// @brief Merges the partitions into sorted arrays using @a pool. Called
+    /// by the first query; no k-mers can be added afterwards.
+    void finish(thread_pool& pool = thread_pool::global())
+    {   std::lock_guard<std::mutex> lock(_finish_mutex);
+        if (_finished)
+            return;
+        parallel_for
+        (   pool
+        ,   _parts.size()
+        ,   [this](std::size_t i)
+            {   std::lock_guard<std::mutex> plock(_parts[i].mutex);
+                _finish_partition(_parts[i]);
+            }
+        );
+        std::size_t bytes = 0;
+        for (const auto& p : _parts)
+            bytes += p.sorted.size() * sizeof(kmer_count);
+        _memory = bytes;
+        _finished = true;
+    }
+
+// -- queries ------------------------------------------------------------------
+    ///
+    /// Returns the number of occurrences of the canonical k-mer @a code.
+    std::uint64_t count(std::uint64_t code)
+    {   finish();
+        const auto& v = _parts[_partition_of(_hash(code))].sorted;
+        auto it = std::lower_bound
+        (   v.begin()
+        ,   v.end()
+        ,   code
+        ,   [](const kmer_count& e, std::uint64_t c) { return e.code < c; }
+        );
+        return (it != v.end() && it->code == code) ? it->count : 0;
+    }
+    ///
+    /// Returns the number of occurrences of @a kmer or its reverse
+    /// complement; 0 if it is not a valid k-mer of this counter.
+    template<typename Container>
+    std::uint64_t count(sq_view_gen<Container> kmer)
+    {   if (kmer.size() != _k)
+            return 0;
+        auto km = kmer | views::kmers(_k);
+        auto it = km.begin();
+        return it == std::default_sentinel ? 0 : count((*it).canonical());
+    }
+    ///
+    /// Returns the number of distinct k-mers.
+    std::size_t distinct()
+    {   finish();
+        std::size_t n = 0;
+        for (const auto& p : _parts)
+            n += p.sorted.size();
+        return n;
+    }
+    ///
+    /// Returns the total number of k-mers counted.
+    std::uint64_t total()
+    {   finish();
+        std::uint64_t n = 0;
+        for (const auto& p : _parts)
+            for (const auto& e : p.sorted)
+                n += e.count;
+        return n;
+    }
+    ///
+    /// @brief Returns the k-mer spectrum: element @a i is the number of
+    /// distinct k-mers seen @a i times, with counts of @a max_count or more
+    /// accumulated in the last element.
+    std::vector<std::uint64_t> histogram(std::size_t max_count = 10000)
+    {   finish();
+        std::vector<std::uint64_t> h(max_count + 1);
+        for (const auto& p : _parts)
+            for (const auto& e : p.sorted)
+                ++h[std::min<std::uint64_t>(e.count, max_count)];
+        return h;
+    }
+    ///
+    /// Calls @a f with every distinct k-mer's kmer_count, partition by
+    /// partition (sorted by code within each).
+    template<typename F>
+    void for_each(F f)
+    {   finish();
+        for (const auto& p : _parts)
+            for (const auto& e : p.sorted)
+                f(e);
+    }
+
+// -- observers ----------------------------------------------------------------
+    std::size_t k() const noexcept
+    {   return _k;
+    }
+    ///
+    /// Returns the bytes held by hash tables (or sorted arrays once
+    /// finished).
+    std::size_t memory_usage() const noexcept
+    {   return _memory;
+    }
+    ///
+    /// Returns the number of partition spills to disk so far.
+    std::size_t spills() const noexcept
+    {   return _spills;
+    }
+};
+
+}   // end gynx namespace
+
+#endif  // _GYNX_KMER_COUNTER_HPP_
@@ -0,0 +1,297 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_KMERS_HPP_
+#define _GYNX_KMERS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <gynx/lut/nucleotide.hpp>
+
+namespace gynx {
+
+// -- k-mer words --------------------------------------------------------------
+
+#if defined(__SIZEOF_INT128__)
+/// 128-bit word used for k-mers with 32 < k <= 64.
+using uint128_t = unsigned __int128;
+#endif
+
+/// @brief The smallest unsigned integer holding a 2-bit encoded k-mer of
+/// length @a K.
+template<std::size_t K>
+using kmer_word_t =
+#if defined(__SIZEOF_INT128__)
+    std::conditional_t<(K > 32), uint128_t, std::uint64_t>;
+#else
+    std::uint64_t;
+#endif
+
+/// @brief A k-mer at position @a pos of a sequence, 2-bit encoded (A = 0,
+/// C = 1, G = 2, T = 3, first base in the most significant bits) on both
+/// strands.
+template<typename Word = std::uint64_t>
+struct kmer
+{   std::size_t pos; ///< start of the k-mer in the underlying sequence
+    Word fwd;        ///< encoding of the forward strand
+    Word rev;        ///< encoding of the reverse complement
+
+    ///
+    /// Returns the strand-independent encoding, min(fwd, rev).
+    constexpr Word canonical() const noexcept
+    {   return fwd < rev ? fwd : rev;
+    }
+    ///
+    /// Returns true if the canonical k-mer comes from the forward strand.
+    constexpr bool is_forward() const noexcept
+    {   return fwd <= rev;
+    }
+    friend constexpr bool operator== (const kmer&, const kmer&) = default;
+};
+
+/// @brief Returns the 2-bit encoding of the residues in @a s, or
+/// std::nullopt if any of them is not A, C, G or T (case-insensitive).
+template<typename Word = std::uint64_t, std::ranges::input_range R>
+constexpr std::optional<Word> kmer_encode(R&& s) noexcept
+{   Word w = 0;
+    for (auto c : s)
+    {   const auto code = lut::nt_class[static_cast<std::uint8_t>(c)];
+        if (code > 3)
+            return std::nullopt;
+        w = (w << 2) | Word(code);
+    }
+    return w;
+}
+
+/// @brief Decodes the 2-bit encoded k-mer @a w of length @a k.
+template<typename Word>
+std::string kmer_decode(Word w, std::size_t k)
+{   std::string s(k, 'A');
+    for (std::size_t i = k; i-- > 0; w >>= 2)
+        s[i] = "ACGT"[static_cast<std::size_t>(w & 3)];
+    return s;
+}
+
+// -- kmer_view ----------------------------------------------------------------
+
+/// @brief A view of the k-mers of a character range, computed with rolling
+/// 2-bit encodings in O(1) per residue.
+/// @details K-mers overlapping a residue other than A/C/G/T (e.g. N) are
+/// skipped; encoding restarts after it. With @a K > 0 the length is a
+/// compile-time constant, otherwise it is given at runtime (1 <= k <= 32).
+/// @tparam V The underlying view of characters.
+/// @tparam K Compile-time k-mer length, or 0 for a runtime length.
+/// @tparam Word The unsigned integer type holding an encoded k-mer.
+template
+<   std::ranges::view V
+,   std::size_t K = 0
+,   typename Word = kmer_word_t<K>
+>
+requires std::ranges::forward_range<V>
+class kmer_view
+:   public std::ranges::view_interface<kmer_view<V, K, Word>>
+{   static_assert
+    (   K <= 4 * sizeof(Word)
+    ,   "gynx::kmer_view: k-mer does not fit in Word"
+    );
+
+    V           _base = V();
+    std::size_t _k = K;
+
+public:
+    using value_type = kmer<Word>;
+
+    class iterator
+    {   using base_iterator = std::ranges::iterator_t<const V>;
+        using base_sentinel = std::ranges::sentinel_t<const V>;
+
+        base_iterator _it{};
+        base_sentinel _end{};
+        std::size_t   _i = 0;      // residues consumed so far
+        std::size_t   _valid = 0;  // consecutive A/C/G/T residues
+        std::size_t   _k = K;
+        Word          _fwd = 0;
+        Word          _rev = 0;
+        bool          _done = true;
+
+        constexpr std::size_t k() const noexcept
+        {   if constexpr (K > 0)
+                return K;
+            else
+                return _k;
+        }
+        constexpr Word mask() const noexcept
+        {   return k() == 4 * sizeof(Word)
+            ?   ~Word(0)
+            :   (Word(1) << (2 * k())) - 1;
+        }
+        // consumes residues until a full k-mer is available or input ends
+        constexpr void _next() noexcept
+        {   const std::size_t shift = 2 * (k() - 1);
+            const Word m = mask();
+            while (_it != _end)
+            {   const auto code = lut::nt_class[static_cast<std::uint8_t>(*_it)];
+                ++_it;
+                ++_i;
+                if (code > 3)
+                {   _valid = 0;
+                    continue;
+                }
+                _fwd = ((_fwd << 2) | Word(code)) & m;
+                _rev = (_rev >> 2) | (Word(3 - code) << shift);
+                if (++_valid >= k())
+                    return;
+            }
+            _done = true;
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = kmer<Word>;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr iterator() = default;
+        constexpr iterator(const kmer_view& parent)
+        :   _it(std::ranges::begin(parent._base))
+        ,   _end(std::ranges::end(parent._base))
+        ,   _k(parent._k)
+        ,   _done(false)
+        {   _next();
+        }
+
+        constexpr value_type operator* () const noexcept
+        {   return { _i - k(), _fwd, _rev };
+        }
+        constexpr iterator& operator++ () noexcept
+        {   _next();
+            return *this;
+        }
+        constexpr iterator operator++ (int) noexcept
+        {   iterator tmp = *this;
+            _next();
+            return tmp;
+        }
+        friend constexpr bool operator== (const iterator& a, const iterator& b)
+        {   return a._done == b._done && (a._done || a._i == b._i);
+        }
+        friend constexpr bool operator==
+        (   const iterator& a
+        ,   std::default_sentinel_t
+        )
+        {   return a._done;
+        }
+    };
+
+// -- constructors -------------------------------------------------------------
+    constexpr kmer_view() requires std::default_initializable<V> = default;
+
+    constexpr explicit kmer_view(V base) requires (K > 0)
+    :   _base(std::move(base))
+    {}
+
+    constexpr kmer_view(V base, std::size_t k) requires (0 == K)
+    :   _base(std::move(base))
+    ,   _k(k)
+    {   if (k < 1 || k > 4 * sizeof(Word))
+            throw std::invalid_argument("gynx::kmer_view: k out of range");
+    }
+
+// -- iterators ----------------------------------------------------------------
+    constexpr iterator begin() const
+    {   return iterator(*this);
+    }
+    constexpr std::default_sentinel_t end() const noexcept
+    {   return std::default_sentinel;
+    }
+
+// -- observers ----------------------------------------------------------------
+    constexpr std::size_t k() const noexcept
+    {   if constexpr (K > 0)
+            return K;
+        else
+            return _k;
+    }
+    constexpr V base() const
+    {   return _base;
+    }
+};
+
+// -- range adaptors -----------------------------------------------------------
+
+namespace views {
+
+namespace detail {
+
+template<std::size_t K>
+struct kmers_closure
+{   std::size_t k = K;
+
+    template<std::ranges::viewable_range R>
+    constexpr auto operator() (R&& r) const
+    {   using V = std::views::all_t<R>;
+        if constexpr (K > 0)
+            return kmer_view<V, K>(std::views::all(std::forward<R>(r)));
+        else
+            return kmer_view<V>(std::views::all(std::forward<R>(r)), k);
+    }
+    template<std::ranges::viewable_range R>
+    friend constexpr auto operator| (R&& r, const kmers_closure& c)
+    {   return c(std::forward<R>(r));
+    }
+};
+
+}   // end gynx::views::detail namespace
+
+///
+/// @brief Range adaptor producing the k-mers of length @a K (1 <= K <= 64
+/// where 128-bit integers are available, 32 otherwise), e.g.
+/// <tt>seq | gynx::views::kmers<21>()</tt>.
+template<std::size_t K>
+requires (K > 0)
+constexpr detail::kmers_closure<K> kmers() noexcept
+{   return {};
+}
+///
+/// @brief Range adaptor producing the k-mers of runtime length @a k
+/// (1 <= k <= 32), e.g. <tt>seq | gynx::views::kmers(21)</tt>.
+constexpr detail::kmers_closure<0> kmers(std::size_t k) noexcept
+{   return { k };
+}
+
+}   // end gynx::views namespace
+
+}   // end gynx namespace
+
+template<std::ranges::view V, std::size_t K, typename Word>
+inline constexpr bool
+    std::ranges::enable_borrowed_range<gynx::kmer_view<V, K, Word>>
+    = std::ranges::enable_borrowed_range<V>;
+
+#endif  // _GYNX_KMERS_HPP_
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_LUT_ALPHABET_HPP_
+#define _GYNX_LUT_ALPHABET_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace gynx::lut {
+
+// Canonical (uppercase) form of each letter of an alphabet indexed by its low
+// five bits ('A' & 0x1F == 1, ...), so the same table serves both cases; 0
+// marks letters outside the alphabet. Letters in @a from are mapped to the
+// corresponding letters in @a to (e.g. U -> T for DNA).
+constexpr std::array<char, 32> create_alphabet_index_table
+(   std::string_view letters
+,   std::string_view from = {}
+,   std::string_view to = {}
+)
+{   std::array<char, 32> table{};
+    for (char c : letters)
+        table[c & 0x1F] = c;
+    for (std::size_t i = 0; i < from.size(); ++i)
+        table[from[i] & 0x1F] = to[i];
+    return table;
+}
+
+// Generate the Lookup Table at Compile Time
+// This maps every ASCII character to its canonical form in the alphabet of
+// @a index, or to 0 if it is not part of the alphabet. The non-letters in
+// @a extra (e.g. '*' for protein stops) map to themselves.
+constexpr std::array<char, 256> create_alphabet_table
+(   const std::array<char, 32>& index
+,   std::string_view extra = {}
+)
+{   std::array<char, 256> table{};
+    for (int c = 0; c < 256; ++c)
+    {   const bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+        table[c] = letter ? index[c & 0x1F] : 0;
+    }
+    for (char c : extra)
+        table[static_cast<std::uint8_t>(c)] = c;
+    return table;
+}
+
+// Instantiate the tables in static memory (read-only, hot cache).
+// Always cast your input char to uint8_t when indexing into these tables
+// to avoid negative indices due to sign extension.
+// Example: char c = gynx::lut::dna_alphabet[static_cast<uint8_t>(ch)];
+static constexpr auto dna_index = create_alphabet_index_table("ACGT", "U", "T");
+static constexpr auto rna_index = create_alphabet_index_table("ACGU", "T", "U");
+static constexpr auto iupac_index = create_alphabet_index_table("ACGTURYSWKMBDHVN");
+static constexpr auto protein_index
+    = create_alphabet_index_table("ACDEFGHIKLMNPQRSTVWYBZJXUO");
+static constexpr auto dna_alphabet = create_alphabet_table(dna_index);
+static constexpr auto rna_alphabet = create_alphabet_table(rna_index);
+static constexpr auto iupac_alphabet = create_alphabet_table(iupac_index, "-");
+static constexpr auto protein_alphabet = create_alphabet_table(protein_index, "*-");
+
+} // namespace gynx::lut
+
+#endif  // _GYNX_LUT_ALPHABET_HPP_
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_LUT_CODON_HPP_
+#define _GYNX_LUT_CODON_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace gynx::lut {
+
+// Generate the Lookup Table at Compile Time
+// This maps every ASCII character to the 2-bit code of a base in a codon,
+// ignoring case: A -> 0, C -> 1, G -> 2, T and U -> 3 and anything else -> 4.
+constexpr std::array<std::uint8_t, 256> create_codon_base_table()
+{   std::array<std::uint8_t, 256> table{};
+    table.fill(4);
+    constexpr char bases[] { 'A', 'C', 'G', 'T', 'U' };
+    for (std::uint8_t i = 0; i < 5; ++i)
+    {   table[static_cast<std::uint8_t>(bases[i])] = i < 4 ? i : 3;
+        table[static_cast<std::uint8_t>(bases[i] | 0x20)] = i < 4 ? i : 3;
+    }
+    return table;
+}
+
+// Generate a codon table at compile time from the amino acid string of an
+// NCBI translation table (gc.prt), whose 64 codons are listed in TCAG order.
+// The result is indexed by 16 * b1 + 4 * b2 + b3, with the bases coded as in
+// codon_base, and holds '*' for stop codons.
+constexpr std::array<char, 64> create_codon_table(std::string_view ncbi)
+{   constexpr std::uint8_t tcag[] { 3, 1, 0, 2 };
+    std::array<char, 64> table{};
+    for (int i = 0; i < 64; ++i)
+        table[16 * tcag[i / 16] + 4 * tcag[i / 4 % 4] + tcag[i % 4]] = ncbi[i];
+    return table;
+}
+
+// Instantiate the tables in static memory (read-only, hot cache).
+// Always cast your input char to uint8_t when indexing into codon_base
+// to avoid negative indices due to sign extension.
+// Example: char aa = gynx::lut::codon_standard[16 * b1 + 4 * b2 + b3];
+static constexpr auto codon_base = create_codon_base_table();
+static constexpr auto codon_standard = create_codon_table
+    ("FFLLSSSSYY**CC*WLLLLPPPPHHQQRRRRIIIMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+static constexpr auto codon_vertebrate_mitochondrial = create_codon_table
+    ("FFLLSSSSYY**CCWWLLLLPPPPHHQQRRRRIIMMTTTTNNKKSS**VVVVAAAADDEEGGGG");
+static constexpr auto codon_yeast_mitochondrial = create_codon_table
+    ("FFLLSSSSYY**CCWWTTTTPPPPHHQQRRRRIIMMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+static constexpr auto codon_mold_mitochondrial = create_codon_table
+    ("FFLLSSSSYY**CCWWLLLLPPPPHHQQRRRRIIIMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+static constexpr auto codon_invertebrate_mitochondrial = create_codon_table
+    ("FFLLSSSSYY**CCWWLLLLPPPPHHQQRRRRIIMMTTTTNNKKSSSSVVVVAAAADDEEGGGG");
+static constexpr auto codon_ciliate = create_codon_table
+    ("FFLLSSSSYYQQCC*WLLLLPPPPHHQQRRRRIIIMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+static constexpr auto codon_echinoderm_mitochondrial = create_codon_table
+    ("FFLLSSSSYY**CCWWLLLLPPPPHHQQRRRRIIIMTTTTNNNKSSSSVVVVAAAADDEEGGGG");
+static constexpr auto codon_euplotid = create_codon_table
+    ("FFLLSSSSYY**CCCWLLLLPPPPHHQQRRRRIIIMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+static constexpr auto codon_alternative_yeast = create_codon_table
+    ("FFLLSSSSYY**CC*WLLLSPPPPHHQQRRRRIIIMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+static constexpr auto codon_ascidian_mitochondrial = create_codon_table
+    ("FFLLSSSSYY**CCWWLLLLPPPPHHQQRRRRIIMMTTTTNNKKSSGGVVVVAAAADDEEGGGG");
+static constexpr auto codon_alternative_flatworm = create_codon_table
+    ("FFLLSSSSYYY*CCWWLLLLPPPPHHQQRRRRIIIMTTTTNNNKSSSSVVVVAAAADDEEGGGG");
+
+} // namespace gynx::lut
+
+#endif  // _GYNX_LUT_CODON_HPP_
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_LUT_COMPLEMENT_HPP_
+#define _GYNX_LUT_COMPLEMENT_HPP_
+
+#include <array>
+#include <cstdint>
+
+namespace gynx::lut {
+
+// Complement of a letter indexed by its low five bits ('A' & 0x1F == 1, ...),
+// so the same table serves both cases. IUPAC codes map to their complementary
+// code (R<->Y, K<->M, B<->V, D<->H), U maps to A, and every other letter
+// (including S, W and N) maps to itself.
+constexpr std::array<std::uint8_t, 32> create_complement_index_table()
+{   std::array<std::uint8_t, 32> table{};
+    for (int i = 0; i < 32; ++i)
+        table[i] = static_cast<std::uint8_t>(i);
+    constexpr char pairs[][2]
+    {   {'A', 'T'}, {'C', 'G'}, {'R', 'Y'}, {'K', 'M'}, {'B', 'V'}, {'D', 'H'}
+    };
+    for (const auto& p : pairs)
+    {   table[p[0] & 0x1F] = p[1] & 0x1F;
+        table[p[1] & 0x1F] = p[0] & 0x1F;
+    }
+    table['U' & 0x1F] = 'A' & 0x1F;
+    return table;
+}
+
+// Generate the Lookup Table at Compile Time
+// This maps every ASCII character to its complement, preserving case.
+// Non-letters are mapped to themselves.
+constexpr std::array<char, 256> create_complement_table()
+{   std::array<char, 256> table{};
+    constexpr auto index = create_complement_index_table();
+    for (int c = 0; c < 256; ++c)
+    {   const bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+        table[c] = static_cast<char>
+        (   letter
+        ?   (c & 0xE0) | index[c & 0x1F]
+        :   c
+        );
+    }
+    return table;
+}
+
+// Instantiate the tables in static memory (read-only, hot cache).
+// Always cast your input char to uint8_t when indexing into this table
+// to avoid negative indices due to sign extension.
+// Example: char c = gynx::lut::complement[static_cast<uint8_t>(ch)];
+static constexpr auto complement_index = create_complement_index_table();
+static constexpr auto complement = create_complement_table();
+
+} // namespace gynx::lut
+
+#endif  // _GYNX_LUT_COMPLEMENT_HPP_
@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_LUT_NUCLEOTIDE_HPP_
+#define _GYNX_LUT_NUCLEOTIDE_HPP_
+
+#include <array>
+#include <cstdint>
+
+namespace gynx::lut {
+
+// Generate the Lookup Table at Compile Time
+// This maps every ASCII character to its nucleotide class, ignoring case:
+// A -> 0, C -> 1, G -> 2, T -> 3, N -> 4 and anything else -> 5. Values
+// below 4 double as the 2-bit encoding of a base.
+constexpr std::array<std::uint8_t, 256> create_nt_class_table()
+{   std::array<std::uint8_t, 256> table{};
+    table.fill(5);
+    constexpr char bases[] { 'A', 'C', 'G', 'T', 'N' };
+    for (std::uint8_t i = 0; i < 5; ++i)
+    {   table[static_cast<std::uint8_t>(bases[i])] = i;
+        table[static_cast<std::uint8_t>(bases[i] | 0x20)] = i;
+    }
+    return table;
+}
+
+// Instantiate the table in static memory (read-only, hot cache).
+// Always cast your input char to uint8_t when indexing into this table
+// to avoid negative indices due to sign extension.
+// Example: auto code = gynx::lut::nt_class[static_cast<uint8_t>(ch)];
+static constexpr auto nt_class = create_nt_class_table();
+
+} // namespace gynx::lut
+
+#endif  // _GYNX_LUT_NUCLEOTIDE_HPP_
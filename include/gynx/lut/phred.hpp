@@ -0,0 +1,48 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_LUT_PHRED_HPP_
+#define _GYNX_LUT_PHRED_HPP_
+
+#include <array>
+#include <cmath>
+
+namespace gynx::lut {
+
+// Generate the Lookup Table at Compile Time
+// This maps every Phred score (not character) from 0 to 127 to its error
+// probability as a float. At 512 bytes it fits in eight cache lines, so
+// SIMD gathers from it stay in L1; subtract the encoding offset (33 or 64)
+// from a quality character and clamp to [0, 127] before indexing.
+constexpr std::array<float, 128> create_phred_error_table()
+{   std::array<float, 128> table{};
+    for (int q = 0; q < 128; ++q)
+        table[q] = static_cast<float>(std::pow(10.0, -q / 10.0));
+    return table;
+}
+
+// Instantiate the table in static memory (read-only, hot cache).
+// Example: float p = gynx::lut::phred_error[ch - 33];
+alignas(64) static constexpr auto phred_error = create_phred_error_table();
+
+} // namespace gynx::lut
+
+#endif  // _GYNX_LUT_PHRED_HPP_
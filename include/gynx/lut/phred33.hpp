@@ -47,7 +47,7 @@ constexpr std::array<double, 256> create_phred33_table()
 // Always cast your input char to uint8_t when indexing into this table
 // to avoid negative indices due to sign extension.
 // Example: double p = gynx::lut::phred33[static_cast<uint8_t>(ch)];
-thread_local static constexpr auto phred33 = create_phred33_table();
+static constexpr auto phred33 = create_phred33_table();
 
 } // namespace gynx::lut
 
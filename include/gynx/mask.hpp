@@ -0,0 +1,398 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_MASK_HPP_
+#define _GYNX_MASK_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/lut/nucleotide.hpp>
+
+namespace gynx {
+
+/// @brief A half-open region [begin, end) of a sequence to be masked.
+struct mask_interval
+{   std::size_t begin = 0;
+    std::size_t end = 0;
+
+    std::size_t size() const noexcept
+    {   return end - begin;
+    }
+    friend bool operator== (const mask_interval&, const mask_interval&) = default;
+};
+
+namespace detail {
+
+// -- symmetric DUST -----------------------------------------------------------
+
+// A port of the symmetric DUST algorithm of Morgulis et al. (2006) as
+// implemented in sdust (minimap2). Triplet counts of the window (cw, rw) and
+// of its longest suffix without a triplet seen more than T/5 times (cv, rv)
+// are updated incrementally as the window slides; "perfect" intervals whose
+// score exceeds T are kept in P by descending start and merged into the
+// result once they fall out of the window.
+
+struct dust_perfect
+{   std::size_t start;
+    std::size_t finish;
+    int r;
+    int l;
+};
+
+class dust_state
+{   std::vector<int> _ring;     // triplets of the window, oldest first
+    std::size_t _head = 0;
+    std::size_t _count = 0;
+    std::array<int, 64> _cw{}, _cv{};
+    int _rw = 0, _rv = 0, _l = 0;
+    std::vector<dust_perfect> _p;
+    int _t;
+    std::size_t _w;
+
+    int _at(std::size_t i) const noexcept
+    {   return _ring[(_head + i) % _ring.size()];
+    }
+
+    void _shift(int t)
+    {   if (_count == _ring.size())
+        {   const int s = _ring[_head];
+            _head = (_head + 1) % _ring.size();
+            --_count;
+            _rw -= --_cw[s];
+            if (_l > int(_count))
+            {   --_l;
+                _rv -= --_cv[s];
+            }
+        }
+        _ring[(_head + _count++) % _ring.size()] = t;
+        ++_l;
+        _rw += _cw[t]++;
+        _rv += _cv[t]++;
+        if (_cv[t] * 10 > _t * 2)
+        {   int s;
+            do
+            {   s = _at(_count - _l);
+                _rv -= --_cv[s];
+                --_l;
+            }   while (s != t);
+        }
+    }
+
+    void _find_perfect(std::size_t start)
+    {   std::array<int, 64> c = _cv;
+        int r = _rv, max_r = 0, max_l = 0;
+        for (long i = long(_count) - _l - 1; i >= 0; --i)
+        {   const int t = _at(std::size_t(i));
+            r += c[t]++;
+            const int new_r = r, new_l = int(_count) - int(i) - 1;
+            if (new_r * 10 > _t * new_l)
+            {   std::size_t j = 0;
+                for (; j < _p.size() && _p[j].start >= std::size_t(i) + start; ++j)
+                    if (0 == max_r || _p[j].r * max_l > max_r * _p[j].l)
+                    {   max_r = _p[j].r;
+                        max_l = _p[j].l;
+                    }
+                if (0 == max_r || new_r * max_l >= max_r * new_l)
+                {   max_r = new_r;
+                    max_l = new_l;
+                    _p.insert
+                    (   _p.begin() + j
+                    ,   { std::size_t(i) + start, _count + 2 + start, new_r, new_l }
+                    );
+                }
+            }
+        }
+    }
+
+public:
+    dust_state(unsigned threshold, std::size_t window)
+    :   _ring(window - 2)
+    ,   _t(int(threshold))
+    ,   _w(window)
+    {}
+
+    // moves the perfect intervals that start before @a start to @a out
+    void save(std::vector<mask_interval>& out, std::size_t start)
+    {   if (_p.empty() || _p.back().start >= start)
+            return;
+        const auto& p = _p.back();
+        if (! out.empty() && p.start <= out.back().end)
+            out.back().end = std::max(out.back().end, p.finish);
+        else
+            out.push_back({ p.start, p.finish });
+        std::size_t i = _p.size();
+        while (i > 0 && _p[i - 1].start < start)
+            --i;
+        _p.resize(i);
+    }
+
+    // masks @a s[0, n), appending the intervals, shifted by @a offset, to out
+    void run(const char* s, std::size_t n, std::size_t offset, std::vector<mask_interval>& out)
+    {   std::size_t l = 0;
+        int t = 0;
+        for (std::size_t i = 0; i <= n; ++i)
+        {   const int b = i < n ? lut::nt_class[static_cast<std::uint8_t>(s[i])] : 4;
+            if (b < 4)
+            {   ++l;
+                t = (t << 2 | b) & 63;
+                if (l >= 3)
+                {   const std::size_t start = offset + (l > _w ? l - _w : 0) + (i + 1 - l);
+                    save(out, start);
+                    _shift(t);
+                    if (_rw * 10 > _l * _t)
+                        _find_perfect(start);
+                }
+            }
+            else    // N or the end: the pieces are masked independently
+            {   std::size_t start = offset + (l + 1 > _w ? l - _w + 1 : 0) + (i + 1 - l);
+                while (! _p.empty())
+                    save(out, start++);
+                l = 0;
+                t = 0;
+                _head = _count = 0;
+                _cw.fill(0);
+                _cv.fill(0);
+                _rw = _rv = _l = 0;
+            }
+        }
+    }
+};
+
+// -- entropy ------------------------------------------------------------------
+
+// c * log2(c) in 32.32 fixed point, so that window sums are exact and do
+// not depend on where a scan started
+inline std::int64_t entropy_term(std::size_t c) noexcept
+{   return c < 2 ? 0 : std::llround(double(c) * std::log2(double(c)) * 4294967296.0);
+}
+
+}   // end gynx::detail namespace
+
+// -- maskers ------------------------------------------------------------------
+
+/// @brief Symmetric DUST low-complexity masker (Morgulis et al. 2006, as in
+/// sdust and minimap2).
+/// @details Scores triplet repetition in windows of @a window bases and
+/// masks every "perfect" interval whose score exceeds @a threshold. Counts
+/// are updated incrementally as the window slides. Any residue other than
+/// A/C/G/T (case ignored) splits the sequence into independent pieces.
+struct dust_masker
+{   unsigned threshold = 20;
+    std::size_t window = 64;
+
+    ///
+    /// Returns the low-complexity intervals of [@a s, @a s + @a n).
+    std::vector<mask_interval> operator() (const char* s, std::size_t n) const
+    {   if (window < 4)
+            throw std::invalid_argument("gynx::dust_masker: window shorter than 4");
+        std::vector<mask_interval> out;
+        detail::dust_state(threshold, window).run(s, n, 0, out);
+        return out;
+    }
+    ///
+    /// Returns the low-complexity intervals of @a v.
+    template<typename Container>
+    std::vector<mask_interval> operator() (sq_view_gen<Container> v) const
+    {   return (*this)(v.data(), v.size());
+    }
+    ///
+    /// @brief Context on either side of a chunk that makes chunked masking
+    /// (see gynx::mask_intervals()) match a single pass.
+    std::size_t margin() const noexcept
+    {   return 4 * window;
+    }
+};
+
+/// @brief Windowed Shannon entropy low-complexity masker.
+/// @details Masks every window of @a window bases whose entropy of k-mers
+/// (k = @a k), normalized by its largest possible value,
+/// log2(min(4^k, window - k + 1)), is below @a threshold. k-mers with
+/// residues other than A/C/G/T are not counted and windows without any
+/// k-mer are left alone. k-mer counts and the entropy sum are updated
+/// incrementally as the window slides. A sequence shorter than the window
+/// is scored as one window.
+struct entropy_masker
+{   std::size_t window = 64;
+    unsigned k = 3;
+    double threshold = 0.5;
+
+    ///
+    /// Returns the low-complexity intervals of [@a s, @a s + @a n).
+    std::vector<mask_interval> operator() (const char* s, std::size_t n) const
+    {   if (0 == k || k > 8)
+            throw std::invalid_argument("gynx::entropy_masker: k not in [1, 8]");
+        if (window < k || window > 65535)
+            throw std::invalid_argument("gynx::entropy_masker: window not in [k, 65535]");
+        std::vector<mask_interval> out;
+        if (n < k)
+            return out;
+        const std::size_t w = std::min(window, n);
+        const std::size_t kmers = w - k + 1;    // k-mers per window
+        std::vector<std::int64_t> term(kmers + 1);
+        for (std::size_t c = 0; c <= kmers; ++c)
+            term[c] = detail::entropy_term(c);
+        const double norm = std::log2(double(std::min<std::size_t>(std::size_t(1) << (2 * k), kmers)));
+        // h = log2(total) - sum / total < threshold * norm, rearranged into a
+        // cutoff on the fixed-point sum for every k-mer total
+        std::vector<double> cutoff(kmers + 1);
+        for (std::size_t t = 1; t <= kmers; ++t)
+            cutoff[t] = (std::log2(double(t)) - threshold * norm) * double(t) * 4294967296.0;
+        // code of the k-mer starting at i, or -1 if it has another residue
+        std::vector<std::int32_t> code(n - k + 1);
+        {   const std::uint32_t mask = (std::uint32_t(1) << (2 * k)) - 1;
+            std::uint32_t x = 0;
+            std::size_t valid = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {   const auto b = lut::nt_class[static_cast<std::uint8_t>(s[i])];
+                valid = b < 4 ? valid + 1 : 0;
+                x = ((x << 2) | (b & 3)) & mask;
+                if (i + 1 >= k)
+                    code[i + 1 - k] = valid >= k ? std::int32_t(x) : -1;
+            }
+        }
+        std::vector<std::uint16_t> counts(std::size_t(1) << (2 * k));
+        std::int64_t sum = 0;
+        std::size_t total = 0;
+        auto add = [&](std::int32_t c)
+        {   if (c >= 0)
+            {   sum += term[counts[c] + 1] - term[counts[c]];
+                ++counts[c];
+                ++total;
+            }
+        };
+        auto remove = [&](std::int32_t c)
+        {   if (c >= 0)
+            {   sum -= term[counts[c]] - term[counts[c] - 1];
+                --counts[c];
+                --total;
+            }
+        };
+        for (std::size_t i = 0; i < kmers; ++i)
+            add(code[i]);
+        for (std::size_t b = 0; ; ++b)
+        {   if (total && double(sum) > cutoff[total])
+            {   if (! out.empty() && b <= out.back().end)
+                    out.back().end = b + w;
+                else
+                    out.push_back({ b, b + w });
+            }
+            if (b + w >= n)
+                break;
+            remove(code[b]);
+            add(code[b + kmers]);
+        }
+        return out;
+    }
+    ///
+    /// Returns the low-complexity intervals of @a v.
+    template<typename Container>
+    std::vector<mask_interval> operator() (sq_view_gen<Container> v) const
+    {   return (*this)(v.data(), v.size());
+    }
+    ///
+    /// @brief Context on either side of a chunk that makes chunked masking
+    /// (see gynx::mask_intervals()) match a single pass.
+    std::size_t margin() const noexcept
+    {   return window;
+    }
+};
+
+// -- masking ------------------------------------------------------------------
+///
+/// @brief Returns the intervals of @a v masked by @a masker, computed in
+/// chunks of @a chunk bases on @a pool for chromosome-scale sequences.
+/// @details Each chunk is scanned with masker.margin() bases of context on
+/// both sides and its intervals are clipped to the chunk before adjacent
+/// ones are merged, so the result matches a single pass of @a masker.
+template<typename Container, typename Masker>
+std::vector<mask_interval> mask_intervals
+(   sq_view_gen<Container> v
+,   const Masker& masker
+,   thread_pool& pool
+,   std::size_t chunk = std::size_t(1) << 20
+)
+{   const std::size_t n = v.size();
+    const std::size_t margin = masker.margin();
+    chunk = std::max(chunk, margin);
+    if (n <= chunk)
+        return masker(v.data(), n);
+    const std::size_t tasks = (n + chunk - 1) / chunk;
+    std::vector<std::vector<mask_interval>> parts(tasks);
+    parallel_for
+    (   pool
+    ,   tasks
+    ,   [&](std::size_t t)
+        {   const std::size_t a = t * chunk, b = std::min(n, a + chunk);
+            const std::size_t first = a > margin ? a - margin : 0;
+            const std::size_t last = std::min(n, b + margin);
+            for (auto r : masker(v.data() + first, last - first))
+            {   r.begin = std::max(r.begin + first, a);
+                r.end = std::min(r.end + first, b);
+                if (r.begin < r.end)
+                    parts[t].push_back(r);
+            }
+        }
+    );
+    std::vector<mask_interval> out;
+    for (const auto& part : parts)
+        for (const auto& r : part)
+            if (! out.empty() && r.begin <= out.back().end)
+                out.back().end = std::max(out.back().end, r.end);
+            else
+                out.push_back(r);
+    return out;
+}
+///
+/// @brief Lowercases the residues of @a s inside @a intervals (soft
+/// masking). Other characters are left as they are.
+template<typename Container, typename Map>
+void soft_mask(sq_gen<Container, Map>& s, const std::vector<mask_interval>& intervals)
+{   for (const auto& r : intervals)
+        for (std::size_t i = r.begin; i < std::min(r.end, s.size()); ++i)
+            if (s[i] >= 'A' && s[i] <= 'Z')
+                s[i] = static_cast<char>(s[i] | 0x20);
+}
+///
+/// @brief Soft-masks the intervals of @a s found by @a masker, on @a pool for
+/// long sequences. Returns the intervals.
+template<typename Container, typename Map, typename Masker>
+std::vector<mask_interval> soft_mask
+(   sq_gen<Container, Map>& s
+,   const Masker& masker
+,   thread_pool& pool = thread_pool::global()
+)
+{   auto intervals = mask_intervals(s(0), masker, pool);
+    soft_mask(s, intervals);
+    return intervals;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_MASK_HPP_
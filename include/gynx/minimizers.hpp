@@ -0,0 +1,671 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_MINIMIZERS_HPP_
+#define _GYNX_MINIMIZERS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gynx/simd.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/kmers.hpp>
+#include <gynx/thread_pool.hpp>
+
+namespace gynx {
+
+// -- hash functions -----------------------------------------------------------
+
+/// @brief Thomas Wang's invertible 64-bit integer hash restricted to the bits
+/// in @a mask, i.e. a bijection on [0, mask] when @a mask is 2^n - 1. Built
+/// from shifts, adds and xors only, so loops over it vectorize well.
+struct invertible_hash
+{   std::uint64_t mask = std::numeric_limits<std::uint64_t>::max();
+
+    constexpr std::uint64_t operator() (std::uint64_t key) const noexcept
+    {   key = (~key + (key << 21)) & mask;
+        key = key ^ key >> 24;
+        key = ((key + (key << 3)) + (key << 8)) & mask;
+        key = key ^ key >> 14;
+        key = ((key + (key << 2)) + (key << 4)) & mask;
+        key = key ^ key >> 28;
+        key = (key + (key << 31)) & mask;
+        return key;
+    }
+    ///
+    /// Returns the key hashed to @a key.
+    constexpr std::uint64_t inverse(std::uint64_t key) const noexcept
+    {   std::uint64_t tmp;
+        tmp = key - (key << 31);
+        key = (key - (tmp << 31)) & mask;
+        tmp = key ^ key >> 28;
+        key = key ^ tmp >> 28;
+        key = (key * 14933078535860113213ull) & mask;
+        tmp = key ^ key >> 14;
+        tmp = key ^ tmp >> 14;
+        tmp = key ^ tmp >> 14;
+        key = key ^ tmp >> 14;
+        key = (key * 15244667743933553977ull) & mask;
+        tmp = key ^ key >> 24;
+        key = key ^ tmp >> 24;
+        tmp = ~key;
+        tmp = ~(key - (tmp << 21));
+        tmp = ~(key - (tmp << 21));
+        key = ~(key - (tmp << 21)) & mask;
+        return key;
+    }
+};
+
+/// @brief Orders k-mers by their 2-bit encoding (lexicographic minimizers).
+struct identity_hash
+{   constexpr std::uint64_t operator() (std::uint64_t key) const noexcept
+    {   return key;
+    }
+};
+
+// -- minimizer / syncmer ------------------------------------------------------
+
+/// @brief A selected k-mer: its position, canonical 2-bit encoding, hash and
+/// the strand the canonical encoding comes from.
+struct minimizer
+{   std::size_t pos;
+    std::uint64_t code;
+    std::uint64_t hash;
+    bool forward;
+
+    friend constexpr bool operator== (const minimizer&, const minimizer&)
+        = default;
+};
+
+/// @brief Syncmers are reported with the same fields as minimizers.
+using syncmer = minimizer;
+
+namespace detail {
+
+/// @brief Sliding-window minimum over the last @a w pushed elements, which
+/// must have consecutive positions. The current minimum is tracked directly
+/// and only recomputed when it leaves the window, from two stacks: the
+/// previous block of @a w elements with its suffix minima and the current
+/// block with its running minimum. Pushes are amortized O(1) and the
+/// per-element comparisons are branch-free; ties keep the leftmost element.
+template<typename T>
+class sliding_min
+{   std::vector<T> _front;            // previous block
+    std::vector<T> _back;             // current block
+    std::vector<std::size_t> _suffix; // index of the minimum of _front[i, w)
+    T _min{};                         // minimum of the window
+    std::uint64_t _bhash = 0;         // minimum hash of _back[0, _b)
+    std::size_t _bidx = 0, _b = 0, _n = 0;
+
+public:
+    explicit sliding_min(std::size_t w = 1)
+    :   _front(w)
+    ,   _back(w)
+    ,   _suffix(w)
+    {}
+
+    /// Returns true once @a w elements have been pushed since clear().
+    bool full() const noexcept
+    {   return _n >= _back.size();
+    }
+    void clear() noexcept
+    {   _b = _n = 0;
+    }
+    /// Pushes @a x and returns true if the minimum of a full window changed.
+    bool push(const T& x) noexcept
+    {   const std::size_t w = _back.size();
+        // masks instead of ternaries: compilers tend to emit branches here
+        std::uint64_t m = -std::uint64_t((0 == _b) | (x.hash < _bhash));
+        _bhash ^= (_bhash ^ x.hash) & m;
+        _bidx ^= (_bidx ^ _b) & m;
+        _back[_b++] = x;
+        if (_b == w)
+        {   std::uint64_t h = _back[w - 1].hash;
+            std::size_t j = w - 1;
+            _suffix[j] = j;
+            for (std::size_t i = w - 1; i-- > 0; )
+            {   m = -std::uint64_t(_back[i].hash <= h);
+                h ^= (h ^ _back[i].hash) & m;
+                j ^= (j ^ i) & m;
+                _suffix[i] = j;
+            }
+            std::swap(_front, _back);
+            _b = 0;
+        }
+        if (0 == _n++ || x.hash < _min.hash)
+        {   _min = x;
+            return _n >= w;
+        }
+        if (_min.pos + w <= x.pos)
+        {   const T& f = _front[_suffix[_b]];
+            _min = (0 == _b || !(_bhash < f.hash)) ? f : _back[_bidx];
+            return true;
+        }
+        return _n == w;
+    }
+    /// Returns the minimum of the window; requires full().
+    const T& min() const noexcept
+    {   return _min;
+    }
+};
+
+// The invertible hash uses only shifts, adds and xors, which the compiler
+// vectorizes on its own once the wider ISA is enabled for the loop.
+
+inline void invertible_hash_block_scalar
+(   std::uint64_t* first
+,   std::uint64_t* last
+,   std::uint64_t mask
+)   noexcept
+{   const invertible_hash hash{ mask };
+    for (; first != last; ++first)
+        *first = hash(*first);
+}
+
+#if GYNX_SIMD_X86
+
+GYNX_TARGET_AVX2
+inline void invertible_hash_block_avx2
+(   std::uint64_t* first
+,   std::uint64_t* last
+,   std::uint64_t mask
+)   noexcept
+{   const invertible_hash hash{ mask };
+    for (; first != last; ++first)
+        *first = hash(*first);
+}
+
+GYNX_TARGET_AVX512
+inline void invertible_hash_block_avx512
+(   std::uint64_t* first
+,   std::uint64_t* last
+,   std::uint64_t mask
+)   noexcept
+{   const invertible_hash hash{ mask };
+    for (; first != last; ++first)
+        *first = hash(*first);
+}
+
+#endif  // GYNX_SIMD_X86
+
+/// Replaces every key in [@a first, @a last) with its invertible_hash.
+inline void invertible_hash_block
+(   std::uint64_t* first
+,   std::uint64_t* last
+,   std::uint64_t mask
+)   noexcept
+{   switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return invertible_hash_block_avx512(first, last, mask);
+        case simd::isa::avx2:
+            return invertible_hash_block_avx2(first, last, mask);
+#endif
+        default:
+            return invertible_hash_block_scalar(first, last, mask);
+    }
+}
+
+}   // end gynx::detail namespace
+
+// -- minimizer_view -----------------------------------------------------------
+
+/// @brief A view of the (w,k)-minimizers of a character range: for every w
+/// consecutive k-mers the one with the smallest hash of its canonical
+/// encoding, reported once per change of the window minimum.
+/// @details Windows do not span k-mers skipped because of ambiguous
+/// residues; the window restarts after them. Amortized O(1) per residue.
+/// @tparam V The underlying view of characters.
+/// @tparam Hash Callable mapping a 2-bit encoded k-mer to its order.
+template<std::ranges::view V, typename Hash = invertible_hash>
+requires std::ranges::forward_range<V>
+class minimizer_view
+:   public std::ranges::view_interface<minimizer_view<V, Hash>>
+{   kmer_view<V> _kmers;
+    std::size_t  _w = 1;
+    Hash         _hash{};
+
+public:
+    using value_type = minimizer;
+
+    class iterator
+    {   using kmer_iterator = typename kmer_view<V>::iterator;
+
+        kmer_iterator _it{};
+        detail::sliding_min<minimizer> _win{};
+        minimizer   _cur{};
+        std::size_t _last = 0;  // position of the last k-mer seen
+        Hash        _hash{};
+        bool        _done = true;
+
+        void _next()
+        {   for (; _it != std::default_sentinel; )
+            {   const auto km = *_it;
+                ++_it;
+                if (km.pos != _last + 1)
+                    _win.clear();
+                _last = km.pos;
+                const auto code = km.canonical();
+                if (_win.push({ km.pos, code, _hash(code), km.is_forward() }))
+                {   _cur = _win.min();
+                    _done = false;
+                    return;
+                }
+            }
+            _done = true;
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = minimizer;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(const minimizer_view& parent)
+        :   _it(parent._kmers.begin())
+        ,   _win(parent._w)
+        ,   _cur{ std::numeric_limits<std::size_t>::max(), 0, 0, false }
+        ,   _last(std::numeric_limits<std::size_t>::max() - 1)
+        ,   _hash(parent._hash)
+        {   _next();
+        }
+
+        minimizer operator* () const noexcept
+        {   return _cur;
+        }
+        iterator& operator++ ()
+        {   _next();
+            return *this;
+        }
+        iterator operator++ (int)
+        {   iterator tmp = *this;
+            _next();
+            return tmp;
+        }
+        friend bool operator== (const iterator& a, const iterator& b)
+        {   return a._done == b._done && (a._done || a._cur.pos == b._cur.pos);
+        }
+        friend bool operator== (const iterator& a, std::default_sentinel_t)
+        {   return a._done;
+        }
+    };
+
+// -- constructors -------------------------------------------------------------
+    minimizer_view() requires std::default_initializable<V> = default;
+
+    minimizer_view(V base, std::size_t w, std::size_t k, Hash hash = Hash())
+    :   _kmers(std::move(base), k)
+    ,   _w(w)
+    ,   _hash(std::move(hash))
+    {   if (0 == w)
+            throw std::invalid_argument("gynx::minimizer_view: zero window");
+    }
+
+// -- iterators ----------------------------------------------------------------
+    iterator begin() const
+    {   return iterator(*this);
+    }
+    std::default_sentinel_t end() const noexcept
+    {   return std::default_sentinel;
+    }
+
+// -- observers ----------------------------------------------------------------
+    std::size_t w() const noexcept
+    {   return _w;
+    }
+    std::size_t k() const noexcept
+    {   return _kmers.k();
+    }
+};
+
+// -- syncmer_view -------------------------------------------------------------
+
+/// @brief A view of the syncmers of a character range: k-mers whose smallest
+/// canonical s-mer (by hash) sits at offset @a t (open syncmers) or at either
+/// end (closed syncmers).
+/// @details S-mer hashes go through a two-stack sliding minimum so each
+/// residue costs amortized O(1) regardless of k - s.
+/// @tparam V The underlying view of characters.
+/// @tparam Hash Callable mapping a 2-bit encoded s-mer to its order.
+template<std::ranges::view V, typename Hash = invertible_hash>
+requires std::ranges::forward_range<V>
+class syncmer_view
+:   public std::ranges::view_interface<syncmer_view<V, Hash>>
+{   kmer_view<V> _kmers;
+    std::size_t  _s = 1;
+    std::size_t  _t = 0;
+    bool         _closed = true;
+    Hash         _hash{};
+
+public:
+    using value_type = syncmer;
+
+    class iterator
+    {   using kmer_iterator = typename kmer_view<V>::iterator;
+        struct smer
+        {   std::size_t pos;
+            std::uint64_t hash;
+        };
+
+        kmer_iterator _it{};
+        detail::sliding_min<smer> _win{};
+        syncmer       _cur{};
+        std::size_t   _k = 1, _s = 1, _t = 0;
+        std::size_t   _last = std::numeric_limits<std::size_t>::max() - 1;
+        std::uint64_t _smask = 0;
+        Hash          _hash{};
+        bool          _closed = true;
+        bool          _done = true;
+
+        void _push(std::uint64_t fwd, std::uint64_t rev, std::size_t pos)
+        {   fwd &= _smask;
+            rev &= _smask;
+            _win.push({ pos, _hash(fwd < rev ? fwd : rev) });
+        }
+        void _next()
+        {   const std::size_t d = _k - _s;
+            for (; _it != std::default_sentinel; )
+            {   const auto km = *_it;
+                ++_it;
+                if (km.pos != _last + 1)
+                {   _win.clear();
+                    for (std::size_t j = 0; j < d; ++j)
+                        _push(km.fwd >> 2 * (d - j), km.rev >> 2 * j, km.pos + j);
+                }
+                _last = km.pos;
+                _push(km.fwd, km.rev >> 2 * d, km.pos + d);
+                const std::size_t o = _win.min().pos - km.pos;
+                if (_closed ? (0 == o || d == o) : _t == o)
+                {   const auto code = km.canonical();
+                    _cur = { km.pos, code, _win.min().hash, km.is_forward() };
+                    _done = false;
+                    return;
+                }
+            }
+            _done = true;
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = syncmer;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(const syncmer_view& parent)
+        :   _it(parent._kmers.begin())
+        ,   _win(parent.k() - parent._s + 1)
+        ,   _k(parent.k())
+        ,   _s(parent._s)
+        ,   _t(parent._t)
+        ,   _smask
+            (   2 * parent._s == 64
+            ?   ~std::uint64_t(0)
+            :   (std::uint64_t(1) << 2 * parent._s) - 1
+            )
+        ,   _hash(parent._hash)
+        ,   _closed(parent._closed)
+        {   _next();
+        }
+
+        syncmer operator* () const noexcept
+        {   return _cur;
+        }
+        iterator& operator++ ()
+        {   _next();
+            return *this;
+        }
+        iterator operator++ (int)
+        {   iterator tmp = *this;
+            _next();
+            return tmp;
+        }
+        friend bool operator== (const iterator& a, const iterator& b)
+        {   return a._done == b._done && (a._done || a._cur.pos == b._cur.pos);
+        }
+        friend bool operator== (const iterator& a, std::default_sentinel_t)
+        {   return a._done;
+        }
+    };
+
+// -- constructors -------------------------------------------------------------
+    syncmer_view() requires std::default_initializable<V> = default;
+
+    /// @param t Offset of the minimal s-mer for open syncmers; ignored when
+    /// @a closed is true.
+    syncmer_view
+    (   V base
+    ,   std::size_t k
+    ,   std::size_t s
+    ,   bool closed
+    ,   std::size_t t = 0
+    ,   Hash hash = Hash()
+    )
+    :   _kmers(std::move(base), k)
+    ,   _s(s)
+    ,   _t(t)
+    ,   _closed(closed)
+    ,   _hash(std::move(hash))
+    {   if (0 == s || s > k)
+            throw std::invalid_argument("gynx::syncmer_view: s out of range");
+        if (t > k - s)
+            throw std::invalid_argument("gynx::syncmer_view: t out of range");
+    }
+
+// -- iterators ----------------------------------------------------------------
+    iterator begin() const
+    {   return iterator(*this);
+    }
+    std::default_sentinel_t end() const noexcept
+    {   return std::default_sentinel;
+    }
+
+// -- observers ----------------------------------------------------------------
+    std::size_t k() const noexcept
+    {   return _kmers.k();
+    }
+    std::size_t s() const noexcept
+    {   return _s;
+    }
+};
+
+// -- range adaptors -----------------------------------------------------------
+
+namespace views {
+
+namespace detail {
+
+template<typename Hash>
+struct minimizers_closure
+{   std::size_t w, k;
+    Hash hash;
+
+    template<std::ranges::viewable_range R>
+    auto operator() (R&& r) const
+    {   return minimizer_view<std::views::all_t<R>, Hash>
+            (std::views::all(std::forward<R>(r)), w, k, hash);
+    }
+    template<std::ranges::viewable_range R>
+    friend auto operator| (R&& r, const minimizers_closure& c)
+    {   return c(std::forward<R>(r));
+    }
+};
+
+template<typename Hash>
+struct syncmers_closure
+{   std::size_t k, s;
+    bool closed;
+    std::size_t t;
+    Hash hash;
+
+    template<std::ranges::viewable_range R>
+    auto operator() (R&& r) const
+    {   return syncmer_view<std::views::all_t<R>, Hash>
+            (std::views::all(std::forward<R>(r)), k, s, closed, t, hash);
+    }
+    template<std::ranges::viewable_range R>
+    friend auto operator| (R&& r, const syncmers_closure& c)
+    {   return c(std::forward<R>(r));
+    }
+};
+
+}   // end gynx::views::detail namespace
+
+///
+/// @brief Range adaptor producing the (@a w, @a k)-minimizers, e.g.
+/// <tt>seq | gynx::views::minimizers(10, 15)</tt>.
+template<typename Hash = invertible_hash>
+detail::minimizers_closure<Hash>
+minimizers(std::size_t w, std::size_t k, Hash hash = Hash())
+{   return { w, k, std::move(hash) };
+}
+///
+/// @brief Range adaptor producing the closed syncmers with s-mer length @a s.
+template<typename Hash = invertible_hash>
+detail::syncmers_closure<Hash>
+closed_syncmers(std::size_t k, std::size_t s, Hash hash = Hash())
+{   return { k, s, true, 0, std::move(hash) };
+}
+///
+/// @brief Range adaptor producing the open syncmers with s-mer length @a s
+/// whose minimal s-mer starts at offset @a t.
+template<typename Hash = invertible_hash>
+detail::syncmers_closure<Hash>
+open_syncmers
+(   std::size_t k
+,   std::size_t s
+,   std::size_t t = 0
+,   Hash hash = Hash()
+)
+{   return { k, s, false, t, std::move(hash) };
+}
+
+}   // end gynx::views namespace
+
+// -- minimizers ---------------------------------------------------------------
+
+/// @brief Returns the (@a w, @a k)-minimizers of @a s, the same elements as
+/// <tt>s | views::minimizers(w, k, hash)</tt>.
+/// @details K-mers are gathered in blocks and hashed in a separate pass,
+/// vectorized with AVX2/AVX-512 for the default invertible_hash, before the
+/// sliding-window pass.
+template<typename Container, typename Hash = invertible_hash>
+std::vector<minimizer> minimizers
+(   sq_view_gen<Container> s
+,   std::size_t w
+,   std::size_t k
+,   Hash hash = Hash()
+)
+{   if (0 == w)
+        throw std::invalid_argument("gynx::minimizers: zero window");
+    constexpr std::size_t block = 4096;
+    std::vector<minimizer> out;
+    out.reserve(2 * s.size() / (w + 1) + 1); // expected density for random input
+    std::vector<std::uint64_t> code(block), h(block);
+    std::vector<std::size_t> pos(block);
+    std::vector<std::uint8_t> fwd(block);
+    detail::sliding_min<minimizer> win(w);
+    std::size_t last = std::numeric_limits<std::size_t>::max() - 1;
+    auto km = kmer_view<sq_view_gen<Container>>(s, k);
+    auto it = km.begin();
+    while (it != std::default_sentinel)
+    {   std::size_t n = 0;
+        for (; n < block && it != std::default_sentinel; ++n, ++it)
+        {   const auto m = *it;
+            pos[n] = m.pos;
+            code[n] = m.canonical();
+            fwd[n] = m.is_forward();
+        }
+        if constexpr (std::is_same_v<Hash, invertible_hash>)
+        {   std::copy_n(code.begin(), n, h.begin());
+            detail::invertible_hash_block(h.data(), h.data() + n, hash.mask);
+        }
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                h[i] = hash(code[i]);
+        for (std::size_t i = 0; i < n; ++i)
+        {   if (pos[i] != last + 1)
+                win.clear();
+            last = pos[i];
+            if (win.push({ pos[i], code[i], h[i], bool(fwd[i]) }))
+                out.push_back(win.min());
+        }
+    }
+    return out;
+}
+
+///
+/// @brief Returns the (@a w, @a k)-minimizers of @a s like minimizers(),
+/// computed in parallel on @a pool.
+/// @details The sequence is split into blocks of @a chunk residues that
+/// overlap by w + k - 2, so every window lies entirely in the block it
+/// starts in. Each block is processed independently, and a minimizer
+/// reported again at the start of a block (because it is also the minimum
+/// of the last window of the previous one) is dropped while merging.
+template<typename Container, typename Hash = invertible_hash>
+std::vector<minimizer> minimizers
+(   sq_view_gen<Container> s
+,   std::size_t w
+,   std::size_t k
+,   thread_pool& pool
+,   Hash hash = Hash()
+,   std::size_t chunk = detail::parallel_block
+)
+{   if (0 == w)
+        throw std::invalid_argument("gynx::minimizers: zero window");
+    chunk = std::max<std::size_t>(chunk, 1);
+    std::vector<std::vector<minimizer>> partial((s.size() + chunk - 1) / chunk);
+    parallel_chunks
+    (   pool
+    ,   s.size()
+    ,   w + k - 2
+    ,   [&](std::size_t i, std::size_t j)
+        {   auto& out = partial[i / chunk];
+            out = minimizers(s.substr(i, j - i), w, k, hash);
+            for (auto& m : out)
+                m.pos += i;
+        }
+    ,   chunk
+    );
+    std::size_t total = 0;
+    for (const auto& p : partial)
+        total += p.size();
+    std::vector<minimizer> out;
+    out.reserve(total);
+    for (const auto& p : partial)
+        for (const auto& m : p)
+            if (out.empty() || m.pos > out.back().pos)
+                out.push_back(m);
+    return out;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_MINIMIZERS_HPP_
@@ -0,0 +1,456 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_MMAP_VECTOR_HPP_
+#define _GYNX_MMAP_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gynx/sq.hpp>
+
+namespace gynx {
+
+/// @brief A contiguous container whose storage is a memory-mapped file.
+/// @details Satisfies the @a Container requirements of gynx::sq_gen, so
+/// sequences larger than physical memory can be held and paged in and out by
+/// the kernel. A default-constructed or grown container is backed by an
+/// unlinked, sparse temporary file (in std::filesystem::temp_directory_path(),
+/// i.e. @c TMPDIR); a container constructed from a path maps that file
+/// directly. Iterators are raw pointers and are invalidated by growth, just
+/// like std::vector.
+/// @tparam T The (trivially copyable) element type.
+template<typename T>
+class mmap_vector
+{   static_assert
+    (   std::is_trivially_copyable_v<T>
+    ,   "gynx::mmap_vector: T must be trivially copyable"
+    );
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// How a file passed to the constructor is mapped.
+    enum class mode
+    {   read_only   ///< private copy-on-write mapping, the file is never modified
+    ,   read_write  ///< shared mapping, changes (and growth) go to the file
+    };
+
+    /// Access pattern hints forwarded to @c madvise().
+    enum class advice
+    {   normal
+    ,   sequential
+    ,   random
+    ,   willneed
+    ,   dontneed
+    };
+
+// -- constructors -------------------------------------------------------------
+    ///
+    /// Default constructor. Constructs an empty container without mapping
+    /// anything.
+    mmap_vector() noexcept = default;
+    ///
+    /// Constructs the container with @a count copies of @a value.
+    explicit mmap_vector(size_type count, const_reference value = value_type())
+    {   resize(count, value);
+    }
+    ///
+    template<typename InputIt>
+    requires std::input_iterator<InputIt>
+    /// Constructs the container with the contents of the range
+    /// [@a first, @a last).
+    mmap_vector(InputIt first, InputIt last)
+    {   if constexpr (std::forward_iterator<InputIt>)
+        {   reserve(static_cast<size_type>(std::distance(first, last)));
+            for (; first != last; ++first)
+                _data[_size++] = *first;
+        }
+        else
+            for (; first != last; ++first)
+                push_back(*first);
+    }
+    ///
+    /// Constructs the container with the contents of @a init.
+    mmap_vector(std::initializer_list<value_type> init)
+    :   mmap_vector(init.begin(), init.end())
+    {}
+    ///
+    /// @brief Maps the file at @a path. Its size must be a multiple of
+    /// sizeof(T).
+    /// @param path The file to map.
+    /// @param m With mode::read_only (the default) the mapping is private and
+    /// copy-on-write; with mode::read_write modifications and growth are
+    /// written back to the file.
+    explicit mmap_vector(const std::filesystem::path& path, mode m = mode::read_only)
+    {   _fd = ::open
+        (   path.c_str()
+        ,   m == mode::read_write ? O_RDWR : O_RDONLY
+        );
+        if (_fd < 0)
+            throw std::runtime_error
+            (   "gynx::mmap_vector: could not open file -> "
+            +   path.string()
+            );
+        struct stat st;
+        if (::fstat(_fd, &st) != 0 || st.st_size % sizeof(value_type))
+        {   ::close(_fd);
+            throw std::runtime_error
+            (   "gynx::mmap_vector: bad file size -> "
+            +   path.string()
+            );
+        }
+        _shared = _persist = (m == mode::read_write);
+        _size = static_cast<size_type>(st.st_size) / sizeof(value_type);
+        _capacity = _size;
+        if (_size)
+            _data = _map(_fd, _size * sizeof(value_type), _shared);
+    }
+    ///
+    /// Copy constructor. The copy is always backed by a new temporary file.
+    mmap_vector(const mmap_vector& other)
+    :   mmap_vector(other.begin(), other.end())
+    {}
+    ///
+    /// Move constructor.
+    mmap_vector(mmap_vector&& other) noexcept
+    {   swap(other);
+    }
+    ///
+    /// Destructor. Unmaps the storage and, for a file opened with
+    /// mode::read_write, trims the file to the current size.
+    ~mmap_vector()
+    {   if (_data)
+            ::munmap(_data, _capacity * sizeof(value_type));
+        if (_fd >= 0)
+        {   if (_persist)
+            {   [[maybe_unused]] int r = ::ftruncate
+                (   _fd
+                ,   static_cast<off_t>(_size * sizeof(value_type))
+                );
+            }
+            ::close(_fd);
+        }
+    }
+
+// -- assignment operators -----------------------------------------------------
+    ///
+    /// Copy assignment operator.
+    mmap_vector& operator= (const mmap_vector& other)
+    {   if (this != &other)
+        {   mmap_vector tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+    ///
+    /// Move assignment operator.
+    mmap_vector& operator= (mmap_vector&& other) noexcept
+    {   mmap_vector tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+    ///
+    /// Replaces the contents with those of @a init.
+    mmap_vector& operator= (std::initializer_list<value_type> init)
+    {   clear();
+        reserve(init.size());
+        std::copy(init.begin(), init.end(), _data);
+        _size = init.size();
+        return *this;
+    }
+
+// -- iterators ----------------------------------------------------------------
+    iterator begin() noexcept
+    {   return _data;
+    }
+    const_iterator begin() const noexcept
+    {   return _data;
+    }
+    const_iterator cbegin() const noexcept
+    {   return _data;
+    }
+    iterator end() noexcept
+    {   return _data + _size;
+    }
+    const_iterator end() const noexcept
+    {   return _data + _size;
+    }
+    const_iterator cend() const noexcept
+    {   return _data + _size;
+    }
+    reverse_iterator rbegin() noexcept
+    {   return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept
+    {   return const_reverse_iterator(end());
+    }
+    const_reverse_iterator crbegin() const noexcept
+    {   return rbegin();
+    }
+    reverse_iterator rend() noexcept
+    {   return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept
+    {   return const_reverse_iterator(begin());
+    }
+    const_reverse_iterator crend() const noexcept
+    {   return rend();
+    }
+
+// -- capacity -----------------------------------------------------------------
+    [[nodiscard]] bool empty() const noexcept
+    {   return 0 == _size;
+    }
+    size_type size() const noexcept
+    {   return _size;
+    }
+    ///
+    /// Returns the number of elements that fit in the current mapping.
+    size_type capacity() const noexcept
+    {   return _capacity;
+    }
+    ///
+    /// Grows the mapping to hold at least @a n elements. Pages of the backing
+    /// file are not allocated until they are written (sparse file).
+    void reserve(size_type n)
+    {   if (n > _capacity)
+            _remap(_round_up(n));
+    }
+
+// -- element access -----------------------------------------------------------
+    reference operator[] (size_type pos)
+    {   return _data[pos];
+    }
+    const_reference operator[] (size_type pos) const
+    {   return _data[pos];
+    }
+    reference at(size_type pos)
+    {   if (pos >= _size)
+            throw std::out_of_range("gynx::mmap_vector: pos >= size()");
+        return _data[pos];
+    }
+    const_reference at(size_type pos) const
+    {   if (pos >= _size)
+            throw std::out_of_range("gynx::mmap_vector: pos >= size()");
+        return _data[pos];
+    }
+    reference front()
+    {   return _data[0];
+    }
+    const_reference front() const
+    {   return _data[0];
+    }
+    reference back()
+    {   return _data[_size - 1];
+    }
+    const_reference back() const
+    {   return _data[_size - 1];
+    }
+    value_type* data() noexcept
+    {   return _data;
+    }
+    const value_type* data() const noexcept
+    {   return _data;
+    }
+
+// -- modifiers ----------------------------------------------------------------
+    void clear() noexcept
+    {   _size = 0;
+    }
+    void push_back(const_reference value)
+    {   if (_size == _capacity)
+            reserve(std::max<size_type>(2 * _capacity, 1));
+        _data[_size++] = value;
+    }
+    void pop_back()
+    {   --_size;
+    }
+    void resize(size_type count, const_reference value = value_type())
+    {   reserve(count);
+        if (count > _size)
+            std::fill(_data + _size, _data + count, value);
+        _size = count;
+    }
+    void swap(mmap_vector& other) noexcept
+    {   std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+        std::swap(_fd, other._fd);
+        std::swap(_shared, other._shared);
+        std::swap(_persist, other._persist);
+    }
+
+// -- mapping control ----------------------------------------------------------
+    ///
+    /// Hints the kernel about the expected access pattern of the @a count
+    /// elements starting at @a pos (the whole container by default), e.g.
+    /// advice::sequential before a linear scan or advice::random before
+    /// k-mer lookups. advice::dontneed is ignored for a mode::read_only
+    /// mapping, where it would discard modified (copy-on-write) pages.
+    void advise
+    (   advice a
+    ,   size_type pos = 0
+    ,   size_type count = static_cast<size_type>(-1)
+    )   const
+    {   if (! _data || pos >= _size || (advice::dontneed == a && ! _shared))
+            return;
+        count = std::min(count, _size - pos);
+        const std::size_t page = _page_size();
+        auto first = reinterpret_cast<std::uintptr_t>(_data + pos);
+        auto last = reinterpret_cast<std::uintptr_t>(_data + pos + count);
+        first -= first % page;
+        int flag = MADV_NORMAL;
+        switch (a)
+        {   case advice::sequential : flag = MADV_SEQUENTIAL; break;
+            case advice::random     : flag = MADV_RANDOM;     break;
+            case advice::willneed   : flag = MADV_WILLNEED;   break;
+            case advice::dontneed   : flag = MADV_DONTNEED;   break;
+            default                 : break;
+        }
+        ::madvise(reinterpret_cast<void*>(first), last - first, flag);
+    }
+    ///
+    /// Flushes modified pages of a mode::read_write mapping to the file.
+    void sync() const
+    {   if (_data && _shared)
+            ::msync(_data, _size * sizeof(value_type), MS_SYNC);
+    }
+
+// -- comparison operators -----------------------------------------------------
+    friend bool operator== (const mmap_vector& lhs, const mmap_vector& rhs)
+    {   return lhs.size() == rhs.size()
+        && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+private:
+    T*        _data = nullptr;
+    size_type _size = 0;
+    size_type _capacity = 0;
+    int       _fd = -1;
+    bool      _shared = false;    // writes reach the backing file
+    bool      _persist = false;   // user file opened in mode::read_write
+
+    static std::size_t _page_size() noexcept
+    {   return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    }
+    // rounds n elements up to a whole number of pages
+    static size_type _round_up(size_type n) noexcept
+    {   const std::size_t page = _page_size();
+        const std::size_t bytes = (n * sizeof(value_type) + page - 1) / page * page;
+        return bytes / sizeof(value_type);
+    }
+    static T* _map(int fd, std::size_t bytes, bool shared)
+    {   void* p = ::mmap
+        (   nullptr
+        ,   bytes
+        ,   PROT_READ | PROT_WRITE
+        ,   shared ? MAP_SHARED : MAP_PRIVATE
+        ,   fd
+        ,   0
+        );
+        if (MAP_FAILED == p)
+            throw std::runtime_error("gynx::mmap_vector: mmap failed");
+        return static_cast<T*>(p);
+    }
+    // creates an already unlinked temporary file, so that nothing is left
+    // behind even if the process is killed
+    static int _make_temp()
+    {   std::string name
+        (   (   std::filesystem::temp_directory_path()
+            /   "gynx-mmap-XXXXXX"
+            ).string()
+        );
+        int fd = ::mkstemp(name.data());
+        if (fd < 0)
+            throw std::runtime_error
+            (   "gynx::mmap_vector: could not create temporary file -> "
+            +   name
+            );
+        ::unlink(name.c_str());
+        return fd;
+    }
+    static void _truncate(int fd, std::size_t bytes)
+    {   if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+            throw std::runtime_error("gynx::mmap_vector: could not resize file");
+    }
+    void _remap(size_type cap)
+    {   const std::size_t bytes = cap * sizeof(value_type);
+        if (_fd >= 0 && _shared)
+        {   // grow the backing file in place; old pages stay in the page
+            // cache. The old region is unmapped only once the new one is
+            // mapped, so a failure leaves the container unchanged.
+            _truncate(_fd, bytes);
+            T* p = _map(_fd, bytes, true);
+            if (_data)
+                ::munmap(_data, _capacity * sizeof(value_type));
+            _data = p;
+            _capacity = cap;
+            return;
+        }
+        // no backing file yet, or a private (read-only) mapping: move the
+        // contents into a fresh sparse temporary file
+        mmap_vector tmp;
+        tmp._fd = _make_temp();
+        tmp._shared = true;
+        _truncate(tmp._fd, bytes);
+        tmp._data = _map(tmp._fd, bytes, true);
+        tmp._capacity = cap;
+        if (_size)
+            std::memcpy(tmp._data, _data, _size * sizeof(value_type));
+        tmp._size = _size;
+        swap(tmp);
+    }
+};
+
+// -- aliases ------------------------------------------------------------------
+    ///
+    /// A sequence of @a char stored in a memory-mapped file
+    using mmap_sq = sq_gen<mmap_vector<char>>;
+
+}   // end gynx namespace
+
+#endif  //_GYNX_MMAP_VECTOR_HPP_
@@ -0,0 +1,365 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_NORMALIZE_HPP_
+#define _GYNX_NORMALIZE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include <gynx/simd.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/lut/alphabet.hpp>
+
+namespace gynx {
+
+/// Residue alphabets known to normalize().
+enum class alphabet
+{   dna       ///< A, C, G, T; U is read as T
+,   rna       ///< A, C, G, U; T is read as U
+,   iupac     ///< IUPAC nucleotide codes (A, C, G, T, U, R, Y, S, W, K, M, B,
+              ///< D, H, V, N) and '-'
+,   protein   ///< the 20 amino acids, B, Z, J, X, U, O, '*' and '-'
+};
+
+/// What normalize() does with the residues of a sequence.
+enum class normalization
+{   none       ///< nothing, residues are kept as read
+,   validate   ///< reports residues outside the alphabet, changes nothing
+,   uppercase  ///< uppercases residues (and maps U/T, see alphabet), reports
+               ///< residues outside the alphabet
+,   replace    ///< like uppercase, but replaces residues outside the
+               ///< alphabet by its wildcard ('N', or 'X' for protein)
+};
+
+namespace detail {
+
+struct alphabet_lookup
+{   const std::array<char, 32>* index = &lut::iupac_index;
+    const std::array<char, 256>* table = &lut::iupac_alphabet;
+    char extra[2] { '-', 0 };  // non-letters of the alphabet, 0 if unused
+    char wildcard = 'N';
+
+    explicit alphabet_lookup(alphabet a) noexcept
+    {   switch (a)
+        {   case alphabet::dna:
+                index = &lut::dna_index;
+                table = &lut::dna_alphabet;
+                extra[0] = 0;
+                break;
+            case alphabet::rna:
+                index = &lut::rna_index;
+                table = &lut::rna_alphabet;
+                extra[0] = 0;
+                break;
+            case alphabet::protein:
+                index = &lut::protein_index;
+                table = &lut::protein_alphabet;
+                extra[0] = '*';
+                extra[1] = '-';
+                wildcard = 'X';
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+// -- scalar kernel ------------------------------------------------------------
+
+// Returns the first residue of the input outside the alphabet (unless
+// replacing), or last. The output may be the input itself.
+inline const char* normalize_copy_scalar
+(   const char* first
+,   const char* last
+,   char* d_first
+,   const alphabet_lookup& a
+,   normalization p
+)   noexcept
+{   for (; first != last; ++first, ++d_first)
+    {   const char c = *first;
+        const char r = (*a.table)[static_cast<std::uint8_t>(c)];
+        if (r)
+            *d_first = normalization::validate == p ? c : r;
+        else if (normalization::replace == p)
+            *d_first = a.wildcard;
+        else
+        {   *d_first = c;
+            return first;
+        }
+    }
+    return last;
+}
+
+#if GYNX_SIMD_X86
+
+// All vector kernels look up the low five bits of each byte in the alphabet's
+// 32-entry index (two pshufb tables) and keep the result for letters only,
+// plus the alphabet's non-letters. A zero byte then marks a residue outside
+// the alphabet. A block with such a residue is redone by the scalar loop,
+// unless replacing, so the returned position is exact.
+
+// -- SSE4.2 -------------------------------------------------------------------
+
+GYNX_TARGET_SSE42
+inline const char* normalize_copy_sse42
+(   const char* first
+,   const char* last
+,   char* d_first
+,   const alphabet_lookup& a
+,   normalization p
+)   noexcept
+{   const __m128i lo = _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(a.index->data()));
+    const __m128i hi = _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(a.index->data() + 16));
+    const __m128i zero = _mm_setzero_si128();
+    for (; last - first >= 16; first += 16, d_first += 16)
+    {   const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i low = _mm_and_si128(x, _mm_set1_epi8(0x1F));
+        const __m128i t = _mm_sub_epi8
+            (_mm_or_si128(x, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i letter = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(25)), t);
+        __m128i r = _mm_and_si128
+        (   letter
+        ,   _mm_blendv_epi8
+            (   _mm_shuffle_epi8(lo, low)
+            ,   _mm_shuffle_epi8(hi, low)
+            ,   _mm_slli_epi16(low, 3)
+            )
+        );
+        for (char e : a.extra)
+            r = _mm_or_si128(r, _mm_and_si128(x, _mm_cmpeq_epi8(x, _mm_set1_epi8(e))));
+        const __m128i bad = _mm_cmpeq_epi8(r, zero);
+        if (normalization::replace == p)
+            r = _mm_blendv_epi8(r, _mm_set1_epi8(a.wildcard), bad);
+        else if (_mm_movemask_epi8(bad))
+            return normalize_copy_scalar(first, last, d_first, a, p);
+        else if (normalization::validate == p)
+            r = x;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d_first), r);
+    }
+    return normalize_copy_scalar(first, last, d_first, a, p);
+}
+
+// -- AVX2 ---------------------------------------------------------------------
+
+GYNX_TARGET_AVX2
+inline const char* normalize_copy_avx2
+(   const char* first
+,   const char* last
+,   char* d_first
+,   const alphabet_lookup& a
+,   normalization p
+)   noexcept
+{   const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(a.index->data())));
+    const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(a.index->data() + 16)));
+    const __m256i zero = _mm256_setzero_si256();
+    for (; last - first >= 32; first += 32, d_first += 32)
+    {   const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i low = _mm256_and_si256(x, _mm256_set1_epi8(0x1F));
+        const __m256i t = _mm256_sub_epi8
+            (_mm256_or_si256(x, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        const __m256i letter = _mm256_cmpeq_epi8
+            (_mm256_min_epu8(t, _mm256_set1_epi8(25)), t);
+        __m256i r = _mm256_and_si256
+        (   letter
+        ,   _mm256_blendv_epi8
+            (   _mm256_shuffle_epi8(lo, low)
+            ,   _mm256_shuffle_epi8(hi, low)
+            ,   _mm256_slli_epi16(low, 3)
+            )
+        );
+        for (char e : a.extra)
+            r = _mm256_or_si256
+                (r, _mm256_and_si256(x, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(e))));
+        const __m256i bad = _mm256_cmpeq_epi8(r, zero);
+        if (normalization::replace == p)
+            r = _mm256_blendv_epi8(r, _mm256_set1_epi8(a.wildcard), bad);
+        else if (_mm256_movemask_epi8(bad))
+            return normalize_copy_scalar(first, last, d_first, a, p);
+        else if (normalization::validate == p)
+            r = x;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d_first), r);
+    }
+    return normalize_copy_sse42(first, last, d_first, a, p);
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+GYNX_TARGET_AVX512
+inline const char* normalize_copy_avx512
+(   const char* first
+,   const char* last
+,   char* d_first
+,   const alphabet_lookup& a
+,   normalization p
+)   noexcept
+{   // maskz forms avoid GCC's maybe-uninitialized false positives
+    const __m512i lo = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(a.index->data())));
+    const __m512i hi = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(a.index->data() + 16)));
+    for (; last - first >= 64; first += 64, d_first += 64)
+    {   const __m512i x = _mm512_loadu_si512(first);
+        const __m512i low = _mm512_and_si512(x, _mm512_set1_epi8(0x1F));
+        const __m512i t = _mm512_sub_epi8
+            (_mm512_or_si512(x, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+        const __mmask64 letter = _mm512_cmple_epu8_mask(t, _mm512_set1_epi8(25));
+        __m512i r = _mm512_maskz_mov_epi8
+        (   letter
+        ,   _mm512_mask_blend_epi8
+            (   _mm512_test_epi8_mask(low, _mm512_set1_epi8(0x10))
+            ,   _mm512_shuffle_epi8(lo, low)
+            ,   _mm512_shuffle_epi8(hi, low)
+            )
+        );
+        for (char e : a.extra)
+            r = _mm512_mask_mov_epi8
+                (r, _mm512_cmpeq_epi8_mask(x, _mm512_set1_epi8(e)), x);
+        const __mmask64 bad = _mm512_testn_epi8_mask(r, r);
+        if (normalization::replace == p)
+            r = _mm512_mask_mov_epi8(r, bad, _mm512_set1_epi8(a.wildcard));
+        else if (bad)
+            return normalize_copy_scalar(first, last, d_first, a, p);
+        else if (normalization::validate == p)
+            r = x;
+        _mm512_storeu_si512(d_first, r);
+    }
+    return normalize_copy_avx2(first, last, d_first, a, p);
+}
+
+#endif  // GYNX_SIMD_X86
+
+}   // end gynx::detail namespace
+
+// -- raw buffers --------------------------------------------------------------
+///
+/// @brief Normalizes the residues of [@a first, @a last) to alphabet @a a
+/// according to policy @a p while copying them to the range beginning at
+/// @a d_first, which may be @a first itself (see gynx::normalization).
+/// @details Dispatches at runtime to the best of AVX-512, AVX2 and SSE4.2
+/// kernels (see gynx::simd::level()), falling back to a lookup-table loop.
+/// @return The first residue of the input outside the alphabet, where
+/// copying stopped, or @a last if there is none (always with
+/// normalization::replace).
+inline const char* normalize_copy
+(   const char* first
+,   const char* last
+,   char* d_first
+,   alphabet a
+,   normalization p
+)   noexcept
+{   if (normalization::none == p)
+    {   if (first != d_first)
+            std::copy(first, last, d_first);
+        return last;
+    }
+    const detail::alphabet_lookup t(a);
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return detail::normalize_copy_avx512(first, last, d_first, t, p);
+        case simd::isa::avx2:
+            return detail::normalize_copy_avx2(first, last, d_first, t, p);
+        case simd::isa::sse42:
+            return detail::normalize_copy_sse42(first, last, d_first, t, p);
+#endif
+        default:
+            return detail::normalize_copy_scalar(first, last, d_first, t, p);
+    }
+}
+///
+/// @brief Normalizes the residues of [@a first, @a last) in place.
+/// @return The first residue outside the alphabet, or @a last.
+inline char* normalize(char* first, char* last, alphabet a, normalization p) noexcept
+{   return const_cast<char*>(normalize_copy(first, last, first, a, p));
+}
+
+///
+/// @brief Normalizes the residues of [@a first, @a last) in place, in
+/// parallel blocks on @a pool.
+/// @details Unlike the serial version, blocks after the one holding the
+/// first residue outside the alphabet are normalized as well, each up to
+/// its own first such residue.
+/// @return The first residue outside the alphabet, or @a last.
+inline char* normalize
+(   char* first
+,   char* last
+,   alphabet a
+,   normalization p
+,   thread_pool& pool
+)
+{   const std::size_t n = static_cast<std::size_t>(last - first);
+    std::vector<std::size_t> bad
+        ((n + detail::parallel_block - 1) / detail::parallel_block, n);
+    parallel_chunks
+    (   pool
+    ,   n
+    ,   0
+    ,   [&](std::size_t i, std::size_t j)
+        {   const char* r = normalize(first + i, first + j, a, p);
+            if (r != first + j)
+                bad[i / detail::parallel_block] = static_cast<std::size_t>(r - first);
+        }
+    );
+    for (auto b : bad)
+        if (b != n)
+            return first + b;
+    return last;
+}
+
+// -- sequences ----------------------------------------------------------------
+///
+/// @brief Normalizes the residues of @a s (e.g. a gynx::sq) in place.
+/// @return The position of the first residue outside the alphabet, or the
+/// size of @a s if there is none.
+template<std::ranges::contiguous_range R>
+requires std::same_as<std::ranges::range_value_t<R>, char>
+std::size_t normalize(R& s, alphabet a, normalization p = normalization::uppercase)
+{   char* first = std::ranges::data(s);
+    return static_cast<std::size_t>
+        (normalize(first, first + std::ranges::size(s), a, p) - first);
+}
+///
+/// @brief Normalizes the residues of @a s in place, in parallel blocks on
+/// @a pool.
+/// @return The position of the first residue outside the alphabet, or the
+/// size of @a s if there is none.
+template<std::ranges::contiguous_range R>
+requires std::same_as<std::ranges::range_value_t<R>, char>
+std::size_t normalize(R& s, alphabet a, normalization p, thread_pool& pool)
+{   char* first = std::ranges::data(s);
+    return static_cast<std::size_t>
+        (normalize(first, first + std::ranges::size(s), a, p, pool) - first);
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_NORMALIZE_HPP_
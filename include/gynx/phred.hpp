@@ -0,0 +1,330 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_PHRED_HPP_
+#define _GYNX_PHRED_HPP_
+
+#include <algorithm>
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <gynx/simd.hpp>
+
+namespace gynx {
+
+/// @brief Offsets of FASTQ quality strings; the values are the ASCII codes
+/// of Phred score 0.
+enum class phred_encoding : unsigned
+{   unknown = 0    ///< not known (e.g. no quality strings)
+,   phred33 = 33   ///< Sanger, Illumina 1.8+ and long-read platforms
+,   phred64 = 64   ///< Illumina 1.3 to 1.7
+};
+
+/// @brief Smallest and largest quality characters seen, see
+/// gynx::quality_range().
+struct phred_range
+{   std::uint8_t min = 255;
+    std::uint8_t max = 0;
+
+    ///
+    /// Returns true if no quality character has been seen.
+    bool empty() const noexcept
+    {   return min > max;
+    }
+    phred_range& operator+= (const phred_range& rhs) noexcept
+    {   min = std::min(min, rhs.min);
+        max = std::max(max, rhs.max);
+        return *this;
+    }
+    friend bool operator== (const phred_range&, const phred_range&) = default;
+};
+
+namespace detail {
+
+// -- range kernels ------------------------------------------------------------
+
+inline void phred_range_scalar
+(   const char* first
+,   const char* last
+,   phred_range& r
+)   noexcept
+{   for (; first != last; ++first)
+    {   const auto c = static_cast<std::uint8_t>(*first);
+        r.min = std::min(r.min, c);
+        r.max = std::max(r.max, c);
+    }
+}
+
+// -- conversion kernels -------------------------------------------------------
+
+// Converts quality characters from offset 'from' to offset 'to', clamping
+// scores below 0 to 0 and characters above '~' to '~':
+// to + min(max(c - from, 0), '~' - to).
+
+inline void convert_phred_scalar
+(   char* first
+,   char* last
+,   std::uint8_t from
+,   std::uint8_t to
+)   noexcept
+{   const int top = '~' - to;
+    for (; first != last; ++first)
+        *first = static_cast<char>
+            (to + std::clamp(int(static_cast<std::uint8_t>(*first)) - from, 0, top));
+}
+
+#if GYNX_SIMD_X86
+
+// -- SSE4.2 -------------------------------------------------------------------
+
+GYNX_TARGET_SSE42
+inline const char* phred_range_sse42
+(   const char* first
+,   const char* last
+,   phred_range& r
+)   noexcept
+{   if (last - first < 16)
+        return first;
+    __m128i lo = _mm_set1_epi8(char(0xFF));
+    __m128i hi = _mm_setzero_si128();
+    for (; last - first >= 16; first += 16)
+    {   const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        lo = _mm_min_epu8(lo, x);
+        hi = _mm_max_epu8(hi, x);
+    }
+    alignas(16) std::uint8_t l[16], h[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(l), lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(h), hi);
+    r.min = std::min(r.min, *std::min_element(l, l + 16));
+    r.max = std::max(r.max, *std::max_element(h, h + 16));
+    return first;
+}
+
+GYNX_TARGET_SSE42
+inline char* convert_phred_sse42
+(   char* first
+,   char* last
+,   std::uint8_t from
+,   std::uint8_t to
+)   noexcept
+{   const __m128i f = _mm_set1_epi8(char(from));
+    const __m128i t = _mm_set1_epi8(char(to));
+    const __m128i top = _mm_set1_epi8(char('~' - to));
+    for (; last - first >= 16; first += 16)
+    {   const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        _mm_storeu_si128
+        (   reinterpret_cast<__m128i*>(first)
+        ,   _mm_add_epi8(_mm_min_epu8(_mm_subs_epu8(x, f), top), t)
+        );
+    }
+    return first;
+}
+
+// -- AVX2 ---------------------------------------------------------------------
+
+GYNX_TARGET_AVX2
+inline const char* phred_range_avx2
+(   const char* first
+,   const char* last
+,   phred_range& r
+)   noexcept
+{   if (last - first < 32)
+        return first;
+    __m256i lo = _mm256_set1_epi8(char(0xFF));
+    __m256i hi = _mm256_setzero_si256();
+    for (; last - first >= 32; first += 32)
+    {   const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        lo = _mm256_min_epu8(lo, x);
+        hi = _mm256_max_epu8(hi, x);
+    }
+    alignas(32) std::uint8_t l[32], h[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(l), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(h), hi);
+    r.min = std::min(r.min, *std::min_element(l, l + 32));
+    r.max = std::max(r.max, *std::max_element(h, h + 32));
+    return first;
+}
+
+GYNX_TARGET_AVX2
+inline char* convert_phred_avx2
+(   char* first
+,   char* last
+,   std::uint8_t from
+,   std::uint8_t to
+)   noexcept
+{   const __m256i f = _mm256_set1_epi8(char(from));
+    const __m256i t = _mm256_set1_epi8(char(to));
+    const __m256i top = _mm256_set1_epi8(char('~' - to));
+    for (; last - first >= 32; first += 32)
+    {   const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        _mm256_storeu_si256
+        (   reinterpret_cast<__m256i*>(first)
+        ,   _mm256_add_epi8(_mm256_min_epu8(_mm256_subs_epu8(x, f), top), t)
+        );
+    }
+    return first;
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+GYNX_TARGET_AVX512
+inline const char* phred_range_avx512
+(   const char* first
+,   const char* last
+,   phred_range& r
+)   noexcept
+{   if (last - first < 64)
+        return first;
+    __m512i lo = _mm512_set1_epi8(char(0xFF));
+    __m512i hi = _mm512_setzero_si512();
+    for (; last - first >= 64; first += 64)
+    {   const __m512i x = _mm512_loadu_si512(first);
+        lo = _mm512_min_epu8(lo, x);
+        hi = _mm512_max_epu8(hi, x);
+    }
+    alignas(64) std::uint8_t l[64], h[64];
+    _mm512_store_si512(l, lo);
+    _mm512_store_si512(h, hi);
+    r.min = std::min(r.min, *std::min_element(l, l + 64));
+    r.max = std::max(r.max, *std::max_element(h, h + 64));
+    return first;
+}
+
+GYNX_TARGET_AVX512
+inline char* convert_phred_avx512
+(   char* first
+,   char* last
+,   std::uint8_t from
+,   std::uint8_t to
+)   noexcept
+{   const __m512i f = _mm512_set1_epi8(char(from));
+    const __m512i t = _mm512_set1_epi8(char(to));
+    const __m512i top = _mm512_set1_epi8(char('~' - to));
+    for (; last - first >= 64; first += 64)
+    {   const __m512i x = _mm512_loadu_si512(first);
+        _mm512_storeu_si512
+        (   first
+        ,   _mm512_add_epi8(_mm512_min_epu8(_mm512_subs_epu8(x, f), top), t)
+        );
+    }
+    return first;
+}
+
+#endif  // GYNX_SIMD_X86
+
+}   // end gynx::detail namespace
+
+// -- detection ----------------------------------------------------------------
+///
+/// @brief Returns the smallest and largest characters of quality string
+/// @a qual.
+inline phred_range quality_range(std::string_view qual) noexcept
+{   phred_range r;
+    const char* first = qual.data();
+    const char* last = first + qual.size();
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            first = detail::phred_range_avx512(first, last, r);
+            [[fallthrough]];
+        case simd::isa::avx2:
+            first = detail::phred_range_avx2(first, last, r);
+            [[fallthrough]];
+        case simd::isa::sse42:
+            first = detail::phred_range_sse42(first, last, r);
+            [[fallthrough]];
+#endif
+        default:
+            detail::phred_range_scalar(first, last, r);
+    }
+    return r;
+}
+///
+/// @brief Returns the encoding of quality strings whose characters span
+/// @a r, the way FastQC guesses it: anything below '@' (Phred+64 score 0)
+/// can only be Phred+33, otherwise the file is taken for Phred+64.
+/// @details An empty range is phred_encoding::unknown. Sampling enough
+/// reads matters: high-quality Phred+33 data without a base below Q31 is
+/// indistinguishable from Phred+64. See gynx::in::detect_phred() for
+/// files.
+inline phred_encoding guess_phred(phred_range r) noexcept
+{   if (r.empty())
+        return phred_encoding::unknown;
+    return r.min < 64 ? phred_encoding::phred33 : phred_encoding::phred64;
+}
+
+// -- conversion ---------------------------------------------------------------
+///
+/// @brief Converts the quality characters of [@a first, @a last) in place
+/// from encoding @a from to encoding @a to.
+/// @details Scores that would fall below 0 become 0 and characters that
+/// would pass '~' become '~'. Nothing is done if either encoding is
+/// phred_encoding::unknown. Dispatches at runtime to the best of AVX-512,
+/// AVX2 and SSE4.2 kernels (see gynx::simd::level()).
+inline void convert_phred
+(   char* first
+,   char* last
+,   phred_encoding from
+,   phred_encoding to
+)   noexcept
+{   if (phred_encoding::unknown == from || phred_encoding::unknown == to || from == to)
+        return;
+    const auto f = static_cast<std::uint8_t>(from);
+    const auto t = static_cast<std::uint8_t>(to);
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            first = detail::convert_phred_avx512(first, last, f, t);
+            [[fallthrough]];
+        case simd::isa::avx2:
+            first = detail::convert_phred_avx2(first, last, f, t);
+            [[fallthrough]];
+        case simd::isa::sse42:
+            first = detail::convert_phred_sse42(first, last, f, t);
+            [[fallthrough]];
+#endif
+        default:
+            detail::convert_phred_scalar(first, last, f, t);
+    }
+}
+///
+/// Converts quality string @a qual in place from @a from to @a to.
+inline void convert_phred(std::string& qual, phred_encoding from, phred_encoding to) noexcept
+{   convert_phred(qual.data(), qual.data() + qual.size(), from, to);
+}
+///
+/// @brief Converts the "_qs" quality string of record @a r (e.g. a gynx::sq)
+/// in place from @a from to @a to. A record without qualities is left as is.
+template<typename Record>
+requires requires (Record& r) { r.has("_qs"); r["_qs"]; }
+void convert_phred(Record& r, phred_encoding from, phred_encoding to)
+{   if (r.has("_qs"))
+        convert_phred(std::any_cast<std::string&>(r["_qs"]), from, to);
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_PHRED_HPP_
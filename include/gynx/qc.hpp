@@ -0,0 +1,367 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_QC_HPP_
+#define _GYNX_QC_HPP_
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/io/fastaqz.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/composition.hpp>
+#include <gynx/lut/nucleotide.hpp>
+
+namespace gynx {
+
+/// Number of Phred score bins (0 to 93, the range of Phred+33).
+inline constexpr std::size_t qc_quality_bins = 94;
+
+/// @brief Options of gynx::qc_collector.
+struct qc_options
+{   unsigned offset = 33;             ///< Phred offset of quality strings
+    std::size_t max_positions = 1000; ///< read positions tracked one by one
+    std::size_t tracked_sequences = 100000;  ///< distinct sequences counted
+    double overrepresented = 0.001;   ///< fraction of reads to be reported
+    std::size_t batch_size = 4096;    ///< records per task
+};
+
+/// @brief A sequence seen in more than the overrepresented fraction of
+/// reads (the first 50 bases of reads longer than 75, as FastQC does).
+struct overrepresented_sequence
+{   std::string sequence;
+    std::uint64_t count = 0;
+    double fraction = 0.0;
+};
+
+/// @brief FastQC-style statistics of a set of reads, see
+/// gynx::qc_collector::report(). Every distribution is a plain array of
+/// counts, ready to print or plot.
+struct qc_report
+{   std::uint64_t reads = 0;
+    std::uint64_t bases = 0;
+    /// A, C, G, T and N (or any other residue) counts per read position
+    std::vector<std::array<std::uint64_t, 5>> base_counts;
+    /// Phred score counts per read position
+    std::vector<std::array<std::uint64_t, qc_quality_bins>> quality_counts;
+    /// number of reads of every length
+    std::map<std::size_t, std::uint64_t> lengths;
+    /// number of reads by GC percentage (of A/C/G/T bases), 0 to 100
+    std::array<std::uint64_t, 101> gc_counts{};
+    /// number of reads by rounded mean Phred score
+    std::array<std::uint64_t, qc_quality_bins> mean_quality_counts{};
+    /// overrepresented sequences, most frequent first
+    std::vector<overrepresented_sequence> overrepresented;
+
+    ///
+    /// Returns the number of positions with statistics.
+    std::size_t positions() const noexcept
+    {   return base_counts.size();
+    }
+    ///
+    /// Returns the mean Phred score at read position @a pos.
+    double mean_quality(std::size_t pos) const noexcept
+    {   std::uint64_t n = 0, s = 0;
+        for (std::size_t q = 0; q < qc_quality_bins; ++q)
+        {   n += quality_counts[pos][q];
+            s += q * quality_counts[pos][q];
+        }
+        return n ? double(s) / double(n) : 0.0;
+    }
+    ///
+    /// @brief Returns the Phred score below which fraction @a p of the
+    /// bases at read position @a pos fall (0.5 for the median, 0.25 and
+    /// 0.75 for the quartiles, 0.1 and 0.9 for FastQC's whiskers).
+    unsigned quality_quantile(std::size_t pos, double p) const noexcept
+    {   std::uint64_t n = 0;
+        for (auto c : quality_counts[pos])
+            n += c;
+        const double target = p * double(n);
+        std::uint64_t acc = 0;
+        for (std::size_t q = 0; q < qc_quality_bins; ++q)
+        {   acc += quality_counts[pos][q];
+            if (n && double(acc) >= target && acc)
+                return unsigned(q);
+        }
+        return 0;
+    }
+    ///
+    /// Returns the fraction of N (and other non-ACGT) residues at @a pos.
+    double n_content(std::size_t pos) const noexcept
+    {   const auto& b = base_counts[pos];
+        const std::uint64_t n = b[0] + b[1] + b[2] + b[3] + b[4];
+        return n ? double(b[4]) / double(n) : 0.0;
+    }
+    ///
+    /// Returns the GC fraction of the A/C/G/T bases at @a pos.
+    double gc_content(std::size_t pos) const noexcept
+    {   const auto& b = base_counts[pos];
+        const std::uint64_t n = b[0] + b[1] + b[2] + b[3];
+        return n ? double(b[1] + b[2]) / double(n) : 0.0;
+    }
+};
+
+/// @brief Accumulates FastQC-style statistics of reads: per-position base
+/// composition, N content and quality distributions, read lengths, per-read
+/// GC content and mean quality, and overrepresented sequences.
+/// @details add() accumulates one record on the calling thread. add_each()
+/// and add_file() spread batches of records over a thread pool, each task
+/// accumulating into a private collector that is merged into this one at
+/// the end, so workers never share counters. Positions beyond
+/// qc_options::max_positions only count towards per-read statistics.
+/// Like FastQC, only the first qc_options::tracked_sequences distinct
+/// sequences are counted for overrepresentation (per worker).
+class qc_collector
+{   struct _key_hash
+    {   using is_transparent = void;
+        std::size_t operator() (std::string_view s) const noexcept
+        {   return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    qc_options _o;
+    std::array<std::uint8_t, 256> _phred{};     // character -> clamped score
+    std::uint64_t _reads = 0;
+    std::uint64_t _bases = 0;
+    std::vector<std::array<std::uint64_t, 5>> _base;
+    std::vector<std::array<std::uint64_t, qc_quality_bins>> _qual;
+    std::map<std::size_t, std::uint64_t> _lengths;
+    std::array<std::uint64_t, 101> _gc{};
+    std::array<std::uint64_t, qc_quality_bins> _mean{};
+    std::unordered_map<std::string, std::uint64_t, _key_hash, std::equal_to<>> _seqs;
+
+    void _add(const char* s, std::size_t n, const std::string* qs)
+    {   ++_reads;
+        _bases += n;
+        ++_lengths[n];
+        const std::size_t m = std::min(n, _o.max_positions);
+        if (_base.size() < m)
+            _base.resize(m);
+        for (std::size_t i = 0; i < m; ++i)
+            ++_base[i][std::min<unsigned>(lut::nt_class[static_cast<std::uint8_t>(s[i])], 4)];
+        const auto k = detail::count_acgtn(s, s + n);
+        const std::uint64_t acgt = k[0] + k[1] + k[2] + k[3];
+        if (acgt)
+            ++_gc[(200 * (k[1] + k[2]) + acgt) / (2 * acgt)];
+        if (qs && ! qs->empty())
+        {   const std::size_t mq = std::min(qs->size(), _o.max_positions);
+            if (_qual.size() < mq)
+                _qual.resize(mq);
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < mq; ++i)
+            {   const auto q = _phred[static_cast<std::uint8_t>((*qs)[i])];
+                sum += q;
+                ++_qual[i][q];
+            }
+            for (std::size_t i = mq; i < qs->size(); ++i)
+                sum += _phred[static_cast<std::uint8_t>((*qs)[i])];
+            ++_mean[(2 * sum + qs->size()) / (2 * qs->size())];
+        }
+        const std::string_view key(s, n > 75 ? 50 : n);
+        if (auto it = _seqs.find(key); it != _seqs.end())
+            ++it->second;
+        else if (_seqs.size() < _o.tracked_sequences)
+            _seqs.emplace(key, 1);
+    }
+
+    // calls submit_all(run), where run(f) calls f(collector&) with a
+    // collector that no other task uses at the time, then merges the
+    // collectors into this one
+    template<typename Submit>
+    void _parallel(Submit submit_all)
+    {   std::vector<std::unique_ptr<qc_collector>> locals;
+        std::vector<qc_collector*> free;
+        std::mutex mutex;
+        auto run = [&](auto&& body)
+        {   qc_collector* c;
+            {   std::lock_guard<std::mutex> lock(mutex);
+                if (free.empty())
+                {   locals.push_back(std::make_unique<qc_collector>(_o));
+                    free.push_back(locals.back().get());
+                }
+                c = free.back();
+                free.pop_back();
+            }
+            body(*c);
+            std::lock_guard<std::mutex> lock(mutex);
+            free.push_back(c);
+        };
+        submit_all(run);
+        for (const auto& c : locals)
+            merge(*c);
+    }
+
+public:
+    ///
+    /// Creates an empty collector.
+    explicit qc_collector(qc_options o = {})
+    :   _o(o)
+    {   for (unsigned c = 0; c < 256; ++c)
+            _phred[c] = std::uint8_t(std::min<unsigned>
+            (   std::max(c, _o.offset) - _o.offset
+            ,   qc_quality_bins - 1
+            ));
+    }
+
+// -- accumulating -------------------------------------------------------------
+    ///
+    /// Adds record @a r and its "_qs" quality string, if any.
+    template<typename Container, typename Map>
+    void add(const sq_gen<Container, Map>& r)
+    {   const std::string* qs = r.has("_qs")
+        ?   &std::any_cast<const std::string&>(r["_qs"])
+        :   nullptr;
+        _add(r.data(), r.size(), qs);
+    }
+    ///
+    /// Adds the records in @a records in parallel on @a pool.
+    template<std::ranges::random_access_range R>
+    void add_each(const R& records, thread_pool& pool = thread_pool::global())
+    {   const std::size_t n = std::ranges::size(records);
+        const std::size_t chunk = std::max<std::size_t>(_o.batch_size, 1);
+        _parallel
+        (   [&](auto& run)
+            {   parallel_for
+                (   pool
+                ,   (n + chunk - 1) / chunk
+                ,   [&](std::size_t t)
+                    {   run([&](qc_collector& c)
+                        {   const std::size_t end = std::min(n, (t + 1) * chunk);
+                            for (std::size_t i = t * chunk; i < end; ++i)
+                                c.add(records[i]);
+                        });
+                    }
+                );
+            }
+        );
+    }
+    ///
+    /// @brief Adds every record of @a filename, read with gynx::in::fast_aqz
+    /// and accumulated in batches on @a pool with gynx::parallel_pipeline().
+    /// Returns the number of records.
+    template<typename Sequence = sq>
+    std::size_t add_file
+    (   std::string_view filename
+    ,   thread_pool& pool = thread_pool::global()
+    ,   in::fast_aqz<Sequence> reader = {}
+    )
+    {   typedef std::vector<Sequence> batch_type;
+        std::size_t n{};
+        _parallel
+        (   [&](auto& run)
+            {   parallel_pipeline<batch_type>
+                (   pool
+                ,   [&](auto& submit)
+                    {   auto batch = std::make_shared<batch_type>();
+                        n = reader
+                        (   filename
+                        ,   [&](Sequence&& s)
+                            {   batch->push_back(std::move(s));
+                                if (batch->size() >= _o.batch_size)
+                                    submit(std::exchange(batch, std::make_shared<batch_type>()));
+                            }
+                        );
+                        if (! batch->empty())
+                            submit(std::move(batch));
+                    }
+                ,   [&run](batch_type& b)
+                    {   run([&](qc_collector& c)
+                        {   for (const auto& r : b)
+                                c.add(r);
+                        });
+                    }
+                );
+            }
+        );
+        return n;
+    }
+    ///
+    /// Adds the statistics of @a other to this collector.
+    void merge(const qc_collector& other)
+    {   _reads += other._reads;
+        _bases += other._bases;
+        if (_base.size() < other._base.size())
+            _base.resize(other._base.size());
+        for (std::size_t i = 0; i < other._base.size(); ++i)
+            for (std::size_t j = 0; j < 5; ++j)
+                _base[i][j] += other._base[i][j];
+        if (_qual.size() < other._qual.size())
+            _qual.resize(other._qual.size());
+        for (std::size_t i = 0; i < other._qual.size(); ++i)
+            for (std::size_t j = 0; j < qc_quality_bins; ++j)
+                _qual[i][j] += other._qual[i][j];
+        for (const auto& [len, c] : other._lengths)
+            _lengths[len] += c;
+        for (std::size_t i = 0; i < _gc.size(); ++i)
+            _gc[i] += other._gc[i];
+        for (std::size_t i = 0; i < _mean.size(); ++i)
+            _mean[i] += other._mean[i];
+        for (const auto& [s, c] : other._seqs)
+            _seqs[s] += c;
+    }
+
+// -- results ------------------------------------------------------------------
+    ///
+    /// Returns the number of reads added.
+    std::uint64_t reads() const noexcept
+    {   return _reads;
+    }
+    ///
+    /// Returns the statistics accumulated so far.
+    qc_report report() const
+    {   qc_report r;
+        r.reads = _reads;
+        r.bases = _bases;
+        r.base_counts = _base;
+        r.quality_counts = _qual;
+        r.lengths = _lengths;
+        r.gc_counts = _gc;
+        r.mean_quality_counts = _mean;
+        for (const auto& [s, c] : _seqs)
+            if (_reads && double(c) > _o.overrepresented * double(_reads))
+                r.overrepresented.push_back({ s, c, double(c) / double(_reads) });
+        std::sort
+        (   r.overrepresented.begin()
+        ,   r.overrepresented.end()
+        ,   [](const auto& a, const auto& b)
+            {   return a.count != b.count ? a.count > b.count : a.sequence < b.sequence;
+            }
+        );
+        return r;
+    }
+};
+
+}   // end gynx namespace
+
+#endif  // _GYNX_QC_HPP_
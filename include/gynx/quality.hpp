@@ -0,0 +1,398 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_QUALITY_HPP_
+#define _GYNX_QUALITY_HPP_
+
+#include <algorithm>
+#include <any>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/lut/phred.hpp>
+
+namespace gynx {
+
+/// @brief Quality summary of one read, see quality_summary().
+struct read_quality
+{   std::size_t length = 0;
+    double expected_errors = 0.0;  ///< sum of the error probabilities
+    double mean = 0.0;             ///< mean Phred score
+    unsigned min = 0;              ///< lowest Phred score (0 if empty)
+    std::size_t below = 0;         ///< bases below the threshold
+};
+
+namespace detail {
+
+// Error probabilities are summed in float lanes and flushed to a double
+// every quality_flush bases, which keeps long reads accurate.
+inline constexpr std::size_t quality_flush = 4096;
+
+inline float phred_error_of(char c, unsigned offset) noexcept
+{   const unsigned q = std::max<unsigned>(static_cast<std::uint8_t>(c), offset) - offset;
+    return lut::phred_error[std::min(q, 127u)];
+}
+
+// -- scalar kernels -----------------------------------------------------------
+
+inline double expected_errors_scalar
+(   const char* q
+,   std::size_t n
+,   unsigned offset
+)   noexcept
+{   double ee = 0.0;
+    for (std::size_t i = 0; i < n; )
+    {   const std::size_t end = std::min(n, i + quality_flush);
+        // four accumulators keep the float adds from serializing
+        float s[4] {};
+        for (; i + 4 <= end; i += 4)
+            for (int j = 0; j < 4; ++j)
+                s[j] += phred_error_of(q[i + j], offset);
+        for (; i < end; ++i)
+            s[0] += phred_error_of(q[i], offset);
+        ee += double(s[0] + s[1]) + double(s[2] + s[3]);
+    }
+    return ee;
+}
+
+inline void quality_summary_scalar
+(   const char* q
+,   std::size_t n
+,   unsigned threshold
+,   unsigned offset
+,   read_quality& r
+,   std::uint64_t& sum
+,   unsigned& min
+)   noexcept
+{   for (std::size_t i = 0; i < n; ++i)
+    {   const unsigned c = std::max<unsigned>(static_cast<std::uint8_t>(q[i]), offset);
+        sum += c;
+        min = std::min(min, c);
+        r.below += c < threshold + offset;
+    }
+    r.expected_errors += expected_errors_scalar(q, n, offset);
+}
+
+#if GYNX_SIMD_X86
+
+// -- AVX2 ---------------------------------------------------------------------
+
+// error probabilities of 8 quality characters gathered from lut::phred_error
+GYNX_TARGET_AVX2
+inline __m256 phred_error_avx2(__m128i c8, __m256i offset) noexcept
+{   __m256i q = _mm256_sub_epi32(_mm256_cvtepu8_epi32(c8), offset);
+    q = _mm256_min_epi32(_mm256_max_epi32(q, _mm256_setzero_si256()), _mm256_set1_epi32(127));
+    return _mm256_i32gather_ps(lut::phred_error.data(), q, 4);
+}
+
+GYNX_TARGET_AVX2
+inline double expected_errors_avx2
+(   const char* q
+,   std::size_t n
+,   unsigned offset
+)   noexcept
+{   const __m256i off = _mm256_set1_epi32(int(offset));
+    double ee = 0.0;
+    std::size_t i = 0;
+    while (i + 32 <= n)
+    {   const std::size_t end = std::min(n, i + quality_flush);
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+        for (; i + 32 <= end; i += 32)
+        {   const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i));
+            const __m128i lo = _mm256_castsi256_si128(c);
+            const __m128i hi = _mm256_extracti128_si256(c, 1);
+            s0 = _mm256_add_ps(s0, phred_error_avx2(lo, off));
+            s1 = _mm256_add_ps(s1, phred_error_avx2(_mm_unpackhi_epi64(lo, lo), off));
+            s0 = _mm256_add_ps(s0, phred_error_avx2(hi, off));
+            s1 = _mm256_add_ps(s1, phred_error_avx2(_mm_unpackhi_epi64(hi, hi), off));
+        }
+        alignas(32) float v[8];
+        _mm256_store_ps(v, _mm256_add_ps(s0, s1));
+        ee += double(v[0] + v[1] + v[2] + v[3]) + double(v[4] + v[5] + v[6] + v[7]);
+    }
+    // short reads end in up to three more groups of 8
+    if (i + 8 <= n)
+    {   __m256 s = _mm256_setzero_ps();
+        for (; i + 8 <= n; i += 8)
+            s = _mm256_add_ps(s, phred_error_avx2(_mm_loadl_epi64
+                (reinterpret_cast<const __m128i*>(q + i)), off));
+        alignas(32) float v[8];
+        _mm256_store_ps(v, s);
+        ee += double(v[0] + v[1] + v[2] + v[3]) + double(v[4] + v[5] + v[6] + v[7]);
+    }
+    return ee + expected_errors_scalar(q + i, n - i, offset);
+}
+
+GYNX_TARGET_AVX2
+inline void quality_summary_avx2
+(   const char* q
+,   std::size_t n
+,   unsigned threshold
+,   unsigned offset
+,   read_quality& r
+,   std::uint64_t& sum
+,   unsigned& min
+)   noexcept
+{   const __m256i floor = _mm256_set1_epi8(char(offset));
+    const __m256i limit = _mm256_set1_epi8(char(std::min(threshold + offset, 255u)));
+    __m256i m = _mm256_set1_epi8(char(0xFF));
+    __m256i s = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {   const __m256i c = _mm256_max_epu8
+            (_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i)), floor);
+        s = _mm256_add_epi64(s, _mm256_sad_epu8(c, _mm256_setzero_si256()));
+        m = _mm256_min_epu8(m, c);
+        // c >= limit where max(c, limit) == c
+        const unsigned ge = _mm256_movemask_epi8
+            (_mm256_cmpeq_epi8(_mm256_max_epu8(c, limit), c));
+        r.below += 32 - std::popcount(ge);
+    }
+    alignas(32) std::uint64_t sv[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(sv), s);
+    sum += sv[0] + sv[1] + sv[2] + sv[3];
+    alignas(32) std::uint8_t mv[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mv), m);
+    for (auto x : mv)
+        min = std::min<unsigned>(min, x);
+    r.expected_errors += expected_errors_avx2(q, i, offset);
+    quality_summary_scalar(q + i, n - i, threshold, offset, r, sum, min);
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+GYNX_TARGET_AVX512
+inline __m512 phred_error_avx512(__m128i c16, __m512i offset) noexcept
+{   __m512i q = _mm512_sub_epi32(_mm512_maskz_cvtepu8_epi32(0xFFFF, c16), offset);
+    q = _mm512_maskz_min_epi32
+    (   0xFFFF
+    ,   _mm512_maskz_max_epi32(0xFFFF, q, _mm512_setzero_si512())
+    ,   _mm512_set1_epi32(127)
+    );
+    return _mm512_mask_i32gather_ps
+        (_mm512_setzero_ps(), 0xFFFF, q, lut::phred_error.data(), 4);
+}
+
+GYNX_TARGET_AVX512
+inline double expected_errors_avx512
+(   const char* q
+,   std::size_t n
+,   unsigned offset
+)   noexcept
+{   const __m512i off = _mm512_set1_epi32(int(offset));
+    double ee = 0.0;
+    std::size_t i = 0;
+    while (i + 64 <= n)
+    {   const std::size_t end = std::min(n, i + quality_flush);
+        __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+        for (; i + 64 <= end; i += 64)
+        {   const char* p = q + i;
+            s0 = _mm512_add_ps(s0, phred_error_avx512(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), off));
+            s1 = _mm512_add_ps(s1, phred_error_avx512(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), off));
+            s0 = _mm512_add_ps(s0, phred_error_avx512(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)), off));
+            s1 = _mm512_add_ps(s1, phred_error_avx512(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)), off));
+        }
+        alignas(64) float v[16];
+        _mm512_store_ps(v, _mm512_add_ps(s0, s1));
+        float t = 0.0f;
+        for (auto x : v)
+            t += x;
+        ee += t;
+    }
+    return ee + expected_errors_avx2(q + i, n - i, offset);
+}
+
+GYNX_TARGET_AVX512
+inline void quality_summary_avx512
+(   const char* q
+,   std::size_t n
+,   unsigned threshold
+,   unsigned offset
+,   read_quality& r
+,   std::uint64_t& sum
+,   unsigned& min
+)   noexcept
+{   const __m512i floor = _mm512_set1_epi8(char(offset));
+    const __m512i limit = _mm512_set1_epi8(char(std::min(threshold + offset, 255u)));
+    __m512i m = _mm512_set1_epi8(char(0xFF));
+    __m512i s = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {   const __m512i c = _mm512_max_epu8(_mm512_loadu_si512(q + i), floor);
+        s = _mm512_add_epi64(s, _mm512_sad_epu8(c, _mm512_setzero_si512()));
+        m = _mm512_min_epu8(m, c);
+        r.below += std::popcount(_mm512_cmplt_epu8_mask(c, limit));
+    }
+    alignas(64) std::uint64_t sv[8];
+    _mm512_store_si512(sv, s);
+    for (auto x : sv)
+        sum += x;
+    alignas(64) std::uint8_t mv[64];
+    _mm512_store_si512(mv, m);
+    for (auto x : mv)
+        min = std::min<unsigned>(min, x);
+    r.expected_errors += expected_errors_avx512(q, i, offset);
+    quality_summary_avx2(q + i, n - i, threshold, offset, r, sum, min);
+}
+
+#endif  // GYNX_SIMD_X86
+
+template<typename Container, typename Map>
+std::string_view quality_string(const sq_gen<Container, Map>& r)
+{   if (! r.has("_qs"))
+        throw std::invalid_argument("gynx::quality: record has no quality string");
+    return std::any_cast<const std::string&>(r["_qs"]);
+}
+
+}   // end gynx::detail namespace
+
+// -- single reads -------------------------------------------------------------
+///
+/// @brief Returns the expected number of errors of quality string @a qual
+/// with Phred @a offset (33 or 64): the sum of 10^(-Q/10) over its bases.
+/// @details Error probabilities are gathered from the 512-byte float table
+/// gynx::lut::phred_error, 8 or 16 at a time with AVX2 or AVX-512 (see
+/// gynx::simd::level()). Characters below @a offset count as Q0.
+inline double expected_errors(std::string_view qual, unsigned offset = 33) noexcept
+{   switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return detail::expected_errors_avx512(qual.data(), qual.size(), offset);
+        case simd::isa::avx2:
+            return detail::expected_errors_avx2(qual.data(), qual.size(), offset);
+#endif
+        default:
+            return detail::expected_errors_scalar(qual.data(), qual.size(), offset);
+    }
+}
+///
+/// @brief Returns the expected errors, mean and minimum Phred score and the
+/// number of bases below @a threshold of quality string @a qual, in one
+/// pass.
+/// @details Scores are summed with psadbw, and the minimum and the
+/// threshold test use byte min/max. Characters below @a offset count as Q0.
+inline read_quality quality_summary
+(   std::string_view qual
+,   unsigned threshold = 20
+,   unsigned offset = 33
+)   noexcept
+{   read_quality r;
+    r.length = qual.size();
+    if (qual.empty())
+        return r;
+    std::uint64_t sum = 0;
+    unsigned min = 255;
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            detail::quality_summary_avx512(qual.data(), qual.size(), threshold, offset, r, sum, min);
+            break;
+        case simd::isa::avx2:
+            detail::quality_summary_avx2(qual.data(), qual.size(), threshold, offset, r, sum, min);
+            break;
+#endif
+        default:
+            detail::quality_summary_scalar(qual.data(), qual.size(), threshold, offset, r, sum, min);
+    }
+    r.mean = double(sum - std::uint64_t(offset) * r.length) / double(r.length);
+    r.min = min - offset;
+    return r;
+}
+///
+/// Returns expected_errors() of the "_qs" quality string of record @a r.
+/// Throws std::invalid_argument if @a r has none.
+template<typename Container, typename Map>
+double expected_errors(const sq_gen<Container, Map>& r, unsigned offset = 33)
+{   return expected_errors(detail::quality_string(r), offset);
+}
+///
+/// Returns quality_summary() of the "_qs" quality string of record @a r.
+/// Throws std::invalid_argument if @a r has none.
+template<typename Container, typename Map>
+read_quality quality_summary
+(   const sq_gen<Container, Map>& r
+,   unsigned threshold = 20
+,   unsigned offset = 33
+)
+{   return quality_summary(detail::quality_string(r), threshold, offset);
+}
+
+// -- batches ------------------------------------------------------------------
+///
+/// @brief Returns expected_errors() of every record in @a records, computed
+/// in parallel on @a pool.
+template<std::ranges::random_access_range R>
+std::vector<double> expected_errors_each
+(   const R& records
+,   unsigned offset = 33
+,   thread_pool& pool = thread_pool::global()
+)
+{   std::vector<double> out(std::ranges::size(records));
+    constexpr std::size_t chunk = 1024;
+    parallel_for
+    (   pool
+    ,   (out.size() + chunk - 1) / chunk
+    ,   [&](std::size_t t)
+        {   const std::size_t end = std::min(out.size(), (t + 1) * chunk);
+            for (std::size_t i = t * chunk; i < end; ++i)
+                out[i] = expected_errors(records[i], offset);
+        }
+    );
+    return out;
+}
+///
+/// @brief Returns quality_summary() of every record in @a records, computed
+/// in parallel on @a pool.
+template<std::ranges::random_access_range R>
+std::vector<read_quality> quality_summary_each
+(   const R& records
+,   unsigned threshold = 20
+,   unsigned offset = 33
+,   thread_pool& pool = thread_pool::global()
+)
+{   std::vector<read_quality> out(std::ranges::size(records));
+    constexpr std::size_t chunk = 1024;
+    parallel_for
+    (   pool
+    ,   (out.size() + chunk - 1) / chunk
+    ,   [&](std::size_t t)
+        {   const std::size_t end = std::min(out.size(), (t + 1) * chunk);
+            for (std::size_t i = t * chunk; i < end; ++i)
+                out[i] = quality_summary(records[i], threshold, offset);
+        }
+    );
+    return out;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_QUALITY_HPP_
@@ -0,0 +1,417 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_REVERSE_COMPLEMENT_HPP_
+#define _GYNX_REVERSE_COMPLEMENT_HPP_
+
+#include <algorithm>
+#include <any>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/lut/complement.hpp>
+
+namespace gynx {
+
+namespace detail {
+
+// -- scalar kernels -----------------------------------------------------------
+
+inline void reverse_complement_scalar(char* first, char* last) noexcept
+{   while (last - first > 1)
+    {   --last;
+        const char a = *first;
+        *first++ = lut::complement[static_cast<std::uint8_t>(*last)];
+        *last = lut::complement[static_cast<std::uint8_t>(a)];
+    }
+    if (first != last)
+        *first = lut::complement[static_cast<std::uint8_t>(*first)];
+}
+
+inline char* reverse_complement_copy_scalar
+(   const char* first
+,   const char* last
+,   char* d_first
+)   noexcept
+{   while (last != first)
+        *d_first++ = lut::complement[static_cast<std::uint8_t>(*--last)];
+    return d_first;
+}
+
+#if GYNX_SIMD_X86
+
+// All vector kernels complement a letter by looking up its low five bits in
+// lut::complement_index (two 16-byte pshufb tables), keep the case bits and
+// pass non-letters through unchanged, then reverse the byte order.
+
+// -- SSE4.2 -------------------------------------------------------------------
+
+GYNX_TARGET_SSE42
+inline __m128i reverse_complement_sse42(__m128i x) noexcept
+{   const __m128i lo = _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(lut::complement_index.data()));
+    const __m128i hi = _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(lut::complement_index.data() + 16));
+    const __m128i rev = _mm_setr_epi8
+        (15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i nib = _mm_and_si128(x, _mm_set1_epi8(0x0F));
+    const __m128i b4 = _mm_set1_epi8(0x10);
+    const __m128i comp = _mm_blendv_epi8
+    (   _mm_shuffle_epi8(lo, nib)
+    ,   _mm_shuffle_epi8(hi, nib)
+    ,   _mm_cmpeq_epi8(_mm_and_si128(x, b4), b4)
+    );
+    const __m128i t = _mm_sub_epi8
+        (_mm_or_si128(x, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i letter = _mm_cmpeq_epi8
+        (_mm_min_epu8(t, _mm_set1_epi8(25)), t);
+    const __m128i res = _mm_blendv_epi8
+    (   x
+    ,   _mm_or_si128(_mm_and_si128(x, _mm_set1_epi8(char(0xE0))), comp)
+    ,   letter
+    );
+    return _mm_shuffle_epi8(res, rev);
+}
+
+GYNX_TARGET_SSE42
+inline void reverse_complement_sse42(char* first, char* last) noexcept
+{   while (last - first >= 32)
+    {   last -= 16;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last));
+        _mm_storeu_si128
+            (reinterpret_cast<__m128i*>(first), reverse_complement_sse42(b));
+        _mm_storeu_si128
+            (reinterpret_cast<__m128i*>(last), reverse_complement_sse42(a));
+        first += 16;
+    }
+    reverse_complement_scalar(first, last);
+}
+
+GYNX_TARGET_SSE42
+inline char* reverse_complement_copy_sse42
+(   const char* first
+,   const char* last
+,   char* d_first
+)   noexcept
+{   while (last - first >= 16)
+    {   last -= 16;
+        _mm_storeu_si128
+        (   reinterpret_cast<__m128i*>(d_first)
+        ,   reverse_complement_sse42
+                (_mm_loadu_si128(reinterpret_cast<const __m128i*>(last)))
+        );
+        d_first += 16;
+    }
+    return reverse_complement_copy_scalar(first, last, d_first);
+}
+
+// -- AVX2 ---------------------------------------------------------------------
+
+GYNX_TARGET_AVX2
+inline __m256i reverse_complement_avx2(__m256i x) noexcept
+{   const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(lut::complement_index.data())));
+    const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(lut::complement_index.data() + 16)));
+    const __m256i rev = _mm256_setr_epi8
+    (   15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+    ,   15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+    );
+    const __m256i nib = _mm256_and_si256(x, _mm256_set1_epi8(0x0F));
+    const __m256i b4 = _mm256_set1_epi8(0x10);
+    const __m256i comp = _mm256_blendv_epi8
+    (   _mm256_shuffle_epi8(lo, nib)
+    ,   _mm256_shuffle_epi8(hi, nib)
+    ,   _mm256_cmpeq_epi8(_mm256_and_si256(x, b4), b4)
+    );
+    const __m256i t = _mm256_sub_epi8
+        (_mm256_or_si256(x, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i letter = _mm256_cmpeq_epi8
+        (_mm256_min_epu8(t, _mm256_set1_epi8(25)), t);
+    const __m256i res = _mm256_blendv_epi8
+    (   x
+    ,   _mm256_or_si256(_mm256_and_si256(x, _mm256_set1_epi8(char(0xE0))), comp)
+    ,   letter
+    );
+    // reverse within each 128-bit lane, then swap the lanes
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(res, rev), 0x4E);
+}
+
+GYNX_TARGET_AVX2
+inline void reverse_complement_avx2(char* first, char* last) noexcept
+{   while (last - first >= 64)
+    {   last -= 32;
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last));
+        _mm256_storeu_si256
+            (reinterpret_cast<__m256i*>(first), reverse_complement_avx2(b));
+        _mm256_storeu_si256
+            (reinterpret_cast<__m256i*>(last), reverse_complement_avx2(a));
+        first += 32;
+    }
+    reverse_complement_sse42(first, last);
+}
+
+GYNX_TARGET_AVX2
+inline char* reverse_complement_copy_avx2
+(   const char* first
+,   const char* last
+,   char* d_first
+)   noexcept
+{   while (last - first >= 32)
+    {   last -= 32;
+        _mm256_storeu_si256
+        (   reinterpret_cast<__m256i*>(d_first)
+        ,   reverse_complement_avx2
+                (_mm256_loadu_si256(reinterpret_cast<const __m256i*>(last)))
+        );
+        d_first += 32;
+    }
+    return reverse_complement_copy_sse42(first, last, d_first);
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+GYNX_TARGET_AVX512
+inline __m512i reverse_complement_avx512(__m512i x) noexcept
+{   // maskz forms avoid GCC's maybe-uninitialized false positives
+    const __m512i lo = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(lut::complement_index.data())));
+    const __m512i hi = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128
+        (reinterpret_cast<const __m128i*>(lut::complement_index.data() + 16)));
+    const __m512i rev = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_setr_epi8
+        (15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    const __m512i nib = _mm512_and_si512(x, _mm512_set1_epi8(0x0F));
+    const __m512i comp = _mm512_mask_blend_epi8
+    (   _mm512_test_epi8_mask(x, _mm512_set1_epi8(0x10))
+    ,   _mm512_shuffle_epi8(lo, nib)
+    ,   _mm512_shuffle_epi8(hi, nib)
+    );
+    const __m512i t = _mm512_sub_epi8
+        (_mm512_or_si512(x, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+    const __m512i res = _mm512_mask_blend_epi8
+    (   _mm512_cmple_epu8_mask(t, _mm512_set1_epi8(25))
+    ,   x
+    ,   _mm512_or_si512(_mm512_and_si512(x, _mm512_set1_epi8(char(0xE0))), comp)
+    );
+    // reverse within each 128-bit lane, then reverse the order of the lanes
+    return _mm512_maskz_permutexvar_epi64
+    (   0xFF
+    ,   _mm512_setr_epi64(6, 7, 4, 5, 2, 3, 0, 1)
+    ,   _mm512_shuffle_epi8(res, rev)
+    );
+}
+
+GYNX_TARGET_AVX512
+inline void reverse_complement_avx512(char* first, char* last) noexcept
+{   while (last - first >= 128)
+    {   last -= 64;
+        const __m512i a = _mm512_loadu_si512(first);
+        const __m512i b = _mm512_loadu_si512(last);
+        _mm512_storeu_si512(first, reverse_complement_avx512(b));
+        _mm512_storeu_si512(last, reverse_complement_avx512(a));
+        first += 64;
+    }
+    reverse_complement_avx2(first, last);
+}
+
+GYNX_TARGET_AVX512
+inline char* reverse_complement_copy_avx512
+(   const char* first
+,   const char* last
+,   char* d_first
+)   noexcept
+{   while (last - first >= 64)
+    {   last -= 64;
+        _mm512_storeu_si512
+            (d_first, reverse_complement_avx512(_mm512_loadu_si512(last)));
+        d_first += 64;
+    }
+    return reverse_complement_copy_avx2(first, last, d_first);
+}
+
+#endif  // GYNX_SIMD_X86
+
+}   // end gynx::detail namespace
+
+// -- raw buffers --------------------------------------------------------------
+///
+/// @brief Reverse-complements the residues in [@a first, @a last) in place.
+/// @details Handles IUPAC nucleotide codes (R/Y, K/M, B/V, D/H swap; S, W
+/// and N are self-complementary; U becomes A), preserves case and leaves
+/// non-letters (gaps, '*', ...) untouched. Dispatches at runtime to the best
+/// of AVX-512, AVX2 and SSE4.2 byte-shuffle kernels (see gynx::simd::level()),
+/// falling back to a portable lookup-table loop.
+inline void reverse_complement(char* first, char* last) noexcept
+{   switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            detail::reverse_complement_avx512(first, last);
+            return;
+        case simd::isa::avx2:
+            detail::reverse_complement_avx2(first, last);
+            return;
+        case simd::isa::sse42:
+            detail::reverse_complement_sse42(first, last);
+            return;
+#endif
+        default:
+            detail::reverse_complement_scalar(first, last);
+    }
+}
+///
+/// @brief Writes the reverse complement of [@a first, @a last) to the range
+/// beginning at @a d_first, which must not overlap the input.
+/// @return Iterator one past the last residue written.
+inline char* reverse_complement_copy
+(   const char* first
+,   const char* last
+,   char* d_first
+)   noexcept
+{   switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return detail::reverse_complement_copy_avx512(first, last, d_first);
+        case simd::isa::avx2:
+            return detail::reverse_complement_copy_avx2(first, last, d_first);
+        case simd::isa::sse42:
+            return detail::reverse_complement_copy_sse42(first, last, d_first);
+#endif
+        default:
+            return detail::reverse_complement_copy_scalar(first, last, d_first);
+    }
+}
+
+///
+/// @brief Reverse-complements [@a first, @a last) in place, in parallel on
+/// @a pool.
+/// @details Blocks at mirrored positions from both ends are swapped and
+/// complemented as pairs, through a per-thread buffer; the middle, which
+/// is its own mirror image, is done in place.
+inline void reverse_complement(char* first, char* last, thread_pool& pool)
+{   const std::size_t block = detail::parallel_block;
+    const std::size_t pairs = static_cast<std::size_t>(last - first) / (2 * block);
+    parallel_for
+    (   pool
+    ,   pairs + 1
+    ,   [&](std::size_t i)
+        {   if (i == pairs)
+                return reverse_complement(first + pairs * block, last - pairs * block);
+            thread_local std::vector<char> buffer;
+            buffer.resize(block);
+            char* front = first + i * block;
+            char* back = last - (i + 1) * block;
+            reverse_complement_copy(front, front + block, buffer.data());
+            reverse_complement_copy(back, back + block, front);
+            std::copy_n(buffer.data(), block, back);
+        }
+    );
+}
+///
+/// @brief Writes the reverse complement of [@a first, @a last) to the range
+/// beginning at @a d_first, in parallel blocks on @a pool.
+/// @return Iterator one past the last residue written.
+inline char* reverse_complement_copy
+(   const char* first
+,   const char* last
+,   char* d_first
+,   thread_pool& pool
+)
+{   parallel_chunks
+    (   pool
+    ,   static_cast<std::size_t>(last - first)
+    ,   0
+    ,   [&](std::size_t i, std::size_t j)
+        {   reverse_complement_copy(last - j, last - i, d_first + i);
+        }
+    );
+    return d_first + (last - first);
+}
+
+// -- sequences ----------------------------------------------------------------
+///
+/// @brief Reverse-complements @a s in place. A quality string stored in the
+/// "_qs" tag is reversed along with it.
+/// @return A reference to @a s.
+template<typename Container, typename Map>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container, Map>& reverse_complement(sq_gen<Container, Map>& s)
+{   reverse_complement(s.data(), s.data() + s.size());
+    if (s.has("_qs"))
+        if (auto* qs = std::any_cast<std::string>(&s["_qs"]))
+            std::reverse(qs->begin(), qs->end());
+    return s;
+}
+///
+/// @brief Returns the reverse complement of @a s, including its tagged data
+/// (with "_qs" reversed).
+template<typename Container, typename Map>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container, Map> reverse_complement_copy(const sq_gen<Container, Map>& s)
+{   sq_gen<Container, Map> r(s);
+    reverse_complement(r);
+    return r;
+}
+///
+/// @brief Reverse-complements @a s in place, in parallel on @a pool.
+template<typename Container, typename Map>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container, Map>& reverse_complement(sq_gen<Container, Map>& s, thread_pool& pool)
+{   reverse_complement(s.data(), s.data() + s.size(), pool);
+    if (s.has("_qs"))
+        if (auto* qs = std::any_cast<std::string>(&s["_qs"]))
+            std::reverse(qs->begin(), qs->end());
+    return s;
+}
+///
+/// @brief Materializes the reverse complement of the view @a v into a new
+/// sequence.
+template<typename Container>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container> reverse_complement_copy(sq_view_gen<Container> v)
+{   sq_gen<Container> r(v.size());
+    reverse_complement_copy(v.data(), v.data() + v.size(), r.data());
+    return r;
+}
+///
+/// @brief Materializes the reverse complement of the view @a v into a new
+/// sequence, in parallel on @a pool.
+template<typename Container>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container> reverse_complement_copy(sq_view_gen<Container> v, thread_pool& pool)
+{   sq_gen<Container> r(v.size());
+    reverse_complement_copy(v.data(), v.data() + v.size(), r.data(), pool);
+    return r;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_REVERSE_COMPLEMENT_HPP_
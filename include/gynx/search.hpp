@@ -0,0 +1,579 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_SEARCH_HPP_
+#define _GYNX_SEARCH_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <gynx/simd.hpp>
+#include <gynx/sq_view.hpp>
+
+namespace gynx {
+
+namespace detail {
+
+inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// Patterns up to this length are matched by comparing every pattern byte
+// in-register ("packed" path); longer ones use a first/last-byte filter and
+// verify candidates with memcmp.
+inline constexpr std::size_t packed_max = 16;
+
+inline std::size_t find_scalar
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   return std::string_view(s, n).find(std::string_view(p, m));
+}
+
+inline std::size_t rfind_scalar
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   return std::string_view(s, n).rfind(std::string_view(p, m));
+}
+
+#if GYNX_SIMD_X86
+
+// -- SSE4.2 -------------------------------------------------------------------
+
+GYNX_TARGET_SSE42
+inline std::uint32_t match_mask_sse42
+(   const char* s
+,   const __m128i* pat
+,   std::size_t m
+)   noexcept
+{   const auto* v = reinterpret_cast<const __m128i*>(s);
+    __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(v), pat[0]);
+    if (m <= packed_max)
+        for (std::size_t j = 1; j < m; ++j)
+            eq = _mm_and_si128(eq, _mm_cmpeq_epi8(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(s + j)), pat[j]));
+    else
+        eq = _mm_and_si128(eq, _mm_cmpeq_epi8(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(s + m - 1)), pat[1]));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+}
+
+GYNX_TARGET_SSE42
+inline std::size_t find_sse42
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   __m128i pat[packed_max] = {};
+    const bool packed = m <= packed_max;
+    if (packed)
+        for (std::size_t j = 0; j < m; ++j)
+            pat[j] = _mm_set1_epi8(p[j]);
+    else
+    {   pat[0] = _mm_set1_epi8(p[0]);
+        pat[1] = _mm_set1_epi8(p[m - 1]);
+    }
+    std::size_t i = 0;
+    for (; i + 16 + m - 1 <= n; i += 16)
+        for (auto mask = match_mask_sse42(s + i, pat, m); mask; mask &= mask - 1)
+        {   const std::size_t pos = i + __builtin_ctz(mask);
+            if (packed || 0 == std::memcmp(s + pos + 1, p + 1, m - 2))
+                return pos;
+        }
+    const auto r = find_scalar(s + i, n - i, p, m);
+    return npos == r ? npos : i + r;
+}
+
+GYNX_TARGET_SSE42
+inline std::size_t rfind_sse42
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   __m128i pat[packed_max] = {};
+    const bool packed = m <= packed_max;
+    if (packed)
+        for (std::size_t j = 0; j < m; ++j)
+            pat[j] = _mm_set1_epi8(p[j]);
+    else
+    {   pat[0] = _mm_set1_epi8(p[0]);
+        pat[1] = _mm_set1_epi8(p[m - 1]);
+    }
+    std::size_t end = n - m + 1;  // candidate starts are [0, end)
+    for (; end >= 16; end -= 16)
+    {   const std::size_t b = end - 16;
+        for (auto mask = match_mask_sse42(s + b, pat, m); mask; )
+        {   const int bit = 31 - __builtin_clz(mask);
+            if (packed || 0 == std::memcmp(s + b + bit + 1, p + 1, m - 2))
+                return b + bit;
+            mask &= ~(1u << bit);
+        }
+    }
+    return rfind_scalar(s, end + m - 1, p, m);
+}
+
+// -- AVX2 ---------------------------------------------------------------------
+
+GYNX_TARGET_AVX2
+inline std::uint32_t match_mask_avx2
+(   const char* s
+,   const __m256i* pat
+,   std::size_t m
+)   noexcept
+{   const auto* v = reinterpret_cast<const __m256i*>(s);
+    __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(v), pat[0]);
+    if (m <= packed_max)
+        for (std::size_t j = 1; j < m; ++j)
+            eq = _mm256_and_si256(eq, _mm256_cmpeq_epi8(_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(s + j)), pat[j]));
+    else
+        eq = _mm256_and_si256(eq, _mm256_cmpeq_epi8(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(s + m - 1)), pat[1]));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+}
+
+GYNX_TARGET_AVX2
+inline std::size_t find_avx2
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   __m256i pat[packed_max] = {};
+    const bool packed = m <= packed_max;
+    if (packed)
+        for (std::size_t j = 0; j < m; ++j)
+            pat[j] = _mm256_set1_epi8(p[j]);
+    else
+    {   pat[0] = _mm256_set1_epi8(p[0]);
+        pat[1] = _mm256_set1_epi8(p[m - 1]);
+    }
+    std::size_t i = 0;
+    for (; i + 32 + m - 1 <= n; i += 32)
+        for (auto mask = match_mask_avx2(s + i, pat, m); mask; mask &= mask - 1)
+        {   const std::size_t pos = i + __builtin_ctz(mask);
+            if (packed || 0 == std::memcmp(s + pos + 1, p + 1, m - 2))
+                return pos;
+        }
+    const auto r = find_sse42(s + i, n - i, p, m);
+    return npos == r ? npos : i + r;
+}
+
+GYNX_TARGET_AVX2
+inline std::size_t rfind_avx2
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   __m256i pat[packed_max] = {};
+    const bool packed = m <= packed_max;
+    if (packed)
+        for (std::size_t j = 0; j < m; ++j)
+            pat[j] = _mm256_set1_epi8(p[j]);
+    else
+    {   pat[0] = _mm256_set1_epi8(p[0]);
+        pat[1] = _mm256_set1_epi8(p[m - 1]);
+    }
+    std::size_t end = n - m + 1;
+    for (; end >= 32; end -= 32)
+    {   const std::size_t b = end - 32;
+        for (auto mask = match_mask_avx2(s + b, pat, m); mask; )
+        {   const int bit = 31 - __builtin_clz(mask);
+            if (packed || 0 == std::memcmp(s + b + bit + 1, p + 1, m - 2))
+                return b + bit;
+            mask &= ~(1u << bit);
+        }
+    }
+    return rfind_sse42(s, end + m - 1, p, m);
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+GYNX_TARGET_AVX512
+inline std::uint64_t match_mask_avx512
+(   const char* s
+,   const __m512i* pat
+,   std::size_t m
+)   noexcept
+{   __mmask64 eq = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(s), pat[0]);
+    if (m <= packed_max)
+        for (std::size_t j = 1; j < m; ++j)
+            eq = _mm512_mask_cmpeq_epi8_mask
+                (eq, _mm512_loadu_si512(s + j), pat[j]);
+    else
+        eq = _mm512_mask_cmpeq_epi8_mask
+            (eq, _mm512_loadu_si512(s + m - 1), pat[1]);
+    return eq;
+}
+
+GYNX_TARGET_AVX512
+inline std::size_t find_avx512
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   __m512i pat[packed_max] = {};
+    const bool packed = m <= packed_max;
+    if (packed)
+        for (std::size_t j = 0; j < m; ++j)
+            pat[j] = _mm512_set1_epi8(p[j]);
+    else
+    {   pat[0] = _mm512_set1_epi8(p[0]);
+        pat[1] = _mm512_set1_epi8(p[m - 1]);
+    }
+    std::size_t i = 0;
+    for (; i + 64 + m - 1 <= n; i += 64)
+        for (auto mask = match_mask_avx512(s + i, pat, m); mask; mask &= mask - 1)
+        {   const std::size_t pos = i + __builtin_ctzll(mask);
+            if (packed || 0 == std::memcmp(s + pos + 1, p + 1, m - 2))
+                return pos;
+        }
+    const auto r = find_avx2(s + i, n - i, p, m);
+    return npos == r ? npos : i + r;
+}
+
+GYNX_TARGET_AVX512
+inline std::size_t rfind_avx512
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   __m512i pat[packed_max] = {};
+    const bool packed = m <= packed_max;
+    if (packed)
+        for (std::size_t j = 0; j < m; ++j)
+            pat[j] = _mm512_set1_epi8(p[j]);
+    else
+    {   pat[0] = _mm512_set1_epi8(p[0]);
+        pat[1] = _mm512_set1_epi8(p[m - 1]);
+    }
+    std::size_t end = n - m + 1;
+    for (; end >= 64; end -= 64)
+    {   const std::size_t b = end - 64;
+        for (auto mask = match_mask_avx512(s + b, pat, m); mask; )
+        {   const int bit = 63 - __builtin_clzll(mask);
+            if (packed || 0 == std::memcmp(s + b + bit + 1, p + 1, m - 2))
+                return b + bit;
+            mask &= ~(std::uint64_t(1) << bit);
+        }
+    }
+    return rfind_avx2(s, end + m - 1, p, m);
+}
+
+#endif  // GYNX_SIMD_X86
+
+/// Returns the offset of the first occurrence of [@a p, @a p + @a m) in
+/// [@a s, @a s + @a n), or npos.
+inline std::size_t find
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   if (m > n)
+        return npos;
+    if (m < 2)  // memchr is vectorized already
+        return find_scalar(s, n, p, m);
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return find_avx512(s, n, p, m);
+        case simd::isa::avx2:
+            return find_avx2(s, n, p, m);
+        case simd::isa::sse42:
+            return find_sse42(s, n, p, m);
+#endif
+        default:
+            return find_scalar(s, n, p, m);
+    }
+}
+
+/// Returns the offset of the last occurrence of [@a p, @a p + @a m) in
+/// [@a s, @a s + @a n), or npos.
+inline std::size_t rfind
+(   const char* s
+,   std::size_t n
+,   const char* p
+,   std::size_t m
+)   noexcept
+{   if (m > n)
+        return npos;
+    if (m < 2)
+        return rfind_scalar(s, n, p, m);
+    switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return rfind_avx512(s, n, p, m);
+        case simd::isa::avx2:
+            return rfind_avx2(s, n, p, m);
+        case simd::isa::sse42:
+            return rfind_sse42(s, n, p, m);
+#endif
+        default:
+            return rfind_scalar(s, n, p, m);
+    }
+}
+
+}   // end gynx::detail namespace
+
+// -- single pattern -----------------------------------------------------------
+
+/// @brief Returns the position of the first occurrence of @a pattern in
+/// @a s at or after @a pos, or npos. Matching is exact (case-sensitive).
+template<typename Container>
+requires std::is_same_v<typename Container::value_type, char>
+std::size_t find
+(   sq_view_gen<Container> s
+,   std::string_view pattern
+,   std::size_t pos = 0
+)   noexcept
+{   if (pos > s.size())
+        return sq_view_gen<Container>::npos;
+    const auto r = detail::find
+        (s.data() + pos, s.size() - pos, pattern.data(), pattern.size());
+    return detail::npos == r ? sq_view_gen<Container>::npos : pos + r;
+}
+
+/// @brief Returns the position of the last occurrence of @a pattern in @a s
+/// starting at or before @a pos, or npos.
+template<typename Container>
+requires std::is_same_v<typename Container::value_type, char>
+std::size_t rfind
+(   sq_view_gen<Container> s
+,   std::string_view pattern
+,   std::size_t pos = sq_view_gen<Container>::npos
+)   noexcept
+{   if (pattern.size() > s.size())
+        return sq_view_gen<Container>::npos;
+    const std::size_t n = std::min(pos, s.size() - pattern.size())
+    +   pattern.size();
+    const auto r = detail::rfind(s.data(), n, pattern.data(), pattern.size());
+    return detail::npos == r ? sq_view_gen<Container>::npos : r;
+}
+
+/// @brief Returns true if @a pattern occurs in @a s.
+template<typename Container>
+requires std::is_same_v<typename Container::value_type, char>
+bool contains(sq_view_gen<Container> s, std::string_view pattern) noexcept
+{   return sq_view_gen<Container>::npos != find(s, pattern);
+}
+
+/// @brief Returns the positions of all, possibly overlapping, occurrences of
+/// @a pattern in @a s.
+template<typename Container>
+requires std::is_same_v<typename Container::value_type, char>
+std::vector<std::size_t> find_all
+(   sq_view_gen<Container> s
+,   std::string_view pattern
+)
+{   if (pattern.empty())
+        throw std::invalid_argument("gynx::find_all: empty pattern");
+    std::vector<std::size_t> hits;
+    for
+    (   std::size_t i = find(s, pattern)
+    ;   i != sq_view_gen<Container>::npos
+    ;   i = find(s, pattern, i + 1)
+    )
+        hits.push_back(i);
+    return hits;
+}
+
+/// @brief Returns the number of, possibly overlapping, occurrences of
+/// @a pattern in @a s.
+template<typename Container>
+requires std::is_same_v<typename Container::value_type, char>
+std::size_t count(sq_view_gen<Container> s, std::string_view pattern)
+{   if (pattern.empty())
+        throw std::invalid_argument("gynx::count: empty pattern");
+    std::size_t n = 0;
+    for
+    (   std::size_t i = find(s, pattern)
+    ;   i != sq_view_gen<Container>::npos
+    ;   i = find(s, pattern, i + 1)
+    )
+        ++n;
+    return n;
+}
+
+// -- multiple patterns --------------------------------------------------------
+
+/// @brief An occurrence of pattern number @a pattern starting at @a pos.
+struct pattern_match
+{   std::size_t pos;
+    std::size_t pattern;
+
+    friend constexpr bool operator== (const pattern_match&, const pattern_match&)
+        = default;
+};
+
+/// @brief Aho–Corasick automaton searching for many patterns (primers,
+/// motifs, adapters) in a single pass.
+/// @details The automaton is a dense DFA over the byte classes occurring in
+/// the patterns, so scanning costs one table lookup per residue whatever the
+/// number of patterns. Matching is exact (case-sensitive).
+class aho_corasick
+{   std::vector<std::string> _patterns;
+    std::array<std::uint32_t, 256> _class{};  // 0 = in no pattern
+    std::size_t _classes = 1;
+    std::vector<std::uint32_t> _next;         // state * _classes + class
+    std::vector<std::uint32_t> _out_begin;    // per state, into _out
+    std::vector<std::uint32_t> _out;          // pattern ids, CSR
+
+    void _build()
+    {   for (const auto& p : _patterns)
+        {   if (p.empty())
+                throw std::invalid_argument("gynx::aho_corasick: empty pattern");
+            for (unsigned char c : p)
+                if (0 == _class[c])
+                    _class[c] = static_cast<std::uint32_t>(_classes++);
+        }
+        // trie; 0 marks a missing edge as the root is never a child
+        std::vector<std::uint32_t> next(_classes, 0);
+        std::vector<std::vector<std::uint32_t>> own(1);
+        for (std::size_t i = 0; i < _patterns.size(); ++i)
+        {   std::uint32_t st = 0;
+            for (unsigned char c : _patterns[i])
+            {   auto& e = next[st * _classes + _class[c]];
+                if (0 == e)
+                {   e = static_cast<std::uint32_t>(own.size());
+                    own.emplace_back();
+                    next.resize(own.size() * _classes, 0);
+                }
+                st = next[st * _classes + _class[c]];
+            }
+            own[st].push_back(static_cast<std::uint32_t>(i));
+        }
+        // breadth-first: failure links, DFA completion and output merging
+        const std::size_t states = own.size();
+        std::vector<std::uint32_t> fail(states, 0), order;
+        order.reserve(states);
+        std::deque<std::uint32_t> queue;
+        for (std::size_t c = 0; c < _classes; ++c)
+            if (next[c])
+                queue.push_back(next[c]);
+        while (! queue.empty())
+        {   const auto st = queue.front();
+            queue.pop_front();
+            order.push_back(st);
+            for (std::size_t c = 0; c < _classes; ++c)
+            {   auto& e = next[st * _classes + c];
+                const auto f = next[fail[st] * _classes + c];
+                if (e)
+                {   fail[e] = f;
+                    queue.push_back(e);
+                }
+                else
+                    e = f;
+            }
+        }
+        _out_begin.assign(states + 1, 0);
+        std::vector<std::vector<std::uint32_t>> out(states);
+        out[0] = own[0];
+        for (auto st : order)
+        {   out[st] = own[st];
+            out[st].insert(out[st].end(), out[fail[st]].begin(), out[fail[st]].end());
+        }
+        for (std::size_t st = 0; st < states; ++st)
+        {   _out_begin[st] = static_cast<std::uint32_t>(_out.size());
+            _out.insert(_out.end(), out[st].begin(), out[st].end());
+        }
+        _out_begin[states] = static_cast<std::uint32_t>(_out.size());
+        _next = std::move(next);
+    }
+
+public:
+    ///
+    /// Builds the automaton for @a patterns; pattern numbers in matches
+    /// are indices into this list.
+    explicit aho_corasick(std::vector<std::string> patterns)
+    :   _patterns(std::move(patterns))
+    {   _build();
+    }
+    aho_corasick(std::initializer_list<std::string_view> patterns)
+    :   _patterns(patterns.begin(), patterns.end())
+    {   _build();
+    }
+
+    ///
+    /// @brief Calls @a f with a pattern_match for every occurrence of every
+    /// pattern in @a s, in order of their end positions.
+    template<typename Container, typename F>
+    void for_each_match(sq_view_gen<Container> s, F f) const
+    {   const std::uint32_t* next = _next.data();
+        const std::size_t classes = _classes;
+        const char* d = s.data();
+        std::uint32_t st = 0;
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {   st = next
+            [   st * classes
+            +   _class[static_cast<unsigned char>(d[i])]
+            ];
+            if (_out_begin[st] != _out_begin[st + 1])
+                for (auto j = _out_begin[st]; j < _out_begin[st + 1]; ++j)
+                    f(pattern_match{ i + 1 - _patterns[_out[j]].size(), _out[j] });
+        }
+    }
+    ///
+    /// Returns all occurrences of all patterns in @a s.
+    template<typename Container>
+    std::vector<pattern_match> find_all(sq_view_gen<Container> s) const
+    {   std::vector<pattern_match> hits;
+        for_each_match(s, [&](const pattern_match& m) { hits.push_back(m); });
+        return hits;
+    }
+    ///
+    /// Returns the number of occurrences of each pattern in @a s.
+    template<typename Container>
+    std::vector<std::size_t> count(sq_view_gen<Container> s) const
+    {   std::vector<std::size_t> n(_patterns.size());
+        for_each_match(s, [&](const pattern_match& m) { ++n[m.pattern]; });
+        return n;
+    }
+    ///
+    /// Returns the patterns.
+    const std::vector<std::string>& patterns() const noexcept
+    {   return _patterns;
+    }
+};
+
+}   // end gynx namespace
+
+#endif  // _GYNX_SEARCH_HPP_
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_SIMD_HPP_
+#define _GYNX_SIMD_HPP_
+
+#include <atomic>
+
+// x86 kernels are compiled with per-function target attributes and selected
+// at runtime, so no -mavx2 (etc.) is needed to build code using gynx. Other
+// compilers/architectures always use the portable scalar kernels.
+#if (defined(__GNUC__) || defined(__clang__)) \
+&&  (defined(__x86_64__) || defined(__i386__))
+#   define GYNX_SIMD_X86 1
+#   define GYNX_TARGET_SSE42  __attribute__((target("sse4.2,popcnt")))
+#   define GYNX_TARGET_AVX2   __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#   define GYNX_TARGET_AVX512 \
+        __attribute__((target("avx512f,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt")))
+#   include <immintrin.h>
+#else
+#   define GYNX_SIMD_X86 0
+#endif
+
+// Cache prefetch hint for the line at addr (rw: 0 = read, 1 = write);
+// compiles to nothing where __builtin_prefetch is not available.
+#if defined(__GNUC__) || defined(__clang__)
+#   define GYNX_PREFETCH(addr, rw) __builtin_prefetch((addr), (rw))
+#else
+#   define GYNX_PREFETCH(addr, rw) ((void)(addr))
+#endif
+
+namespace gynx::simd {
+
+/// Instruction set levels the vectorized kernels are specialized for.
+enum class isa : int
+{   scalar = 0
+,   sse42  = 1
+,   avx2   = 2
+,   avx512 = 3  ///< AVX-512F + BW + VL
+};
+
+/// Returns the best instruction set supported by the running CPU.
+inline isa detect() noexcept
+{
+#if GYNX_SIMD_X86
+    __builtin_cpu_init();
+    if
+    (   __builtin_cpu_supports("avx512f")
+    &&  __builtin_cpu_supports("avx512bw")
+    &&  __builtin_cpu_supports("avx512vl")
+    )
+        return isa::avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2"))
+        return isa::avx2;
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+        return isa::sse42;
+#endif
+    return isa::scalar;
+}
+
+namespace detail {
+    inline std::atomic<isa>& level_ref() noexcept
+    {   static std::atomic<isa> level{detect()};
+        return level;
+    }
+}   // end gynx::simd::detail namespace
+
+/// Returns the instruction set the kernels currently dispatch to.
+inline isa level() noexcept
+{   return detail::level_ref().load(std::memory_order_relaxed);
+}
+
+/// Restricts dispatch to @a l (clamped to what the CPU supports), e.g. to
+/// compare against the scalar baseline. Returns the level actually set.
+inline isa set_level(isa l) noexcept
+{   const isa best = detect();
+    if (static_cast<int>(l) > static_cast<int>(best))
+        l = best;
+    detail::level_ref().store(l, std::memory_order_relaxed);
+    return l;
+}
+
+}   // end gynx::simd namespace
+
+#endif  // _GYNX_SIMD_HPP_
@@ -0,0 +1,464 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_SKETCH_HPP_
+#define _GYNX_SKETCH_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/kmers.hpp>
+#include <gynx/minimizers.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/io/fastaqz.hpp>
+
+namespace gynx {
+
+// -- sketch -------------------------------------------------------------------
+
+/// @brief Parameters of a gynx::sketch.
+struct sketch_options
+{   std::size_t   k = 21;       ///< k-mer length, 1 <= k <= 32
+    std::size_t   size = 1000;  ///< bottom-k size, used when scaled is 0
+    std::uint64_t scaled = 0;   ///< FracMinHash scale factor, or 0 for bottom-k
+    std::uint64_t seed = 42;    ///< hash seed
+
+    friend constexpr bool operator==
+        (const sketch_options&, const sketch_options&) = default;
+};
+
+/// @brief A MinHash sketch of the canonical k-mers of one or more sequences.
+/// @details Every k-mer is hashed with gynx::invertible_hash restricted to
+/// 2k bits (a bijection on k-mer space) after mixing in the seed, so
+/// sketches with equal options are comparable. A bottom-k sketch keeps the
+/// sketch_options::size smallest distinct hashes (as Mash does); a
+/// FracMinHash sketch keeps every hash below 4^k / sketch_options::scaled,
+/// so its size grows with the number of distinct k-mers and it also
+/// estimates containment of sets of very different sizes. Hashes are kept
+/// sorted in increasing order.
+class sketch
+{   std::size_t   _k = 21;
+    std::size_t   _size = 1000;
+    std::uint64_t _scaled = 0;
+    std::uint64_t _seed = 42;
+    std::uint64_t _mask = 0;
+    std::uint64_t _cut = 0;     // largest hash that may still be kept
+    std::size_t   _sorted = 0;  // length of the sorted prefix of _hashes
+    std::vector<std::uint64_t> _hashes;
+
+    static constexpr char magic[8] { 'G', 'Y', 'N', 'X', 'M', 'H', '0', '1' };
+
+    void _init()
+    {   if (_k < 1 || _k > 32)
+            throw std::invalid_argument("gynx::sketch: k out of range");
+        if (0 == _scaled && 0 == _size)
+            throw std::invalid_argument("gynx::sketch: zero size");
+        _mask = _k == 32 ? ~std::uint64_t(0) : (std::uint64_t(1) << (2 * _k)) - 1;
+        _cut = _scaled ? _mask / _scaled : _mask;
+    }
+    // sorts the candidates appended since the last call, merges them into
+    // the sorted prefix, removes duplicates and keeps the bottom-k hashes
+    void _compact()
+    {   const auto mid = _hashes.begin() + std::ptrdiff_t(_sorted);
+        std::sort(mid, _hashes.end());
+        std::inplace_merge(_hashes.begin(), mid, _hashes.end());
+        _hashes.erase(std::unique(_hashes.begin(), _hashes.end()), _hashes.end());
+        if (0 == _scaled && _hashes.size() >= _size)
+        {   _hashes.resize(_size);
+            _cut = _hashes.back();
+        }
+        _sorted = _hashes.size();
+    }
+    // hashes the canonical k-mers in [first, last) and keeps candidates
+    void _flush(std::uint64_t* first, std::uint64_t* last)
+    {   detail::invertible_hash_block(first, last, _mask);
+        for (; first != last; ++first)
+            if (*first <= _cut)
+            {   _hashes.push_back(*first);
+                if (0 == _scaled && _hashes.size() - _sorted >= _size)
+                    _compact();
+            }
+    }
+
+    static void _put(std::ostream& os, std::uint64_t v)
+    {   char b[10];
+        int n = 0;
+        for (; v >= 0x80; v >>= 7)
+            b[n++] = char(v | 0x80);
+        b[n++] = char(v);
+        os.write(b, n);
+    }
+    static std::uint64_t _get(std::istream& is)
+    {   std::uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {   const int c = is.get();
+            if (c == std::char_traits<char>::eof())
+                break;
+            v |= std::uint64_t(c & 0x7f) << shift;
+            if (! (c & 0x80))
+                return v;
+        }
+        throw std::runtime_error("gynx::sketch: corrupt sketch");
+    }
+
+public:
+// -- constructors -------------------------------------------------------------
+    sketch()
+    {   _init();
+    }
+    explicit sketch(const sketch_options& o)
+    :   _k(o.k)
+    ,   _size(o.size)
+    ,   _scaled(o.scaled)
+    ,   _seed(o.seed)
+    {   _init();
+    }
+    ///
+    /// Constructs a sketch of @a s with options @a o.
+    template<typename Container>
+    explicit sketch(sq_view_gen<Container> s, const sketch_options& o = {})
+    :   sketch(o)
+    {   add(s);
+    }
+
+// -- modifiers ----------------------------------------------------------------
+    ///
+    /// @brief Adds the canonical k-mers of @a s, e.g. one contig of an
+    /// assembly. K-mers overlapping non-ACGT residues are skipped.
+    /// @details K-mers are gathered and hashed in blocks, vectorized with
+    /// AVX2/AVX-512 (see gynx::simd::level()).
+    template<typename Container>
+    requires std::is_same_v<typename Container::value_type, char>
+    void add(sq_view_gen<Container> s)
+    {   constexpr std::size_t block = 4096;
+        thread_local std::vector<std::uint64_t> buffer(block);
+        std::uint64_t* code = buffer.data();
+        const std::uint64_t seed = _seed & _mask;
+        std::size_t n = 0;
+        for (auto km : kmer_view<sq_view_gen<Container>>(s, _k))
+        {   code[n] = km.canonical() ^ seed;
+            if (++n == block)
+            {   _flush(code, code + n);
+                n = 0;
+            }
+        }
+        _flush(code, code + n);
+        _compact();
+    }
+    ///
+    /// Adds the canonical k-mers of sequence @a s.
+    template<typename Container, typename Map>
+    void add(const sq_gen<Container, Map>& s)
+    {   add(s(0));
+    }
+    ///
+    /// @brief Merges @a other into this sketch, which then sketches the
+    /// union of both inputs. Throws std::invalid_argument if the options
+    /// differ.
+    void merge(const sketch& other)
+    {   check_compatible(other);
+        for (auto h : other._hashes)
+            if (h <= _cut)
+                _hashes.push_back(h);
+        _compact();
+    }
+    ///
+    /// Throws std::invalid_argument unless @a other has the same options.
+    void check_compatible(const sketch& other) const
+    {   if
+        (   _k != other._k
+        ||  _scaled != other._scaled
+        ||  _seed != other._seed
+        ||  (0 == _scaled && _size != other._size)
+        )
+            throw std::invalid_argument("gynx::sketch: incompatible sketches");
+    }
+
+// -- observers ----------------------------------------------------------------
+    [[nodiscard]] bool empty() const noexcept
+    {   return _hashes.empty();
+    }
+    ///
+    /// Returns the number of hashes in the sketch.
+    std::size_t size() const noexcept
+    {   return _hashes.size();
+    }
+    ///
+    /// Returns the hashes in increasing order.
+    const std::vector<std::uint64_t>& hashes() const noexcept
+    {   return _hashes;
+    }
+    ///
+    /// Returns the options the sketch was built with.
+    sketch_options options() const noexcept
+    {   return { _k, _size, _scaled, _seed };
+    }
+    std::size_t k() const noexcept
+    {   return _k;
+    }
+    ///
+    /// @brief Returns the largest hash that could belong to the sketch: the
+    /// FracMinHash threshold, the largest kept hash of a full bottom-k
+    /// sketch, or the largest possible hash otherwise.
+    std::uint64_t max_hash() const noexcept
+    {   return _cut;
+    }
+
+// -- persistence --------------------------------------------------------------
+    ///
+    /// @brief Writes the sketch to @a os in a compact binary form: options
+    /// and gaps between consecutive hashes as LEB128 varints.
+    void write(std::ostream& os) const
+    {   os.write(magic, sizeof(magic));
+        _put(os, _k);
+        _put(os, _size);
+        _put(os, _scaled);
+        _put(os, _seed);
+        _put(os, _hashes.size());
+        std::uint64_t prev = 0;
+        for (auto h : _hashes)
+        {   _put(os, h - prev);
+            prev = h;
+        }
+    }
+    ///
+    /// Reads a sketch written by write(). Throws std::runtime_error if the
+    /// input is not a sketch.
+    void read(std::istream& is)
+    {   char m[sizeof(magic)];
+        if (! is.read(m, sizeof(m)) || ! std::equal(m, m + sizeof(m), magic))
+            throw std::runtime_error("gynx::sketch: not a sketch");
+        _k = _get(is);
+        _size = _get(is);
+        _scaled = _get(is);
+        _seed = _get(is);
+        _init();
+        const std::uint64_t n = _get(is);
+        _hashes.clear();
+        _hashes.reserve(std::min<std::uint64_t>(n, 1 << 20));
+        std::uint64_t h = 0;
+        for (std::uint64_t i = 0; i < n; ++i)
+            _hashes.push_back(h += _get(is));
+        _sorted = _hashes.size();
+        if (0 == _scaled && _hashes.size() >= _size)
+            _cut = _hashes.back();
+    }
+
+    friend bool operator== (const sketch& a, const sketch& b) noexcept
+    {   return a.options() == b.options() && a._hashes == b._hashes;
+    }
+};
+
+// -- persistence --------------------------------------------------------------
+///
+/// @brief Writes @a sketches to @a path, one after the other.
+inline void save_sketches
+(   const std::filesystem::path& path
+,   const std::vector<sketch>& sketches
+)
+{   std::ofstream os(path, std::ios::binary);
+    for (const auto& s : sketches)
+        s.write(os);
+    if (! os)
+        throw std::runtime_error
+        (   "gynx::sketch: could not write sketch file -> "
+        +   path.string()
+        );
+}
+///
+/// @brief Reads every sketch of a file written by save_sketches().
+inline std::vector<sketch> load_sketches(const std::filesystem::path& path)
+{   std::ifstream is(path, std::ios::binary);
+    if (! is)
+        throw std::runtime_error
+        (   "gynx::sketch: could not open sketch file -> "
+        +   path.string()
+        );
+    std::vector<sketch> out;
+    while (is.peek() != std::char_traits<char>::eof())
+        out.emplace_back().read(is);
+    return out;
+}
+
+// -- sketching files ----------------------------------------------------------
+///
+/// @brief Returns the sketch of all records of @a filename (e.g. the
+/// contigs of an assembly), read with gynx::in::fast_aqz.
+template<typename Sequence = sq>
+sketch sketch_file
+(   std::string_view filename
+,   const sketch_options& o = {}
+,   in::fast_aqz<Sequence> reader = {}
+)
+{   sketch s(o);
+    reader
+    (   filename
+    ,   [&](Sequence&& r)
+        {   s.add(r);
+        }
+    );
+    return s;
+}
+///
+/// @brief Returns the sketches of @a filenames, one per file, computed in
+/// parallel on @a pool.
+template<typename Sequence = sq>
+std::vector<sketch> sketch_files
+(   const std::vector<std::string>& filenames
+,   const sketch_options& o = {}
+,   thread_pool& pool = thread_pool::global()
+,   in::fast_aqz<Sequence> reader = {}
+)
+{   std::vector<sketch> out(filenames.size(), sketch(o));
+    parallel_for
+    (   pool
+    ,   filenames.size()
+    ,   [&](std::size_t i)
+        {   out[i] = sketch_file(filenames[i], o, reader);
+        }
+    );
+    return out;
+}
+
+// -- distances ----------------------------------------------------------------
+
+namespace detail {
+
+/// Shared hashes and hashes considered when comparing two sketches.
+struct sketch_overlap
+{   std::size_t shared = 0;
+    std::size_t total = 0;
+};
+
+/// @brief Counts shared hashes among the union of @a a and @a b, limited
+/// to its bottom-k for bottom-k sketches (the Mash estimator).
+inline sketch_overlap overlap(const sketch& a, const sketch& b)
+{   a.check_compatible(b);
+    const auto& x = a.hashes();
+    const auto& y = b.hashes();
+    const std::size_t limit = 0 == a.options().scaled
+    ?   a.options().size
+    :   std::numeric_limits<std::size_t>::max();
+    sketch_overlap r;
+    std::size_t i = 0, j = 0;
+    while (i < x.size() && j < y.size() && r.total < limit)
+    {   if (x[i] < y[j])
+            ++i;
+        else if (y[j] < x[i])
+            ++j;
+        else
+        {   ++r.shared;
+            ++i;
+            ++j;
+        }
+        ++r.total;
+    }
+    const std::size_t rest = (x.size() - i) + (y.size() - j);
+    r.total += std::min(rest, limit - r.total);
+    return r;
+}
+
+}   // end gynx::detail namespace
+
+/// @brief Returns the estimated Jaccard index of the k-mer sets sketched by
+/// @a a and @a b. Throws std::invalid_argument if their options differ.
+inline double jaccard(const sketch& a, const sketch& b)
+{   const auto r = detail::overlap(a, b);
+    return r.total ? double(r.shared) / double(r.total) : 0.0;
+}
+
+/// @brief Returns the estimated fraction of the k-mers sketched by @a a
+/// that also occur in those sketched by @a b.
+/// @details Only hashes below the max_hash() of both sketches are compared,
+/// so the estimate stays unbiased for bottom-k sketches of different sizes;
+/// it is most accurate for FracMinHash sketches.
+inline double containment(const sketch& a, const sketch& b)
+{   a.check_compatible(b);
+    const std::uint64_t bound = std::min(a.max_hash(), b.max_hash());
+    const auto& x = a.hashes();
+    const auto& y = b.hashes();
+    std::size_t shared = 0, total = 0;
+    for (std::size_t i = 0, j = 0; i < x.size() && x[i] <= bound; ++i)
+    {   ++total;
+        while (j < y.size() && y[j] < x[i])
+            ++j;
+        shared += j < y.size() && y[j] == x[i];
+    }
+    return total ? double(shared) / double(total) : 0.0;
+}
+
+/// @brief Returns the Mash distance -ln(2j / (1 + j)) / k for Jaccard index
+/// @a j and k-mer length @a k, an estimate of the mutation rate; 1 if
+/// nothing is shared.
+inline double mash_distance(double j, std::size_t k)
+{   return j > 0.0
+    ?   std::min(1.0, std::log((1.0 + j) / (2.0 * j)) / double(k))
+    :   1.0;
+}
+///
+/// @brief Returns the Mash distance between the sequences sketched by @a a
+/// and @a b.
+inline double mash_distance(const sketch& a, const sketch& b)
+{   return mash_distance(jaccard(a, b), a.k());
+}
+
+/// @brief Returns the all-vs-all Mash distances of @a sketches as a
+/// row-major n x n matrix, computed on @a pool.
+/// @details Each row of the upper triangle is one task, claimed dynamically
+/// so the shrinking rows balance themselves; with no shared state the
+/// work scales with the number of cores. Throws std::invalid_argument if
+/// any two sketches have different options.
+inline std::vector<double> mash_distances
+(   const std::vector<sketch>& sketches
+,   thread_pool& pool = thread_pool::global()
+)
+{   const std::size_t n = sketches.size();
+    for (const auto& s : sketches)
+        sketches.front().check_compatible(s);
+    std::vector<double> d(n * n, 0.0);
+    parallel_for
+    (   pool
+    ,   n
+    ,   [&](std::size_t i)
+        {   for (std::size_t j = i + 1; j < n; ++j)
+                d[i * n + j] = d[j * n + i]
+                    = mash_distance(sketches[i], sketches[j]);
+        }
+    );
+    return d;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_SKETCH_HPP_
@@ -97,6 +97,15 @@ public:
     ,   _ptr_td()
     {}
     ///
+    /// @brief Constructs a sequence by taking over an existing container
+    /// (e.g. a gynx::mmap_vector mapping a file).
+    /// @param sq The container holding the residues.
+    explicit sq_gen(Container&& sq)
+        noexcept(std::is_nothrow_move_constructible_v<Container>)
+    :   _sq(std::move(sq))
+    ,   _ptr_td()
+    {}
+    ///
     template<typename InputIt>
     requires std::input_iterator<InputIt> &&
         std::is_same_v<typename std::iterator_traits<InputIt>::value_type, value_type>
@@ -222,6 +231,11 @@ public:
     size_type size() const noexcept
     {   return _sq.size();   }
     ///
+    /// @brief Resizes the @a sq to @a count residues, appending copies of
+    /// @a value if it grows. Tagged data is left untouched.
+    void resize(size_type count, const_reference value)
+    {   _sq.resize(count, value);   }
+    ///
     /// Returns the size in memory (in bytes) used by the @a sq including its
     /// tagged data.
     size_type size_in_memory() const noexcept
@@ -309,9 +323,8 @@ public:
 // -- comparison operators -----------------------------------------------------
     ///
     /// Equality operator.
-    template<typename Container1, typename Container2>
     friend
-    bool operator== (const sq_gen<Container1>& lhs, const sq_gen<Container2>& rhs)
+    bool operator== (const sq_gen& lhs, const sq_gen& rhs)
     {   return lhs._sq == rhs._sq;
     }
     ///
@@ -323,9 +336,8 @@ public:
     }
     ///
     /// Inequality operator.
-    template<typename Container1, typename Container2>
     friend
-    bool operator!= (const sq_gen<Container1>& lhs, const sq_gen<Container2>& rhs)
+    bool operator!= (const sq_gen& lhs, const sq_gen& rhs)
     {   return lhs._sq != rhs._sq;
     }
 
@@ -419,6 +431,13 @@ public:
     :   std::true_type
     {};
     ///
+    /// Equality operator for sequences with different containers.
+    template<typename Container1, typename Container2>
+    bool operator== (const sq_gen<Container1>& lhs, const sq_gen<Container2>& rhs)
+    {   return lhs.size() == rhs.size()
+        &&  std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    ///
     /// Equality operators
     template<typename Container1, typename Container2>
     bool operator== (const sq_gen<Container1>& lhs, const Container2& rhs)
@@ -453,6 +472,9 @@ public:
     }
     ///    /// Inequality operator.
     template<typename Container1, typename Container2>
+    bool operator!= (const sq_gen<Container1>& lhs, const sq_gen<Container2>& rhs)
+    {   return ! (lhs == rhs);   }
+    template<typename Container1, typename Container2>
     bool operator!= (const sq_gen<Container1>& lhs, const Container2& rhs)
     {   return ! (lhs == rhs);   }
     template<typename Container1, typename Container2>
@@ -61,8 +61,9 @@ public:
     ,   _size(count)
     {}
 
-    template<typename Map>
-    constexpr sq_view_gen(const sq_gen<Container, Map>& seq) noexcept
+    template<typename C, typename Map>
+    requires std::is_same_v<typename C::value_type, value_type>
+    constexpr sq_view_gen(const sq_gen<C, Map>& seq) noexcept
     :   _data(seq.data())
     ,   _size(seq.size())
     {}
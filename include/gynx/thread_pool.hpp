@@ -0,0 +1,266 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_THREAD_POOL_HPP_
+#define _GYNX_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gynx {
+
+/// @brief A fixed-size pool of worker threads executing submitted tasks in
+/// FIFO order.
+class thread_pool
+{   std::vector<std::thread>          _workers;
+    std::deque<std::function<void()>> _tasks;
+    std::mutex                        _mutex;
+    std::condition_variable           _cv;
+    bool                              _stop = false;
+
+public:
+// -- constructors -------------------------------------------------------------
+    ///
+    /// Constructs a pool with @a n worker threads (default is one per
+    /// hardware thread).
+    explicit thread_pool(unsigned n = std::thread::hardware_concurrency())
+    {   n = std::max(n, 1u);
+        _workers.reserve(n);
+        for (unsigned i = 0; i < n; ++i)
+            _workers.emplace_back([this] { _run(); });
+    }
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator= (const thread_pool&) = delete;
+    ///
+    /// Destructor. Finishes all queued tasks, then joins the workers.
+    ~thread_pool()
+    {   {   std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_all();
+        for (auto& w : _workers)
+            w.join();
+    }
+
+// -- capacity -----------------------------------------------------------------
+    ///
+    /// Returns the number of worker threads.
+    unsigned size() const noexcept
+    {   return static_cast<unsigned>(_workers.size());
+    }
+
+// -- tasks --------------------------------------------------------------------
+    ///
+    /// Queues @a f for execution and returns a future for its result.
+    template<typename F>
+    auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+    {   using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        auto fut = task->get_future();
+        {   std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.emplace_back([task] { (*task)(); });
+        }
+        _cv.notify_one();
+        return fut;
+    }
+    ///
+    /// Returns a process-wide pool with one thread per hardware thread,
+    /// created on first use.
+    static thread_pool& global()
+    {   static thread_pool pool;
+        return pool;
+    }
+
+private:
+    void _run()
+    {   for (;;)
+        {   std::function<void()> task;
+            {   std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [this] { return _stop || ! _tasks.empty(); });
+                if (_tasks.empty())
+                    return;
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+/// @brief Calls @a f(i) for every i in [0, @a n) using the workers of
+/// @a pool and the calling thread, and returns when all calls are done.
+/// @details Indices are claimed dynamically, so uneven work balances itself.
+/// The caller only waits for indices that are already running, which makes
+/// nested calls from inside pool tasks safe. The first exception thrown by
+/// @a f is rethrown in the caller.
+template<typename F>
+void parallel_for(thread_pool& pool, std::size_t n, F f)
+{   if (0 == n)
+        return;
+    struct state
+    {   std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::exception_ptr       error;
+        std::mutex               mutex;
+        std::condition_variable  cv;
+        std::size_t              n;
+        F                        f;
+        state(std::size_t count, F fn) : n(count), f(std::move(fn)) {}
+        void work()
+        {   for (std::size_t i; (i = next.fetch_add(1)) < n; )
+            {   try
+                {   f(i);
+                }
+                catch (...)
+                {   std::lock_guard<std::mutex> lock(mutex);
+                    if (! error)
+                        error = std::current_exception();
+                }
+                if (done.fetch_add(1) + 1 == n)
+                {   std::lock_guard<std::mutex> lock(mutex);
+                    cv.notify_all();
+                }
+            }
+        }
+    };
+    auto st = std::make_shared<state>(n, std::move(f));
+    const std::size_t helpers = std::min<std::size_t>(pool.size(), n - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+        pool.submit([st] { st->work(); });
+    st->work();
+    std::unique_lock<std::mutex> lock(st->mutex);
+    st->cv.wait(lock, [&] { return st->done.load() == n; });
+    if (st->error)
+        std::rethrow_exception(st->error);
+}
+
+namespace detail {
+
+// block size used to split whole-sequence work across threads
+inline constexpr std::size_t parallel_block = std::size_t(1) << 22;
+
+// default consumer of parallel_pipeline(): ignores finished batches
+struct ignore_batch
+{   template<typename... Args>
+    void operator() (Args&&...) const noexcept
+    {}
+};
+
+}   // end gynx::detail namespace
+
+/// @brief Splits [0, @a n) into blocks of @a block positions and calls
+/// @a f(first, last) for each of them via parallel_for(), where
+/// [first, last) is the block extended by @a overlap positions (clipped at
+/// @a n).
+/// @details Every window of @a overlap + 1 positions lies entirely in the
+/// range of the block it starts in, so k-mer and sliding-window algorithms
+/// can process blocks independently without missing or repeating windows
+/// that straddle block boundaries.
+template<typename F>
+void parallel_chunks
+(   thread_pool& pool
+,   std::size_t n
+,   std::size_t overlap
+,   F f
+,   std::size_t block = detail::parallel_block
+)
+{   block = std::max<std::size_t>(block, 1);
+    parallel_for
+    (   pool
+    ,   (n + block - 1) / block
+    ,   [&](std::size_t b)
+        {   const std::size_t first = b * block;
+            f(first, std::min(n, first + block + overlap));
+        }
+    );
+}
+
+// -- parallel_pipeline --------------------------------------------------------
+
+/// @brief Runs a bounded producer/consumer pipeline of @a Batch objects on
+/// @a pool.
+/// @details @a produce(submit) runs on the calling thread and passes every
+/// batch, as a std::shared_ptr<Batch>, to submit(). Each batch is processed
+/// by @a work(batch&) on @a pool. @a consume(batch&, result) (or
+/// @a consume(batch&) if @a work returns void) is called on the calling
+/// thread with the batches in submission order. At most 2 * pool.size()
+/// batches are in flight: submit() consumes the oldest one first if
+/// needed, so memory stays bounded while the producer (e.g. a file reader)
+/// keeps the pool busy. If anything throws, the batches in flight are
+/// waited for and the first exception is rethrown.
+/// @note Must not be called from a task running on @a pool.
+template
+<   typename Batch
+,   typename Produce
+,   typename Work
+,   typename Consume = detail::ignore_batch
+>
+void parallel_pipeline
+(   thread_pool& pool
+,   Produce produce
+,   Work work
+,   Consume consume = Consume()
+)
+{   using R = std::invoke_result_t<Work&, Batch&>;
+    std::deque<std::pair<std::shared_ptr<Batch>, std::future<R>>> pending;
+    auto drain = [&]
+    {   auto [b, f] = std::move(pending.front());
+        pending.pop_front();
+        if constexpr (std::is_void_v<R>)
+        {   f.get();
+            consume(*b);
+        }
+        else
+            consume(*b, f.get());
+    };
+    auto submit = [&](std::shared_ptr<Batch> b)
+    {   if (pending.size() >= 2 * std::size_t(pool.size()))
+            drain();
+        auto f = pool.submit([b, &work] { return work(*b); });
+        pending.emplace_back(std::move(b), std::move(f));
+    };
+    try
+    {   produce(submit);
+        while (! pending.empty())
+            drain();
+    }
+    catch (...)
+    {   for (auto& p : pending)
+            p.second.wait();
+        throw;
+    }
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_THREAD_POOL_HPP_
@@ -0,0 +1,557 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_TRANSLATE_HPP_
+#define _GYNX_TRANSLATE_HPP_
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/reverse_complement.hpp>
+#include <gynx/lut/codon.hpp>
+
+namespace gynx {
+
+/// @brief The genetic codes supported by translate(), numbered as the NCBI
+/// translation tables.
+enum class genetic_code
+{   standard = 1
+,   vertebrate_mitochondrial = 2
+,   yeast_mitochondrial = 3
+,   mold_mitochondrial = 4   ///< also protozoan mitochondrial and Mycoplasma
+,   invertebrate_mitochondrial = 5
+,   ciliate = 6
+,   echinoderm_mitochondrial = 9
+,   euplotid = 10
+,   bacterial = 11           ///< also archaeal and plant plastid
+,   alternative_yeast = 12
+,   ascidian_mitochondrial = 13
+,   alternative_flatworm = 14
+};
+
+namespace detail {
+
+// The codon table of a genetic code twice: indexed by lut::codon_base codes
+// for the scalar loop and by the (c >> 1) & 3 codes of the vector kernels
+// (A 0, C 1, T/U 2, G 3), as four 16-byte pshufb tables.
+struct codon_lookup
+{   const std::array<char, 64>* scalar;
+    alignas(64) std::array<char, 64> simd;
+
+    explicit codon_lookup(genetic_code code)
+    {   switch (code)
+        {   case genetic_code::standard:
+            case genetic_code::bacterial:
+                scalar = &lut::codon_standard; break;
+            case genetic_code::vertebrate_mitochondrial:
+                scalar = &lut::codon_vertebrate_mitochondrial; break;
+            case genetic_code::yeast_mitochondrial:
+                scalar = &lut::codon_yeast_mitochondrial; break;
+            case genetic_code::mold_mitochondrial:
+                scalar = &lut::codon_mold_mitochondrial; break;
+            case genetic_code::invertebrate_mitochondrial:
+                scalar = &lut::codon_invertebrate_mitochondrial; break;
+            case genetic_code::ciliate:
+                scalar = &lut::codon_ciliate; break;
+            case genetic_code::echinoderm_mitochondrial:
+                scalar = &lut::codon_echinoderm_mitochondrial; break;
+            case genetic_code::euplotid:
+                scalar = &lut::codon_euplotid; break;
+            case genetic_code::alternative_yeast:
+                scalar = &lut::codon_alternative_yeast; break;
+            case genetic_code::ascidian_mitochondrial:
+                scalar = &lut::codon_ascidian_mitochondrial; break;
+            case genetic_code::alternative_flatworm:
+                scalar = &lut::codon_alternative_flatworm; break;
+            default:
+                throw std::invalid_argument("gynx::translate: unknown genetic code");
+        }
+        constexpr std::uint8_t base[] { 0, 1, 3, 2 };
+        for (int i = 0; i < 64; ++i)
+            simd[i] = (*scalar)[16 * base[i / 16] + 4 * base[i / 4 % 4] + base[i % 4]];
+    }
+};
+
+// -- scalar kernel ------------------------------------------------------------
+
+inline char* translate_scalar
+(   const char* first
+,   std::size_t codons
+,   char* d_first
+,   const codon_lookup& t
+)   noexcept
+{   for (; codons; --codons, first += 3)
+    {   const auto b1 = lut::codon_base[static_cast<std::uint8_t>(first[0])];
+        const auto b2 = lut::codon_base[static_cast<std::uint8_t>(first[1])];
+        const auto b3 = lut::codon_base[static_cast<std::uint8_t>(first[2])];
+        *d_first++ = (b1 | b2 | b3) & 4 ? 'X' : (*t.scalar)[16 * b1 + 4 * b2 + b3];
+    }
+    return d_first;
+}
+
+#if GYNX_SIMD_X86
+
+// All vector kernels work on 16 codons (48 bytes) per 128-bit lane: three
+// pshufb per base position gather the first, second and third bases of the
+// codons, (c >> 1) & 3 packs each codon into a 6-bit index, and four pshufb
+// tables blended on index bits 4 and 5 look up the amino acid. Codons with
+// anything but A/C/G/T/U become 'X'.
+
+// pshufb masks gathering base k of codon i from register r of a 48-byte
+// group, at [3 * k + r]
+constexpr std::array<std::array<std::int8_t, 16>, 9> create_codon_gather_masks()
+{   std::array<std::array<std::int8_t, 16>, 9> masks{};
+    for (int k = 0; k < 3; ++k)
+        for (int r = 0; r < 3; ++r)
+            for (int i = 0; i < 16; ++i)
+            {   const int s = 3 * i + k;
+                masks[3 * k + r][i] = static_cast<std::int8_t>(s / 16 == r ? s % 16 : -128);
+            }
+    return masks;
+}
+static constexpr auto codon_gather = create_codon_gather_masks();
+
+// -- SSE4.2 -------------------------------------------------------------------
+
+GYNX_TARGET_SSE42
+inline __m128i translate_sse42
+(   __m128i r0
+,   __m128i r1
+,   __m128i r2
+,   const codon_lookup& t
+)   noexcept
+{   const __m128i three = _mm_set1_epi8(3);
+    const __m128i upper = _mm_set1_epi8(char(0xDF));
+    __m128i code[3], valid = _mm_set1_epi8(-1);
+    for (int k = 0; k < 3; ++k)
+    {   const __m128i* m
+            = reinterpret_cast<const __m128i*>(codon_gather[3 * k].data());
+        const __m128i b = _mm_or_si128
+        (   _mm_or_si128
+            (   _mm_shuffle_epi8(r0, _mm_loadu_si128(m))
+            ,   _mm_shuffle_epi8(r1, _mm_loadu_si128(m + 1))
+            )
+        ,   _mm_shuffle_epi8(r2, _mm_loadu_si128(m + 2))
+        );
+        const __m128i u = _mm_and_si128(b, upper);
+        valid = _mm_and_si128
+        (   valid
+        ,   _mm_or_si128
+            (   _mm_or_si128
+                (   _mm_or_si128
+                    (   _mm_cmpeq_epi8(u, _mm_set1_epi8('A'))
+                    ,   _mm_cmpeq_epi8(u, _mm_set1_epi8('C'))
+                    )
+                ,   _mm_or_si128
+                    (   _mm_cmpeq_epi8(u, _mm_set1_epi8('G'))
+                    ,   _mm_cmpeq_epi8(u, _mm_set1_epi8('T'))
+                    )
+                )
+            ,   _mm_cmpeq_epi8(u, _mm_set1_epi8('U'))
+            )
+        );
+        code[k] = _mm_and_si128(_mm_srli_epi16(b, 1), three);
+    }
+    const __m128i idx = _mm_or_si128
+    (   _mm_or_si128(_mm_slli_epi16(code[0], 4), _mm_slli_epi16(code[1], 2))
+    ,   code[2]
+    );
+    const __m128i* tab = reinterpret_cast<const __m128i*>(t.simd.data());
+    const __m128i bit4 = _mm_slli_epi16(idx, 3);
+    const __m128i bit5 = _mm_slli_epi16(idx, 2);
+    const __m128i aa = _mm_blendv_epi8
+    (   _mm_blendv_epi8
+        (   _mm_shuffle_epi8(_mm_load_si128(tab), idx)
+        ,   _mm_shuffle_epi8(_mm_load_si128(tab + 1), idx)
+        ,   bit4
+        )
+    ,   _mm_blendv_epi8
+        (   _mm_shuffle_epi8(_mm_load_si128(tab + 2), idx)
+        ,   _mm_shuffle_epi8(_mm_load_si128(tab + 3), idx)
+        ,   bit4
+        )
+    ,   bit5
+    );
+    return _mm_blendv_epi8(_mm_set1_epi8('X'), aa, valid);
+}
+
+GYNX_TARGET_SSE42
+inline char* translate_sse42
+(   const char* first
+,   std::size_t codons
+,   char* d_first
+,   const codon_lookup& t
+)   noexcept
+{   for (; codons >= 16; codons -= 16, first += 48, d_first += 16)
+    {   const __m128i* p = reinterpret_cast<const __m128i*>(first);
+        _mm_storeu_si128
+        (   reinterpret_cast<__m128i*>(d_first)
+        ,   translate_sse42
+            (   _mm_loadu_si128(p)
+            ,   _mm_loadu_si128(p + 1)
+            ,   _mm_loadu_si128(p + 2)
+            ,   t
+            )
+        );
+    }
+    return translate_scalar(first, codons, d_first, t);
+}
+
+// -- AVX2 ---------------------------------------------------------------------
+
+GYNX_TARGET_AVX2
+inline char* translate_avx2
+(   const char* first
+,   std::size_t codons
+,   char* d_first
+,   const codon_lookup& t
+)   noexcept
+{   const __m256i three = _mm256_set1_epi8(3);
+    const __m256i upper = _mm256_set1_epi8(char(0xDF));
+    __m256i gather[9], tab[4];
+    for (int i = 0; i < 9; ++i)
+        gather[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128
+            (reinterpret_cast<const __m128i*>(codon_gather[i].data())));
+    for (int i = 0; i < 4; ++i)
+        tab[i] = _mm256_broadcastsi128_si256(_mm_load_si128
+            (reinterpret_cast<const __m128i*>(t.simd.data()) + i));
+    // each 128-bit lane translates its own 48-byte group
+    for (; codons >= 32; codons -= 32, first += 96, d_first += 32)
+    {   const __m128i* p = reinterpret_cast<const __m128i*>(first);
+        const __m256i r[3]
+        {   _mm256_set_m128i(_mm_loadu_si128(p + 3), _mm_loadu_si128(p))
+        ,   _mm256_set_m128i(_mm_loadu_si128(p + 4), _mm_loadu_si128(p + 1))
+        ,   _mm256_set_m128i(_mm_loadu_si128(p + 5), _mm_loadu_si128(p + 2))
+        };
+        __m256i code[3], valid = _mm256_set1_epi8(-1);
+        for (int k = 0; k < 3; ++k)
+        {   const __m256i b = _mm256_or_si256
+            (   _mm256_or_si256
+                (   _mm256_shuffle_epi8(r[0], gather[3 * k])
+                ,   _mm256_shuffle_epi8(r[1], gather[3 * k + 1])
+                )
+            ,   _mm256_shuffle_epi8(r[2], gather[3 * k + 2])
+            );
+            const __m256i u = _mm256_and_si256(b, upper);
+            valid = _mm256_and_si256
+            (   valid
+            ,   _mm256_or_si256
+                (   _mm256_or_si256
+                    (   _mm256_or_si256
+                        (   _mm256_cmpeq_epi8(u, _mm256_set1_epi8('A'))
+                        ,   _mm256_cmpeq_epi8(u, _mm256_set1_epi8('C'))
+                        )
+                    ,   _mm256_or_si256
+                        (   _mm256_cmpeq_epi8(u, _mm256_set1_epi8('G'))
+                        ,   _mm256_cmpeq_epi8(u, _mm256_set1_epi8('T'))
+                        )
+                    )
+                ,   _mm256_cmpeq_epi8(u, _mm256_set1_epi8('U'))
+                )
+            );
+            code[k] = _mm256_and_si256(_mm256_srli_epi16(b, 1), three);
+        }
+        const __m256i idx = _mm256_or_si256
+        (   _mm256_or_si256
+            (   _mm256_slli_epi16(code[0], 4)
+            ,   _mm256_slli_epi16(code[1], 2)
+            )
+        ,   code[2]
+        );
+        const __m256i bit4 = _mm256_slli_epi16(idx, 3);
+        const __m256i bit5 = _mm256_slli_epi16(idx, 2);
+        const __m256i aa = _mm256_blendv_epi8
+        (   _mm256_blendv_epi8
+            (   _mm256_shuffle_epi8(tab[0], idx)
+            ,   _mm256_shuffle_epi8(tab[1], idx)
+            ,   bit4
+            )
+        ,   _mm256_blendv_epi8
+            (   _mm256_shuffle_epi8(tab[2], idx)
+            ,   _mm256_shuffle_epi8(tab[3], idx)
+            ,   bit4
+            )
+        ,   bit5
+        );
+        _mm256_storeu_si256
+        (   reinterpret_cast<__m256i*>(d_first)
+        ,   _mm256_blendv_epi8(_mm256_set1_epi8('X'), aa, valid)
+        );
+    }
+    return translate_sse42(first, codons, d_first, t);
+}
+
+// -- AVX-512 ------------------------------------------------------------------
+
+GYNX_TARGET_AVX512
+inline char* translate_avx512
+(   const char* first
+,   std::size_t codons
+,   char* d_first
+,   const codon_lookup& t
+)   noexcept
+{   const __m512i three = _mm512_set1_epi8(3);
+    const __m512i upper = _mm512_set1_epi8(char(0xDF));
+    // maskz forms avoid GCC's maybe-uninitialized false positives
+    __m512i gather[9], tab[4];
+    for (int i = 0; i < 9; ++i)
+        gather[i] = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128
+            (reinterpret_cast<const __m128i*>(codon_gather[i].data())));
+    for (int i = 0; i < 4; ++i)
+        tab[i] = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_load_si128
+            (reinterpret_cast<const __m128i*>(t.simd.data()) + i));
+    // each 128-bit lane translates its own 48-byte group
+    for (; codons >= 64; codons -= 64, first += 192, d_first += 64)
+    {   const __m128i* p = reinterpret_cast<const __m128i*>(first);
+        __m512i r[3];
+        for (int j = 0; j < 3; ++j)
+        {   r[j] = _mm512_maskz_broadcast_i32x4(0x000F, _mm_loadu_si128(p + j));
+            r[j] = _mm512_mask_broadcast_i32x4(r[j], 0x00F0, _mm_loadu_si128(p + 3 + j));
+            r[j] = _mm512_mask_broadcast_i32x4(r[j], 0x0F00, _mm_loadu_si128(p + 6 + j));
+            r[j] = _mm512_mask_broadcast_i32x4(r[j], 0xF000, _mm_loadu_si128(p + 9 + j));
+        }
+        __m512i code[3];
+        __mmask64 valid = ~__mmask64(0);
+        for (int k = 0; k < 3; ++k)
+        {   const __m512i b = _mm512_or_si512
+            (   _mm512_or_si512
+                (   _mm512_shuffle_epi8(r[0], gather[3 * k])
+                ,   _mm512_shuffle_epi8(r[1], gather[3 * k + 1])
+                )
+            ,   _mm512_shuffle_epi8(r[2], gather[3 * k + 2])
+            );
+            const __m512i u = _mm512_and_si512(b, upper);
+            valid &= _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('A'))
+                |   _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('C'))
+                |   _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('G'))
+                |   _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('T'))
+                |   _mm512_cmpeq_epi8_mask(u, _mm512_set1_epi8('U'));
+            code[k] = _mm512_and_si512(_mm512_srli_epi16(b, 1), three);
+        }
+        const __m512i idx = _mm512_or_si512
+        (   _mm512_or_si512
+            (   _mm512_slli_epi16(code[0], 4)
+            ,   _mm512_slli_epi16(code[1], 2)
+            )
+        ,   code[2]
+        );
+        const __mmask64 bit4 = _mm512_test_epi8_mask(idx, _mm512_set1_epi8(16));
+        const __mmask64 bit5 = _mm512_test_epi8_mask(idx, _mm512_set1_epi8(32));
+        const __m512i aa = _mm512_mask_blend_epi8
+        (   bit5
+        ,   _mm512_mask_blend_epi8
+            (   bit4
+            ,   _mm512_shuffle_epi8(tab[0], idx)
+            ,   _mm512_shuffle_epi8(tab[1], idx)
+            )
+        ,   _mm512_mask_blend_epi8
+            (   bit4
+            ,   _mm512_shuffle_epi8(tab[2], idx)
+            ,   _mm512_shuffle_epi8(tab[3], idx)
+            )
+        );
+        _mm512_storeu_si512
+        (   d_first
+        ,   _mm512_mask_blend_epi8(valid, _mm512_set1_epi8('X'), aa)
+        );
+    }
+    return translate_avx2(first, codons, d_first, t);
+}
+
+#endif  // GYNX_SIMD_X86
+
+inline char* translate
+(   const char* first
+,   std::size_t codons
+,   char* d_first
+,   const codon_lookup& t
+)   noexcept
+{   switch (simd::level())
+    {
+#if GYNX_SIMD_X86
+        case simd::isa::avx512:
+            return translate_avx512(first, codons, d_first, t);
+        case simd::isa::avx2:
+            return translate_avx2(first, codons, d_first, t);
+        case simd::isa::sse42:
+            return translate_sse42(first, codons, d_first, t);
+#endif
+        default:
+            return translate_scalar(first, codons, d_first, t);
+    }
+}
+
+// Returns the offset of the frame and whether it is on the reverse strand.
+inline std::pair<std::size_t, bool> frame_offset(int frame)
+{   if (frame < -3 || frame > 3 || 0 == frame)
+        throw std::invalid_argument("gynx::translate: frame must be 1..3 or -1..-3");
+    return { static_cast<std::size_t>(frame < 0 ? -frame - 1 : frame - 1), frame < 0 };
+}
+
+}   // end gynx::detail namespace
+
+// -- raw buffers --------------------------------------------------------------
+///
+/// @brief Translates the whole codons of [@a first, @a last) with the
+/// genetic @a code and writes one residue per codon to the range beginning
+/// at @a d_first. Stop codons become '*' and codons with anything but
+/// A/C/G/T/U (either case) become 'X'. A trailing partial codon is ignored.
+/// @details Dispatches at runtime to the best of AVX-512, AVX2 and SSE4.2
+/// kernels (see gynx::simd::level()), falling back to a lookup-table loop.
+/// @return Iterator one past the last residue written.
+inline char* translate
+(   const char* first
+,   const char* last
+,   char* d_first
+,   genetic_code code = genetic_code::standard
+)
+{   const detail::codon_lookup t(code);
+    return detail::translate(first, std::size_t(last - first) / 3, d_first, t);
+}
+
+// -- sequences ----------------------------------------------------------------
+///
+/// @brief Returns the translation of @a v in @a frame: 1, 2 or 3 start at
+/// the first, second or third residue of @a v; -1, -2 or -3 likewise on its
+/// reverse complement.
+template<typename Container>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container> translate
+(   sq_view_gen<Container> v
+,   int frame = 1
+,   genetic_code code = genetic_code::standard
+)
+{   const auto [offset, reverse] = detail::frame_offset(frame);
+    const detail::codon_lookup t(code);
+    const std::size_t codons = v.size() > offset ? (v.size() - offset) / 3 : 0;
+    sq_gen<Container> r(codons);
+    if (0 == codons)
+        return r;
+    if (reverse)
+    {   std::vector<char> rc(v.size());
+        reverse_complement_copy(v.data(), v.data() + v.size(), rc.data());
+        detail::translate(rc.data() + offset, codons, r.data(), t);
+    }
+    else
+        detail::translate(v.data() + offset, codons, r.data(), t);
+    return r;
+}
+///
+/// @brief Returns the translation of @a s in @a frame (see above).
+template<typename Container, typename Map>
+requires std::same_as<typename Container::value_type, char>
+sq_gen<Container> translate
+(   const sq_gen<Container, Map>& s
+,   int frame = 1
+,   genetic_code code = genetic_code::standard
+)
+{   return translate(s(0), frame, code);
+}
+///
+/// @brief Returns the translations of @a v in frames 1, 2, 3, -1, -2 and
+/// -3, in that order.
+template<typename Container>
+requires std::same_as<typename Container::value_type, char>
+std::array<sq_gen<Container>, 6> translate_six_frames
+(   sq_view_gen<Container> v
+,   genetic_code code = genetic_code::standard
+)
+{   const detail::codon_lookup t(code);
+    std::vector<char> rc(v.size());
+    reverse_complement_copy(v.data(), v.data() + v.size(), rc.data());
+    std::array<sq_gen<Container>, 6> r;
+    for (std::size_t f = 0; f < 6; ++f)
+    {   const std::size_t offset = f % 3;
+        const std::size_t codons = v.size() > offset ? (v.size() - offset) / 3 : 0;
+        r[f] = sq_gen<Container>(codons);
+        detail::translate((f < 3 ? v.data() : rc.data()) + offset, codons, r[f].data(), t);
+    }
+    return r;
+}
+
+// -- open reading frames ------------------------------------------------------
+
+/// @brief An open reading frame: [@a begin, @a end) on the forward strand of
+/// the searched sequence, stop codon included, and its @a frame (1..3 or
+/// -1..-3, as in translate()).
+struct orf
+{   int frame;
+    std::size_t begin;
+    std::size_t end;
+
+    /// Returns the number of amino acids, not counting the stop codon.
+    std::size_t length() const noexcept
+    {   return (end - begin) / 3 - 1;
+    }
+
+    friend bool operator== (const orf&, const orf&) = default;
+};
+
+/// @brief Returns the open reading frames of @a v with at least
+/// @a min_length amino acids, on both strands unless @a both_strands is
+/// false.
+/// @details An ORF runs from the first methionine codon after a stop (or the
+/// start of the frame) to the next stop codon of @a code; frames are
+/// translated with the vector kernels and scanned for 'M' and '*'. ORFs
+/// without a stop codon before the end of @a v are not reported. The result
+/// is ordered by frame (1, 2, 3, -1, -2, -3), then by position in the frame.
+template<typename Container>
+requires std::same_as<typename Container::value_type, char>
+std::vector<orf> find_orfs
+(   sq_view_gen<Container> v
+,   std::size_t min_length = 100
+,   genetic_code code = genetic_code::standard
+,   bool both_strands = true
+)
+{   const auto frames = translate_six_frames(v, code);
+    std::vector<orf> r;
+    const std::size_t n = v.size();
+    for (std::size_t f = 0; f < (both_strands ? 6u : 3u); ++f)
+    {   const auto& p = frames[f];
+        const std::size_t offset = f % 3;
+        std::size_t start = std::size_t(-1);
+        for (std::size_t i = 0; i < p.size(); ++i)
+            if ('*' == p[i])
+            {   if (start != std::size_t(-1) && i - start >= min_length)
+                {   const std::size_t b = offset + 3 * start, e = offset + 3 * (i + 1);
+                    if (f < 3)
+                        r.push_back({ int(f) + 1, b, e });
+                    else
+                        r.push_back({ 2 - int(f), n - e, n - b });
+                }
+                start = std::size_t(-1);
+            }
+            else if ('M' == p[i] && start == std::size_t(-1))
+                start = i;
+    }
+    return r;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_TRANSLATE_HPP_
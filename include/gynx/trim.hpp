@@ -0,0 +1,398 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _GYNX_TRIM_HPP_
+#define _GYNX_TRIM_HPP_
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/simd.hpp>
+#include <gynx/thread_pool.hpp>
+
+namespace gynx {
+
+/// @brief The half-open region [begin, end) of a read kept by a trimmer.
+struct trim_range
+{   std::size_t begin = 0;
+    std::size_t end = 0;
+
+    std::size_t size() const noexcept
+    {   return end - begin;
+    }
+    friend bool operator== (const trim_range&, const trim_range&) = default;
+};
+
+namespace detail {
+
+// -- sliding window kernels ---------------------------------------------------
+
+// All kernels return the start of the first window of @a w quality
+// characters in [i, n) whose raw sum is below @a required, or n - w + 1 if
+// there is none; n >= w.
+
+inline std::size_t first_low_window_scalar
+(   const char* q
+,   std::size_t n
+,   std::size_t w
+,   std::uint64_t required
+,   std::size_t i
+)   noexcept
+{   if (i + w > n)
+        return n - w + 1;
+    std::uint64_t sum = 0;
+    for (std::size_t j = 0; j < w; ++j)
+        sum += static_cast<std::uint8_t>(q[i + j]);
+    for (; ; ++i)
+    {   if (sum < required)
+            return i;
+        if (i + w == n)
+            return i + 1;
+        sum += static_cast<std::uint8_t>(q[i + w]);
+        sum -= static_cast<std::uint8_t>(q[i]);
+    }
+}
+
+#if GYNX_SIMD_X86
+
+// windows start at consecutive lanes and are summed from w shifted loads of
+// 16-bit values and compared as signed 16-bit values, so w is limited to
+// window_simd_max to keep sums below 2^15, and required to
+// window_simd_required_max
+
+inline constexpr std::size_t window_simd_max = 64;
+inline constexpr std::uint64_t window_simd_required_max = 0x7FFF;
+
+GYNX_TARGET_SSE42
+inline std::size_t first_low_window_sse42
+(   const char* q
+,   std::size_t n
+,   std::size_t w
+,   std::uint64_t required
+)   noexcept
+{   const __m128i r = _mm_set1_epi16(static_cast<short>(required));
+    std::size_t i = 0;
+    for (; i + 8 + w - 1 <= n; i += 8)
+    {   __m128i s = _mm_setzero_si128();
+        for (std::size_t j = 0; j < w; ++j)
+            s = _mm_add_epi16(s, _mm_cvtepu8_epi16(_mm_loadl_epi64
+                (reinterpret_cast<const __m128i*>(q + i + j))));
+        const unsigned m = _mm_movemask_epi8(_mm_cmpgt_epi16(r, s));
+        if (m)
+            return i + std::countr_zero(m) / 2;
+    }
+    return first_low_window_scalar(q, n, w, required, i);
+}
+
+GYNX_TARGET_AVX2
+inline std::size_t first_low_window_avx2
+(   const char* q
+,   std::size_t n
+,   std::size_t w
+,   std::uint64_t required
+)   noexcept
+{   const __m256i r = _mm256_set1_epi16(static_cast<short>(required));
+    std::size_t i = 0;
+    for (; i + 16 + w - 1 <= n; i += 16)
+    {   __m256i s = _mm256_setzero_si256();
+        for (std::size_t j = 0; j < w; ++j)
+            s = _mm256_add_epi16(s, _mm256_cvtepu8_epi16(_mm_loadu_si128
+                (reinterpret_cast<const __m128i*>(q + i + j))));
+        const unsigned m = _mm256_movemask_epi8(_mm256_cmpgt_epi16(r, s));
+        if (m)
+            return i + std::countr_zero(m) / 2;
+    }
+    if (i + w > n)
+        return n - w + 1;
+    return first_low_window_sse42(q + i, n - i, w, required) + i;
+}
+
+GYNX_TARGET_AVX512
+inline std::size_t first_low_window_avx512
+(   const char* q
+,   std::size_t n
+,   std::size_t w
+,   std::uint64_t required
+)   noexcept
+{   const __m512i r = _mm512_set1_epi16(static_cast<short>(required));
+    std::size_t i = 0;
+    for (; i + 32 + w - 1 <= n; i += 32)
+    {   __m512i s = _mm512_setzero_si512();
+        for (std::size_t j = 0; j < w; ++j)
+            s = _mm512_add_epi16(s, _mm512_cvtepu8_epi16(_mm256_loadu_si256
+                (reinterpret_cast<const __m256i*>(q + i + j))));
+        const std::uint32_t m = _mm512_cmplt_epu16_mask(s, r);
+        if (m)
+            return i + std::countr_zero(m);
+    }
+    if (i + w > n)
+        return n - w + 1;
+    return first_low_window_sse42(q + i, n - i, w, required) + i;
+}
+
+#endif  // GYNX_SIMD_X86
+
+inline std::size_t first_low_window
+(   const char* q
+,   std::size_t n
+,   std::size_t w
+,   std::uint64_t required
+)   noexcept
+{
+#if GYNX_SIMD_X86
+    if (w <= window_simd_max && required <= window_simd_required_max)
+        switch (simd::level())
+        {   case simd::isa::avx512:
+                return first_low_window_avx512(q, n, w, required);
+            case simd::isa::avx2:
+                return first_low_window_avx2(q, n, w, required);
+            case simd::isa::sse42:
+                return first_low_window_sse42(q, n, w, required);
+            default:
+                break;
+        }
+#endif
+    return first_low_window_scalar(q, n, w, required, 0);
+}
+
+// -- minimum quality ----------------------------------------------------------
+
+// returns true if every character of q[0, n) is at least @a c
+inline bool all_at_least_scalar(const char* q, std::size_t n, std::uint8_t c) noexcept
+{   std::uint8_t m = 0xFF;
+    for (std::size_t i = 0; i < n; ++i)
+        m = std::min(m, static_cast<std::uint8_t>(q[i]));
+    return m >= c;
+}
+
+#if GYNX_SIMD_X86
+
+GYNX_TARGET_AVX2
+inline bool all_at_least_avx2(const char* q, std::size_t n, std::uint8_t c) noexcept
+{   __m256i m = _mm256_set1_epi8(char(0xFF));
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+        m = _mm256_min_epu8(m, _mm256_loadu_si256
+            (reinterpret_cast<const __m256i*>(q + i)));
+    const __m256i low = _mm256_cmpeq_epi8
+        (_mm256_max_epu8(m, _mm256_set1_epi8(char(c))), m);
+    return -1 == _mm256_movemask_epi8(low) && all_at_least_scalar(q + i, n - i, c);
+}
+
+#endif  // GYNX_SIMD_X86
+
+inline bool all_at_least(const char* q, std::size_t n, std::uint8_t c) noexcept
+{
+#if GYNX_SIMD_X86
+    if (simd::level() >= simd::isa::avx2)
+        return all_at_least_avx2(q, n, c);
+#endif
+    return all_at_least_scalar(q, n, c);
+}
+
+}   // end gynx::detail namespace
+
+// -- trimmers -----------------------------------------------------------------
+
+/// @brief Trimmomatic-style SLIDINGWINDOW trimmer.
+/// @details Scans from the 5' end and cuts at the first window of @a window
+/// bases whose mean quality is below @a threshold, keeping the leading
+/// bases of that window that reach @a threshold themselves. A read shorter
+/// than the window is treated as one window. Window sums are computed 8 to
+/// 32 windows at a time with SSE4.2, AVX2 or AVX-512 (see
+/// gynx::simd::level()) for windows of up to 64 bases.
+struct sliding_window_trimmer
+{   std::size_t window = 4;
+    unsigned threshold = 20;
+
+    trim_range operator() (std::string_view qual, unsigned offset = 33) const
+    {   if (0 == window)
+            throw std::invalid_argument("gynx::sliding_window_trimmer: window is 0");
+        const std::size_t n = qual.size();
+        const std::size_t w = std::min(window, n);
+        if (0 == w)
+            return {};
+        const std::uint64_t per_base = std::uint64_t(threshold) + offset;
+        std::size_t cut = detail::first_low_window
+        (   qual.data()
+        ,   n
+        ,   w
+        ,   std::uint64_t(w) * per_base
+        );
+        if (cut == n - w + 1)
+            return { 0, n };
+        for (std::size_t end = cut + w; cut < end; ++cut)
+            if (static_cast<std::uint8_t>(qual[cut]) < per_base)
+                break;
+        return { 0, cut };
+    }
+};
+
+/// @brief BWA-style (`bwa aln -q`) running-sum trimmer.
+/// @details From the 3' end, sums threshold - Q and cuts where the sum
+/// peaks, stopping once it turns negative, so a low-quality tail is removed
+/// even if it contains a few good bases. A non-zero @a five_prime threshold
+/// trims the 5' end the same way (as cutadapt does).
+struct bwa_trimmer
+{   unsigned threshold = 20;
+    unsigned five_prime = 0;
+
+    trim_range operator() (std::string_view qual, unsigned offset = 33) const
+    {   auto q = [&](std::size_t i)
+        {   return int(static_cast<std::uint8_t>(qual[i])) - int(offset);
+        };
+        std::size_t begin = 0, end = qual.size();
+        if (five_prime)
+        {   long s = 0, best = 0;
+            for (std::size_t i = 0; i < end; ++i)
+            {   s += long(five_prime) - q(i);
+                if (s < 0)
+                    break;
+                if (s > best)
+                {   best = s;
+                    begin = i + 1;
+                }
+            }
+        }
+        long s = 0, best = 0;
+        for (std::size_t i = end; i-- > begin; )
+        {   s += long(threshold) - q(i);
+            if (s < 0)
+                break;
+            if (s > best)
+            {   best = s;
+                end = i;
+            }
+        }
+        return { begin, std::max(begin, end) };
+    }
+};
+
+/// @brief Modified Mott trimmer (as in phred and `seqtk trimfq`).
+/// @details Scores each base limit - P(error) and keeps the segment with
+/// the highest total score (a maximum-sum subarray). Scores are held as
+/// 16.16 fixed-point integers per Phred value, and a read whose bases all
+/// score positively is kept whole after one vectorized minimum check.
+class mott_trimmer
+{   std::array<std::int32_t, 128> _score;
+    unsigned _min_positive;  // lowest Phred value with a positive score
+
+public:
+    /// @brief Creates a trimmer with error probability limit @a limit.
+    explicit mott_trimmer(double limit = 0.05)
+    {   if (! (limit > 0.0 && limit < 1.0))
+            throw std::invalid_argument("gynx::mott_trimmer: limit out of (0, 1)");
+        _min_positive = 128;
+        for (unsigned q = 0; q < 128; ++q)
+        {   _score[q] = static_cast<std::int32_t>
+                (std::lround((limit - std::pow(10.0, -double(q) / 10.0)) * 65536.0));
+            if (_score[q] > 0 && 128 == _min_positive)
+                _min_positive = q;
+        }
+    }
+
+    trim_range operator() (std::string_view qual, unsigned offset = 33) const
+    {   const std::size_t n = qual.size();
+        if (_min_positive + offset < 256 && detail::all_at_least
+            (qual.data(), n, static_cast<std::uint8_t>(_min_positive + offset)))
+            return { 0, n };
+        std::int64_t s = 0, best = 0;
+        std::size_t start = 0;
+        trim_range r{ 0, 0 };
+        for (std::size_t i = 0; i < n; ++i)
+        {   const int q = std::clamp
+                (int(static_cast<std::uint8_t>(qual[i])) - int(offset), 0, 127);
+            s += _score[q];
+            if (s > best)
+            {   best = s;
+                r = { start, i + 1 };
+            }
+            if (s < 0)
+            {   s = 0;
+                start = i + 1;
+            }
+        }
+        return r;
+    }
+};
+
+// -- trimming records ---------------------------------------------------------
+///
+/// @brief Returns the region of record @a r kept by @a trimmer, read from
+/// its "_qs" quality string with Phred @a offset (33 or 64), as a view into
+/// @a r without copying. A record without qualities is returned whole.
+template<typename Container, typename Map, typename Trimmer>
+requires std::invocable<const Trimmer&, std::string_view, unsigned>
+sq_view_gen<Container> quality_trim
+(   const sq_gen<Container, Map>& r
+,   const Trimmer& trimmer
+,   unsigned offset = 33
+)
+{   if (! r.has("_qs"))
+        return r(0);
+    const auto& qs = std::any_cast<const std::string&>(r["_qs"]);
+    if (qs.size() != r.size())
+        throw std::invalid_argument
+            ("gynx::quality_trim: quality string length differs from sequence");
+    const trim_range t = trimmer(std::string_view(qs), offset);
+    return r(t.begin, t.size());
+}
+///
+/// @brief Returns quality_trim() of every record in @a records, computed in
+/// parallel on @a pool.
+template<std::ranges::random_access_range R, typename Trimmer>
+auto quality_trim_each
+(   const R& records
+,   const Trimmer& trimmer
+,   unsigned offset = 33
+,   thread_pool& pool = thread_pool::global()
+)
+{   typedef decltype(quality_trim(records[0], trimmer, offset)) view_type;
+    std::vector<view_type> out(std::ranges::size(records));
+    constexpr std::size_t chunk = 1024;
+    parallel_for
+    (   pool
+    ,   (out.size() + chunk - 1) / chunk
+    ,   [&](std::size_t t)
+        {   const std::size_t end = std::min(out.size(), (t + 1) * chunk);
+            for (std::size_t i = t * chunk; i < end; ++i)
+                out[i] = quality_trim(records[i], trimmer, offset);
+        }
+    );
+    return out;
+}
+
+}   // end gynx namespace
+
+#endif  // _GYNX_TRIM_HPP_
@@ -0,0 +1,888 @@
+//
+// Copyright (c) 2025 Armin Sobhani
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <gynx/sq.hpp>
+#include <gynx/sq_view.hpp>
+#include <gynx/reverse_complement.hpp>
+#include <gynx/composition.hpp>
+#include <gynx/minimizers.hpp>
+#include <gynx/kmer_counter.hpp>
+#include <gynx/search.hpp>
+#include <gynx/approximate_search.hpp>
+#include <gynx/align.hpp>
+#include <gynx/dotplot.hpp>
+#include <gynx/fm_index.hpp>
+#include <gynx/translate.hpp>
+#include <gynx/normalize.hpp>
+#include <gynx/hamming.hpp>
+#include <gynx/hash.hpp>
+#include <gynx/dedup.hpp>
+#include <gynx/trim.hpp>
+#include <gynx/quality.hpp>
+#include <gynx/qc.hpp>
+#include <gynx/adapter.hpp>
+#include <gynx/phred.hpp>
+#include <gynx/mask.hpp>
+#include <gynx/homopolymer.hpp>
+#include <gynx/sketch.hpp>
+#include <gynx/bloom.hpp>
+#include <gynx/execution.hpp>
+#include <gynx/lut/phred33.hpp>
+#include <gynx/io/fastaqz.hpp>
+
+// -- helpers ------------------------------------------------------------------
+
+/// Returns a reproducible random sequence of @a n residues drawn from
+/// @a alphabet.
+inline gynx::sq random_sq(std::size_t n, std::string_view alphabet = "ACGT")
+{   std::mt19937_64 gen(19);
+    std::uniform_int_distribution<std::size_t> dist(0, alphabet.size() - 1);
+    gynx::sq s(n);
+    for (auto& c : s)
+        c = alphabet[dist(gen)];
+    return s;
+}
+
+/// Runs @a f once for every dispatch level supported by the CPU, passing the
+/// level name for use in benchmark titles.
+template<typename F>
+void for_each_simd_level(F f)
+{   const auto best = gynx::simd::detect();
+    constexpr const char* names[] { "scalar", "sse4.2", "avx2", "avx512" };
+    for (int l = 0; l <= static_cast<int>(best); ++l)
+    {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+        f(std::string(names[l]));
+    }
+    gynx::simd::set_level(best);
+}
+
+// -- reverse complement -------------------------------------------------------
+
+TEST_CASE( "reverse_complement", "[benchmark][reverse_complement]" )
+{   auto s = random_sq(16 << 20, "ACGTNacgtn");
+    gynx::sq r(s.size());
+
+    BENCHMARK( "16 MB std::transform baseline" )
+    {   std::transform
+        (   s.rbegin()
+        ,   s.rend()
+        ,   r.begin()
+        ,   [](char c)
+            {   return gynx::lut::complement[static_cast<uint8_t>(c)];
+            }
+        );
+        return r[0];
+    };
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "16 MB copy " + level )
+            {   gynx::reverse_complement_copy
+                    (s.data(), s.data() + s.size(), r.data());
+                return r[0];
+            };
+            BENCHMARK( "16 MB in place " + level )
+            {   gynx::reverse_complement(s);
+                return s[0];
+            };
+        }
+    );
+
+    std::vector<gynx::sq> reads;
+    for (std::size_t i = 0; i < 100000; ++i)
+        reads.emplace_back(s(i * 150, 150));
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "100k x 150 bp reads in place " + level )
+            {   for (auto& read : reads)
+                    gynx::reverse_complement(read);
+                return reads[0][0];
+            };
+        }
+    );
+}
+
+// -- composition --------------------------------------------------------------
+
+TEST_CASE( "composition", "[benchmark][composition]" )
+{   auto s = random_sq(256 << 20, "ACGTNacgtn");
+    gynx::sq_view v(s);
+
+    BENCHMARK( "256 MB operator[] loop baseline" )
+    {   std::size_t gc = 0;
+        for (std::size_t i = 0; i < s.size(); ++i)
+            gc += (s[i] == 'G' || s[i] == 'C' || s[i] == 'g' || s[i] == 'c');
+        return gc;
+    };
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "256 MB composition " + level )
+            {   return gynx::composition(v);
+            };
+        }
+    );
+    BENCHMARK( "256 MB composition on global pool" )
+    {   return gynx::composition(v, gynx::thread_pool::global());
+    };
+    BENCHMARK( "256 MB gc_profile window 1000 step 100" )
+    {   return gynx::gc_profile(v, 1000, 100).size();
+    };
+    BENCHMARK( "256 MB gc_profile window 1000 step 100 on global pool" )
+    {   return gynx::gc_profile(v, 1000, 100, gynx::thread_pool::global()).size();
+    };
+}
+
+// -- minimizers ---------------------------------------------------------------
+
+TEST_CASE( "minimizers", "[benchmark][minimizers]" )
+{   auto s = random_sq(64 << 20);
+    gynx::sq_view v(s);
+
+    BENCHMARK( "64 MB k-mers k=15" )
+    {   std::uint64_t x = 0;
+        for (auto km : v | gynx::views::kmers(15))
+            x ^= km.canonical();
+        return x;
+    };
+    BENCHMARK( "64 MB minimizers view w=10 k=15" )
+    {   std::size_t n = 0;
+        for (auto m : v | gynx::views::minimizers(10, 15))
+            n += m.forward;
+        return n;
+    };
+    BENCHMARK( "64 MB minimizers batch w=10 k=15" )
+    {   return gynx::minimizers(v, 10, 15).size();
+    };
+    BENCHMARK( "64 MB closed syncmers k=15 s=5" )
+    {   std::size_t n = 0;
+        for (auto m : v | gynx::views::closed_syncmers(15, 5))
+            n += m.forward;
+        return n;
+    };
+}
+
+// -- k-mer counting -----------------------------------------------------------
+
+TEST_CASE( "kmer_counter", "[benchmark][kmer_counter]" )
+{   auto& pool = gynx::thread_pool::global();
+    for (std::size_t k : { 21, 31 })
+    {   {   gynx::kmer_counter kc(k);
+            kc.add_file(SAMPLE_READS, pool);
+            const auto table_bytes = kc.memory_usage();
+            std::cout
+                << "k=" << k << ": " << kc.distinct() << " distinct, "
+                << kc.total() << " total, " << (table_bytes >> 10)
+                << " KiB in tables, " << (kc.memory_usage() >> 10)
+                << " KiB finished\n";
+        }
+        BENCHMARK( "sample reads k=" + std::to_string(k) )
+        {   gynx::kmer_counter kc(k);
+            kc.add_file(SAMPLE_READS, pool);
+            return kc.histogram(1000)[1];
+        };
+        BENCHMARK( "sample reads k=" + std::to_string(k) + " capped at 1 MiB" )
+        {   gynx::kmer_counter kc(k, 1 << 20);
+            kc.add_file(SAMPLE_READS, pool);
+            return kc.histogram(1000)[1];
+        };
+    }
+}
+
+// -- search -------------------------------------------------------------------
+
+TEST_CASE( "search", "[benchmark][search]" )
+{   gynx::sq genome;
+    genome.load(SAMPLE_GENOME, 0, gynx::in::fast_aqz<gynx::sq>());
+    auto s = genome.empty() ? random_sq(64 << 20) : genome;
+    const std::string title = std::to_string(s.size() / 1000) + " kbp genome ";
+    const std::string_view hay(s.data(), s.size());
+
+    for (std::string motif : { "GAATTC", "TTGACAATTAATCATCGGCTCGTATAATGTGTGG" })
+    {   const std::string m = std::to_string(motif.size()) + " bp motif ";
+        BENCHMARK( title + m + "std::search baseline" )
+        {   std::size_t n = 0;
+            for ( auto it = std::search(hay.begin(), hay.end(), motif.begin(), motif.end())
+                ; it != hay.end()
+                ; it = std::search(it + 1, hay.end(), motif.begin(), motif.end())
+                )
+                ++n;
+            return n;
+        };
+        for_each_simd_level
+        (   [&](const std::string& level)
+            {   BENCHMARK( title + m + "count " + level )
+                {   return gynx::count(s(0), motif);
+                };
+            }
+        );
+    }
+
+    std::mt19937 gen(7);
+    std::vector<std::string> primers;
+    for (int i = 0; i < 100; ++i)
+    {   auto pos = gen() % (s.size() - 32);
+        primers.emplace_back(s.data() + pos, 18 + gen() % 8);
+    }
+    BENCHMARK( title + "100 primers one count() each" )
+    {   std::size_t n = 0;
+        for (const auto& p : primers)
+            n += gynx::count(s(0), p);
+        return n;
+    };
+    gynx::aho_corasick ac(primers);
+    BENCHMARK( title + "100 primers aho_corasick" )
+    {   return ac.count(s(0));
+    };
+}
+
+// -- approximate search -------------------------------------------------------
+
+TEST_CASE( "approximate_search", "[benchmark][search]" )
+{   const auto s = random_sq(100'000 * 150);
+    std::vector<gynx::sq_view> reads;
+    for (std::size_t i = 0; i < 100'000; ++i)
+        reads.push_back(s(i * 150, 150));
+    const std::string adapter = "AGATCGGAAGAGCACACGTCTGAACTCCAGTCA";
+    gynx::approximate_pattern ap(adapter);
+
+    BENCHMARK( "100k x 150 bp reads, 33 bp adapter, DP baseline" )
+    {   std::vector<std::size_t> col(adapter.size() + 1);
+        std::size_t total = 0;
+        for (const auto& r : reads)
+        {   for (std::size_t i = 0; i <= adapter.size(); ++i)
+                col[i] = i;
+            std::size_t best = adapter.size();
+            for (auto c : r)
+            {   std::size_t diag = 0;
+                col[0] = 0;
+                for (std::size_t i = 1; i <= adapter.size(); ++i)
+                {   const auto up = col[i];
+                    col[i] = std::min
+                        ({ up + 1, col[i - 1] + 1, diag + (c != adapter[i - 1]) });
+                    diag = up;
+                }
+                best = std::min(best, col.back());
+            }
+            total += best;
+        }
+        return total;
+    };
+    BENCHMARK( "100k x 150 bp reads, 33 bp adapter, best()" )
+    {   std::size_t total = 0;
+        for (const auto& r : reads)
+            total += ap.best(r).distance;
+        return total;
+    };
+    std::vector<gynx::approximate_match> out(reads.size());
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "100k x 150 bp reads, 33 bp adapter, best_each() " + level )
+            {   ap.best_each(reads, out);
+                return out[0].distance;
+            };
+        }
+    );
+    gynx::approximate_pattern long_primer(std::string_view(s.data() + 777, 150));
+    BENCHMARK( "100k x 150 bp reads, 150 bp pattern, best()" )
+    {   std::size_t total = 0;
+        for (const auto& r : reads)
+            total += long_primer.best(r).distance;
+        return total;
+    };
+}
+
+// -- alignment ----------------------------------------------------------------
+
+TEST_CASE( "align", "[benchmark][align]" )
+{   const auto db = random_sq(2000 * 250);
+    std::vector<gynx::sq_view> targets;
+    for (std::size_t i = 0; i < 2000; ++i)
+        targets.push_back(db(i * 250, 250));
+    const gynx::sq query(db(777, 250));  // shares a 250 bp window with db
+    const double cells = 250.0 * db.size();
+
+    for (auto mode : { gynx::alignment_mode::local, gynx::alignment_mode::global })
+    {   const std::string name = gynx::alignment_mode::local == mode
+        ?   "local"
+        :   "global";
+        for_each_simd_level
+        (   [&](const std::string& level)
+            {   gynx::alignment_profile p(query(0), mode);
+                const auto start = std::chrono::steady_clock::now();
+                for (const auto& t : targets)
+                    p.score(t);
+                const std::chrono::duration<double> dt
+                    = std::chrono::steady_clock::now() - start;
+                std::cout << name << ' ' << level << ": "
+                    << cells / dt.count() * 1e-9 << " GCUPS\n";
+                BENCHMARK( "250 bp vs 2000 x 250 bp " + name + " " + level )
+                {   std::size_t sum = 0;
+                    for (const auto& t : targets)
+                        sum += p.score(t).query_end;
+                    return sum;
+                };
+            }
+        );
+        gynx::alignment_profile p(query(0), mode);
+        BENCHMARK( "250 bp vs 2000 x 250 bp " + name + " score_each on global pool" )
+        {   return p.score_each(targets).size();
+        };
+    }
+}
+
+// -- dot plots ---------------------------------------------------------------
+
+TEST_CASE( "dotplot", "[benchmark][dotplot]" )
+{   // 1 Mbp against a copy carrying an inversion and a translocation
+    const auto x = random_sq(1'000'000);
+    gynx::sq y(x);
+    gynx::reverse_complement(y.data() + 200'000, y.data() + 300'000);
+    std::rotate(y.begin() + 500'000, y.begin() + 700'000, y.end());
+    const auto xs = x(0, 20'000), ys = y(0, 20'000);
+
+    BENCHMARK( "1 Mbp x 1 Mbp, k = 16, 1000 x 1000" )
+    {   return gynx::dotplot(x(0), y(0), 16, 1000, 1000).total();
+    };
+    BENCHMARK( "1 Mbp x 1 Mbp, k = 11, 1000 x 1000" )
+    {   return gynx::dotplot(x(0), y(0), 11, 1000, 1000).total();
+    };
+    BENCHMARK( "20 kbp x 20 kbp identity, 20 / 15, 500 x 500" )
+    {   return gynx::dotplot_identity(xs, ys, 20, 15, 500, 500).total();
+    };
+    BENCHMARK( "20 kbp x 20 kbp naive nested loop, k = 16" )
+    {   std::uint64_t dots = 0;
+        for (std::size_t i = 0; i + 16 <= xs.size(); ++i)
+            for (std::size_t j = 0; j + 16 <= ys.size(); ++j)
+                dots += std::equal(&xs[i], &xs[i] + 16, &ys[j]);
+        return dots;
+    };
+}
+
+// -- FM-index ----------------------------------------------------------------
+
+TEST_CASE( "fm_index", "[benchmark][fm_index]" )
+{   const auto ref = random_sq(4'000'000);
+    std::vector<gynx::sq_view> reads;
+    for (std::size_t i = 0; i < 1'000'000; ++i)
+        reads.push_back(ref((i * 7919) % (ref.size() - 24), 24));
+    const gynx::fm_index index(ref);
+    const auto path = std::filesystem::temp_directory_path() / "gynx_bench.fmi";
+    index.save(path);
+    std::cout << "fm_index: " << index.bytes() / double(ref.size())
+        << " bytes per residue\n";
+
+    BENCHMARK( "build 4 Mbp" )
+    {   return gynx::fm_index(ref).bytes();
+    };
+    BENCHMARK( "load 4 Mbp from file" )
+    {   return gynx::fm_index(path).records();
+    };
+    BENCHMARK( "count 1M x 24 bp on global pool" )
+    {   return index.count_each(reads).size();
+    };
+    BENCHMARK( "locate 1M x 24 bp on global pool" )
+    {   return index.locate_each(reads).size();
+    };
+    std::filesystem::remove(path);
+}
+
+// -- translation -------------------------------------------------------------
+
+TEST_CASE( "translate", "[benchmark][translate]" )
+{   const auto s = random_sq(16 << 20);
+    gynx::sq p(s.size() / 3);
+
+    BENCHMARK( "16 MB std::map baseline" )
+    {   std::map<std::string, char> table;
+        const std::string_view aas
+            ("FFLLSSSSYY**CC*WLLLLPPPPHHQQRRRRIIIMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+        for (int i = 0; i < 64; ++i)
+            table[{ "TCAG"[i / 16], "TCAG"[i / 4 % 4], "TCAG"[i % 4] }] = aas[i];
+        for (std::size_t i = 0; i < p.size(); ++i)
+            p[i] = table[std::string(s.data() + 3 * i, 3)];
+        return p[0];
+    };
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   const auto start = std::chrono::steady_clock::now();
+            gynx::translate(s.data(), s.data() + s.size(), p.data());
+            const std::chrono::duration<double> dt
+                = std::chrono::steady_clock::now() - start;
+            std::cout << "translate " << level << ": "
+                << s.size() / dt.count() * 1e-6 << " Mbp/s\n";
+            BENCHMARK( "16 MB frame 1 " + level )
+            {   gynx::translate(s.data(), s.data() + s.size(), p.data());
+                return p[0];
+            };
+        }
+    );
+    const auto contig = random_sq(1 << 20);
+    BENCHMARK( "1 MB six frames" )
+    {   return gynx::translate_six_frames(contig(0))[5].size();
+    };
+    BENCHMARK( "1 MB open reading frames" )
+    {   return gynx::find_orfs(contig(0), 30).size();
+    };
+}
+
+// -- normalization -----------------------------------------------------------
+
+TEST_CASE( "normalize", "[benchmark][normalize]" )
+{   const auto s = random_sq(16 << 20, "ACGTNacgtn");
+    gynx::sq r(s.size());
+
+    BENCHMARK( "16 MB std::copy baseline" )
+    {   std::copy(s.begin(), s.end(), r.begin());
+        return r[0];
+    };
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "16 MB copy uppercase " + level )
+            {   return gynx::normalize_copy
+                (   s.data(), s.data() + s.size(), r.data()
+                ,   gynx::alphabet::iupac, gynx::normalization::uppercase
+                ) - s.data();
+            };
+            BENCHMARK( "16 MB copy replace " + level )
+            {   return gynx::normalize_copy
+                (   s.data(), s.data() + s.size(), r.data()
+                ,   gynx::alphabet::dna, gynx::normalization::replace
+                ) - s.data();
+            };
+        }
+    );
+    BENCHMARK( "load sample genome as read" )
+    {   return gynx::in::fast_aqz<gynx::sq>()(SAMPLE_GENOME, 0).size();
+    };
+    BENCHMARK( "load sample genome with uppercase" )
+    {   return gynx::in::fast_aqz<gynx::sq>
+            (gynx::alphabet::iupac, gynx::normalization::uppercase)
+            (SAMPLE_GENOME, 0).size();
+    };
+}
+
+// -- Hamming distance --------------------------------------------------------
+
+TEST_CASE( "hamming", "[benchmark][hamming]" )
+{   const auto a = random_sq(16 << 20, "ACGT");
+    auto b = a;
+    for (std::size_t i = 0; i < b.size(); i += 97)
+        b[i] = 'N';
+    std::vector<gynx::sq> barcodes;
+    for (int i = 0; i < 1 << 20; ++i)
+        barcodes.push_back(random_sq(16, "ACGT"));
+    const gynx::barcode_whitelist w(barcodes);
+    std::vector<gynx::sq> queries(barcodes.begin(), barcodes.begin() + 256);
+
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "16 MB hamming " + level )
+            {   return gynx::hamming(a(0), b(0));
+            };
+            BENCHMARK( "16 MB mismatch_positions " + level )
+            {   return gynx::mismatch_positions(a(0), b(0)).size();
+            };
+            BENCHMARK( "1M barcodes one-vs-many " + level )
+            {   return w.nearest(queries[0]).index;
+            };
+        }
+    );
+    BENCHMARK( "256 queries x 1M barcodes nearest_each" )
+    {   return w.nearest_each(queries).size();
+    };
+}
+
+// -- hashing and deduplication ------------------------------------------------
+
+TEST_CASE( "dedup", "[benchmark][dedup]" )
+{   const auto genome = random_sq(16 << 20, "ACGT");
+    std::vector<gynx::sq_view> reads;
+    for (std::size_t i = 0; i + 150 <= genome.size(); i += 150)
+        reads.push_back(genome(i, 150));
+
+    BENCHMARK( "hash 16 MB" )
+    {   return gynx::hash(genome(0));
+    };
+    BENCHMARK( "hash 150 bp reads" )
+    {   std::uint64_t h = 0;
+        for (auto r : reads)
+            h ^= gynx::hash(r);
+        return h;
+    };
+    BENCHMARK( "canonical_hash 150 bp reads" )
+    {   std::uint64_t h = 0;
+        for (auto r : reads)
+            h ^= gynx::canonical_hash(r);
+        return h;
+    };
+    auto& pool = gynx::thread_pool::global();
+    BENCHMARK( "fingerprint_set 16M inserts, " + std::to_string(pool.size()) + " threads" )
+    {   gynx::fingerprint_set set(std::size_t(256) << 20);
+        gynx::parallel_for
+        (   pool
+        ,   256
+        ,   [&](std::size_t t)
+            {   for (std::uint64_t i = t << 16; i < (t + 1) << 16; ++i)
+                    set.insert(gynx::detail::hash_mum(i % 12000000, 0x9E3779B97F4A7C15ull));
+            }
+        );
+        return set.size();
+    };
+    BENCHMARK( "dedup sample reads" )
+    {   return gynx::dedup(SAMPLE_READS, [](gynx::sq&&) {}).kept;
+    };
+    BENCHMARK( "dedup sample reads best quality" )
+    {   gynx::dedup_options o;
+        o.keep = gynx::dedup_keep::best_quality;
+        return gynx::dedup(SAMPLE_READS, [](gynx::sq&&) {}, o).kept;
+    };
+    BENCHMARK( "read sample reads baseline" )
+    {   return gynx::in::fast_aqz<gynx::sq>()(SAMPLE_READS, [](gynx::sq&&) {});
+    };
+}
+
+// -- quality trimming ---------------------------------------------------------
+
+TEST_CASE( "quality_trim", "[benchmark][trim]" )
+{   std::vector<gynx::sq> reads;
+    gynx::in::fast_aqz<gynx::sq>()
+    (   SAMPLE_READS
+    ,   [&](gynx::sq&& s) { reads.push_back(std::move(s)); }
+    );
+    std::size_t bases = 0;
+    for (const auto& r : reads)
+        bases += r.size();
+    auto& pool = gynx::thread_pool::global();
+    const gynx::sliding_window_trimmer window;
+    const gynx::bwa_trimmer bwa;
+    const gynx::mott_trimmer mott;
+    auto run = [&](const auto& trimmer)
+    {   std::size_t kept = 0;
+        for (const auto& r : reads)
+            kept += gynx::quality_trim(r, trimmer).size();
+        return kept;
+    };
+    {   const auto start = std::chrono::steady_clock::now();
+        const auto kept = run(window);
+        const std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+        std::cout
+            << reads.size() << " reads, " << bases << " bases, sliding window keeps "
+            << kept << " at " << bases / t.count() / 1e6 << " Mbp/s\n";
+    }
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "sample reads sliding window " + level )
+            {   return run(window);
+            };
+            BENCHMARK( "sample reads mott " + level )
+            {   return run(mott);
+            };
+        }
+    );
+    BENCHMARK( "sample reads bwa" )
+    {   return run(bwa);
+    };
+    BENCHMARK( "sample reads sliding window, " + std::to_string(pool.size()) + " threads" )
+    {   return gynx::quality_trim_each(reads, window, 33, pool).size();
+    };
+}
+
+// -- read quality -------------------------------------------------------------
+
+TEST_CASE( "quality_summary", "[benchmark][quality]" )
+{   std::vector<gynx::sq> reads;
+    gynx::in::fast_aqz<gynx::sq>()
+    (   SAMPLE_READS
+    ,   [&](gynx::sq&& s) { reads.push_back(std::move(s)); }
+    );
+    std::vector<std::string> quals;
+    for (auto& r : reads)
+        quals.push_back(std::any_cast<std::string>(r["_qs"]));
+    const auto long_qual = random_sq(16 << 20, "#+5?IJ");
+    const std::string_view long_view(long_qual.data(), long_qual.size());
+
+    BENCHMARK( "sample reads expected errors, double LUT loop" )
+    {   double ee = 0;
+        for (const auto& q : quals)
+            for (char c : q)
+                ee += gynx::lut::phred33[static_cast<std::uint8_t>(c)];
+        return ee;
+    };
+    BENCHMARK( "16 MB expected errors, double LUT loop" )
+    {   double ee = 0;
+        for (char c : long_view)
+            ee += gynx::lut::phred33[static_cast<std::uint8_t>(c)];
+        return ee;
+    };
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "sample reads expected errors " + level )
+            {   double ee = 0;
+                for (const auto& q : quals)
+                    ee += gynx::expected_errors(q);
+                return ee;
+            };
+            BENCHMARK( "sample reads quality summary " + level )
+            {   double x = 0;
+                for (const auto& q : quals)
+                {   const auto r = gynx::quality_summary(q, 20);
+                    x += r.expected_errors + r.mean + r.below;
+                }
+                return x;
+            };
+            BENCHMARK( "16 MB expected errors " + level )
+            {   return gynx::expected_errors(long_view);
+            };
+            BENCHMARK( "16 MB quality summary " + level )
+            {   const auto r = gynx::quality_summary(long_view);
+                return r.expected_errors + r.mean + r.below;
+            };
+        }
+    );
+    auto& pool = gynx::thread_pool::global();
+    BENCHMARK( "sample records quality_summary_each, " + std::to_string(pool.size()) + " threads" )
+    {   return gynx::quality_summary_each(reads, 20, 33, pool).size();
+    };
+}
+
+// -- qc -----------------------------------------------------------------------
+
+TEST_CASE( "qc", "[benchmark][qc]" )
+{   std::vector<gynx::sq> reads;
+    gynx::in::fast_aqz<gynx::sq>()
+    (   SAMPLE_READS
+    ,   [&](gynx::sq&& s) { reads.push_back(std::move(s)); }
+    );
+
+    BENCHMARK( "sample records qc, 1 thread" )
+    {   gynx::qc_collector c;
+        for (const auto& r : reads)
+            c.add(r);
+        return c.report().bases;
+    };
+    auto& pool = gynx::thread_pool::global();
+    BENCHMARK( "sample records qc add_each, " + std::to_string(pool.size()) + " threads" )
+    {   gynx::qc_collector c;
+        c.add_each(reads, pool);
+        return c.report().bases;
+    };
+    BENCHMARK( "sample reads qc add_file, " + std::to_string(pool.size()) + " threads" )
+    {   gynx::qc_collector c;
+        c.add_file(SAMPLE_READS, pool);
+        return c.report().bases;
+    };
+}
+
+// -- adapter ------------------------------------------------------------------
+
+TEST_CASE( "adapter", "[benchmark][adapter]" )
+{   std::vector<gynx::sq> reads;
+    gynx::in::fast_aqz<gynx::sq>()
+    (   SAMPLE_READS
+    ,   [&](gynx::sq&& s) { reads.push_back(std::move(s)); }
+    );
+    const gynx::adapter_trimmer trim;
+    const auto output = (std::filesystem::temp_directory_path() / "gynx_adapter.fq.gz").string();
+
+    BENCHMARK( "sample reads adapter_trimmer" )
+    {   std::size_t n = 0;
+        for (const auto& r : reads)
+            n += trim(std::string_view(r.data(), r.size())).size();
+        return n;
+    };
+    BENCHMARK( "sample read pairs adapter_trimmer" )
+    {   std::size_t n = 0;
+        for (std::size_t i = 0; i + 1 < reads.size(); i += 2)
+            n += trim
+            (   std::string_view(reads[i].data(), reads[i].size())
+            ,   std::string_view(reads[i + 1].data(), reads[i + 1].size())
+            ).first.size();
+        return n;
+    };
+    auto& pool = gynx::thread_pool::global();
+    BENCHMARK( "sample reads adapter_trim_file, " + std::to_string(pool.size()) + " threads" )
+    {   return gynx::adapter_trim_file(SAMPLE_READS, output, trim, pool).bases_removed;
+    };
+    std::filesystem::remove(output);
+}
+
+// -- phred --------------------------------------------------------------------
+
+TEST_CASE( "phred", "[benchmark][quality]" )
+{   auto quals = random_sq(16 << 20, "#+5?IJ");
+    std::string q(quals.data(), quals.size());
+
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "16 MB quality_range " + level )
+            {   return gynx::quality_range(q).max;
+            };
+            BENCHMARK( "16 MB convert_phred 33 -> 64 -> 33 " + level )
+            {   gynx::convert_phred(q, gynx::phred_encoding::phred33, gynx::phred_encoding::phred64);
+                gynx::convert_phred(q, gynx::phred_encoding::phred64, gynx::phred_encoding::phred33);
+                return q.back();
+            };
+        }
+    );
+    BENCHMARK( "detect_phred sample reads" )
+    {   return gynx::in::detect_phred(SAMPLE_READS);
+    };
+}
+
+// -- mask ---------------------------------------------------------------------
+
+TEST_CASE( "mask", "[benchmark][mask]" )
+{   gynx::sq genome;
+    genome.load(SAMPLE_GENOME, 0, gynx::in::fast_aqz<gynx::sq>());
+    const gynx::dust_masker dust;
+    const gynx::entropy_masker entropy;
+    const std::string size = std::to_string(genome.size() / 1000) + " kbp genome";
+
+    BENCHMARK( "dust " + size )
+    {   return dust(genome(0)).size();
+    };
+    BENCHMARK( "entropy " + size )
+    {   return entropy(genome(0)).size();
+    };
+    auto& pool = gynx::thread_pool::global();
+    BENCHMARK( "dust " + size + ", " + std::to_string(pool.size()) + " threads" )
+    {   return gynx::mask_intervals(genome(0), dust, pool).size();
+    };
+    BENCHMARK( "entropy " + size + ", " + std::to_string(pool.size()) + " threads" )
+    {   return gynx::mask_intervals(genome(0), entropy, pool).size();
+    };
+}
+
+// -- homopolymer --------------------------------------------------------------
+
+TEST_CASE( "homopolymer", "[benchmark][homopolymer]" )
+{   gynx::sq genome;
+    genome.load(SAMPLE_GENOME, 0, gynx::in::fast_aqz<gynx::sq>());
+    const std::string size = std::to_string(genome.size() / 1000) + " kbp genome";
+
+    BENCHMARK( "runs view " + size )
+    {   std::size_t n = 0;
+        for (auto r : genome(0) | gynx::views::homopolymers())
+            n += r.length > 1;
+        return n;
+    };
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "hpc " + size + " " + level )
+            {   return gynx::hpc(genome).seq.size();
+            };
+        }
+    );
+}
+
+// -- sketch -------------------------------------------------------------------
+
+TEST_CASE( "sketch", "[benchmark][sketch]" )
+{   gynx::sq genome;
+    genome.load(SAMPLE_GENOME, 0, gynx::in::fast_aqz<gynx::sq>());
+    const std::string size = std::to_string(genome.size() / 1000) + " kbp genome";
+
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "bottom-k " + size + " " + level )
+            {   return gynx::sketch(genome(0)).size();
+            };
+        }
+    );
+    BENCHMARK( "FracMinHash scaled 100 " + size )
+    {   return gynx::sketch(genome(0), { 21, 0, 100 }).size();
+    };
+    std::vector<gynx::sketch> sketches;
+    for (std::size_t i = 0; i < 500; ++i)
+        sketches.emplace_back(random_sq(20000)(0));
+    auto& pool = gynx::thread_pool::global();
+    BENCHMARK( "500 x 500 mash distances, " + std::to_string(pool.size()) + " threads" )
+    {   return gynx::mash_distances(sketches, pool)[1];
+    };
+}
+
+// -- bloom filter -------------------------------------------------------------
+
+TEST_CASE( "bloom_filter", "[benchmark][bloom]" )
+{   gynx::sq genome;
+    genome.load(SAMPLE_GENOME, 0, gynx::in::fast_aqz<gynx::sq>());
+    const std::string size = std::to_string(genome.size() / 1000) + " kbp genome";
+    const auto reads = random_sq(16 << 20);
+
+    BENCHMARK( "insert " + size )
+    {   gynx::bloom_filter bf(31, genome.size());
+        return bf.insert(genome);
+    };
+    gynx::bloom_filter bf(31, 64 << 20, 16.0);
+    bf.insert(genome);
+    for_each_simd_level
+    (   [&](const std::string& level)
+        {   BENCHMARK( "query 16 Mbp in " + std::to_string(bf.bytes() >> 20) + " MB filter " + level )
+            {   return bf.count(reads);
+            };
+        }
+    );
+}
+
+// -- parallel scaling ---------------------------------------------------------
+
+TEST_CASE( "parallel scaling", "[benchmark][parallel]" )
+{   auto s = random_sq(std::size_t(1) << 30, "ACGTNacgtn");
+    gynx::sq r(s.size());
+    for
+    (   unsigned n = 1
+    ;   n <= std::max(1u, std::thread::hardware_concurrency())
+    ;   n *= 2
+    )
+    {   gynx::thread_pool pool(n);
+        const std::string threads = ", " + std::to_string(n) + " threads";
+        BENCHMARK( "1 Gbp composition" + threads )
+        {   return gynx::composition(s(0), pool).total();
+        };
+        BENCHMARK( "1 Gbp gc profile, 1 kbp windows" + threads )
+        {   return gynx::gc_profile(s(0), 1000, 1000, pool).size();
+        };
+        BENCHMARK( "1 Gbp reverse complement in place" + threads )
+        {   gynx::reverse_complement(s.data(), s.data() + s.size(), pool);
+            return s[0];
+        };
+        BENCHMARK( "1 Gbp reverse complement copy" + threads )
+        {   gynx::reverse_complement_copy(s.data(), s.data() + s.size(), r.data(), pool);
+            return r[0];
+        };
+        BENCHMARK( "1 Gbp uppercase" + threads )
+        {   std::copy(s.begin(), s.end(), r.begin());
+            return gynx::normalize(r, gynx::alphabet::iupac, gynx::normalization::uppercase, pool);
+        };
+        BENCHMARK( "64 Mbp minimizers (10, 15)" + threads )
+        {   return gynx::minimizers(s(0, 64 << 20), 10, 15, pool).size();
+        };
+    }
+}
@@ -24,9 +24,44 @@
 #include <gynx/sq.hpp>
 #include <gynx/sq_view.hpp>
 #include <gynx/io/fastaqz.hpp>
-// #include <gynx/lut/phred33.hpp>
+#include <gynx/reverse_complement.hpp>
+#include <gynx/thread_pool.hpp>
+#include <gynx/composition.hpp>
+#include <gynx/kmers.hpp>
+#include <gynx/minimizers.hpp>
+#include <gynx/kmer_counter.hpp>
+#include <gynx/search.hpp>
+#include <gynx/approximate_search.hpp>
+#include <gynx/align.hpp>
+#include <gynx/dotplot.hpp>
+#include <gynx/fm_index.hpp>
+#include <gynx/translate.hpp>
+#include <gynx/normalize.hpp>
+#include <gynx/hamming.hpp>
+#include <gynx/hash.hpp>
+#include <gynx/dedup.hpp>
+#include <gynx/trim.hpp>
+#include <gynx/quality.hpp>
+#include <gynx/qc.hpp>
+#include <gynx/adapter.hpp>
+#include <gynx/phred.hpp>
+#include <gynx/mask.hpp>
+#include <gynx/homopolymer.hpp>
+#include <gynx/sketch.hpp>
+#include <gynx/bloom.hpp>
+#include <gynx/execution.hpp>
+#include <gynx/lut/phred33.hpp>
 
-TEMPLATE_TEST_CASE( "gynx::sq", "[class]", std::vector<char>)
+#if __has_include(<sys/mman.h>)
+#   include <filesystem>
+#   include <fstream>
+#   include <gynx/mmap_vector.hpp>
+#   define GYNX_TEST_CONTAINERS std::vector<char>, gynx::mmap_vector<char>
+#else
+#   define GYNX_TEST_CONTAINERS std::vector<char>
+#endif
+
+TEMPLATE_TEST_CASE( "gynx::sq", "[class]", GYNX_TEST_CONTAINERS)
 {   typedef TestType T;
 
     gynx::sq_gen<T> s{"ACGT"};
@@ -271,7 +306,7 @@ TEMPLATE_TEST_CASE( "gynx::sq", "[class]", std::vector<char>)
     }
 }
 
-TEMPLATE_TEST_CASE( "gynx::sq_view", "[view]", std::vector<char>)
+TEMPLATE_TEST_CASE( "gynx::sq_view", "[view]", GYNX_TEST_CONTAINERS)
 {   typedef TestType T;
 
     gynx::sq_gen<T> s{"ACGT"};
@@ -390,7 +425,7 @@ TEMPLATE_TEST_CASE( "gynx::sq_view", "[view]", std::vector<char>)
     }
 }
 
-TEMPLATE_TEST_CASE( "gynx::io::fastaqz", "[io][in][out]", std::vector<char>)
+TEMPLATE_TEST_CASE( "gynx::io::fastaqz", "[io][in][out]", GYNX_TEST_CONTAINERS)
 {   typedef TestType T;
     std::string desc("Chlamydia psittaci 6BC plasmid pCps6BC, complete sequence");
     gynx::sq_gen<T> s, t;
@@ -427,6 +462,26 @@ TEMPLATE_TEST_CASE( "gynx::io::fastaqz", "[io][in][out]", std::vector<char>)
         CHECK("NC_017288.1" == std::any_cast<std::string>(s["_id"]));
         CHECK(desc == std::any_cast<std::string>(s["_desc"]));
     }
+    SECTION( "read all records" )
+    {   std::vector<gynx::sq_gen<T>> all;
+        auto n = gynx::in::fast_aqz<gynx::sq_gen<T>>()
+        (   SAMPLE_GENOME
+        ,   [&](gynx::sq_gen<T>&& r) { all.push_back(std::move(r)); }
+        );
+        REQUIRE(2 == n);
+        REQUIRE(2 == all.size());
+        s.load(SAMPLE_GENOME, 1);
+        CHECK(s == all[1]);
+        CHECK(s["_id"].type() == all[1]["_id"].type());
+        CHECK("NC_017288.1" == std::any_cast<std::string>(all[1]["_id"]));
+        CHECK_THROWS_AS
+        (   gynx::in::fast_aqz<gynx::sq_gen<T>>()
+            (   "wrong.fa"
+            ,   [](gynx::sq_gen<T>&&) {}
+            )
+        ,   std::runtime_error
+        );
+    }
     SECTION( "save fasta" )
     {   s.load(SAMPLE_GENOME, 1);
         std::string filename = "test_output.fa";
@@ -459,4 +514,2567 @@ TEMPLATE_TEST_CASE( "gynx::io::fastaqz", "[io][in][out]", std::vector<char>)
         CHECK(s == t);
         std::remove(filename.c_str());
     }
+    SECTION( "normalize on load" )
+    {   std::string filename = "test_normalize.fa";
+        {   std::ofstream os(filename);
+            os << ">a\nacgtuACGTU\n>b\nACGT\nRYacgt\n";
+        }
+        using gynx::alphabet;
+        using gynx::normalization;
+        gynx::in::fast_aqz<gynx::sq_gen<T>> upper(alphabet::dna, normalization::uppercase);
+        s.load(filename, 0, upper);
+        CHECK(s == "ACGTTACGTT");
+        CHECK("a" == std::any_cast<std::string>(s["_id"]));
+        CHECK_THROWS_AS(s.load(filename, 1, upper), std::runtime_error);
+        s.load(filename, 1, { alphabet::dna, normalization::replace });
+        CHECK(s == "ACGTNNACGT");
+        s.load(filename, 1, { alphabet::iupac, normalization::uppercase });
+        CHECK(s == "ACGTRYACGT");
+        s.load(filename, "a", { alphabet::rna, normalization::validate });
+        CHECK(s == "acgtuACGTU");
+        s.load(filename, "a", { alphabet::rna, normalization::uppercase });
+        CHECK(s == "ACGUUACGUU");
+        std::vector<gynx::sq_gen<T>> all;
+        CHECK_THROWS_AS
+        (   gynx::in::fast_aqz<gynx::sq_gen<T>>(alphabet::rna, normalization::validate)
+            (   filename
+            ,   [&](gynx::sq_gen<T>&& r) { all.push_back(std::move(r)); }
+            )
+        ,   std::runtime_error
+        );
+        CHECK(1 == all.size());
+        std::remove(filename.c_str());
+    }
+}
+
+#if __has_include(<sys/mman.h>)
+TEST_CASE( "gynx::mmap_vector", "[container][mmap]")
+{   using V = gynx::mmap_vector<char>;
+    std::string filename = "test_mmap.seq";
+    {   std::ofstream os(filename, std::ios::binary);
+        os << "TATAATTAAA";
+    }
+
+// -- temporary file backing ---------------------------------------------------
+
+    SECTION( "growth into temporary file" )
+    {   V v;
+        CHECK(v.empty());
+        CHECK(0 == v.capacity());
+        for (int i = 0; i < 10000; ++i)
+            v.push_back("ACGT"[i % 4]);
+        CHECK(10000 == v.size());
+        CHECK(v.capacity() >= v.size());
+        CHECK('A' == v[0]);
+        CHECK('T' == v[9999]);
+        v.resize(20, 'N');
+        CHECK(std::string(v.begin(), v.end()) == "ACGTACGTACGTACGTACGT");
+        v.advise(V::advice::sequential);
+        v.advise(V::advice::random, 4, 8);
+    }
+
+// -- file backing -------------------------------------------------------------
+
+    SECTION( "read_only mapping is copy-on-write" )
+    {   V v(filename);
+        CHECK(10 == v.size());
+        gynx::mmap_sq s(std::move(v));
+        CHECK(s == "TATAATTAAA");
+        CHECK(s(4, 4) == "ATTA");
+        s[0] = 'G';
+        CHECK(s == "GATAATTAAA");
+        V w(filename);
+        w[1] = 'C';
+        w.advise(V::advice::dontneed);  // must not drop the private copy
+        CHECK(std::string(w.begin(), w.end()) == "TCTAATTAAA");
+        gynx::mmap_sq t(V{filename});
+        CHECK(t == "TATAATTAAA");
+    }
+    SECTION( "read_only mapping can grow" )
+    {   V v(filename);
+        v.push_back('C');
+        CHECK(std::string(v.begin(), v.end()) == "TATAATTAAAC");
+        CHECK(std::filesystem::file_size(filename) == 10);
+    }
+    SECTION( "read_write mapping persists" )
+    {   {   V v(filename, V::mode::read_write);
+            v[0] = 'G';
+            v.push_back('C');
+            v.sync();
+        }
+        CHECK(std::filesystem::file_size(filename) == 11);
+        gynx::mmap_sq s(V{filename});
+        CHECK(s == "GATAATTAAAC");
+    }
+    SECTION( "bad file" )
+    {   CHECK_THROWS_AS(V("no_such_file.seq"), std::runtime_error);
+    }
+    std::remove(filename.c_str());
+}
+#endif
+
+TEMPLATE_TEST_CASE( "gynx::reverse_complement", "[algorithm][simd]", GYNX_TEST_CONTAINERS)
+{   typedef TestType T;
+    const auto best = gynx::simd::detect();
+
+    SECTION( "IUPAC codes and case" )
+    {   gynx::sq_gen<T> s{"ACGTUacgtuRYKMBVDHSWNrykmbvdhswn-*.xX"};
+        gynx::reverse_complement(s);
+        CHECK(s == "Xx.*-nwsdhbvkmryNWSDHBVKMRYaacgtAACGT");
+    }
+    SECTION( "in place and out of place over all dispatch levels" )
+    {   std::string alphabet{"ACGTNacgtnRYKMSWBDHVrykmswbdhv-"};
+        for (std::size_t n : {0, 1, 15, 16, 17, 31, 33, 64, 127, 128, 129, 1000})
+        {   std::string in(n, 'A');
+            for (std::size_t i = 0; i < n; ++i)
+                in[i] = alphabet[(i * 7 + n) % alphabet.size()];
+            std::string expected(in.rbegin(), in.rend());
+            for (auto& c : expected)
+                c = gynx::lut::complement[static_cast<uint8_t>(c)];
+            for (int l = 0; l <= static_cast<int>(best); ++l)
+            {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+                gynx::sq_gen<T> s(in);
+                gynx::reverse_complement(s);
+                CHECK(s == expected);
+                auto r = gynx::reverse_complement_copy(gynx::sq_view_gen<T>(s));
+                CHECK(r == in);
+            }
+        }
+        gynx::simd::set_level(best);
+    }
+    SECTION( "quality string and tagged data" )
+    {   gynx::sq_gen<T> s{"AACG"};
+        s["_id"] = std::string("read1");
+        s["_qs"] = std::string("!#%'");
+        const auto& cs = s;
+        auto r = gynx::reverse_complement_copy(cs);
+        CHECK(r == "CGTT");
+        CHECK("'%#!" == std::any_cast<std::string>(r["_qs"]));
+        CHECK("read1" == std::any_cast<std::string>(r["_id"]));
+        CHECK(s == "AACG");
+        CHECK(gynx::reverse_complement_copy(s(1, 2)) == "GT");
+    }
+}
+
+TEST_CASE( "gynx::thread_pool", "[parallel]")
+{   gynx::thread_pool pool(3);
+    CHECK(3 == pool.size());
+
+    SECTION( "submit" )
+    {   auto f = pool.submit([] { return 42; });
+        CHECK(42 == f.get());
+    }
+    SECTION( "parallel_for" )
+    {   std::vector<int> v(1000, 0);
+        gynx::parallel_for(pool, v.size(), [&](std::size_t i) { v[i] = int(i); });
+        for (std::size_t i = 0; i < v.size(); ++i)
+            CHECK(int(i) == v[i]);
+    }
+    SECTION( "nested parallel_for" )
+    {   std::atomic<int> sum{0};
+        gynx::parallel_for
+        (   pool
+        ,   8
+        ,   [&](std::size_t)
+            {   gynx::parallel_for(pool, 8, [&](std::size_t) { ++sum; });
+            }
+        );
+        CHECK(64 == sum);
+    }
+    SECTION( "exceptions are rethrown" )
+    {   CHECK_THROWS_AS
+        (   gynx::parallel_for
+            (   pool
+            ,   10
+            ,   [](std::size_t i)
+                {   if (i == 7) throw std::runtime_error("seven");
+                }
+            )
+        ,   std::runtime_error
+        );
+    }
+    SECTION( "parallel_chunks" )
+    {   // every window of 5 positions lies in exactly one chunk
+        std::vector<std::atomic<int>> seen(1000 - 4);
+        std::atomic<std::size_t> covered{0};
+        gynx::parallel_chunks
+        (   pool
+        ,   1000
+        ,   4
+        ,   [&](std::size_t i, std::size_t j)
+            {   covered += j - i;
+                for (std::size_t w = i; w < i + 64 && w + 5 <= j; ++w)
+                    ++seen[w];
+            }
+        ,   64
+        );
+        bool once = true;
+        for (const auto& s : seen)
+            once = once && 1 == s;
+        CHECK(once);
+        CHECK(1000 + 15 * 4 == covered);
+    }
+    SECTION( "parallel_pipeline" )
+    {   // batches are consumed in order and at most 2 * size() are in flight
+        std::atomic<int> running{0}, peak{0};
+        std::vector<int> order;
+        gynx::parallel_pipeline<int>
+        (   pool
+        ,   [](auto& submit)
+            {   for (int i = 0; i < 100; ++i)
+                    submit(std::make_shared<int>(i));
+            }
+        ,   [&](int& b)
+            {   peak = std::max(peak.load(), ++running);
+                --running;
+                return b * b;
+            }
+        ,   [&](int& b, int r)
+            {   CHECK(b * b == r);
+                order.push_back(b);
+            }
+        );
+        bool in_order = order.size() == 100;
+        for (int i = 0; in_order && i < 100; ++i)
+            in_order = order[i] == i;
+        CHECK(in_order);
+        CHECK(peak <= int(2 * pool.size()));
+        // the first exception is rethrown once every batch in flight is done
+        CHECK_THROWS_AS
+        (   gynx::parallel_pipeline<int>
+            (   pool
+            ,   [](auto& submit)
+                {   for (int i = 0; i < 10; ++i)
+                        submit(std::make_shared<int>(i));
+                }
+            ,   [](int& b)
+                {   if (3 == b)
+                        throw std::runtime_error("batch 3");
+                }
+            )
+        ,   std::runtime_error
+        );
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::composition", "[algorithm][simd]", GYNX_TEST_CONTAINERS)
+{   typedef TestType T;
+    const auto best = gynx::simd::detect();
+
+    SECTION( "counts" )
+    {   gynx::sq_gen<T> s{"AaCcGgTtNn-xU"};
+        auto k = gynx::composition(gynx::sq_view_gen<T>(s));
+        CHECK(2 == k.a);
+        CHECK(2 == k.c);
+        CHECK(2 == k.g);
+        CHECK(2 == k.t);
+        CHECK(2 == k.n);
+        CHECK(3 == k.other);
+        CHECK(13 == k.total());
+        CHECK(0.5 == gynx::gc_content(s(0)));
+        CHECK(0.0 == gynx::composition_counts{}.gc_content());
+    }
+    SECTION( "all dispatch levels and thread pool agree" )
+    {   std::string in(100003, 'A');
+        for (std::size_t i = 0; i < in.size(); ++i)
+            in[i] = "ACGTNacgtn-RY"[(i * i + 7 * i) % 13];
+        gynx::sq_gen<T> s(in);
+        gynx::composition_counts expected;
+        for (char c : in)
+            switch (c)
+            {   case 'A': case 'a': ++expected.a; break;
+                case 'C': case 'c': ++expected.c; break;
+                case 'G': case 'g': ++expected.g; break;
+                case 'T': case 't': ++expected.t; break;
+                case 'N': case 'n': ++expected.n; break;
+                default: ++expected.other;
+            }
+        for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            CHECK(expected == gynx::composition(s(0)));
+            CHECK(expected == gynx::composition(s(0), gynx::thread_pool::global()));
+        }
+        gynx::simd::set_level(best);
+    }
+    SECTION( "gc profile" )
+    {   gynx::sq_gen<T> s{"GGGGCCCCAAAATTTTGCNN"};
+        auto p = gynx::gc_profile(s(0), 4);
+        REQUIRE(5 == p.size());
+        CHECK(1.0 == p[0].gc);
+        CHECK(1.0 == p[0].skew);
+        CHECK(-1.0 == p[1].skew);
+        CHECK(0.0 == p[2].gc);
+        CHECK(16 == p[4].pos);
+        CHECK(1.0 == p[4].gc);
+        CHECK(0.0 == p[4].skew);
+
+        auto q = gynx::gc_profile(s(0), 4, 1);
+        REQUIRE(17 == q.size());
+        CHECK(1.0 == q[1].gc);
+        CHECK(0.5 == q[1].skew);
+        CHECK(0.75 == q[5].gc);
+        CHECK(-1.0 == q[5].skew);
+        auto r = gynx::gc_profile(s(0), 4, 1, gynx::thread_pool::global());
+        for (std::size_t i = 0; i < q.size(); ++i)
+        {   CHECK(q[i].pos == r[i].pos);
+            CHECK(q[i].gc == r[i].gc);
+        }
+        CHECK(gynx::gc_profile(s(0), 21).empty());
+        CHECK_THROWS_AS(gynx::gc_profile(s(0), 0), std::invalid_argument);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::kmers", "[algorithm][kmers]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    gynx::sq_gen<T> s{"ACGTNacgTTGCA"};
+
+    SECTION( "encode/decode" )
+    {   CHECK(0b00011011 == gynx::kmer_encode(std::string_view("ACGT")));
+        CHECK_FALSE(gynx::kmer_encode(std::string_view("ACNT")).has_value());
+        CHECK("ACGT" == gynx::kmer_decode(std::uint64_t(0b00011011), 4));
+    }
+    SECTION( "compile-time k" )
+    {   std::vector<gynx::kmer<>> k;
+        for (auto km : s(0) | gynx::views::kmers<3>())
+            k.push_back(km);
+        // ACG CGT | acg cgT gTT TTG TGC GCA
+        REQUIRE(8 == k.size());
+        CHECK(0 == k[0].pos);
+        CHECK("ACG" == gynx::kmer_decode(k[0].fwd, 3));
+        CHECK("CGT" == gynx::kmer_decode(k[0].rev, 3));
+        CHECK("ACG" == gynx::kmer_decode(k[0].canonical(), 3));
+        CHECK(k[0].is_forward());
+        CHECK(5 == k[2].pos);
+        CHECK(k[0].fwd == k[2].fwd);
+        CHECK(8 == k[5].pos);
+        CHECK("TTG" == gynx::kmer_decode(k[5].fwd, 3));
+        CHECK("CAA" == gynx::kmer_decode(k[5].canonical(), 3));
+        CHECK_FALSE(k[5].is_forward());
+    }
+    SECTION( "runtime k" )
+    {   auto v = s(0) | gynx::views::kmers(3);
+        CHECK(3 == v.k());
+        CHECK(8 == std::ranges::distance(v));
+        CHECK(std::ranges::equal(v, s(0) | gynx::views::kmers<3>()));
+        CHECK(0 == std::ranges::distance(s(0) | gynx::views::kmers(14)));
+        CHECK_THROWS_AS(gynx::views::kmers(0)(s(0)), std::invalid_argument);
+        CHECK_THROWS_AS(gynx::views::kmers(33)(s(0)), std::invalid_argument);
+    }
+    SECTION( "naive comparison" )
+    {   gynx::sq_gen<T> r(1000);
+        std::mt19937 gen(7);
+        for (auto& c : r)
+            c = "ACGTN"[gen() % 5];
+        for (std::size_t k : { 1, 5, 21, 32 })
+        {   std::size_t n = 0;
+            for (auto km : r(0) | gynx::views::kmers(k))
+            {   auto rc = gynx::reverse_complement_copy(r(km.pos, k));
+                CHECK(km.fwd == gynx::kmer_encode(r(km.pos, k)));
+                CHECK(km.rev == gynx::kmer_encode(rc(0)));
+                ++n;
+            }
+            std::size_t expected = 0;
+            for (std::size_t i = 0; i + k <= r.size(); ++i)
+                expected += gynx::kmer_encode(r(i, k)).has_value();
+            CHECK(expected == n);
+        }
+#if defined(__SIZEOF_INT128__)
+        for (auto km : r(0) | gynx::views::kmers<45>())
+        {   auto rc = gynx::reverse_complement_copy(r(km.pos, 45));
+            CHECK(km.fwd == gynx::kmer_encode<gynx::uint128_t>(r(km.pos, 45)));
+            CHECK(km.rev == gynx::kmer_encode<gynx::uint128_t>(rc(0)));
+        }
+#endif
+    }
+    SECTION( "composition with standard adaptors" )
+    {   auto codes = s(0)
+        |   gynx::views::kmers<2>()
+        |   std::views::transform([](auto km) { return km.canonical(); })
+        |   std::views::take(3);
+        std::vector<std::uint64_t> c;
+        std::ranges::copy(codes, std::back_inserter(c));
+        // AC(1) CG(6) GT->AC(1)
+        CHECK(std::vector<std::uint64_t>{ 1, 6, 1 } == c);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::minimizers", "[algorithm][kmers]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    gynx::sq_gen<T> r(5000);
+    std::mt19937 gen(11);
+    for (auto& c : r)
+        c = "ACGTACGTACGTN"[gen() % 13];
+    gynx::invertible_hash h;
+
+    SECTION( "invertible hash" )
+    {   for (std::uint64_t mask : { ~std::uint64_t(0), (std::uint64_t(1) << 42) - 1 })
+        {   gynx::invertible_hash hm{ mask };
+            for (int i = 0; i < 1000; ++i)
+            {   std::uint64_t x = (std::uint64_t(gen()) << 32 | gen()) & mask;
+                CHECK(hm(x) <= mask);
+                CHECK(x == hm.inverse(hm(x)));
+            }
+        }
+    }
+    SECTION( "minimizers" )
+    {   for (auto [w, k] : { std::pair{ 1, 5 }, { 5, 7 }, { 10, 15 }, { 19, 31 } })
+        {   std::vector<gynx::kmer<>> km;
+            for (auto m : r(0) | gynx::views::kmers(k))
+                km.push_back(m);
+            std::vector<gynx::minimizer> expected;
+            for (std::size_t i = 0; i + w <= km.size(); ++i)
+            {   if (km[i + w - 1].pos - km[i].pos != std::size_t(w - 1))
+                    continue;
+                std::size_t best = i;
+                for (std::size_t j = i + 1; j < i + w; ++j)
+                    if (h(km[j].canonical()) < h(km[best].canonical()))
+                        best = j;
+                if (expected.empty() || expected.back().pos != km[best].pos)
+                    expected.push_back
+                    (   {   km[best].pos
+                        ,   km[best].canonical()
+                        ,   h(km[best].canonical())
+                        ,   km[best].is_forward()
+                        }
+                    );
+            }
+            std::vector<gynx::minimizer> v;
+            std::ranges::copy
+            (   r(0) | gynx::views::minimizers(w, k)
+            ,   std::back_inserter(v)
+            );
+            CHECK(expected == v);
+            CHECK(expected == gynx::minimizers(r(0), w, k));
+        }
+        CHECK_THROWS_AS(gynx::minimizers(r(0), 0, 5), std::invalid_argument);
+    }
+    SECTION( "syncmers" )
+    {   for (auto [k, s, t] : { std::tuple{ 15, 5, 2 }, { 21, 11, 0 }, { 8, 8, 0 } })
+        {   std::vector<std::size_t> open, closed;
+            for (auto m : r(0) | gynx::views::kmers(k))
+            {   std::size_t best = 0;
+                std::uint64_t best_hash = ~std::uint64_t(0);
+                for (std::size_t j = 0; j + s <= std::size_t(k); ++j)
+                {   auto f = *gynx::kmer_encode(r(m.pos + j, s));
+                    auto c = gynx::reverse_complement_copy(r(m.pos + j, s));
+                    auto b = *gynx::kmer_encode(c(0));
+                    if (h(std::min(f, b)) < best_hash)
+                    {   best_hash = h(std::min(f, b));
+                        best = j;
+                    }
+                }
+                if (std::size_t(t) == best)
+                    open.push_back(m.pos);
+                if (0 == best || std::size_t(k - s) == best)
+                    closed.push_back(m.pos);
+            }
+            std::vector<std::size_t> o, c;
+            for (auto m : r(0) | gynx::views::open_syncmers(k, s, t))
+                o.push_back(m.pos);
+            for (auto m : r(0) | gynx::views::closed_syncmers(k, s))
+                c.push_back(m.pos);
+            CHECK(open == o);
+            CHECK(closed == c);
+        }
+        CHECK_THROWS_AS
+        (   gynx::views::closed_syncmers(5, 6)(r(0))
+        ,   std::invalid_argument
+        );
+        CHECK_THROWS_AS
+        (   gynx::views::open_syncmers(5, 3, 3)(r(0))
+        ,   std::invalid_argument
+        );
+    }
+}
+
+TEST_CASE( "gynx::kmer_counter", "[algorithm][kmers][parallel]" )
+{   // reference counts: sort all canonical k-mers and count runs
+    auto naive = [](const std::vector<gynx::sq>& seqs, std::size_t k)
+    {   std::vector<std::uint64_t> codes;
+        for (const auto& s : seqs)
+            for (auto km : s | gynx::views::kmers(k))
+                codes.push_back(km.canonical());
+        std::sort(codes.begin(), codes.end());
+        std::vector<gynx::kmer_count> counts;
+        for (auto c : codes)
+            if (counts.empty() || counts.back().code != c)
+                counts.push_back({ c, 1 });
+            else
+                ++counts.back().count;
+        return counts;
+    };
+
+    SECTION( "small sequences" )
+    {   gynx::kmer_counter kc(3);
+        kc.add("ACGTNACG"_sq(0));
+        kc.add("CGTTT"_sq(0));
+        // ACG x2, CGT x2 (both canonical ACG), GTT/AAC, TTT/AAA
+        CHECK(4 == kc.count("ACG"_sq(0)));
+        CHECK(4 == kc.count("CGT"_sq(0)));
+        CHECK(1 == kc.count("AAC"_sq(0)));
+        CHECK(1 == kc.count("AAA"_sq(0)));
+        CHECK(0 == kc.count("GGG"_sq(0)));
+        CHECK(0 == kc.count("ACGT"_sq(0)));
+        CHECK(0 == kc.count("ANG"_sq(0)));
+        CHECK(3 == kc.distinct());
+        CHECK(6 == kc.total());
+        auto h = kc.histogram(3);
+        REQUIRE(4 == h.size());
+        CHECK(std::vector<std::uint64_t>{ 0, 2, 0, 1 } == h);
+        CHECK_THROWS_AS(kc.add("ACGT"_sq(0)), std::logic_error);
+        CHECK_THROWS_AS(gynx::kmer_counter(33), std::invalid_argument);
+    }
+    SECTION( "spilling to disk" )
+    {   std::vector<gynx::sq> seqs;
+        std::mt19937 gen(3);
+        for (int i = 0; i < 200; ++i)
+        {   gynx::sq s(300);
+            for (auto& c : s)
+                c = "ACGT"[gen() % 4];
+            seqs.push_back(s);
+            seqs.push_back(gynx::sq(s(50, 100))); // some repeated k-mers
+        }
+        auto expected = naive(seqs, 15);
+        gynx::kmer_counter kc(15, 64 << 10, std::filesystem::temp_directory_path(), 8);
+        gynx::parallel_for
+        (   gynx::thread_pool::global()
+        ,   seqs.size()
+        ,   [&](std::size_t i) { kc.add(seqs[i](0)); }
+        );
+        CHECK(kc.spills() > 0);
+        // spilled tables shrink back, so the tables stay near the limit
+        CHECK(kc.memory_usage() <= 2 * (64 << 10));
+        CHECK(expected.size() == kc.distinct());
+        for (const auto& e : expected)
+            CHECK(e.count == kc.count(e.code));
+        std::uint64_t n = 0;
+        kc.for_each([&](const gynx::kmer_count& e) { n += e.count; });
+        CHECK(kc.total() == n);
+    }
+    SECTION( "counting a file" )
+    {   std::vector<gynx::sq> reads;
+        gynx::in::fast_aqz<gynx::sq>()
+        (   SAMPLE_READS
+        ,   [&](gynx::sq&& r) { reads.push_back(std::move(r)); }
+        );
+        auto expected = naive(reads, 21);
+        gynx::kmer_counter kc(21);
+        CHECK(reads.size() == kc.add_file(SAMPLE_READS));
+        CHECK(expected.size() == kc.distinct());
+        std::vector<std::uint64_t> h(101);
+        for (const auto& e : expected)
+            ++h[std::min<std::uint64_t>(e.count, 100)];
+        CHECK(h == kc.histogram(100));
+        CHECK(expected.front().count == kc.count(expected.front().code));
+        CHECK(expected.back().count == kc.count(expected.back().code));
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::find", "[algorithm][search][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    const auto best = gynx::simd::detect();
+    constexpr auto npos = gynx::sq_view_gen<T>::npos;
+
+    SECTION( "find/rfind/contains" )
+    {   gynx::sq_gen<T> s{"ACGTNACGTTACGT"};
+        for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            CHECK(0 == gynx::find(s(0), "ACGT"));
+            CHECK(5 == gynx::find(s(0), "ACGT", 1));
+            CHECK(npos == gynx::find(s(0), "ACGA"));
+            CHECK(npos == gynx::find(s(0), "ACGT", 15));
+            CHECK(3 == gynx::find(s(0), "", 3));
+            CHECK(10 == gynx::rfind(s(0), "ACGT"));
+            CHECK(5 == gynx::rfind(s(0), "ACGT", 9));
+            CHECK(0 == gynx::rfind(s(0), "ACGT", 4));
+            CHECK(npos == gynx::rfind(s(0), "TTT"));
+            CHECK(gynx::contains(s(0), "TNA"));
+            CHECK_FALSE(gynx::contains(s(0), "acgt"));
+            CHECK(std::vector<std::size_t>{ 0, 5, 10 } == gynx::find_all(s(0), "ACGT"));
+            CHECK(3 == gynx::count(s(0), "CG"));
+        }
+        CHECK_THROWS_AS(gynx::count(s(0), ""), std::invalid_argument);
+    }
+    SECTION( "naive comparison" )
+    {   gynx::sq_gen<T> s(5000);
+        std::mt19937 gen(5);
+        for (auto& c : s)
+            c = "ACGT"[gen() % 4];
+        std::string_view sv(s.data(), s.size());
+        for (std::size_t m : { 1, 2, 3, 5, 8, 16, 17, 24, 40 })
+            for (int trial = 0; trial < 4; ++trial)
+            {   std::string p(sv.substr(gen() % (s.size() - m), m));
+                if (trial % 2)
+                    p[m / 2] = 'N' == p[m / 2] ? 'A' : 'C';
+                std::vector<std::size_t> expected;
+                for (auto i = sv.find(p); i != sv.npos; i = sv.find(p, i + 1))
+                    expected.push_back(i);
+                for (int l = 0; l <= static_cast<int>(best); ++l)
+                {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+                    CHECK(expected == gynx::find_all(s(0), p));
+                    CHECK(expected.size() == gynx::count(s(0), p));
+                    CHECK(sv.rfind(p) == gynx::rfind(s(0), p));
+                    CHECK(sv.rfind(p, 2500) == gynx::rfind(s(0), p, 2500));
+                    CHECK(sv.find(p, 777) == gynx::find(s(0), p, 777));
+                }
+            }
+    }
+    gynx::simd::set_level(best);
+
+    SECTION( "aho-corasick" )
+    {   gynx::sq_gen<T> s{"ACGTNACGTTACGT"};
+        gynx::aho_corasick ac{ "ACGT", "CG", "GTTA", "TTT", "T" };
+        auto n = ac.count(s(0));
+        CHECK(std::vector<std::size_t>{ 3, 3, 1, 0, 4 } == n);
+        auto hits = ac.find_all(s(0));
+        REQUIRE(11 == hits.size());
+        CHECK(gynx::pattern_match{ 1, 1 } == hits[0]);
+        CHECK(gynx::pattern_match{ 0, 0 } == hits[1]);
+        CHECK(gynx::pattern_match{ 3, 4 } == hits[2]);
+
+        std::mt19937 gen(9);
+        gynx::sq_gen<T> r(3000);
+        for (auto& c : r)
+            c = "ACGT"[gen() % 4];
+        std::vector<std::string> primers;
+        for (int i = 0; i < 50; ++i)
+        {   auto pos = gen() % 2900;
+            primers.emplace_back(r.data() + pos, 4 + gen() % 20);
+        }
+        gynx::aho_corasick many(primers);
+        auto counts = many.count(r(0));
+        for (std::size_t i = 0; i < primers.size(); ++i)
+            CHECK(gynx::count(r(0), primers[i]) == counts[i]);
+        CHECK_THROWS_AS(gynx::aho_corasick({ "ACGT", "" }), std::invalid_argument);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::approximate_pattern", "[algorithm][search][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+
+    // semi-global edit distance of p ending at every position of s
+    auto naive = [](std::string_view s, std::string_view p)
+    {   std::vector<std::size_t> col(p.size() + 1), ends(s.size() + 1);
+        for (std::size_t i = 0; i <= p.size(); ++i)
+            col[i] = i;
+        ends[0] = p.size();
+        for (std::size_t j = 1; j <= s.size(); ++j)
+        {   std::size_t diag = 0;
+            col[0] = 0;
+            for (std::size_t i = 1; i <= p.size(); ++i)
+            {   const auto up = col[i];
+                col[i] = std::min
+                (   { col[i] + 1
+                    , col[i - 1] + 1
+                    , diag + (toupper(s[j - 1]) == toupper(p[i - 1]) ? 0 : 1)
+                    }
+                );
+                diag = up;
+            }
+            ends[j] = col[p.size()];
+        }
+        return ends;
+    };
+
+    SECTION( "simple" )
+    {   gynx::sq_gen<T> s{"TTTTAGATCGGAAGAGCTTTT"};
+        gynx::approximate_pattern adapter("AGATCGGAAGAGC");
+        CHECK(13 == adapter.size());
+        auto b = adapter.best(s(0));
+        CHECK(gynx::approximate_match{ 17, 0 } == b);
+        gynx::approximate_pattern mutated("agatcgTaagagc");
+        CHECK(gynx::approximate_match{ 17, 1 } == mutated.best(s(0)));
+        CHECK(gynx::approximate_match{ 17, 1 } == mutated.first(s(0), 1));
+        CHECK_FALSE(mutated.first(s(0), 0).has_value());
+        CHECK(1 == mutated.find_all(s(0), 1).size());
+        CHECK(3 == mutated.find_all(s(0), 2).size());
+        CHECK_THROWS_AS(gynx::approximate_pattern(""), std::invalid_argument);
+    }
+    SECTION( "naive comparison" )
+    {   std::mt19937 gen(33);
+        gynx::sq_gen<T> s(700);
+        for (auto& c : s)
+            c = "ACGTN"[gen() % 5];
+        std::string_view sv(s.data(), s.size());
+        for (std::size_t m : { 1, 7, 33, 63, 64, 65, 128, 200, 600 })
+        {   std::string p(sv.substr(gen() % (s.size() - m), m));
+            for (std::size_t e = 0; e < m / 8; ++e)
+                p[gen() % m] = "ACGT"[gen() % 4];
+            gynx::approximate_pattern ap(p);
+            const auto expected = naive(sv, p);
+            std::size_t k = m / 4;
+            std::vector<gynx::approximate_match> hits;
+            for (std::size_t j = 0; j < expected.size(); ++j)
+                if (expected[j] <= k)
+                    hits.push_back({ j, expected[j] });
+            CHECK(hits == ap.find_all(s(0), k));
+            const auto b = std::min_element(expected.begin(), expected.end());
+            CHECK(gynx::approximate_match{ std::size_t(b - expected.begin()), *b } == ap.best(s(0)));
+        }
+    }
+    SECTION( "batch" )
+    {   std::mt19937 gen(34);
+        std::vector<gynx::sq_gen<T>> reads;
+        for (int i = 0; i < 37; ++i)
+        {   gynx::sq_gen<T> r(gen() % 160);
+            for (auto& c : r)
+                c = "ACGT"[gen() % 4];
+            reads.push_back(r);
+        }
+        const auto best = gynx::simd::detect();
+        for (std::string p : { std::string("AGATCGGAAGAGC"), std::string(64, 'C'), std::string(70, 'A') })
+        {   gynx::approximate_pattern ap(p);
+            std::vector<gynx::approximate_match> expected;
+            for (const auto& r : reads)
+                expected.push_back(ap.best(r(0)));
+            for (int l = 0; l <= static_cast<int>(best); ++l)
+            {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+                CHECK(expected == ap.best_each(reads));
+            }
+            gynx::simd::set_level(best);
+        }
+    }
+}
+
+TEST_CASE( "gynx::scoring_matrix", "[algorithm][align]" )
+{   auto b = gynx::scoring_matrix::blosum62();
+    CHECK(24 == b.size());
+    for (char x : b.alphabet())
+        for (char y : b.alphabet())
+            CHECK(b(x, y) == b(y, x));
+    CHECK(11 == b('W', 'w'));
+    CHECK(9 == b('C', 'C'));
+    CHECK(-4 == b('*', 'A'));
+    CHECK(b('J', 'A') == b('X', 'A'));
+    CHECK(-4 == b.min());
+    CHECK(11 == b.max());
+
+    auto d = gynx::scoring_matrix::dna(1, -4);
+    CHECK(1 == d('a', 'A'));
+    CHECK(-4 == d('A', 'C'));
+    CHECK(-4 == d('N', 'N'));
+    CHECK(-4 == d('R', 'A'));
+    CHECK_THROWS_AS(gynx::scoring_matrix("AC", { 1, 2, 3 }, 'A'), std::invalid_argument);
+    CHECK_THROWS_AS(gynx::scoring_matrix("AC", { 1, 0, 0, 1 }, 'N'), std::invalid_argument);
+    CHECK_THROWS_AS(gynx::scoring_matrix("AC", { 200, 0, 0, 1 }, 'A'), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE( "gynx::align", "[algorithm][align][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    using gynx::alignment_mode;
+    const auto best = gynx::simd::detect();
+
+    // score of an alignment recomputed from its CIGAR string
+    auto cigar_score = []
+    (   const gynx::alignment& a
+    ,   std::string_view q
+    ,   std::string_view t
+    ,   const gynx::alignment_scoring& sc
+    )
+    {   int score = 0;
+        std::size_t i = a.query_begin, j = a.target_begin, len = 0;
+        for (char c : a.cigar)
+        {   if (std::isdigit(c))
+            {   len = len * 10 + (c - '0');
+                continue;
+            }
+            if ('M' == c)
+                for (std::size_t k = 0; k < len; ++k)
+                    score += sc.matrix(q[i++], t[j++]);
+            else
+            {   score -= sc.gap_open + int(len) * sc.gap_extend;
+                ('I' == c ? i : j) += len;
+            }
+            len = 0;
+        }
+        CHECK(a.query_end == i);
+        CHECK(a.target_end == j);
+        return score;
+    };
+
+    SECTION( "simple" )
+    {   gynx::sq_gen<T> q{"ACGTACGT"}, t{"TTACGTTACGTTT"};
+        gynx::alignment_scoring sc{ gynx::scoring_matrix::dna(2, -3), 5, 2 };
+        auto l = gynx::align(q(0), t(0), alignment_mode::local, sc);
+        CHECK(l.score == 10);
+        CHECK(l.cigar == "5M");
+        CHECK(l.query_begin == 3);
+        CHECK(l.target_begin == 1);
+        CHECK(l.target_end == 6);
+        auto s = gynx::align(q(0), t(0), alignment_mode::semi_global, sc);
+        CHECK(s.score == 9);
+        CHECK(s.score == cigar_score(s, "ACGTACGT", "TTACGTTACGTTT", sc));
+        CHECK(s.target_begin == 2);
+        CHECK(s.target_end == 11);
+        auto g = gynx::align(q(0), t(0), alignment_mode::global, sc);
+        CHECK(g.score == cigar_score(g, "ACGTACGT", "TTACGTTACGTTT", sc));
+        CHECK(g.query_begin == 0);
+        CHECK(g.target_begin == 0);
+        CHECK(g.target_end == 13);
+        auto e = gynx::align(gynx::sq_gen<T>{}(0), t(0), alignment_mode::global, sc);
+        CHECK(e.score == -31);
+        CHECK(e.cigar == "13D");
+        CHECK_THROWS_AS
+        (   gynx::align(q(0), t(0), alignment_mode::local, { sc.matrix, -1, 1 })
+        ,   std::invalid_argument
+        );
+    }
+    SECTION( "striped vs scalar" )
+    {   std::mt19937 gen(34);
+        auto random = [&](std::size_t n, std::string_view abc)
+        {   gynx::sq_gen<T> s(n);
+            for (auto& c : s)
+                c = abc[gen() % abc.size()];
+            return s;
+        };
+        // mutated copy so alignments are not all noise
+        auto mutate = [&](const gynx::sq_gen<T>& s, std::string_view abc)
+        {   std::string r;
+            for (char c : s)
+                switch (gen() % 12)
+                {   case 0: r += abc[gen() % abc.size()]; break;
+                    case 1: break;
+                    case 2: r += c; r += abc[gen() % abc.size()]; break;
+                    default: r += c;
+                }
+            return gynx::sq_gen<T>(r);
+        };
+        const std::vector<std::pair<std::string_view, gynx::alignment_scoring>> schemes
+        {   { "ACGT", { gynx::scoring_matrix::dna(2, -3), 5, 2 } }
+        ,   { "ACGTN", { gynx::scoring_matrix::dna(1, -4), 6, 1 } }
+        ,   { "ARNDCQEGHILKMFPSTWYV", { gynx::scoring_matrix::blosum62(), 11, 1 } }
+        };
+        for (const auto& [abc, sc] : schemes)
+            for (std::size_t m : { 1, 7, 40, 150, 333 })
+                for (std::size_t n : { 1, 9, 160, 500 })
+                {   auto q = random(m, abc);
+                    auto t = m <= n && n < 2 * m ? mutate(q, abc) : random(n, abc);
+                    for (auto mode : { alignment_mode::local, alignment_mode::global, alignment_mode::semi_global })
+                    {   gynx::simd::set_level(gynx::simd::isa::scalar);
+                        const auto expected = gynx::align_score(q(0), t(0), mode, sc);
+                        auto a = gynx::align(q(0), t(0), mode, sc);
+                        CHECK(expected == gynx::alignment_score{ a.score, a.query_end, a.target_end });
+                        std::string_view qv(q.data(), q.size()), tv(t.data(), t.size());
+                        CHECK(a.score == cigar_score(a, qv, tv, sc));
+                        for (int l = 1; l <= static_cast<int>(best); ++l)
+                        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+                            CHECK(expected == gynx::align_score(q(0), t(0), mode, sc));
+                        }
+                    }
+                }
+        gynx::simd::set_level(best);
+    }
+    SECTION( "overflow promotion" )
+    {   // local scores past 8 bits, global scores past 16 bits
+        std::string s(400, 'A');
+        for (std::size_t i = 0; i < s.size(); ++i)
+            s[i] = "ACGT"[(i * 7 + i / 5) % 4];
+        gynx::sq_gen<T> q(s), t(s + s);
+        gynx::alignment_scoring sc{ gynx::scoring_matrix::dna(2, -3), 100, 50 };
+        for (auto mode : { alignment_mode::local, alignment_mode::global, alignment_mode::semi_global })
+        {   gynx::simd::set_level(gynx::simd::isa::scalar);
+            const auto expected = gynx::align_score(q(0), t(0), mode, sc);
+            gynx::simd::set_level(best);
+            CHECK(expected == gynx::align_score(q(0), t(0), mode, sc));
+        }
+        CHECK(-19300 == gynx::align_score(q(0), t(0), alignment_mode::global, sc).score);
+    }
+    SECTION( "batch" )
+    {   std::mt19937 gen(35);
+        gynx::sq_gen<T> q(120);
+        for (auto& c : q)
+            c = "ACGT"[gen() % 4];
+        std::vector<gynx::sq_gen<T>> targets;
+        for (int i = 0; i < 25; ++i)
+        {   gynx::sq_gen<T> t(50 + gen() % 300);
+            for (auto& c : t)
+                c = "ACGT"[gen() % 4];
+            targets.push_back(t);
+        }
+        gynx::thread_pool pool(3);
+        gynx::alignment_profile p(q(0), alignment_mode::local);
+        auto scores = p.score_each(targets, pool);
+        REQUIRE(scores.size() == targets.size());
+        for (std::size_t i = 0; i < targets.size(); ++i)
+            CHECK(scores[i] == gynx::align_score(q(0), targets[i](0), alignment_mode::local));
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::dotplot", "[algorithm][dotplot]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    std::mt19937 gen(35);
+    auto random = [&](std::size_t n, std::string_view abc)
+    {   gynx::sq_gen<T> s(n);
+        for (auto& c : s)
+            c = abc[gen() % abc.size()];
+        return s;
+    };
+    auto complement = [](char c)
+    {   return "TGCA"[std::string_view("ACGT").find(c)];
+    };
+    // x shares a forward and a reverse-complement segment with y
+    auto y = random(700, "ACGT");
+    auto x = random(500, "ACGT");
+    std::copy_n(y.begin() + 100, 150, x.begin() + 20);
+    for (std::size_t i = 0; i < 120; ++i)
+        x[300 + i] = complement(y[519 - i]);
+    x[50] = 'N';
+    x[60] = 'g';
+    gynx::thread_pool pool(3);
+
+    SECTION( "word matches" )
+    {   auto rc = [&](std::string s)
+        {   std::reverse(s.begin(), s.end());
+            for (auto& c : s)
+                c = complement(c);
+            return s;
+        };
+        auto upper = [](std::string s)
+        {   for (auto& c : s)
+                c = std::toupper(c);
+            return s;
+        };
+        for (std::size_t k : { 1, 5, 11, 32 })
+            for (auto [rows, cols] : { std::pair{ 7, 13 }, { 64, 64 }, { 1000, 1000 } })
+                for (bool both : { false, true })
+                {   auto m = gynx::dotplot(x(0), y(0), k, rows, cols, both, 1024, pool);
+                    REQUIRE(m.rows() == std::min<std::size_t>(rows, x.size()));
+                    REQUIRE(m.cols() == std::min<std::size_t>(cols, y.size()));
+                    gynx::dot_matrix e(rows, cols, x.size(), y.size());
+                    std::string xs(x.begin(), x.end()), ys(y.begin(), y.end());
+                    for (std::size_t i = 0; i + k <= xs.size(); ++i)
+                    {   const auto w = upper(xs.substr(i, k));
+                        if (w.find_first_not_of("ACGT") != std::string::npos)
+                            continue;
+                        for (std::size_t j = 0; j + k <= ys.size(); ++j)
+                        {   const auto v = ys.substr(j, k);
+                            if (w == v || (both && rc(w) == v && w != v))
+                                ++e(e.row_of(i), e.col_of(j));
+                        }
+                    }
+                    bool same = true;
+                    for (std::size_t r = 0; r < m.rows(); ++r)
+                        for (std::size_t c = 0; c < m.cols(); ++c)
+                            same = same && m(r, c) == e(r, c);
+                    CHECK(same);
+                }
+        // repeats over the occurrence limit are skipped
+        gynx::sq_gen<T> a(std::string(200, 'A'));
+        CHECK(0 == gynx::dotplot(a(0), a(0), 8, 10, 10, true, 100, pool).total());
+        CHECK(193 * 193 == gynx::dotplot(a(0), a(0), 8, 10, 10, true, 193, pool).total());
+        CHECK_THROWS_AS(gynx::dotplot(x(0), y(0), 33, 10, 10), std::invalid_argument);
+    }
+    SECTION( "windowed identity" )
+    {   for (auto [window, threshold] : { std::pair{ 1, 1 }, { 10, 7 }, { 25, 25 }, { 70, 40 } })
+            for (auto [rows, cols] : { std::pair{ 9, 11 }, { 100, 100 }, { 1000, 1000 } })
+            {   auto m = gynx::dotplot_identity
+                (   x(0), y(0), window, threshold, rows, cols, pool);
+                gynx::dot_matrix e(rows, cols, x.size(), y.size());
+                for (std::size_t i = 0; i + window <= x.size(); ++i)
+                    for (std::size_t j = 0; j + window <= y.size(); ++j)
+                    {   std::size_t same = 0;
+                        for (std::size_t d = 0; d < std::size_t(window); ++d)
+                            same += std::toupper(x[i + d]) == std::toupper(y[j + d]);
+                        if (same >= std::size_t(threshold))
+                            ++e(e.row_of(i), e.col_of(j));
+                    }
+                bool same = true;
+                for (std::size_t r = 0; r < m.rows(); ++r)
+                    for (std::size_t c = 0; c < m.cols(); ++c)
+                        same = same && m(r, c) == e(r, c);
+                CHECK(same);
+                CHECK(m.total() == e.total());
+            }
+        CHECK_THROWS_AS(gynx::dotplot_identity(x(0), y(0), 5, 6, 10, 10), std::invalid_argument);
+    }
+    SECTION( "gnuplot matrix" )
+    {   auto m = gynx::dotplot(x(0), x(0), 12, 3, 4, false);
+        std::ostringstream os;
+        os << m;
+        std::istringstream is(os.str());
+        std::string line;
+        std::size_t lines = 0;
+        while (std::getline(is, line))
+        {   std::istringstream ls(line);
+            std::uint32_t v;
+            std::size_t c = 0;
+            while (ls >> v)
+                CHECK(v == m(lines, c++));
+            CHECK(c == 4);
+            ++lines;
+        }
+        CHECK(lines == 3);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::fm_index", "[algorithm][index]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    std::mt19937 gen(36);
+    auto random = [&](std::size_t n, std::string_view abc)
+    {   std::string s(n, 'A');
+        for (auto& c : s)
+            c = abc[gen() % abc.size()];
+        return s;
+    };
+
+    SECTION( "suffix array" )
+    {   for (std::string_view abc : { "a", "ab", "abc", "acgtn" })
+            for (std::size_t n : { 0, 1, 2, 7, 8, 9, 30, 200, 1000 })
+            {   const auto s = random(n, abc);
+                std::vector<std::int32_t> text(s.begin(), s.end());
+                std::vector<std::int32_t> expected(n);
+                std::iota(expected.begin(), expected.end(), 0);
+                std::sort
+                (   expected.begin()
+                ,   expected.end()
+                ,   [&](auto a, auto b) { return s.substr(a) < s.substr(b); }
+                );
+                CHECK(expected == gynx::detail::sa_is(text, 'z'));
+            }
+    }
+    SECTION( "count and locate" )
+    {   // repeats, lowercase and N across three records
+        std::vector<std::string> texts
+        {   random(3000, "ACGT")
+        ,   random(40, "ACGT") + std::string(30, 'A') + "NNNN" + random(500, "ACGTacgtN")
+        ,   "ACGTACGTACGTACGT"
+        };
+        texts[0] += texts[0].substr(100, 300);
+        std::vector<gynx::sq_gen<T>> records;
+        for (const auto& t : texts)
+            records.emplace_back(t);
+        auto upper = [](std::string s)
+        {   for (auto& c : s)
+                c = std::toupper(c);
+            return s;
+        };
+        auto naive = [&](const std::string& q)
+        {   std::vector<gynx::fm_hit> hits;
+            for (std::size_t r = 0; r < texts.size(); ++r)
+            {   const auto t = upper(texts[r]);
+                for (auto p = t.find(q); p != std::string::npos; p = t.find(q, p + 1))
+                    hits.push_back({ r, p });
+            }
+            return hits;
+        };
+        std::vector<std::string> queries { "A", "ACGT", "AAAAAAAAAA", "T", "GATTACA", "ACGTN", "" };
+        for (int i = 0; i < 200; ++i)
+        {   const auto& t = texts[gen() % 2];
+            const std::size_t len = 1 + gen() % 25;
+            const std::size_t pos = gen() % (t.size() - len);
+            queries.push_back(upper(t.substr(pos, len)));
+            queries.push_back(random(len, "ACGT"));
+        }
+        const auto path = std::filesystem::temp_directory_path() / "gynx_fm_index_test.fmi";
+        for (std::size_t rate : { 1, 7, 32 })
+        {   gynx::fm_index built(records, rate);
+            REQUIRE(3 == built.records());
+            CHECK(texts[1].size() == built.record_size(1));
+            built.save(path);
+            gynx::fm_index mapped(path);
+            CHECK(built.bytes() == mapped.bytes());
+            for (const auto* index : { &built, &mapped })
+            {   bool same = true;
+                for (const auto& q : queries)
+                {   auto expected = q.find('N') == std::string::npos
+                    ?   naive(q)
+                    :   std::vector<gynx::fm_hit>{};
+                    if (q.empty())
+                        expected.clear();
+                    gynx::sq_gen<T> s(q);
+                    auto hits = index->locate(s(0));
+                    std::sort(hits.begin(), hits.end());
+                    same = same && expected == hits
+                        && expected.size() == index->count(s(0));
+                }
+                CHECK(same);
+            }
+            gynx::thread_pool pool(3);
+            std::vector<gynx::sq_gen<T>> batch(queries.begin(), queries.end());
+            const auto counts = mapped.count_each(batch, pool);
+            const auto located = mapped.locate_each(batch, pool);
+            REQUIRE(counts.size() == batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {   CHECK(counts[i] == built.count(batch[i](0)));
+                CHECK(located[i].size() == counts[i]);
+            }
+        }
+        std::filesystem::remove(path);
+        gynx::fm_index single(records[2]);
+        CHECK(4 == single.count("ACGT"_sq(0)));
+        CHECK(0 == gynx::fm_index().count("ACGT"_sq(0)));
+        CHECK_THROWS_AS(gynx::fm_index(path), std::runtime_error);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::translate", "[algorithm][translate][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    using gynx::genetic_code;
+    const auto best = gynx::simd::detect();
+    std::mt19937 gen(37);
+    // NCBI tables list codons in TCAG order
+    auto naive = [](const std::string& s, std::string_view aas)
+    {   auto base = [](char c)
+        {   const auto i = std::string_view("TCAGUtcagu").find(c);
+            return std::string_view::npos == i ? -1 : int(i % 5 == 4 ? 0 : i % 5);
+        };
+        std::string p;
+        for (std::size_t i = 0; i + 3 <= s.size(); i += 3)
+        {   const int a = base(s[i]), b = base(s[i + 1]), c = base(s[i + 2]);
+            p += a < 0 || b < 0 || c < 0 ? 'X' : aas[16 * a + 4 * b + c];
+        }
+        return p;
+    };
+    auto rc = [](std::string s)
+    {   std::reverse(s.begin(), s.end());
+        for (auto& c : s)
+            c = gynx::lut::complement[static_cast<std::uint8_t>(c)];
+        return s;
+    };
+    const std::string standard
+        ("FFLLSSSSYY**CC*WLLLLPPPPHHQQRRRRIIIMTTTTNNKKSSRRVVVVAAAADDEEGGGG");
+
+    SECTION( "frames" )
+    {   for (std::size_t n : { 0, 2, 3, 47, 48, 49, 100, 191, 192, 500, 1001 })
+        {   std::string s(n, 'A');
+            for (auto& c : s)
+                c = "ACGTacgtNU"[gen() % (gen() % 8 ? 4 : 10)];
+            gynx::sq_gen<T> seq(s);
+            for (int l = 0; l <= static_cast<int>(best); ++l)
+            {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+                bool same = true;
+                for (int frame : { 1, 2, 3, -1, -2, -3 })
+                {   const std::size_t off = std::abs(frame) - 1;
+                    const auto src = frame > 0 ? s : rc(s);
+                    const auto expected = naive(off < n ? src.substr(off) : "", standard);
+                    const auto p = gynx::translate(seq(0), frame);
+                    same = same && std::string(p.begin(), p.end()) == expected;
+                }
+                const auto six = gynx::translate_six_frames(seq(0));
+                for (int f = 0; f < 6; ++f)
+                    same = same && six[f] == gynx::translate(seq, f < 3 ? f + 1 : 2 - f);
+                CHECK(same);
+            }
+        }
+        gynx::simd::set_level(best);
+        CHECK_THROWS_AS(gynx::translate("ACGT"_sq, 4), std::invalid_argument);
+    }
+    SECTION( "genetic codes" )
+    {   const gynx::sq_gen<T> s("ATGTGAAGAATAAAATAACTGTAG");
+        CHECK(gynx::translate(s) == gynx::sq_gen<T>("M*RIK*L*"));
+        CHECK(gynx::translate(s, 1, genetic_code::vertebrate_mitochondrial) == gynx::sq_gen<T>("MW*MK*L*"));
+        CHECK(gynx::translate(s, 1, genetic_code::invertebrate_mitochondrial) == gynx::sq_gen<T>("MWSMK*L*"));
+        CHECK(gynx::translate(s, 1, genetic_code::yeast_mitochondrial) == gynx::sq_gen<T>("MWRMK*T*"));
+        CHECK(gynx::translate(s, 1, genetic_code::echinoderm_mitochondrial) == gynx::sq_gen<T>("MWSIN*L*"));
+        CHECK(gynx::translate(s, 1, genetic_code::ciliate) == gynx::sq_gen<T>("M*RIKQLQ"));
+        CHECK(gynx::translate(s, 1, genetic_code::alternative_yeast) == gynx::sq_gen<T>("M*RIK*S*"));
+        CHECK(gynx::translate(s, 1, genetic_code::bacterial) == gynx::translate(s));
+        CHECK_THROWS_AS(gynx::translate(s, 1, genetic_code(7)), std::invalid_argument);
+        // a long run through the vector kernels
+        std::string r(3000, 'A');
+        for (auto& c : r)
+            c = "ACGT"[gen() % 4];
+        const std::string ascidian
+            ("FFLLSSSSYY**CCWWLLLLPPPPHHQQRRRRIIMMTTTTNNKKSSGGVVVVAAAADDEEGGGG");
+        const auto p = gynx::translate(gynx::sq_gen<T>(r), 1, genetic_code::ascidian_mitochondrial);
+        CHECK(std::string(p.begin(), p.end()) == naive(r, ascidian));
+    }
+    SECTION( "open reading frames" )
+    {   // an ORF of 5 aa on the forward strand and one of 4 aa on the reverse
+        const std::string fwd = "CC" "ATGAAACCCATGGGGTAA" "T";
+        const std::string s = fwd + rc("ATGTTTCCCGGGTAG") + "GG";
+        gynx::sq_gen<T> seq(s);
+        const auto orfs = gynx::find_orfs(seq(0), 3);
+        REQUIRE(2 == orfs.size());
+        CHECK(orfs[0] == gynx::orf{ 3, 2, 20 });
+        CHECK(5 == orfs[0].length());
+        CHECK(-3 == orfs[1].frame);
+        CHECK("ATGTTTCCCGGGTAG" == rc(s.substr(orfs[1].begin, orfs[1].end - orfs[1].begin)));
+        CHECK(1 == gynx::find_orfs(seq(0), 5).size());
+        CHECK(1 == gynx::find_orfs(seq(0), 3, genetic_code::standard, false).size());
+        // against a naive scan of random sequences
+        std::string r(5000, 'A');
+        for (auto& c : r)
+            c = "ACGT"[gen() % 4];
+        gynx::sq_gen<T> rs(r);
+        std::vector<gynx::orf> expected;
+        for (int f = 0; f < 6; ++f)
+        {   const auto src = f < 3 ? r : rc(r);
+            for (std::size_t i = f % 3; i + 3 <= src.size(); i += 3)
+            {   if (src.compare(i, 3, "ATG"))
+                    continue;
+                std::size_t j = i;
+                while (j + 3 <= src.size() && std::string("TAA TAG TGA").find(src.substr(j, 3)) == std::string::npos)
+                    j += 3;
+                if (j + 3 > src.size() || (j - i) / 3 < 20)
+                    continue;
+                const std::size_t b = i, e = j + 3;
+                expected.push_back(f < 3 ? gynx::orf{ f + 1, b, e } : gynx::orf{ 2 - f, r.size() - e, r.size() - b });
+                i = j;  // nested methionines belong to the same ORF
+            }
+        }
+        CHECK(expected == gynx::find_orfs(rs(0), 20));
+    }
+}
+
+TEST_CASE( "gynx::normalize", "[algorithm][normalize][simd]" )
+{   using gynx::alphabet;
+    using gynx::normalization;
+    const auto best = gynx::simd::detect();
+    std::mt19937 gen(38);
+    auto reference = [](std::string s, std::string_view letters, std::string_view extra, char wildcard, normalization p)
+    {   std::size_t bad = s.size();
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {   char u = std::toupper(static_cast<unsigned char>(s[i]));
+            if (letters == "ACGT" && 'U' == u)
+                u = 'T';
+            if (letters == "ACGU" && 'T' == u)
+                u = 'U';
+            const bool ok = std::isalpha(static_cast<unsigned char>(s[i]))
+            ?   letters.find(u) != std::string_view::npos
+            :   s[i] && extra.find(s[i]) != std::string_view::npos;
+            if (ok && normalization::validate != p)
+                s[i] = u;
+            else if (! ok && normalization::replace == p)
+                s[i] = wildcard;
+            else if (! ok)
+            {   bad = i;
+                break;
+            }
+        }
+        return std::pair{ s, bad };
+    };
+    const std::tuple<alphabet, std::string_view, std::string_view, char> alphabets[]
+    {   { alphabet::dna, "ACGT", "", 'N' }
+    ,   { alphabet::rna, "ACGU", "", 'N' }
+    ,   { alphabet::iupac, "ACGTURYSWKMBDHVN", "-", 'N' }
+    ,   { alphabet::protein, "ACDEFGHIKLMNPQRSTVWYBZJXUO", "*-", 'X' }
+    };
+    for (int l = 0; l <= static_cast<int>(best); ++l)
+    {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+        bool same = true;
+        for (const auto& [a, letters, extra, wildcard] : alphabets)
+            for (auto p : { normalization::validate, normalization::uppercase, normalization::replace })
+                for (std::size_t n : { 0, 15, 16, 33, 64, 200, 1000 })
+                    for (int bad : { 0, 1, 2 })
+                    {   // mostly valid residues, then any byte at all
+                        std::string s(n, 'A');
+                        for (auto& c : s)
+                            c = letters[gen() % letters.size()] | (gen() % 2 ? 0x20 : 0);
+                        for (int i = 0; i < bad && n; ++i)
+                            s[gen() % n] = static_cast<char>(bad > 1 ? gen() % 256 : 'z');
+                        const auto [expected, pos] = reference(s, letters, extra, wildcard, p);
+                        std::string out(n, '?');
+                        const char* r = gynx::normalize_copy(s.data(), s.data() + n, out.data(), a, p);
+                        same = same && std::size_t(r - s.data()) == pos
+                            && out.substr(0, pos) == expected.substr(0, pos);
+                        const auto in_place = gynx::normalize(s, a, p);
+                        same = same && in_place == pos && s.substr(0, pos) == expected.substr(0, pos);
+                    }
+        CHECK(same);
+    }
+    gynx::simd::set_level(best);
+    std::string all(256, 0);
+    std::iota(all.begin(), all.end(), 0);
+    CHECK(256 == gynx::normalize(all, alphabet::protein, normalization::replace));
+    CHECK(all.substr(0, 42) == std::string(42, 'X'));
+    CHECK('*' == all['*']);
+    CHECK('W' == all['w']);
+}
+
+TEMPLATE_TEST_CASE( "gynx::hamming", "[algorithm][hamming][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    const auto best = gynx::simd::detect();
+    std::mt19937 gen(39);
+    auto random = [&](std::size_t n, std::string_view alphabet)
+    {   std::string s(n, 'A');
+        for (auto& c : s)
+            c = alphabet[gen() % alphabet.size()];
+        return s;
+    };
+
+    SECTION( "raw" )
+    {   for (std::size_t n : { 0, 1, 15, 16, 17, 63, 64, 65, 100, 129, 1000 })
+        {   const auto s = random(n, "ACGT");
+            for (unsigned rate : { 0, 2, 10, 50 })
+            {   auto t = s;
+                std::vector<std::size_t> expected;
+                for (std::size_t i = 0; i < n; ++i)
+                    if (rate && 0 == gen() % rate)
+                    {   t[i] = t[i] == 'A' ? 'c' : 'A';
+                        expected.push_back(i);
+                    }
+                gynx::sq_gen<T> a(s), b(t);
+                for (int l = 0; l <= static_cast<int>(best); ++l)
+                {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+                    const std::size_t d = expected.size();
+                    CHECK(gynx::hamming(a(0), b(0)) == d);
+                    CHECK(gynx::mismatch_positions(a(0), b(0)) == expected);
+                    CHECK(gynx::hamming_le(a(0), b(0), d));
+                    CHECK((0 == d || ! gynx::hamming_le(a(0), b(0), d - 1)));
+                    // unaligned subviews
+                    if (n > 3)
+                        CHECK(gynx::hamming(a(3), b(3))
+                            == std::size_t(std::ranges::count_if
+                            (   expected
+                            ,   [](std::size_t i) { return i >= 3; }
+                            )));
+                }
+            }
+        }
+        gynx::simd::set_level(best);
+        const gynx::sq_gen<T> a("ACGT"), b("ACG");
+        CHECK_THROWS_AS(gynx::hamming(a(0), b(0)), std::invalid_argument);
+        CHECK_THROWS_AS(gynx::mismatch_positions(a(0), b(0)), std::invalid_argument);
+    }
+    SECTION( "2-bit packed" )
+    {   CHECK(gynx::hamming_2bit(0, 0) == 0);
+        CHECK(gynx::hamming_2bit(0b00011011, 0b11011011) == 1);
+        CHECK(gynx::hamming_2bit(0b00011011, 0b11011000) == 2);
+        CHECK(gynx::hamming_2bit(~0ull, 0) == 32);
+        CHECK(gynx::hamming_2bit(0b01, 0b10) == 1);
+    }
+    SECTION( "barcode whitelist" )
+    {   std::vector<std::string> barcodes;
+        for (int i = 0; i < 5000; ++i)
+            barcodes.push_back(random(16, "ACGT"));
+        barcodes.push_back(barcodes[17]);   // a duplicate is never unique
+        const gynx::barcode_whitelist w(barcodes);
+        CHECK(w.size() == barcodes.size());
+        CHECK(w.length() == 16);
+
+        std::vector<gynx::sq_gen<T>> queries;
+        for (int i = 0; i < 200; ++i)
+        {   auto q = barcodes[gen() % barcodes.size()];
+            for (unsigned e = gen() % 4; e--; )
+                q[gen() % 16] = "ACGTN"[gen() % 5];
+            queries.emplace_back(q);
+        }
+        queries.emplace_back(barcodes[17]);
+        for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            bool same = true;
+            for (const auto& q : queries)
+            {   std::vector<std::uint8_t> d;
+                std::vector<std::size_t> within;
+                gynx::barcode_match m{ 0, 99, false };
+                for (std::size_t i = 0; i < barcodes.size(); ++i)
+                {   std::size_t e = 0;
+                    for (std::size_t j = 0; j < 16; ++j)
+                        e += q[j] != barcodes[i][j];
+                    d.push_back(std::uint8_t(e));
+                    if (e <= 2)
+                        within.push_back(i);
+                    if (e < m.distance)
+                        m = { i, e, true };
+                    else if (e == m.distance)
+                        m.unique = false;
+                }
+                same = same
+                    && w.distances(q) == d
+                    && w.within(q, 2) == within
+                    && w.nearest(q) == m;
+            }
+            CHECK(same);
+        }
+        gynx::simd::set_level(best);
+        const auto each = w.nearest_each(queries);
+        REQUIRE(each.size() == queries.size());
+        CHECK(each.back() == gynx::barcode_match{ 17, 0, false });
+        for (std::size_t i = 0; i < queries.size(); ++i)
+            CHECK(each[i] == w.nearest(queries[i]));
+
+        CHECK_THROWS_AS(w.nearest(std::string("ACGT")), std::invalid_argument);
+        CHECK_THROWS_AS
+        (   gynx::barcode_whitelist(std::vector<std::string>{ "ACGT", "ACG" })
+        ,   std::invalid_argument
+        );
+        CHECK_THROWS_AS
+        (   gynx::barcode_whitelist(std::vector<std::string>{ "ACNT" })
+        ,   std::invalid_argument
+        );
+        CHECK_THROWS_AS
+        (   gynx::barcode_whitelist(std::vector<std::string>{ std::string(33, 'A') })
+        ,   std::invalid_argument
+        );
+        CHECK_THROWS_AS
+        (   gynx::barcode_whitelist(std::vector<std::string>{}).nearest(std::string())
+        ,   std::out_of_range
+        );
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::hash", "[algorithm][hash]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    std::mt19937 gen(40);
+    auto rc = [](std::string s)
+    {   std::reverse(s.begin(), s.end());
+        for (auto& c : s)
+            c = gynx::lut::complement[static_cast<std::uint8_t>(c)];
+        return s;
+    };
+    std::set<std::uint64_t> seen;
+    for (std::size_t n = 0; n < 300; ++n)
+    {   std::string s(n, 'A');
+        for (auto& c : s)
+            c = "ACGTN"[gen() % 5];
+        gynx::sq_gen<T> a(s), b(s), r(rc(s));
+        std::vector<char> v(s.begin(), s.end());
+        CHECK(gynx::hash(a(0)) == gynx::hash(b(0)));
+        CHECK(gynx::hash(a(0)) == gynx::hash(gynx::sq_view_gen<std::vector<char>>(v.data(), v.size())));
+        CHECK(gynx::hash(a(0), 1) != gynx::hash(a(0), 2));
+        CHECK(gynx::canonical_hash(a(0)) == gynx::canonical_hash(r(0)));
+        seen.insert(gynx::hash(a(0)));
+        if (n > 0)
+        {   // a single changed residue changes the hash
+            auto t = s;
+            t[gen() % n] = 'a';
+            CHECK(gynx::hash(a(0)) != gynx::hash(gynx::sq_gen<T>(t)(0)));
+            CHECK(gynx::canonical_hash(a(0)) != gynx::canonical_hash(gynx::sq_gen<T>(t)(0)));
+        }
+    }
+    CHECK(300 == seen.size());
+    // subviews hash like the sequences they show
+    const gynx::sq_gen<T> s("TTACGTACGTAA");
+    CHECK(gynx::hash(s(2, 8)) == gynx::hash(gynx::sq_gen<T>("ACGTACGT")(0)));
+    // the portable 128-bit product agrees with the native one
+    bool same = true;
+    for (std::uint64_t x : { std::uint64_t(0), ~std::uint64_t(0), std::uint64_t(gen()) << 32 | gen() })
+        for (std::size_t i = 0; i < 100; ++i)
+        {   const std::uint64_t y = std::uint64_t(gen()) << 32 | gen();
+            std::uint64_t hi, hi_portable;
+            same = same && gynx::detail::mul128(x, y, hi) == gynx::detail::mul128_portable(x, y, hi_portable)
+                && hi == hi_portable;
+        }
+    CHECK(same);
+}
+
+TEST_CASE( "gynx::dedup", "[algorithm][dedup][parallel]" )
+{   SECTION( "fingerprint_set" )
+    {   gynx::fingerprint_set set(1 << 16, 4);
+        auto mix = [](std::uint64_t i)
+        {   return gynx::detail::hash_mum(i * 0x9E3779B97F4A7C15ull, 0xD6E8FEB86659FD93ull);
+        };
+        CHECK(set.insert(0));
+        CHECK(! set.insert(0));
+        CHECK(set.contains(0));
+        CHECK(! set.contains(42));
+        // concurrent inserts of overlapping ranges: each value is new once
+        gynx::thread_pool pool(4);
+        std::atomic<std::size_t> fresh{0};
+        gynx::parallel_for
+        (   pool
+        ,   8
+        ,   [&](std::size_t t)
+            {   for (std::uint64_t i = 1; i <= 4000; ++i)
+                    if (set.insert(mix(i + t % 2 * 2000)))
+                        ++fresh;
+            }
+        );
+        CHECK(fresh == 6000);
+        CHECK(set.size() == 6001);
+        CHECK(set.contains(mix(5999)));
+        CHECK(! set.saturated());
+        // 4 partitions of 2048 slots hold at most 4 * 1792 fingerprints
+        std::size_t added = 0;
+        for (std::uint64_t i = 1; i <= 20000; ++i)
+            added += set.insert(mix(i + 10000));
+        CHECK(added == 20000);
+        CHECK(set.saturated());
+        CHECK(set.size() <= 4 * 1792);
+        CHECK(set.bytes() <= 1 << 16);
+    }
+    SECTION( "reads" )
+    {   std::string filename = "test_dedup.fq";
+        {   std::ofstream os(filename);
+            os  << "@r0\nACGTTGCA\n+\nIIIIIIII\n"
+                << "@r1\nTTTTGGGG\n+\n########\n"
+                << "@r2\nACGTTGCA\n+\nIIIIIIII\n"   // duplicate of r0
+                << "@r3\nCCCCAAAA\n+\nIIIIIIII\n"   // reverse complement of r1
+                << "@r4\nGATTACA\n+\nIIIIIII\n"
+                << "@r5\nTTTTGGGG\n+\nIIIIIIII\n";  // duplicate of r1
+        }
+        gynx::thread_pool pool(3);
+        auto ids = [&](const gynx::dedup_options& o)
+        {   std::vector<std::string> v;
+            const auto st = gynx::dedup
+            (   filename
+            ,   [&](gynx::sq&& s)
+                {   v.push_back(std::any_cast<std::string>(s["_id"]));
+                }
+            ,   o
+            ,   pool
+            );
+            CHECK(st.kept == v.size());
+            CHECK(6 == st.reads);
+            CHECK(! st.saturated);
+            return std::make_pair(v, st);
+        };
+        gynx::dedup_options o;
+        o.batch_size = 2;
+        auto [first, st] = ids(o);
+        CHECK(first == std::vector<std::string>{ "r0", "r1", "r4" });
+        CHECK(3 == st.duplicates());
+        CHECK(0.5 == st.duplication_rate());
+        o.canonical = false;
+        CHECK(ids(o).first == std::vector<std::string>{ "r0", "r1", "r3", "r4" });
+        o.canonical = true;
+        o.keep = gynx::dedup_keep::best_quality;
+        CHECK(ids(o).first == std::vector<std::string>{ "r0", "r3", "r4" });
+        o.batch_size = 1000;
+        CHECK(ids(o).first == std::vector<std::string>{ "r0", "r3", "r4" });
+        CHECK_THROWS_AS(ids({ .batch_size = 0 }), std::invalid_argument);
+        std::remove(filename.c_str());
+    }
+    SECTION( "sample reads" )
+    {   std::vector<std::uint64_t> all;
+        gynx::in::fast_aqz<gynx::sq>()
+        (   SAMPLE_READS
+        ,   [&](gynx::sq&& s) { all.push_back(gynx::canonical_hash(s(0))); }
+        );
+        const std::size_t distinct = std::set<std::uint64_t>(all.begin(), all.end()).size();
+        std::size_t n = 0;
+        const auto st = gynx::dedup(SAMPLE_READS, [&](gynx::sq&&) { ++n; });
+        CHECK(st.reads == all.size());
+        CHECK(st.kept == distinct);
+        CHECK(n == distinct);
+        // a set too small for all reads keeps some duplicates, never loses reads
+        gynx::dedup_options tiny;
+        tiny.memory_limit = 1024;
+        const auto sat = gynx::dedup(SAMPLE_READS, [](gynx::sq&&) {}, tiny);
+        CHECK((all.size() <= 112 || sat.saturated));
+        CHECK(sat.kept >= distinct);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::quality_trim", "[algorithm][trim][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    const auto best = gynx::simd::detect();
+    std::mt19937 gen(41);
+    // reads that start good and degrade towards the 3' end
+    auto random_qual = [&](std::size_t n, unsigned offset)
+    {   std::string q(n, 'I');
+        for (std::size_t i = 0; i < n; ++i)
+        {   const int hi = 41 - int(40 * i / std::max<std::size_t>(n, 1));
+            q[i] = char(offset + gen() % std::max(hi, 1) + (gen() % 4 ? 0 : gen() % 20));
+        }
+        return q;
+    };
+
+    SECTION( "sliding window" )
+    {   auto naive = [](const std::string& q, std::size_t w, unsigned t, unsigned off)
+        {   const std::size_t n = q.size();
+            w = std::min(w, n);
+            for (std::size_t i = 0; w && i + w <= n; ++i)
+            {   unsigned s = 0;
+                for (std::size_t j = 0; j < w; ++j)
+                    s += q[i + j] - off;
+                if (s < w * t)
+                {   std::size_t k = i;
+                    while (k < i + w && unsigned(q[k] - off) >= t)
+                        ++k;
+                    return gynx::trim_range{ 0, k };
+                }
+            }
+            return gynx::trim_range{ 0, n };
+        };
+        for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            bool same = true;
+            for (std::size_t n : { 0, 1, 3, 4, 5, 20, 36, 37, 75, 150, 301 })
+                for (std::size_t w : { 1, 4, 5, 10, 64, 100 })
+                    for (unsigned off : { 33, 64 })
+                        for (int rep = 0; rep < 5; ++rep)
+                        {   const auto q = random_qual(n, off);
+                            gynx::sliding_window_trimmer t{ w, 20 };
+                            same = same && t(q, off) == naive(q, w, 20, off);
+                        }
+            // window sums needing more than 16 bits
+            for (unsigned th : { 20u, 250u, 600u })
+                for (std::size_t w : { 64, 1000 })
+                {   const auto q = random_qual(3000, 33);
+                    gynx::sliding_window_trimmer t{ w, th };
+                    same = same && t(q) == naive(q, w, th, 33);
+                }
+            CHECK(same);
+        }
+        gynx::simd::set_level(best);
+        CHECK(gynx::sliding_window_trimmer{}("IIIII#####") == gynx::trim_range{ 0, 5 });
+        CHECK(gynx::sliding_window_trimmer{}("II5#IIIIII") == gynx::trim_range{ 0, 10 });
+        CHECK(gynx::sliding_window_trimmer{}("II5#I#II##") == gynx::trim_range{ 0, 3 });
+        CHECK_THROWS_AS(gynx::sliding_window_trimmer{ 0 }("II"), std::invalid_argument);
+    }
+    SECTION( "bwa" )
+    {   // the example of the cutadapt documentation: -q 10 keeps 4 bases
+        const std::string q
+        {   char(33 + 42), char(33 + 40), char(33 + 26), char(33 + 27), char(33 + 8)
+        ,   char(33 + 7), char(33 + 11), char(33 + 4), char(33 + 2), char(33 + 3)
+        };
+        CHECK(gynx::bwa_trimmer{ 10 }(q) == gynx::trim_range{ 0, 4 });
+        CHECK(gynx::bwa_trimmer{ 10, 10 }(std::string(q.rbegin(), q.rend())) == gynx::trim_range{ 6, 10 });
+        CHECK(gynx::bwa_trimmer{ 0 }(q) == gynx::trim_range{ 0, 10 });
+        CHECK(gynx::bwa_trimmer{ 50 }(q) == gynx::trim_range{ 0, 0 });
+    }
+    SECTION( "mott" )
+    {   auto naive = [](const std::string& q, double limit, unsigned off)
+        {   double s = 0, m = 0;
+            std::size_t start = 0;
+            gynx::trim_range r;
+            for (std::size_t i = 0; i < q.size(); ++i)
+            {   s += limit - std::pow(10.0, -(q[i] - double(off)) / 10.0);
+                if (s > m)
+                {   m = s;
+                    r = { start, i + 1 };
+                }
+                if (s < 0)
+                {   s = 0;
+                    start = i + 1;
+                }
+            }
+            return r;
+        };
+        const gynx::mott_trimmer mott;
+        for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            bool same = true;
+            for (std::size_t n : { 0, 1, 31, 32, 33, 150, 500 })
+                for (int rep = 0; rep < 20; ++rep)
+                {   const auto q = random_qual(n, 33);
+                    same = same && mott(q) == naive(q, 0.05, 33);
+                    // all good: kept whole
+                    const std::string g(n, char(33 + 14 + rep));
+                    same = same && mott(g) == gynx::trim_range{ 0, n };
+                }
+            CHECK(same);
+        }
+        gynx::simd::set_level(best);
+        CHECK(mott(std::string(10, '#')) == gynx::trim_range{ 0, 0 });
+        CHECK_THROWS_AS(gynx::mott_trimmer(0.0), std::invalid_argument);
+    }
+    SECTION( "records" )
+    {   gynx::sq_gen<T> r("ACGTACGTAC");
+        CHECK(gynx::quality_trim(r, gynx::bwa_trimmer{}) == r(0));
+        r["_qs"] = std::string("IIIIIII###");
+        const auto v = gynx::quality_trim(r, gynx::bwa_trimmer{});
+        CHECK(v == "ACGTACG");
+        CHECK(v.data() == r.data());
+        r["_qs"] = std::string("hhhhhhhBBB");
+        CHECK(gynx::quality_trim(r, gynx::sliding_window_trimmer{ 2, 20 }, 64) == "ACGTACG");
+        r["_qs"] = std::string("III");
+        CHECK_THROWS_AS(gynx::quality_trim(r, gynx::bwa_trimmer{}), std::invalid_argument);
+
+        std::vector<gynx::sq_gen<T>> reads;
+        for (int i = 0; i < 3000; ++i)
+        {   const std::size_t n = 50 + gen() % 100;
+            gynx::sq_gen<T> s(n, 'A');
+            s["_qs"] = random_qual(n, 33);
+            reads.push_back(std::move(s));
+        }
+        gynx::thread_pool pool(3);
+        const gynx::mott_trimmer mott;
+        const auto each = gynx::quality_trim_each(reads, mott, 33, pool);
+        REQUIRE(each.size() == reads.size());
+        bool same = true;
+        for (std::size_t i = 0; i < reads.size(); ++i)
+            same = same
+                && each[i].data() == gynx::quality_trim(reads[i], mott).data()
+                && each[i].size() == gynx::quality_trim(reads[i], mott).size();
+        CHECK(same);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::quality_summary", "[algorithm][quality][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    const auto best = gynx::simd::detect();
+    std::mt19937 gen(42);
+    auto naive = [](const std::string& q, unsigned t, unsigned off)
+    {   gynx::read_quality r;
+        r.length = q.size();
+        r.min = q.empty() ? 0 : 255;
+        double sum = 0;
+        for (char ch : q)
+        {   const int s = std::max(0, int(static_cast<std::uint8_t>(ch)) - int(off));
+            r.expected_errors += std::pow(10.0, -std::min(s, 127) / 10.0);
+            sum += s;
+            r.min = std::min<unsigned>(r.min, s);
+            r.below += unsigned(s) < t;
+        }
+        r.mean = q.empty() ? 0 : sum / q.size();
+        return r;
+    };
+    auto close = [](double a, double b)
+    {   return std::abs(a - b) <= 1e-5 * std::max(1.0, std::abs(b));
+    };
+
+    SECTION( "quality strings" )
+    {   for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            bool same = true;
+            for (std::size_t n : { 0, 1, 7, 31, 32, 33, 64, 100, 151, 1000, 10000 })
+                for (unsigned off : { 33, 64 })
+                {   std::string q(n, 'I');
+                    for (auto& c : q)   // includes characters below the offset
+                        c = char(off - 2 + gen() % 45);
+                    const auto e = naive(q, 20, off);
+                    const auto r = gynx::quality_summary(q, 20, off);
+                    same = same
+                        && r.length == e.length
+                        && close(r.expected_errors, e.expected_errors)
+                        && close(gynx::expected_errors(q, off), e.expected_errors)
+                        && close(r.mean, e.mean)
+                        && r.min == e.min
+                        && r.below == e.below;
+                }
+            CHECK(same);
+        }
+        gynx::simd::set_level(best);
+        CHECK_THAT(gynx::expected_errors("+5?"), Catch::Matchers::WithinAbs(0.111, 1e-6));
+        CHECK(gynx::expected_errors("") == 0.0);
+        const auto r = gynx::quality_summary("II#5", 20);
+        CHECK(r.mean == 25.5);
+        CHECK(r.min == 2);
+        CHECK(r.below == 1);
+        CHECK_THAT(gynx::lut::phred33[static_cast<std::uint8_t>('+')], Catch::Matchers::WithinAbs(0.1, 1e-12));
+        CHECK_THAT(gynx::lut::phred_error[40], Catch::Matchers::WithinAbs(1e-4, 1e-9));
+    }
+    SECTION( "records" )
+    {   std::vector<gynx::sq_gen<T>> reads;
+        for (int i = 0; i < 2500; ++i)
+        {   const std::size_t n = 30 + gen() % 200;
+            gynx::sq_gen<T> s(n, 'A');
+            std::string q(n, 'I');
+            for (auto& c : q)
+                c = char(33 + gen() % 42);
+            s["_qs"] = q;
+            reads.push_back(std::move(s));
+        }
+        gynx::thread_pool pool(3);
+        const auto ee = gynx::expected_errors_each(reads, 33, pool);
+        const auto qs = gynx::quality_summary_each(reads, 30, 33, pool);
+        REQUIRE(ee.size() == reads.size());
+        REQUIRE(qs.size() == reads.size());
+        bool same = true;
+        for (std::size_t i = 0; i < reads.size(); ++i)
+        {   const auto q = std::any_cast<std::string>(reads[i]["_qs"]);
+            const auto e = naive(q, 30, 33);
+            same = same
+                && close(ee[i], e.expected_errors)
+                && ee[i] == gynx::expected_errors(reads[i])
+                && qs[i].below == e.below
+                && qs[i].min == e.min
+                && close(qs[i].mean, e.mean);
+        }
+        CHECK(same);
+        CHECK_THROWS_AS(gynx::expected_errors(gynx::sq_gen<T>("ACGT")), std::invalid_argument);
+    }
+}
+
+TEST_CASE( "gynx::qc", "[algorithm][qc][parallel]" )
+{   SECTION( "records" )
+    {   gynx::qc_collector c;
+        for (auto [s, q] : std::vector<std::pair<std::string, std::string>>
+        {   { "ACGTN", "!+5?I" }    // Phred 0, 10, 20, 30, 40
+        ,   { "GGCC",  "IIII"  }
+        ,   { "ACGTN", "!+5?I" }
+        })
+        {   gynx::sq r(s);
+            r["_qs"] = q;
+            c.add(r);
+        }
+        c.add(gynx::sq("AT"));      // no quality string
+        const auto r = c.report();
+        CHECK(4 == r.reads);
+        CHECK(16 == r.bases);
+        REQUIRE(5 == r.positions());
+        CHECK(r.base_counts[0] == std::array<std::uint64_t, 5>{ 3, 0, 1, 0, 0 });
+        CHECK(r.base_counts[4] == std::array<std::uint64_t, 5>{ 0, 0, 0, 0, 2 });
+        CHECK(0.75 == r.gc_content(1));
+        CHECK(1.0 == r.n_content(4));
+        REQUIRE(5 == r.quality_counts.size());
+        CHECK(2 == r.quality_counts[0][0]);
+        CHECK(1 == r.quality_counts[0][40]);
+        CHECK_THAT(r.mean_quality(0), Catch::Matchers::WithinAbs(40.0 / 3.0, 1e-9));
+        CHECK(0 == r.quality_quantile(0, 0.5));
+        CHECK(40 == r.quality_quantile(0, 0.9));
+        CHECK(40 == r.quality_quantile(4, 0.1));
+        CHECK(r.lengths == std::map<std::size_t, std::uint64_t>{ {2, 1}, {4, 1}, {5, 2} });
+        CHECK(2 == r.gc_counts[50]);
+        CHECK(1 == r.gc_counts[100]);
+        CHECK(1 == r.gc_counts[0]);
+        CHECK(2 == r.mean_quality_counts[20]);
+        CHECK(1 == r.mean_quality_counts[40]);
+        REQUIRE(3 == r.overrepresented.size());
+        CHECK("ACGTN" == r.overrepresented[0].sequence);
+        CHECK(2 == r.overrepresented[0].count);
+        CHECK(0.5 == r.overrepresented[0].fraction);
+    }
+    SECTION( "parallel" )
+    {   std::mt19937 gen(7);
+        std::vector<gynx::sq> reads;
+        for (int i = 0; i < 3000; ++i)
+        {   const std::size_t n = 20 + gen() % 120;
+            std::string s(n, 'A'), q(n, 'I');
+            for (std::size_t j = 0; j < n; ++j)
+            {   s[j] = "ACGTN"[gen() % 5];
+                q[j] = char(33 + gen() % 42);
+            }
+            gynx::sq r(i % 10 ? s : std::string("ACGTACGT"));
+            r["_qs"] = i % 10 ? q : std::string("IIIIIIII");
+            reads.push_back(std::move(r));
+        }
+        gynx::qc_options o;
+        o.max_positions = 100;
+        o.batch_size = 128;
+        gynx::qc_collector serial(o), parallel(o);
+        for (const auto& r : reads)
+            serial.add(r);
+        gynx::thread_pool pool(3);
+        parallel.add_each(reads, pool);
+        const auto a = serial.report(), b = parallel.report();
+        CHECK(a.reads == b.reads);
+        CHECK(a.bases == b.bases);
+        CHECK(100 == b.positions());
+        CHECK(a.base_counts == b.base_counts);
+        CHECK(a.quality_counts == b.quality_counts);
+        CHECK(a.lengths == b.lengths);
+        CHECK(a.gc_counts == b.gc_counts);
+        CHECK(a.mean_quality_counts == b.mean_quality_counts);
+        REQUIRE(1 == b.overrepresented.size());
+        CHECK("ACGTACGT" == b.overrepresented[0].sequence);
+        CHECK(300 == b.overrepresented[0].count);
+    }
+    SECTION( "sample reads" )
+    {   std::vector<gynx::sq> reads;
+        gynx::in::fast_aqz<gynx::sq>()
+        (   SAMPLE_READS
+        ,   [&](gynx::sq&& s) { reads.push_back(std::move(s)); }
+        );
+        gynx::qc_collector serial, streamed;
+        for (const auto& r : reads)
+            serial.add(r);
+        gynx::thread_pool pool(4);
+        CHECK(reads.size() == streamed.add_file(SAMPLE_READS, pool));
+        const auto a = serial.report(), b = streamed.report();
+        CHECK(a.reads == b.reads);
+        CHECK(a.base_counts == b.base_counts);
+        CHECK(a.quality_counts == b.quality_counts);
+        CHECK(a.lengths == b.lengths);
+        CHECK(a.gc_counts == b.gc_counts);
+        CHECK(a.mean_quality_counts == b.mean_quality_counts);
+        CHECK(a.overrepresented.size() == b.overrepresented.size());
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::adapter_trim", "[algorithm][trim][parallel]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    const std::string insert = "ACGTTGCAAGGCTTAC";
+    const std::string adapter = "AGATCGGAAGAGC";
+    gynx::adapter_trimmer trim;
+
+    SECTION( "single reads" )
+    {   CHECK(trim(insert + adapter + "TTT") == gynx::trim_range{ 0, 16 });
+        CHECK(trim(insert + "AGATCGGTAGAGC") == gynx::trim_range{ 0, 16 });
+        CHECK(trim(insert + "AGATCGCTAGAGC") == gynx::trim_range{ 0, 29 });
+        CHECK(trim(insert + "agat") == gynx::trim_range{ 0, 16 });
+        CHECK(trim(insert + "AG") == gynx::trim_range{ 0, 18 });
+        CHECK(trim(insert) == gynx::trim_range{ 0, 16 });
+        CHECK(trim(adapter) == gynx::trim_range{ 0, 0 });
+        CHECK(trim("") == gynx::trim_range{ 0, 0 });
+        // poly-G tails, with a mismatch, too short, then adapter before it
+        CHECK(trim(insert + "GGGGGGGGGGGGGG") == gynx::trim_range{ 0, 16 });
+        CHECK(trim(insert + "GGGGGGAGGGGGGGG") == gynx::trim_range{ 0, 16 });
+        CHECK(trim(insert + "GGGGG") == gynx::trim_range{ 0, 21 });
+        CHECK(trim(insert + adapter + std::string(20, 'G')) == gynx::trim_range{ 0, 16 });
+        gynx::adapter_options o;
+        o.poly_g = 0;
+        o.error_rate = 0.0;
+        gynx::adapter_trimmer strict(o);
+        CHECK(strict(insert + "GGGGGGGGGGGGGG") == gynx::trim_range{ 0, 30 });
+        CHECK(strict(insert + "AGATCGGTAGAGC") == gynx::trim_range{ 0, 29 });
+        CHECK(strict(insert + "AGATCNNNNNNNN" ) == gynx::trim_range{ 0, 29 });
+        o.adapter = "agatcnnaagagc";
+        CHECK(gynx::adapter_trimmer(o)(insert + "AGATCGTAAGAGC") == gynx::trim_range{ 0, 16 });
+        o.error_rate = 1.0;
+        CHECK_THROWS_AS(gynx::adapter_trimmer(o), std::invalid_argument);
+    }
+    SECTION( "pairs" )
+    {   std::mt19937 gen(5);
+        auto random = [&](std::size_t n)
+        {   std::string s(n, 'A');
+            for (auto& c : s)
+                c = "ACGT"[gen() % 4];
+            return s;
+        };
+        auto rc = [](std::string s)
+        {   gynx::reverse_complement(s.data(), s.data() + s.size());
+            return s;
+        };
+        gynx::adapter_options o;
+        o.adapter = o.adapter2 = "";
+        gynx::adapter_trimmer overlap(o);
+        // a 40 bp insert read through by both 60 bp mates
+        const std::string i40 = random(40);
+        std::string r1 = i40 + random(20), r2 = rc(i40) + random(20);
+        auto [t1, t2] = overlap(r1, r2);
+        CHECK(t1 == gynx::trim_range{ 0, 40 });
+        CHECK(t2 == gynx::trim_range{ 0, 40 });
+        r1[3] = r1[3] == 'A' ? 'C' : 'A';   // sequencing errors are tolerated
+        r2[30] = r2[30] == 'A' ? 'C' : 'A';
+        CHECK(overlap(r1, r2).first == gynx::trim_range{ 0, 40 });
+        // a 100 bp insert: mates overlap tail to tail, nothing is cut
+        const std::string i100 = random(100);
+        r1 = i100.substr(0, 60);
+        r2 = rc(i100).substr(0, 60);
+        CHECK(overlap(r1, r2).first == gynx::trim_range{ 0, 60 });
+        CHECK(overlap(r1, r2).second == gynx::trim_range{ 0, 60 });
+        // without an overlap the known adapters are used
+        CHECK(trim(insert + adapter, rc(i100).substr(0, 30) + adapter).second
+            == gynx::trim_range{ 0, 30 });
+    }
+    SECTION( "simd levels" )
+    {   const auto best = gynx::simd::detect();
+        std::mt19937 gen(13);
+        auto naive = [](std::string_view read, std::string_view a, double rate, std::size_t o)
+        {   for (std::size_t p = 0; p + o <= read.size(); ++p)
+            {   const std::size_t len = std::min(a.size(), read.size() - p);
+                std::size_t d = 0;
+                for (std::size_t i = 0; i < len; ++i)
+                    d += a[i] != 'N' && (read[p + i] & 0xDF) != (a[i] & 0xDF);
+                if (d <= static_cast<std::size_t>(double(len) * rate))
+                    return p;
+            }
+            return read.size();
+        };
+        std::vector<std::string> reads;
+        for (std::size_t n : { 0, 1, 2, 5, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 151, 300 })
+            for (int k = 0; k < 20; ++k)
+            {   std::string s(n, 'A');
+                for (auto& c : s)
+                    c = "ACGTNacgt"[gen() % 9];
+                if (n && k % 2)   // plant a mutated, possibly partial adapter
+                {   const std::size_t p = gen() % n;
+                    s.replace(p, std::min(adapter.size(), n - p), adapter.substr(0, n - p));
+                    s[p + gen() % std::min(adapter.size(), n - p)] = 'T';
+                }
+                reads.push_back(s);
+            }
+        for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            bool same = true;
+            for (const auto& s : reads)
+                for (const std::string& a : { adapter, std::string("AGNNCGG") })
+                    same = same && gynx::detail::find_adapter(s, a, 0.1, 3) == naive(s, a, 0.1, 3);
+            CHECK(same);
+        }
+        gynx::simd::set_level(best);
+    }
+    SECTION( "records" )
+    {   gynx::sq_gen<T> r(insert + adapter);
+        r["_qs"] = std::string(29, 'I');
+        CHECK(13 == gynx::adapter_trim(r, trim));
+        CHECK(r == insert);
+        CHECK(std::any_cast<std::string>(r["_qs"]) == std::string(16, 'I'));
+        CHECK(0 == gynx::adapter_trim(r, trim));
+        gynx::sq_gen<T> p(insert + "GGGGGGGGGGGGGG"), q(insert + adapter);
+        CHECK(27 == gynx::adapter_trim(p, q, trim));
+        CHECK(p == insert);
+        CHECK(q == insert);
+        CHECK(! p.has("_qs"));
+    }
+    SECTION( "files" )
+    {   std::mt19937 gen(9);
+        const std::string in1 = "test_adapter_1.fq", in2 = "test_adapter_2.fq";
+        const std::string out1 = "test_adapter_1.fq.gz", out2 = "test_adapter_2.fq.gz";
+        {   std::ofstream os1(in1), os2(in2);
+            for (int i = 0; i < 100; ++i)
+            {   std::string s(60, 'A');
+                for (auto& c : s)
+                    c = "ACGT"[gen() % 4];
+                if (i % 3 == 0)
+                    s.replace(20 + i % 30, adapter.size(), adapter);
+                if (i % 7 == 0)
+                    s.replace(45, 15, std::string(15, 'G'));
+                const std::string q(60, char(33 + i % 40));
+                const std::string header = "@r" + std::to_string(i)
+                    + (i % 5 == 0 ? " 1:N:0:ACGT" : "");
+                os1 << header << "\n" << s << "\n+\n" << q << "\n";
+                os2 << header << "\n" << s << "\n+\n" << q << "\n";
+            }
+        }
+        std::vector<gynx::sq_gen<T>> expected;
+        std::size_t removed = 0;
+        gynx::in::fast_aqz<gynx::sq_gen<T>>()
+        (   in1
+        ,   [&](gynx::sq_gen<T>&& s)
+            {   removed += gynx::adapter_trim(s, trim);
+                expected.push_back(std::move(s));
+            }
+        );
+        gynx::adapter_options o;
+        o.batch_size = 7;
+        gynx::thread_pool pool(3);
+        auto read_back = [](const std::string& filename)
+        {   std::vector<gynx::sq_gen<T>> v;
+            gynx::in::fast_aqz<gynx::sq_gen<T>>()
+            (   filename
+            ,   [&](gynx::sq_gen<T>&& s) { v.push_back(std::move(s)); }
+            );
+            return v;
+        };
+        auto same = [&](const std::vector<gynx::sq_gen<T>>& v)
+        {   bool ok = v.size() == expected.size();
+            for (std::size_t i = 0; ok && i < v.size(); ++i)
+                ok = v[i] == expected[i]
+                    && std::any_cast<std::string>(v[i]["_id"])
+                    == std::any_cast<std::string>(expected[i]["_id"])
+                    && std::any_cast<std::string>(v[i]["_qs"])
+                    == std::any_cast<std::string>(expected[i]["_qs"]);
+            return ok;
+        };
+        auto headers = [](const std::string& filename)
+        {   std::vector<std::string> v;
+            gzFile fp = gzopen(filename.c_str(), "r");
+            char line[256];
+            for (std::size_t i = 0; gzgets(fp, line, sizeof(line)); ++i)
+                if (0 == i % 4)
+                    v.emplace_back(line);
+            gzclose(fp);
+            return v;
+        };
+        const auto st = gynx::adapter_trim_file<gynx::sq_gen<T>>
+            (in1, out1, gynx::adapter_trimmer(o), pool);
+        CHECK(100 == st.reads);
+        CHECK(st.trimmed > 30);
+        CHECK(removed == st.bases_removed);
+        CHECK(same(read_back(out1)));
+        // header lines, with or without a comment, are written back as read
+        CHECK(headers(in1) == headers(out1));
+        // identical mates do not overlap head to head, so each is trimmed
+        // on its own
+        const auto pst = gynx::adapter_trim_files<gynx::sq_gen<T>>
+            (in1, in2, out1, out2, gynx::adapter_trimmer(o), pool);
+        CHECK(200 == pst.reads);
+        CHECK(2 * removed == pst.bases_removed);
+        CHECK(same(read_back(out1)));
+        CHECK(same(read_back(out2)));
+        {   std::ofstream os(in2, std::ios::app);
+            os << "@extra\nACGT\n+\nIIII\n";
+        }
+        CHECK_THROWS_AS
+        (   gynx::adapter_trim_files<gynx::sq_gen<T>>(in1, in2, out1, out2, trim, pool)
+        ,   std::runtime_error
+        );
+        o.batch_size = 0;
+        CHECK_THROWS_AS
+        (   gynx::adapter_trim_file<gynx::sq_gen<T>>(in1, out1, gynx::adapter_trimmer(o), pool)
+        ,   std::invalid_argument
+        );
+        for (const auto& f : { in1, in2, out1, out2 })
+            std::remove(f.c_str());
+    }
+}
+
+TEST_CASE( "gynx::phred", "[algorithm][quality][simd]" )
+{   const auto best = gynx::simd::detect();
+    std::mt19937 gen(17);
+    using gynx::phred_encoding;
+
+    SECTION( "range and conversion" )
+    {   for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            bool same = true;
+            for (std::size_t n : { 0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000 })
+            {   std::string q(n, 'I');
+                for (auto& c : q)
+                    c = char(33 + gen() % 94);
+                gynx::phred_range e;
+                for (char c : q)
+                {   e.min = std::min<std::uint8_t>(e.min, c);
+                    e.max = std::max<std::uint8_t>(e.max, c);
+                }
+                same = same && gynx::quality_range(q) == e;
+                std::string up = q, down = q;
+                gynx::convert_phred(up, phred_encoding::phred33, phred_encoding::phred64);
+                gynx::convert_phred(down, phred_encoding::phred64, phred_encoding::phred33);
+                for (std::size_t i = 0; i < n; ++i)
+                    same = same
+                        && up[i] == char(std::min(q[i] + 31, int('~')))
+                        && down[i] == char(std::max(q[i] - 31, int('!')));
+            }
+            CHECK(same);
+        }
+        gynx::simd::set_level(best);
+        CHECK(gynx::quality_range("").empty());
+        std::string q = "!+5?I";
+        gynx::convert_phred(q, phred_encoding::phred33, phred_encoding::phred64);
+        CHECK("@JT^h" == q);
+        gynx::convert_phred(q, phred_encoding::unknown, phred_encoding::phred33);
+        CHECK("@JT^h" == q);
+        gynx::sq r("ACGTA");
+        r["_qs"] = q;
+        gynx::convert_phred(r, phred_encoding::phred64, phred_encoding::phred33);
+        CHECK("!+5?I" == std::any_cast<std::string>(r["_qs"]));
+    }
+    SECTION( "detection" )
+    {   CHECK(phred_encoding::unknown == gynx::guess_phred({}));
+        CHECK(phred_encoding::phred33 == gynx::guess_phred(gynx::quality_range("#IIII")));
+        CHECK(phred_encoding::phred64 == gynx::guess_phred(gynx::quality_range("BhhhH")));
+        CHECK(phred_encoding::phred33 == gynx::in::detect_phred(SAMPLE_READS));
+        const std::string filename = "test_phred64.fq";
+        {   std::ofstream os(filename);
+            os  << "@r0\nACGT\n+\nhhhB\n"
+                << "@r1\nACGTA\n+\nhhh_@\n";
+        }
+        CHECK(phred_encoding::phred64 == gynx::in::detect_phred(filename));
+        CHECK(phred_encoding::phred64 == gynx::in::detect_phred(filename, 1));
+        // "-" reads the standard input, like gynx::in::fast_aqz
+        REQUIRE(std::freopen(filename.c_str(), "r", stdin));
+        CHECK(phred_encoding::phred64 == gynx::in::detect_phred("-"));
+        std::vector<std::string> qs;
+        gynx::in::fast_aqz<gynx::sq>
+        (   gynx::alphabet::iupac
+        ,   gynx::normalization::none
+        ,   gynx::in::detect_phred(filename)
+        )
+        (   filename
+        ,   [&](gynx::sq&& s) { qs.push_back(std::any_cast<std::string>(s["_qs"])); }
+        );
+        CHECK(qs == std::vector<std::string>{ "III#", "III@!" });
+        std::remove(filename.c_str());
+        CHECK_THROWS_AS(gynx::in::detect_phred("no_such_file.fq"), std::runtime_error);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::mask", "[algorithm][mask][parallel]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    std::mt19937 gen(19);
+    auto random = [&](std::size_t n)
+    {   std::string s(n, 'A');
+        for (auto& c : s)
+            c = "ACGT"[gen() % 4];
+        return s;
+    };
+    const std::string left = random(200), right = random(200);
+    gynx::sq_gen<T> s(left + std::string(40, 'A') + right);
+    gynx::sq_gen<T> tandem(left + std::string("CAGCAGCAGCAGCAGCAGCAGCAGCAGCAG") + right);
+
+    SECTION( "dust" )
+    {   gynx::dust_masker dust;
+        auto iv = dust(s(0));
+        REQUIRE(1 == iv.size());
+        CHECK(iv[0].begin <= 200);
+        CHECK(iv[0].end >= 240);
+        CHECK(iv[0].size() <= 48);
+        iv = dust(tandem(0));
+        REQUIRE(1 == iv.size());
+        CHECK(iv[0].begin <= 200);
+        CHECK(iv[0].end >= 230);
+        CHECK(dust(gynx::sq_gen<T>(left)(0)).empty());
+        // an N splits the run; each piece is still masked
+        gynx::sq_gen<T> n(left + std::string(20, 'A') + "N" + std::string(20, 'A') + right);
+        iv = dust(n(0));
+        REQUIRE(2 == iv.size());
+        CHECK(iv[0].end <= 220);
+        CHECK(iv[1].begin >= 221);
+        CHECK(dust(gynx::sq_gen<T>("")(0)).empty());
+        CHECK_THROWS_AS(gynx::dust_masker({ 20, 3 })(s(0)), std::invalid_argument);
+    }
+    SECTION( "entropy" )
+    {   gynx::entropy_masker entropy;
+        auto naive = [&](const std::string& x, const gynx::entropy_masker& m)
+        {   std::vector<gynx::mask_interval> out;
+            const std::size_t w = std::min(m.window, x.size());
+            const double norm = std::log2(double(std::min<std::size_t>(1u << (2 * m.k), w - m.k + 1)));
+            for (std::size_t b = 0; b + w <= x.size(); ++b)
+            {   std::map<std::string, int> c;
+                int total = 0;
+                for (std::size_t i = b; i + m.k <= b + w; ++i)
+                {   const auto kmer = x.substr(i, m.k);
+                    if (kmer.find_first_not_of("ACGT") == std::string::npos)
+                    {   ++c[kmer];
+                        ++total;
+                    }
+                }
+                double h = 0;
+                for (const auto& [k, v] : c)
+                    h -= double(v) / total * std::log2(double(v) / total);
+                if (total && h < m.threshold * norm)
+                {   if (! out.empty() && b <= out.back().end)
+                        out.back().end = b + w;
+                    else
+                        out.push_back({ b, b + w });
+                }
+            }
+            return out;
+        };
+        const std::string x = left + std::string(40, 'A') + "CAGCAGCAGCAGCAGCAGCAGCAG"
+            + random(30) + "NNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNNN" + right;
+        for (const auto& m : { entropy, gynx::entropy_masker{ 32, 2, 0.6 }, gynx::entropy_masker{ 20, 1, 0.8 } })
+        {   const auto iv = m(gynx::sq_gen<T>(x)(0));
+            CHECK(iv == naive(x, m));
+            CHECK(! iv.empty());
+        }
+        CHECK(entropy(gynx::sq_gen<T>(left)(0)).empty());
+        CHECK(entropy(gynx::sq_gen<T>("AAAAAAAAAA")(0)) == std::vector<gynx::mask_interval>{ { 0, 10 } });
+        CHECK(entropy(gynx::sq_gen<T>("AA")(0)).empty());
+        CHECK_THROWS_AS(gynx::entropy_masker({ 64, 9 })(s(0)), std::invalid_argument);
+    }
+    SECTION( "chunks and soft masking" )
+    {   std::string g;
+        for (int i = 0; i < 300; ++i)
+        {   g += random(gen() % 400);
+            switch (gen() % 4)
+            {   case 0: g += std::string(10 + gen() % 60, "ACGT"[gen() % 4]); break;
+                case 1: for (int r = gen() % 20; r >= 0; --r) g += "CA"; break;
+                case 2: g += "NNNNN"; break;
+                default: for (int r = gen() % 15; r >= 0; --r) g += "TTAGGG"; break;
+            }
+        }
+        gynx::sq_gen<T> genome(g);
+        gynx::thread_pool pool(3);
+        const gynx::dust_masker dust;
+        const gynx::entropy_masker entropy;
+        const auto d = dust(genome(0));
+        const auto e = entropy(genome(0));
+        CHECK(d.size() > 100);
+        CHECK(e.size() > 50);
+        for (std::size_t chunk : { 256, 1000, 4099 })
+        {   CHECK(gynx::mask_intervals(genome(0), dust, pool, chunk) == d);
+            CHECK(gynx::mask_intervals(genome(0), entropy, pool, chunk) == e);
+        }
+        auto masked = genome;
+        CHECK(gynx::soft_mask(masked, dust, pool) == d);
+        std::size_t lower = 0, expected = 0;
+        bool same = true;
+        for (std::size_t i = 0; i < masked.size(); ++i)
+        {   lower += masked[i] >= 'a';
+            same = same && std::toupper(masked[i]) == genome[i];
+        }
+        CHECK(same);
+        for (const auto& r : d)
+            for (std::size_t i = r.begin; i < r.end; ++i)
+                expected += genome[i] != 'N';
+        CHECK(lower == expected);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::homopolymer", "[algorithm][homopolymer][simd]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    gynx::sq_gen<T> s("AAACGGGGTNNA");
+
+    SECTION( "runs view" )
+    {   std::vector<gynx::homopolymer> runs;
+        for (auto r : s(0) | gynx::views::homopolymers())
+            runs.push_back(r);
+        const std::vector<gynx::homopolymer> expected
+        {   { 0, 'A', 3 }, { 3, 'C', 1 }, { 4, 'G', 4 }
+        ,   { 8, 'T', 1 }, { 9, 'N', 2 }, { 11, 'A', 1 }
+        };
+        CHECK(runs == expected);
+        CHECK(6 == std::ranges::distance(gynx::views::homopolymers()(s(0))));
+        CHECK(0 == std::ranges::distance(gynx::sq_gen<T>("")(0) | gynx::views::homopolymers()));
+        CHECK(std::ranges::equal(s(0) | gynx::views::homopolymers(), std::string("AAACGGGGTNNA") | gynx::views::homopolymers()));
+        // soft-masked residues are distinct bytes
+        CHECK(2 == std::ranges::distance(gynx::sq_gen<T>("aA")(0) | gynx::views::homopolymers()));
+    }
+    SECTION( "hpc" )
+    {   auto h = gynx::hpc(s);
+        CHECK(h.seq == "ACGTNA");
+        CHECK(h.offsets == std::vector<std::size_t>{ 0, 3, 4, 8, 9, 11, 12 });
+        CHECK(4 == h.original(2));
+        CHECK(4 == h.run_length(2));
+        CHECK(12 == h.original_size());
+        auto e = gynx::hpc(gynx::sq_gen<T>(""));
+        CHECK(e.seq.empty());
+        CHECK(e.offsets == std::vector<std::size_t>{ 0 });
+        CHECK(gynx::hpc(s(4, 4)).seq == "G");
+    }
+    SECTION( "simd levels" )
+    {   std::mt19937 gen(47);
+        std::string x;
+        while (x.size() < 5000)
+            x += std::string(1 + gen() % (gen() % 8 ? 4 : 150), "ACGTN"[gen() % 5]);
+        gynx::sq_gen<T> g(x);
+        std::string seq;
+        std::vector<std::size_t> offsets;
+        for (auto r : g(0) | gynx::views::homopolymers())
+        {   seq += r.base;
+            offsets.push_back(r.pos);
+        }
+        offsets.push_back(x.size());
+        const auto best = gynx::simd::detect();
+        for (int l = 0; l <= static_cast<int>(best); ++l)
+        {   gynx::simd::set_level(static_cast<gynx::simd::isa>(l));
+            for (std::size_t n : { std::size_t(0), std::size_t(1), std::size_t(63), std::size_t(64), std::size_t(65), x.size() })
+            {   const auto h = gynx::hpc(g(0, n));
+                const auto r = g(0, n) | gynx::views::homopolymers();
+                CHECK(h.seq.size() == std::size_t(std::ranges::distance(r)));
+                CHECK(h.original_size() == n);
+            }
+            const auto h = gynx::hpc(g);
+            CHECK(h.seq == seq);
+            CHECK(h.offsets == offsets);
+        }
+        gynx::simd::set_level(best);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::sketch", "[algorithm][sketch][parallel]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    std::mt19937 gen(48);
+    auto random = [&](std::size_t n)
+    {   std::string s(n, 'A');
+        for (auto& c : s)
+            c = "ACGT"[gen() % 4];
+        return s;
+    };
+    auto mutate = [&](std::string s, double rate)
+    {   for (auto& c : s)
+            if (gen() % 10000 < rate * 10000)
+                c = "ACGT"[(std::string_view("ACGT").find(c) + 1 + gen() % 3) % 4];
+        return s;
+    };
+    const std::string x = random(50000);
+    gynx::sq_gen<T> a(x);
+
+    SECTION( "bottom-k" )
+    {   const gynx::sketch_options o{ 15, 200, 0, 7 };
+        const gynx::sketch s(a(0), o);
+        // naive: hash every canonical k-mer and keep the smallest distinct
+        const gynx::invertible_hash hash{ (std::uint64_t(1) << 30) - 1 };
+        std::set<std::uint64_t> all;
+        for (auto km : a(0) | gynx::views::kmers(15))
+            all.insert(hash(km.canonical() ^ 7));
+        std::vector<std::uint64_t> expected(all.begin(), all.end());
+        expected.resize(200);
+        CHECK(s.hashes() == expected);
+        CHECK(s.max_hash() == expected.back());
+        auto rc = a;
+        gynx::reverse_complement(rc);
+        CHECK(gynx::sketch(rc(0), o) == s);
+        // adding pieces equals merging their sketches
+        gynx::sketch u(o), h1(a(0, 20000), o), h2(a(20000), o);
+        u.add(a(0, 20000));
+        u.add(a(20000));
+        h1.merge(h2);
+        CHECK(u == h1);
+        CHECK(gynx::sketch(gynx::sq_gen<T>("ACGTN")(0), o).empty());
+        CHECK_THROWS_AS(gynx::sketch({ 0 }), std::invalid_argument);
+        CHECK_THROWS_AS(gynx::sketch({ 33 }), std::invalid_argument);
+        CHECK_THROWS_AS(gynx::sketch({ 21, 0 }), std::invalid_argument);
+    }
+    SECTION( "distances" )
+    {   const gynx::sketch s(a(0));
+        CHECK(1.0 == gynx::jaccard(s, s));
+        CHECK(0.0 == gynx::mash_distance(s, s));
+        const gynx::sketch m(gynx::sq_gen<T>(mutate(x, 0.01))(0));
+        CHECK_THAT(gynx::mash_distance(s, m), Catch::Matchers::WithinAbs(0.01, 0.004));
+        const gynx::sketch r(gynx::sq_gen<T>(random(50000))(0));
+        CHECK(1.0 == gynx::mash_distance(s, r));
+        CHECK(1.0 == gynx::mash_distance(0.0, 21));
+        CHECK_THROWS_AS(gynx::jaccard(s, gynx::sketch({ 19 })), std::invalid_argument);
+        // FracMinHash estimates containment of a subset
+        const gynx::sketch_options f{ 21, 0, 50 };
+        const gynx::sketch whole(a(0), f), half(a(0, 25000), f);
+        CHECK(whole.size() > 700);
+        CHECK(1.0 == gynx::containment(half, whole));
+        CHECK_THAT(gynx::containment(whole, half), Catch::Matchers::WithinAbs(0.5, 0.1));
+        CHECK_THAT(gynx::jaccard(whole, half), Catch::Matchers::WithinAbs(0.5, 0.1));
+    }
+    SECTION( "serialization" )
+    {   std::vector<gynx::sketch> v
+        {   gynx::sketch(a(0))
+        ,   gynx::sketch(a(0), { 21, 0, 100 })
+        ,   gynx::sketch(a(0, 10), { 5, 2000 })
+        ,   gynx::sketch()
+        };
+        std::stringstream ss;
+        v[0].write(ss);
+        CHECK(ss.str().size() < 8 * v[0].size());
+        gynx::sketch r;
+        r.read(ss);
+        CHECK(r == v[0]);
+        const auto path = std::filesystem::temp_directory_path() / "gynx_sketch_test.msh";
+        gynx::save_sketches(path, v);
+        CHECK(gynx::load_sketches(path) == v);
+        std::filesystem::remove(path);
+        std::stringstream bad("GYNXSQ");
+        CHECK_THROWS_AS(r.read(bad), std::runtime_error);
+    }
+    SECTION( "all vs all" )
+    {   std::vector<gynx::sketch> v;
+        for (double rate : { 0.0, 0.01, 0.02, 0.05, 0.1 })
+            v.emplace_back(gynx::sq_gen<T>(mutate(x, rate))(0));
+        gynx::thread_pool pool(3);
+        const auto d = gynx::mash_distances(v, pool);
+        REQUIRE(d.size() == 25);
+        bool same = true;
+        for (std::size_t i = 0; i < 5; ++i)
+            for (std::size_t j = 0; j < 5; ++j)
+                same = same && d[i * 5 + j] == (i == j ? 0.0 : gynx::mash_distance(v[i], v[j]));
+        CHECK(same);
+        CHECK(d[1] < d[2]);
+        CHECK(d[2] < d[3]);
+        CHECK(d[3] < d[4]);
+        v.push_back(gynx::sketch({ 15 }));
+        CHECK_THROWS_AS(gynx::mash_distances(v, pool), std::invalid_argument);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::bloom_filter", "[algorithm][bloom][parallel]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    std::mt19937 gen(49);
+    auto random = [&](std::size_t n)
+    {   std::string s(n, 'A');
+        for (auto& c : s)
+            c = "ACGT"[gen() % 4];
+        return s;
+    };
+    const std::string x = random(60000);
+    gynx::sq_gen<T> a(x), other(random(60000));
+    const std::size_t kmers = x.size() - 31 + 1;
+    auto files_equal = [](const std::filesystem::path& p, const std::filesystem::path& q)
+    {   std::ifstream f(p, std::ios::binary), g(q, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(f), {})
+            == std::string(std::istreambuf_iterator<char>(g), {});
+    };
+
+    SECTION( "membership" )
+    {   gynx::bloom_filter bf(31, kmers);
+        CHECK(31 == bf.k());
+        CHECK(bf.canonical());
+        CHECK(bf.bytes() == 64 * (bf.blocks() + 1));
+        CHECK(kmers == bf.insert(a));
+        CHECK(kmers == bf.count(a));
+        auto rc = a;
+        gynx::reverse_complement(rc);
+        CHECK(kmers == bf.count(rc));
+        CHECK(bf.count(other) < kmers / 100);
+        // single and batch queries on raw codes
+        std::vector<std::uint64_t> codes;
+        for (auto km : a(0, 1000) | gynx::views::kmers(31))
+            codes.push_back(km.canonical());
+        for (auto km : other(0, 1000) | gynx::views::kmers(31))
+            codes.push_back(km.canonical());
+        std::vector<std::uint8_t> hit(codes.size());
+        const auto hits = bf.contains(codes.data(), codes.data() + codes.size(), hit.data());
+        bool same = true;
+        for (std::size_t i = 0; i < codes.size(); ++i)
+            same = same && bool(hit[i]) == bf.contains(codes[i]) && (i >= 970 || hit[i]);
+        CHECK(same);
+        CHECK(hits >= 970);
+        CHECK(hits < 990);
+        // forward-only filters tell the strands apart
+        gynx::bloom_filter fwd(31, kmers, 16.0, false);
+        fwd.insert(a);
+        CHECK(kmers == fwd.count(a));
+        CHECK(fwd.count(rc) < kmers / 100);
+        gynx::bloom_filter empty;
+        CHECK(empty.empty());
+        CHECK(0 == empty.count(a));
+        CHECK(! empty.contains(codes[0]));
+        CHECK_THROWS_AS(gynx::bloom_filter(33, 100), std::invalid_argument);
+        CHECK_THROWS_AS(gynx::bloom_filter(21, 100, 0.0), std::invalid_argument);
+    }
+    SECTION( "concurrent insertion and persistence" )
+    {   gynx::bloom_filter serial(25, kmers, 10.0), parallel(25, kmers, 10.0);
+        serial.insert(a);
+        gynx::thread_pool pool(3);
+        gynx::parallel_for
+        (   pool
+        ,   60
+        ,   [&](std::size_t i)
+            {   parallel.insert(a(i * 1000, 1000 + 24));
+            }
+        );
+        const auto dir = std::filesystem::temp_directory_path();
+        const auto p = dir / "gynx_bloom_test_1.bf", q = dir / "gynx_bloom_test_2.bf";
+        serial.save(p);
+        parallel.save(q);
+        CHECK(files_equal(p, q));
+        const gynx::bloom_filter mapped(p);
+        CHECK(25 == mapped.k());
+        CHECK(mapped.blocks() == serial.blocks());
+        CHECK(x.size() - 24 == mapped.count(a));
+        CHECK(mapped.count(other) == serial.count(other));
+        // a copy of a mapped filter owns its bits
+        auto copy = mapped;
+        copy.insert(other);
+        CHECK(copy.count(other) == 60000 - 24);
+        CHECK(mapped.count(other) == serial.count(other));
+        // filters built from a file on a pool
+        const auto fa = dir / "gynx_bloom_test.fa";
+        {   std::ofstream os(fa);
+            for (std::size_t i = 0; i < 60; ++i)
+                os << ">r" << i << '\n' << x.substr(i * 1000, 1000 + 24) << '\n';
+        }
+        gynx::bloom_filter from_file(25, kmers, 10.0);
+        CHECK(60 == from_file.insert_file<gynx::sq_gen<T>>(fa.string(), pool, {}, 7));
+        from_file.save(q);
+        CHECK(files_equal(p, q));
+        std::filesystem::remove(fa);
+        std::filesystem::remove(p);
+        std::filesystem::remove(q);
+        CHECK_THROWS_AS(gynx::bloom_filter(fa), std::runtime_error);
+    }
+}
+
+TEMPLATE_TEST_CASE( "gynx::execution", "[algorithm][parallel]", GYNX_TEST_CONTAINERS )
+{   typedef TestType T;
+    std::mt19937 gen(50);
+    gynx::thread_pool pool(3);
+
+    SECTION( "whole-sequence algorithms" )
+    {   // longer than two parallel blocks, so reverse complements pair blocks
+        // and leave an odd-sized middle
+        std::string x(2 * gynx::detail::parallel_block + 1234567, 'A');
+        for (auto& c : x)
+            c = "ACGTNacgtnRY-"[gen() % 13];
+        const gynx::sq_gen<T> s(x);
+        auto serial = s, parallel = s;
+        gynx::reverse_complement(serial);
+        gynx::reverse_complement(parallel, pool);
+        CHECK(serial == parallel);
+        CHECK(serial == gynx::reverse_complement_copy(s(0), pool));
+        CHECK(serial == gynx::reverse_complement_copy(std::execution::par, s(0)));
+        gynx::reverse_complement(std::execution::seq, parallel);
+        CHECK(s == parallel);
+        CHECK(gynx::composition(s(0)) == gynx::composition(std::execution::par, s(0)));
+        CHECK(gynx::gc_content(s(0)) == gynx::gc_content(std::execution::seq, s(0)));
+        const auto p = gynx::gc_profile(std::execution::par, s(0), 1000, 100);
+        CHECK(p.size() == gynx::gc_profile(s(0), 1000, 100).size());
+        // case folding
+        auto upper = s, upper_parallel = s;
+        CHECK(x.size() == gynx::normalize(upper, gynx::alphabet::iupac));
+        CHECK(x.size() == gynx::normalize(upper_parallel, gynx::alphabet::iupac, gynx::normalization::uppercase, pool));
+        CHECK(upper == upper_parallel);
+        // the first residue outside the alphabet is reported
+        x[5000000] = x[9000000] = '!';
+        gynx::sq_gen<T> bad(x), bad_parallel(x), replaced(x), replaced_parallel(x);
+        CHECK(5000000 == gynx::normalize(bad, gynx::alphabet::iupac));
+        CHECK(5000000 == gynx::normalize(std::execution::par, bad_parallel, gynx::alphabet::iupac));
+        CHECK(std::equal(bad.begin(), bad.begin() + 5000000, bad_parallel.begin()));
+        CHECK(x.size() == gynx::normalize(replaced, gynx::alphabet::iupac, gynx::normalization::replace));
+        CHECK(x.size() == gynx::normalize(std::execution::par_unseq, replaced_parallel, gynx::alphabet::iupac, gynx::normalization::replace));
+        CHECK(replaced == replaced_parallel);
+    }
+    SECTION( "minimizers" )
+    {   std::string x;
+        while (x.size() < 50000)
+        {   x += std::string(1 + gen() % 300, 'A');
+            if (0 == gen() % 7)
+                x += std::string(1 + gen() % 40, 'N');
+        }
+        for (auto& c : x)
+            if (c != 'N')
+                c = "ACGT"[gen() % 4];
+        const gynx::sq_gen<T> s(x);
+        for (auto [w, k] : { std::pair<std::size_t, std::size_t>{ 10, 15 }, { 1, 5 }, { 50, 21 }, { 5, 31 } })
+        {   const auto expected = gynx::minimizers(s(0), w, k);
+            for (std::size_t chunk : { 1, 100, 1000, 4099, 1 << 20 })
+                CHECK(expected == gynx::minimizers(s(0), w, k, pool, gynx::invertible_hash(), chunk));
+            CHECK(expected == gynx::minimizers(std::execution::par, s(0), w, k));
+        }
+        CHECK_THROWS_AS(gynx::minimizers(s(0), 0, 15, pool), std::invalid_argument);
+    }
 }